@@ -0,0 +1,226 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Clock System - Crystal Startup in the Background
+ *
+ * Description: Starts the 48 MHz crystal on HFXTIN/HFXTOUT and the 32 kHz
+ * crystal on LFXTIN/LFXTOUT with CS_startCrystal, which returns at once.
+ * The application keeps running from the DCO and REFO while the fault
+ * counters watch the crystals. Once a crystal has oscillated for the set
+ * number of cycles without a fault, the CS interrupt calls its ready
+ * callback. That runs in the interrupt and must not change clocks, so it
+ * only flags main, which switches the clocks over: MCLK and HSMCLK to
+ * HFXT, SMCLK to HFXT/2, ACLK and BCLK to LFXT. A crystal still not stable
+ * after two seconds is given up and its clocks stay where they were.
+ *
+ * Where CS_startHFXT and CS_startLFXT would hold main for the whole start
+ * up, here it gets on with its work straight away. benchResults records
+ * when each crystal was ready, in milliseconds from main, whether it was
+ * stable, and the passes main made in the meantime. The core voltage is
+ * raised for 48 MHz while the crystals start.
+ * ACLK = REFO then LFXT = 32 kHz, MCLK = HSMCLK = DCO then HFXT = 48 MHz
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.0  |---> LED, lit while a crystal is starting
+ *            |      PJ.0 LFXIN  |---------
+ *            |                  |         |
+ *            |                  |     < 32khz xTal >
+ *            |                  |         |
+ *            |      PJ.1 LFXOUT |---------
+ *            |      PJ.3 HFXTIN |---------
+ *            |                  |         |
+ *            |                  |     < 48Mhz xTal >
+ *            |                  |         |
+ *            |     PJ.2 HFXTOUT |---------
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TICKS_PER_MS  4    // ACLK/8, 4096 Hz
+#define DEADLINE_TICK 8192 // two seconds
+
+typedef struct {
+  uint32_t hfxtReadyMilliseconds;
+  uint32_t lfxtReadyMilliseconds;
+  bool     hfxtStable;
+  bool     lfxtStable;
+  uint32_t passesWhileStarting;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+/* Set by the ready callbacks, for main to switch the clocks over */
+static volatile bool hfxtSwitch;
+static volatile bool lfxtSwitch;
+
+/* Timer_A0 counts from main on, on ACLK, which keeps its rate when it
+ * moves from REFO to LFXT */
+static const Timer_A_ContinuousModeConfig clockConfig = {
+    TIMER_A_CLOCKSOURCE_ACLK,        // ACLK Clock Source
+    TIMER_A_CLOCKSOURCE_DIVIDER_8,   // ACLK/8 = 4096 Hz
+    TIMER_A_TAIE_INTERRUPT_DISABLE,  // Disable Timer interrupt
+    TIMER_A_DO_CLEAR                 // Clear value
+};
+
+static const Timer_A_CompareModeConfig deadlineConfig = {
+    TIMER_A_CAPTURECOMPARE_REGISTER_1,        // CCR1
+    TIMER_A_CAPTURECOMPARE_INTERRUPT_ENABLE,  // Enable CCR1 interrupt
+    TIMER_A_OUTPUTMODE_OUTBITVALUE,           // No output
+    DEADLINE_TICK                             // Two seconds from main
+};
+
+static uint32_t milliseconds(void) {
+  return MAP_Timer_A_getCounterValue(TIMER_A0_BASE) / TICKS_PER_MS;
+}
+
+static bool starting(void) {
+  return CS_isCrystalStarting(CS_HFXT_FAULT_COUNTER) ||
+         CS_isCrystalStarting(CS_LFXT_FAULT_COUNTER);
+}
+
+/* From the CS interrupt, once HFXT is stable or given up */
+static void hfxtReady(bool stable) {
+  benchResults.hfxtReadyMilliseconds = milliseconds();
+  benchResults.hfxtStable            = stable;
+  hfxtSwitch                         = stable;
+  if (!starting())
+    MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+}
+
+/* From the CS interrupt, once LFXT is stable or given up */
+static void lfxtReady(bool stable) {
+  benchResults.lfxtReadyMilliseconds = milliseconds();
+  benchResults.lfxtStable            = stable;
+  lfxtSwitch                         = stable;
+  if (!starting())
+    MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+}
+
+/* From main, the clocks over to the crystals that are ready */
+static void switchClocks(void) {
+  if (hfxtSwitch) {
+    hfxtSwitch = false;
+    /* SMCLK divided down before its source speeds up */
+    MAP_CS_initClockSignal(CS_SMCLK, CS_HFXTCLK_SELECT, CS_CLOCK_DIVIDER_2);
+    MAP_CS_initClockSignal(CS_HSMCLK, CS_HFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
+    MAP_CS_initClockSignal(CS_MCLK, CS_HFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  }
+  if (lfxtSwitch) {
+    lfxtSwitch = false;
+    MAP_CS_initClockSignal(CS_ACLK, CS_LFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
+    MAP_CS_initClockSignal(CS_BCLK, CS_LFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  }
+}
+
+/* Stable after 32768 cycles without a fault, about 0.7 ms */
+static const CS_CrystalStart hfxtStart = {
+    CS_HFXT_FAULT_COUNTER, 0, CS_FAULT_COUNTER_32768_CYCLES, 0, hfxtReady};
+
+/* Stable after 8192 cycles without a fault, a quarter of a second */
+static const CS_CrystalStart lfxtStart = {CS_LFXT_FAULT_COUNTER,
+                                          CS_LFXT_DRIVE3,
+                                          CS_FAULT_COUNTER_8192_CYCLES, 0,
+                                          lfxtReady};
+
+int main(void) {
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  /* No ready callback until the core voltage is up */
+  MAP_Interrupt_disableMaster();
+
+  /* The deadline cancels the starts from TA0_N, which the CS driver must
+   * be able to hold off, so nothing stays at the reset priority of 0 */
+  Interrupt_applyPriorityPlan();
+
+  /* Time kept on ACLK from REFO until LFXT takes over */
+  MAP_CS_setReferenceOscillatorFrequency(CS_REFO_32KHZ);
+  MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  MAP_Timer_A_configureContinuousMode(TIMER_A0_BASE, &clockConfig);
+  MAP_Timer_A_initCompare(TIMER_A0_BASE, &deadlineConfig);
+  MAP_Interrupt_enableInterrupt(INT_TA0_N);
+  MAP_Timer_A_startCounter(TIMER_A0_BASE, TIMER_A_CONTINUOUS_MODE);
+
+  /* Crystal pins, then the crystals, which start without waiting */
+  MAP_GPIO_setAsPeripheralModuleFunctionOutputPin(
+      GPIO_PORT_PJ, GPIO_PIN0 | GPIO_PIN1 | GPIO_PIN2 | GPIO_PIN3,
+      GPIO_PRIMARY_MODULE_FUNCTION);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  CS_setExternalClockSourceFrequency(32768, 48000000);
+  CS_startCrystal(&hfxtStart);
+  CS_startCrystal(&lfxtStart);
+
+  /* VCORE1 and 3 wait states for the 48 MHz MCLK, meanwhile */
+  MAP_PCM_setCoreVoltageLevel(PCM_VCORE1);
+  MAP_FlashCtl_A_setWaitState(FLASH_A_BANK0, 3);
+  MAP_FlashCtl_A_setWaitState(FLASH_A_BANK1, 3);
+
+  MAP_Interrupt_enableMaster();
+
+  while (1) {
+    switchClocks();
+
+    /* Work the application would otherwise have waited out */
+    if (starting()) {
+      benchResults.passesWhileStarting++;
+      continue;
+    }
+
+    /* Asleep only with no switch flagged, a ready callback wakes it */
+    MAP_Interrupt_disableMaster();
+    if (!hfxtSwitch && !lfxtSwitch)
+      MAP_PCM_gotoLPM0();
+    MAP_Interrupt_enableMaster();
+  }
+}
+
+void CS_IRQHandler(void) { CS_handleCrystalInterrupt(); }
+
+/* A crystal that has not come up by the deadline is not going to */
+void TA0_N_IRQHandler(void) {
+  MAP_Timer_A_clearCaptureCompareInterrupt(TIMER_A0_BASE,
+                                           TIMER_A_CAPTURECOMPARE_REGISTER_1);
+  MAP_Timer_A_disableCaptureCompareInterrupt(
+      TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1);
+
+  CS_cancelCrystalStart(CS_HFXT_FAULT_COUNTER);
+  CS_cancelCrystalStart(CS_LFXT_FAULT_COUNTER);
+}
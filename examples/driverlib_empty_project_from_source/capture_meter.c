@@ -0,0 +1,306 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <math.h>
+#include <ti/devices/msp432p4xx/driverlib/capture_meter.h>
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/dma.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+// Capture numbers wrap at 2^32, which only keeps capture % LENGTH
+// continuous for a power of two
+#if (CAPTUREMETER_LENGTH & (CAPTUREMETER_LENGTH - 1)) ||                       \
+    CAPTUREMETER_LENGTH > 2048 || CAPTUREMETER_LENGTH < 8
+#error "CAPTUREMETER_LENGTH must be a power of two, from 8 to 2048"
+#endif
+
+// One DMA control structure covers each half of the ring
+#define CAPTUREMETER_HALF (CAPTUREMETER_LENGTH / 2)
+
+// CCR1 dates the captures, interrupting at the wrap and in the middle
+#define CAPTUREMETER_DATING 1
+#define CAPTUREMETER_MIDDLE 0x8000
+
+static CaptureMeter_Meter *CaptureMeter_meters[4];
+
+// Indexed by DMA channel, 2 * instance for CCR0 and 2 * instance + 1 for
+// CCR2
+static const uint32_t CaptureMeter_dmaMappings[8] = {
+    DMA_CH0_TIMERA0CCR0, DMA_CH1_TIMERA0CCR2, DMA_CH2_TIMERA1CCR0,
+    DMA_CH3_TIMERA1CCR2, DMA_CH4_TIMERA2CCR0, DMA_CH5_TIMERA2CCR2,
+    DMA_CH6_TIMERA3CCR0, DMA_CH7_TIMERA3CCR2};
+
+// Points the primary or alternate structure at its half of the ring
+static void CaptureMeter_arm(CaptureMeter_Meter *meter, uint32_t select) {
+  uint32_t  structure = meter->dmaChannel | select;
+  uint16_t *half =
+      &meter->captures[select == UDMA_ALT_SELECT ? CAPTUREMETER_HALF : 0];
+
+  DMA_setChannelControl(structure, UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                                       UDMA_DST_INC_16 | UDMA_ARB_1);
+  DMA_setChannelTransfer(
+      structure, UDMA_MODE_PINGPONG,
+      (void *)&TIMER_A_CMSIS(meter->timer)->CCR[meter->ccr], half,
+      CAPTUREMETER_HALF);
+}
+
+// Ring index the DMA writes next
+static uint_fast16_t CaptureMeter_dmaPosition(const CaptureMeter_Meter *meter) {
+  uint32_t alternate, remaining;
+
+  // The DMA may move on to the other half between the two reads
+  do {
+    alternate = DMA_getChannelAttribute(meter->dmaChannel) &
+                UDMA_ATTR_ALTSELECT;
+    remaining = DMA_getChannelSize(
+        meter->dmaChannel | (alternate ? UDMA_ALT_SELECT : UDMA_PRI_SELECT));
+  } while (alternate != (DMA_getChannelAttribute(meter->dmaChannel) &
+                         UDMA_ATTR_ALTSELECT));
+
+  return ((alternate ? CAPTUREMETER_LENGTH : CAPTUREMETER_HALF) - remaining) %
+         CAPTUREMETER_LENGTH;
+}
+
+static void CaptureMeter_date(CaptureMeter_Meter *meter) {
+  Timer_A_Type *timer = TIMER_A_CMSIS(meter->timer);
+  uint_fast16_t position, index;
+  bool          wrapped;
+
+  position = CaptureMeter_dmaPosition(meter);
+
+  wrapped = timer->CCR[CAPTUREMETER_DATING] == 0;
+  timer->CCR[CAPTUREMETER_DATING] ^= CAPTUREMETER_MIDDLE;
+
+  // The captures since the last interrupt. If the count has just wrapped
+  // that was in the middle of the previous counter period, and those
+  // below the middle were taken after the wrap.
+  for (index = meter->position; index != position;
+       index = (index + 1) % CAPTUREMETER_LENGTH) {
+    meter->wraps[index] = meter->wrap;
+    if (wrapped && meter->captures[index] < CAPTUREMETER_MIDDLE)
+      meter->wraps[index]++;
+  }
+  meter->dated += (position - meter->position + CAPTUREMETER_LENGTH) %
+                  CAPTUREMETER_LENGTH;
+  meter->position = position;
+  if (wrapped)
+    meter->wrap++;
+
+  // Rearm the half the DMA has finished, long before it gets back to it
+  if (DMA_getChannelMode(meter->dmaChannel | UDMA_PRI_SELECT) ==
+      UDMA_MODE_STOP)
+    CaptureMeter_arm(meter, UDMA_PRI_SELECT);
+  if (DMA_getChannelMode(meter->dmaChannel | UDMA_ALT_SELECT) ==
+      UDMA_MODE_STOP)
+    CaptureMeter_arm(meter, UDMA_ALT_SELECT);
+  DMA_clearInterruptFlag(meter->dmaChannel);
+}
+
+void CaptureMeter_init(uint32_t timer, CaptureMeter_Meter *meter,
+                       const CaptureMeter_Config *config) {
+  const Timer_A_ContinuousModeConfig continuousConfig = {
+      config->clockSource, config->clockSourceDivider,
+      TIMER_A_TAIE_INTERRUPT_DISABLE, TIMER_A_DO_CLEAR};
+  Timer_A_Type *timerA;
+  uint_fast8_t  instance;
+  uint32_t      basePri;
+
+  ASSERT(timer == TIMER_A0_BASE || timer == TIMER_A1_BASE ||
+         timer == TIMER_A2_BASE || timer == TIMER_A3_BASE);
+  ASSERT(config->captureRegister == TIMER_A_CAPTURECOMPARE_REGISTER_0 ||
+         config->captureRegister == TIMER_A_CAPTURECOMPARE_REGISTER_2);
+  ASSERT(config->captureMode == TIMER_A_CAPTUREMODE_RISING_EDGE ||
+         config->captureMode == TIMER_A_CAPTUREMODE_FALLING_EDGE ||
+         config->captureMode == TIMER_A_CAPTUREMODE_RISING_AND_FALLING_EDGE);
+  ASSERT(DMA_getControlBase() != 0);
+
+  instance = (timer - TIMER_A0_BASE) >> 10;
+  timerA   = TIMER_A_CMSIS(timer);
+
+  Timer_A_stopTimer(timer);
+
+  meter->timer          = timer;
+  meter->clockFrequency = config->clockFrequency;
+  meter->ccr            = (config->captureRegister >> 1) - 1;
+  meter->dmaChannel     = 2 * instance + (meter->ccr == 2);
+  meter->bothEdges =
+      config->captureMode == TIMER_A_CAPTUREMODE_RISING_AND_FALLING_EDGE;
+  meter->wrap     = 0;
+  meter->position = 0;
+  meter->dated    = 0;
+
+  DMA_disableChannel(meter->dmaChannel);
+  CaptureMeter_meters[instance] = meter;
+
+  Timer_A_configureContinuousMode(timer, &continuousConfig);
+
+  // Capture mode with no edge selected until the counter runs
+  timerA->CCTL[meter->ccr] = TIMER_A_CCTLN_CAP | TIMER_A_CAPTURE_SYNCHRONOUS |
+                             config->captureInputSelect;
+  timerA->CCR[CAPTUREMETER_DATING]  = CAPTUREMETER_MIDDLE;
+  timerA->CCTL[CAPTUREMETER_DATING] = TIMER_A_CCTLN_CCIE;
+
+  DMA_assignChannel(CaptureMeter_dmaMappings[meter->dmaChannel]);
+  DMA_disableChannelAttribute(meter->dmaChannel, UDMA_ATTR_ALL);
+  CaptureMeter_arm(meter, UDMA_PRI_SELECT);
+  CaptureMeter_arm(meter, UDMA_ALT_SELECT);
+  DMA_clearInterruptFlag(meter->dmaChannel);
+  DMA_enableChannel(meter->dmaChannel);
+
+  Interrupt_setPriority(INT_TA0_N + 2 * instance, INTERRUPT_PRIORITY_TIMER);
+  Timer_A_registerInterrupt(timer, TIMER_A_CCRX_AND_OVERFLOW_INTERRUPT,
+                            CaptureMeter_handleInterrupt);
+
+  Timer_A_startCounter(timer, TIMER_A_CONTINUOUS_MODE);
+
+  // With both edges captured, they alternate from the input level as
+  // capturing starts
+  basePri          = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  meter->startHigh = (timerA->CCTL[meter->ccr] & TIMER_A_CCTLN_CCI) != 0;
+  timerA->CCTL[meter->ccr] |= config->captureMode;
+  Interrupt_exitCritical(basePri);
+}
+
+void CaptureMeter_stop(CaptureMeter_Meter *meter) {
+  Timer_A_Type *timerA = TIMER_A_CMSIS(meter->timer);
+
+  timerA->CCTL[meter->ccr] &= ~TIMER_A_CCTLN_CM_3;
+  timerA->CCTL[CAPTUREMETER_DATING] = 0;
+  Timer_A_stopTimer(meter->timer);
+  DMA_disableChannel(meter->dmaChannel);
+
+  CaptureMeter_meters[(meter->timer - TIMER_A0_BASE) >> 10] = NULL;
+}
+
+uint32_t CaptureMeter_getCount(const CaptureMeter_Meter *meter) {
+  return meter->dated;
+}
+
+// Capture number capture, extended to 32 bits
+static uint32_t CaptureMeter_time(const CaptureMeter_Meter *meter,
+                                  uint32_t                  capture) {
+  uint_fast16_t index = capture % CAPTUREMETER_LENGTH;
+
+  return ((uint32_t)meter->wraps[index] << 16) | meter->captures[index];
+}
+
+bool CaptureMeter_getStatistics(CaptureMeter_Meter      *meter,
+                                uint32_t                 periods,
+                                CaptureMeter_Statistics *statistics) {
+  uint32_t dated, step, first, last, capture, start, period, high, span;
+  uint32_t reference;
+  float    deviation, sum, squares, variance;
+
+  dated = meter->dated;
+  if (dated < 2)
+    return false;
+
+  // With both edges, periods run from rising edge to rising edge; which
+  // captures those are follows from the level the input started at
+  step = meter->bothEdges ? 2 : 1;
+  last = dated - 1;
+  if (meter->bothEdges && ((last + meter->startHigh) & 1))
+    last--;
+
+  // The DMA writes fewer than half a ring ahead of the dated captures, so
+  // the half behind them is safe from it for a while
+  if (periods > (CAPTUREMETER_HALF - 2) / step)
+    periods = (CAPTUREMETER_HALF - 2) / step;
+  if (periods > last / step)
+    periods = last / step;
+  if (periods == 0)
+    return false;
+
+  first = last - periods * step;
+  span  = CaptureMeter_time(meter, last) - CaptureMeter_time(meter, first);
+
+  // Deviations from the first period keep the squares small
+  reference = CaptureMeter_time(meter, first + step) -
+              CaptureMeter_time(meter, first);
+
+  statistics->minPeriod = UINT32_MAX;
+  statistics->maxPeriod = 0;
+  high                  = 0;
+  sum                   = 0;
+  squares               = 0;
+
+  for (capture = first; capture != last; capture += step) {
+    start  = CaptureMeter_time(meter, capture);
+    period = CaptureMeter_time(meter, capture + step) - start;
+
+    if (period < statistics->minPeriod)
+      statistics->minPeriod = period;
+    if (period > statistics->maxPeriod)
+      statistics->maxPeriod = period;
+    if (meter->bothEdges)
+      high += CaptureMeter_time(meter, capture + 1) - start;
+
+    deviation = (float)(int32_t)(period - reference);
+    sum += deviation;
+    squares += deviation * deviation;
+  }
+
+  // Captures overwritten while they were read
+  if (meter->dated - first > CAPTUREMETER_HALF)
+    return false;
+
+  variance = squares / periods - (sum / periods) * (sum / periods);
+  if (variance < 0)
+    variance = 0;
+
+  statistics->periods   = periods;
+  statistics->period    = (float)span / periods;
+  statistics->jitter    = sqrtf(variance);
+  statistics->frequency = meter->clockFrequency / statistics->period;
+  statistics->duty      = meter->bothEdges ? (float)high / span : 0.0f;
+
+  return true;
+}
+
+void CaptureMeter_handleInterrupt(void) {
+  CaptureMeter_Meter *meter;
+  Timer_A_Type       *timerA;
+  uint_fast8_t        instance;
+
+  for (instance = 0; instance < 4; instance++) {
+    meter = CaptureMeter_meters[instance];
+    if (meter == NULL)
+      continue;
+
+    timerA = TIMER_A_CMSIS(meter->timer);
+    if (!(timerA->CCTL[CAPTUREMETER_DATING] & TIMER_A_CCTLN_CCIFG))
+      continue;
+    timerA->CCTL[CAPTUREMETER_DATING] &= ~TIMER_A_CCTLN_CCIFG;
+
+    CaptureMeter_date(meter);
+  }
+}
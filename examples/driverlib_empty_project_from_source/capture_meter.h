@@ -0,0 +1,259 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef CAPTURE_METER_H_
+#define CAPTURE_METER_H_
+
+//*****************************************************************************
+//
+//! \addtogroup capture_meter_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/driverlib/timer_a.h>
+
+//*****************************************************************************
+//
+// Frequency, period and duty measurement on a Timer_A capture register.
+//
+// The Timer_A counts in continuous mode and captures the input on CCR0 or
+// CCR2, the two registers whose captures can trigger the DMA. The DMA copies
+// every capture into a ring buffer in ping-pong mode, so edges cost no CPU
+// time. CCR1 interrupts twice per counter period, as the count reaches 0
+// and 0x8000, to date the captures the DMA has written since: each gets the
+// number of counter wraps before it, which extends it to 32 bits. A capture
+// the DMA wrote between the wrap and the interrupt is told apart from one
+// from before the wrap by its value, below or above 0x8000, so dating is
+// exact as long as the interrupt runs within half a counter period. The same
+// interrupt rearms the half of the ring the DMA has finished.
+//
+// Statistics are computed on demand from the most recent captures.
+//
+// Requirements:
+//  - fewer than CAPTUREMETER_LENGTH / 2 edges per half counter period
+//  - the DMA enabled and its control table set by the application
+//  - CCR1 of the Timer_A left to the meter
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Captures held by a meter, a power of two. The statistics use at most half
+// of them.
+//
+//*****************************************************************************
+#ifndef CAPTUREMETER_LENGTH
+#define CAPTUREMETER_LENGTH 256
+#endif
+
+//*****************************************************************************
+//
+//! \typedef CaptureMeter_Config
+//! \brief Set up of a meter, see \link CaptureMeter_init \endlink.
+//
+//*****************************************************************************
+typedef struct _CaptureMeter_Config {
+  uint_fast16_t clockSource;
+  uint_fast16_t clockSourceDivider;
+  uint32_t      clockFrequency;
+  uint_fast16_t captureRegister;
+  uint_fast16_t captureMode;
+  uint_fast16_t captureInputSelect;
+} CaptureMeter_Config;
+
+//*****************************************************************************
+//
+//! \typedef CaptureMeter_Meter
+//! \brief A meter. Allocated by the caller, set up with
+//!        \link CaptureMeter_init \endlink; the members are private.
+//
+//*****************************************************************************
+typedef struct _CaptureMeter_Meter {
+  uint16_t          captures[CAPTUREMETER_LENGTH]; /* written by the DMA */
+  uint16_t          wraps[CAPTUREMETER_LENGTH];    /* upper 16 bits */
+  uint32_t          timer;
+  uint32_t          clockFrequency;
+  uint8_t           dmaChannel;
+  uint8_t           ccr;
+  bool              bothEdges;
+  bool              startHigh; /* input level before the first capture */
+  uint16_t          wrap;      /* upper 16 bits of the count */
+  uint16_t          position;  /* ring index of the next capture to date */
+  volatile uint32_t dated;     /* captures dated so far */
+} CaptureMeter_Meter;
+
+//*****************************************************************************
+//
+//! \typedef CaptureMeter_Statistics
+//! \brief What \link CaptureMeter_getStatistics \endlink measured. Periods
+//!        are in counts of the Timer_A.
+//
+//*****************************************************************************
+typedef struct _CaptureMeter_Statistics {
+  uint32_t periods;    /* periods measured */
+  float    period;     /* mean */
+  uint32_t minPeriod;
+  uint32_t maxPeriod;
+  float    jitter;     /* standard deviation of the period */
+  float    frequency;  /* Hz, from the mean period */
+  float    duty;       /* high fraction of the period, both edges only */
+} CaptureMeter_Statistics;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Starts measuring.
+//!
+//! \param timer is the instance of the Timer_A module. Valid parameters
+//! vary from part to part, but can include:
+//!         - \b TIMER_A0_BASE
+//!         - \b TIMER_A1_BASE
+//!         - \b TIMER_A2_BASE
+//!         - \b TIMER_A3_BASE
+//! \param meter is the meter, one per Timer_A.
+//! \param config is the set up:
+//!     - \e clockSource and \e clockSourceDivider select what the Timer_A
+//!       counts, as for \link Timer_A_configureContinuousMode \endlink
+//!     - \e clockFrequency is that count rate in Hz, for frequencies
+//!     - \e captureRegister is \b TIMER_A_CAPTURECOMPARE_REGISTER_0 or
+//!       \b TIMER_A_CAPTURECOMPARE_REGISTER_2
+//!     - \e captureMode is \b TIMER_A_CAPTUREMODE_RISING_EDGE,
+//!       \b TIMER_A_CAPTUREMODE_FALLING_EDGE or
+//!       \b TIMER_A_CAPTUREMODE_RISING_AND_FALLING_EDGE, the only one that
+//!       measures duty
+//!     - \e captureInputSelect is one of the
+//!       \b TIMER_A_CAPTURE_INPUTSELECT_ values
+//!
+//! The Timer_A is cleared and started in continuous mode, and DMA channel
+//! 2 * instance, or 2 * instance + 1 for CCR2, is assigned to its capture
+//! register. The TAx_N interrupt is set to \b INTERRUPT_PRIORITY_TIMER,
+//! registered with \link Timer_A_registerInterrupt \endlink and enabled.
+//! If other sources on TAx_N are in use, register a handler of your own
+//! for it afterwards, and have it call
+//! \link CaptureMeter_handleInterrupt \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CaptureMeter_init(uint32_t timer, CaptureMeter_Meter *meter,
+                              const CaptureMeter_Config *config);
+
+//*****************************************************************************
+//
+//! Stops measuring, leaving the Timer_A halted and the DMA channel disabled.
+//!
+//! \param meter is the meter.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CaptureMeter_stop(CaptureMeter_Meter *meter);
+
+//*****************************************************************************
+//
+//! Returns the number of edges captured and dated so far.
+//!
+//! \param meter is the meter.
+//!
+//! \return Edge count, behind by up to half a counter period.
+//
+//*****************************************************************************
+extern uint32_t CaptureMeter_getCount(const CaptureMeter_Meter *meter);
+
+//*****************************************************************************
+//
+//! Measures the most recent periods of the input.
+//!
+//! \param meter is the meter.
+//! \param periods is the number of periods wanted, from 1 up. Only one
+//!        edge per period is captured except with
+//!        \b TIMER_A_CAPTUREMODE_RISING_AND_FALLING_EDGE, which takes two.
+//! \param statistics receives the results.
+//!
+//! Periods start and end on a rising edge with both edges captured, on the
+//! captured edge otherwise. Fewer are measured while the meter has not
+//! dated enough edges yet, and never more than half the ring buffer holds.
+//!
+//! \return false if no period could be measured, or if the DMA was fast
+//!         enough to overwrite the captures while they were read; calling
+//!         again then usually succeeds.
+//
+//*****************************************************************************
+extern bool CaptureMeter_getStatistics(CaptureMeter_Meter      *meter,
+                                       uint32_t                 periods,
+                                       CaptureMeter_Statistics *statistics);
+
+//*****************************************************************************
+//
+//! Handles the TAx_N interrupt of every meter. Only for calling from a
+//! TAx_N handler shared with other sources, see
+//! \link CaptureMeter_init \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CaptureMeter_handleInterrupt(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* CAPTURE_METER_H_ */
@@ -33,6 +33,7 @@
 #include <stdint.h>
 
 /* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/cpu.h>
 #include <ti/devices/msp432p4xx/driverlib/cs.h>
 #include <ti/devices/msp432p4xx/driverlib/debug.h>
 #include <ti/devices/msp432p4xx/driverlib/interrupt.h>
@@ -43,10 +44,65 @@
 #include <ti/devices/msp432p4xx/driverlib/sysctl.h>
 #endif
 
+/* Fraction bits of the fixed point DCO calibration */
+#define CS_DCO_SCALE_SHIFT 12
+
+/* Slots of the clock frequency cache */
+#define CS_CACHE_MCLK   0
+#define CS_CACHE_HSMCLK 1
+#define CS_CACHE_SMCLK  2
+#define CS_CACHE_ACLK   3
+#define CS_CACHE_BCLK   4
+#define CS_CACHE_DCO    5
+#define CS_CACHE_SLOTS  6
+
 /* Statics */
 static uint32_t hfxtFreq;
 static uint32_t lfxtFreq;
 
+/* DCO calibration, loaded from the TLV on first use. For each resistor and
+ * DCORSEL range, scale is (1 / K + 768 - FCAL) in fixed point, which turns
+ * the datasheet formulas into integer ones:
+ *   f    = fCenter * scale / (scale - tune)
+ *   tune = (f - fCenter) * scale / f
+ * A scale of 0 means the device has no calibration for that range. */
+static bool     dcoCalLoaded;
+static uint32_t dcoScale[2][2]; /* [external resistor][DCORSEL 5] */
+
+/* Clock frequencies already computed. They stay valid while the CS
+ * registers they were computed from are unchanged, so a change through
+ * any path, not just this API, drops them. */
+static uint32_t clockCacheCTL0;
+static uint32_t clockCacheCTL1;
+static uint32_t clockCacheCLKEN;
+static uint32_t clockCacheValid;
+static uint32_t clockCache[CS_CACHE_SLOTS];
+
+/* Clock change notifiers, and the change in progress. Changes nest, only
+ * the outermost one is notified. */
+static CS_ClockNotifier *clockNotifiers;
+static uint_fast8_t      clockChangeDepth;
+static uint32_t          clockChangeContext; /* exception number, 0 thread */
+static bool              clockChangeNotified;
+static CS_ClockChange    clockChange;
+
+/* Crystals started in the background, by fault counter select - 1, and
+ * the counts of each that ended on a fault */
+#define CS_CRYSTALS 2
+static CS_CrystalStart crystalStart[CS_CRYSTALS];
+static bool            crystalPending[CS_CRYSTALS];
+static uint_fast8_t    crystalFaults[CS_CRYSTALS];
+static uint_fast8_t    crystalNMIStatus;
+static bool            crystalInReady; /* a ready callback is running */
+
+/* Flags of a crystal, at the same position in IFG, CLRIFG and IE */
+#define CS_CRYSTAL_FAULT(crystal)                                              \
+  ((crystal) == CS_HFXT_FAULT_COUNTER ? CS_IFG_HFXTIFG : CS_IFG_LFXTIFG)
+#define CS_CRYSTAL_COUNT(crystal)                                              \
+  ((crystal) == CS_HFXT_FAULT_COUNTER ? CS_IFG_FCNTHFIFG : CS_IFG_FCNTLFIFG)
+
+static uint32_t _CSComputeDCOFrequency(uint32_t ctl0);
+
 #ifdef DEBUG
 
 bool _CSIsClockDividerValid(uint8_t divider) {
@@ -105,7 +161,8 @@ static uint32_t _CSGetDividerValue(uint32_t wDivider) {
 }
 
 static uint32_t _CSComputeCLKFrequency(uint32_t wClockSource,
-                                       uint32_t wDivider) {
+                                       uint32_t wDivider, uint32_t ctl0,
+                                       uint32_t clken) {
   uint_fast8_t bDivider;
 
   bDivider = _CSGetDividerValue(wDivider);
@@ -116,7 +173,7 @@ static uint32_t _CSComputeCLKFrequency(uint32_t wClockSource,
       CS_clearInterruptFlag(CS_LFXT_FAULT);
 
       if (BITBAND_PERI(CS->IFG, CS_IFG_LFXTIFG_OFS)) {
-        if (BITBAND_PERI(CS->CLKEN, CS_CLKEN_REFOFSEL_OFS))
+        if (clken & CS_CLKEN_REFOFSEL)
           return (128000 / bDivider);
         else
           return (32768 / bDivider);
@@ -129,7 +186,7 @@ static uint32_t _CSComputeCLKFrequency(uint32_t wClockSource,
       CS_clearInterruptFlag(CS_HFXT_FAULT);
 
       if (BITBAND_PERI(CS->IFG, CS_IFG_HFXTIFG_OFS)) {
-        if (BITBAND_PERI(CS->CLKEN, CS_CLKEN_REFOFSEL_OFS))
+        if (clken & CS_CLKEN_REFOFSEL)
           return (128000 / bDivider);
         else
           return (32768 / bDivider);
@@ -140,13 +197,13 @@ static uint32_t _CSComputeCLKFrequency(uint32_t wClockSource,
   case CS_VLOCLK_SELECT:
     return CS_VLOCLK_FREQUENCY / bDivider;
   case CS_REFOCLK_SELECT: {
-    if (BITBAND_PERI(CS->CLKEN, CS_CLKEN_REFOFSEL_OFS))
+    if (clken & CS_CLKEN_REFOFSEL)
       return (128000 / bDivider);
     else
       return (32768 / bDivider);
   }
   case CS_DCOCLK_SELECT:
-    return (CS_getDCOFrequency() / bDivider);
+    return (_CSComputeDCOFrequency(ctl0) / bDivider);
   case CS_MODOSC_SELECT:
     return CS_MODCLK_FREQUENCY / bDivider;
   default:
@@ -155,13 +212,214 @@ static uint32_t _CSComputeCLKFrequency(uint32_t wClockSource,
   }
 }
 
+//******************************************************************************
+// Internal functions for the DCO calibration and the clock cache
+//******************************************************************************
+static uint32_t _CSComputeDCOScale(uint32_t constK, uint32_t fcal) {
+  uint32_t exponent = (constK >> 23) & 0xFF;
+  uint32_t mantissa = (constK & 0x7FFFFF) | 0x800000;
+  int32_t  shift;
+  uint64_t inverse;
+  int64_t  scale;
+
+  /* K is an IEEE single, K = mantissa * 2^(exponent - 150), so 1 / K in
+   * fixed point is 2^(150 - exponent + CS_DCO_SCALE_SHIFT) / mantissa */
+  shift = 150 + CS_DCO_SCALE_SHIFT - (int32_t)exponent;
+  if ((constK & 0x80000000) || exponent == 0 || exponent == 0xFF ||
+      shift < 0 || shift > 63) {
+    return 0;
+  }
+  inverse = ((1ULL << shift) + mantissa / 2) / mantissa;
+
+  scale = (int64_t)inverse +
+          ((int64_t)(768 - (int32_t)fcal) << CS_DCO_SCALE_SHIFT);
+  if (scale <= 0 || scale > 0xFFFFFFFF) {
+    return 0;
+  }
+  return (uint32_t)scale;
+}
+
+static uint32_t _CSGetDCOScale(bool externalResistor, bool rsel5) {
+  uint_fast8_t tlvLength;
+
+  if (!dcoCalLoaded) {
+#ifdef __MCU_HAS_SYSCTL_A__
+    SysCtl_A_CSCalTLV_Info *csInfo;
+
+    /* Parsing the TLV and getting the trim information */
+    SysCtl_A_getTLVInfo(TLV_TAG_CS, 0, &tlvLength, (uint32_t **)&csInfo);
+#else
+    SysCtl_CSCalTLV_Info *csInfo;
+
+    /* Parsing the TLV and getting the trim information */
+    SysCtl_getTLVInfo(TLV_TAG_CS, 0, &tlvLength, (uint32_t **)&csInfo);
+#endif
+
+    if (tlvLength != 0) {
+      dcoScale[0][0] = _CSComputeDCOScale(csInfo->rDCOIR_CONSTK_RSEL04,
+                                          csInfo->rDCOIR_FCAL_RSEL04);
+      dcoScale[0][1] = _CSComputeDCOScale(csInfo->rDCOIR_CONSTK_RSEL5,
+                                          csInfo->rDCOIR_FCAL_RSEL5);
+      dcoScale[1][0] = _CSComputeDCOScale(csInfo->rDCOER_CONSTK_RSEL04,
+                                          csInfo->rDCOER_FCAL_RSEL04);
+      dcoScale[1][1] = _CSComputeDCOScale(csInfo->rDCOER_CONSTK_RSEL5,
+                                          csInfo->rDCOER_FCAL_RSEL5);
+    }
+    dcoCalLoaded = true;
+  }
+
+  return dcoScale[externalResistor][rsel5];
+}
+
+/* Source and divider of a clock in a CTL1 value */
+static uint32_t _CSGetClockSource(uint_fast8_t slot, uint32_t ctl1,
+                                  uint32_t *wDivider) {
+  switch (slot) {
+  case CS_CACHE_MCLK:
+    *wDivider = ((ctl1 & CS_CTL1_DIVM_MASK) << CS_MCLK_DIV_BITPOS);
+    return (ctl1 & CS_CTL1_SELM_MASK) << CS_MCLK_SRC_BITPOS;
+  case CS_CACHE_HSMCLK:
+    *wDivider = ((ctl1 & CS_CTL1_DIVHS_MASK) << CS_HSMCLK_DIV_BITPOS);
+    return (ctl1 & CS_CTL1_SELS_MASK) >> CS_HSMCLK_SRC_BITPOS;
+  case CS_CACHE_SMCLK:
+    *wDivider = ((ctl1 & CS_CTL1_DIVS_MASK));
+    return (ctl1 & CS_CTL1_SELS_MASK) >> CS_HSMCLK_SRC_BITPOS;
+  case CS_CACHE_ACLK:
+    *wDivider = ((ctl1 & CS_CTL1_DIVA_MASK) << CS_ACLK_DIV_BITPOS);
+    return (ctl1 & CS_CTL1_SELA_MASK) >> CS_ACLK_SRC_BITPOS;
+  case CS_CACHE_BCLK:
+    *wDivider = CS_CLOCK_DIVIDER_1;
+    return (ctl1 & CS_CTL1_SELB) ? CS_REFOCLK_SELECT : CS_LFXTCLK_SELECT;
+  default:
+    *wDivider = CS_CLOCK_DIVIDER_1;
+    return CS_DCOCLK_SELECT;
+  }
+}
+
+/* Frequency of a clock for given CS register values, current or about to
+ * be written */
+static uint32_t _CSComputeClock(uint_fast8_t slot, uint32_t ctl0,
+                                uint32_t ctl1, uint32_t clken) {
+  uint32_t wSource, wDivider;
+
+  if (slot == CS_CACHE_DCO) {
+    return _CSComputeDCOFrequency(ctl0);
+  }
+
+  wSource = _CSGetClockSource(slot, ctl1, &wDivider);
+  return _CSComputeCLKFrequency(wSource, wDivider, ctl0, clken);
+}
+
+static uint32_t _CSGetClock(uint_fast8_t slot) {
+  uint32_t ctl0  = CS->CTL0;
+  uint32_t ctl1  = CS->CTL1;
+  uint32_t clken = CS->CLKEN;
+  uint32_t wSource, wDivider;
+  uint32_t freq;
+  bool     intDisabled;
+  bool     cached;
+
+  /* Clocks are read from interrupts of any priority, Timestamp_rescale
+   * among them, so the keys, the valid bits and the slot are only looked
+   * at and updated together. The computation itself is left unmasked. */
+  intDisabled = CPU_cpsid();
+  cached      = ctl0 == clockCacheCTL0 && ctl1 == clockCacheCTL1 &&
+           clken == clockCacheCLKEN && (clockCacheValid & (1 << slot));
+  freq        = clockCache[slot];
+  if (!intDisabled)
+    CPU_cpsie();
+
+  if (cached) {
+    return freq;
+  }
+
+  freq = _CSComputeClock(slot, ctl0, ctl1, clken);
+
+  /* The crystals fall back to REFO on a fault, which no register above
+   * shows, so they are computed every time */
+  wSource = _CSGetClockSource(slot, ctl1, &wDivider);
+
+  intDisabled = CPU_cpsid();
+  if (ctl0 != clockCacheCTL0 || ctl1 != clockCacheCTL1 ||
+      clken != clockCacheCLKEN) {
+    clockCacheValid = 0;
+    clockCacheCTL0  = ctl0;
+    clockCacheCTL1  = ctl1;
+    clockCacheCLKEN = clken;
+  }
+  if (wSource != CS_LFXTCLK_SELECT && wSource != CS_HFXTCLK_SELECT) {
+    clockCache[slot]  = freq;
+    clockCacheValid  |= 1 << slot;
+  }
+  if (!intDisabled)
+    CPU_cpsie();
+
+  return freq;
+}
+
+//******************************************************************************
+// Internal functions for the clock change notifications
+//******************************************************************************
+static void _CSComputeClocks(uint32_t ctl0, uint32_t ctl1, uint32_t clken,
+                             CS_ClockFrequencies *freq) {
+  freq->mclk   = _CSComputeClock(CS_CACHE_MCLK, ctl0, ctl1, clken);
+  freq->hsmclk = _CSComputeClock(CS_CACHE_HSMCLK, ctl0, ctl1, clken);
+  freq->smclk  = _CSComputeClock(CS_CACHE_SMCLK, ctl0, ctl1, clken);
+  freq->aclk   = _CSComputeClock(CS_CACHE_ACLK, ctl0, ctl1, clken);
+  freq->bclk   = _CSComputeClock(CS_CACHE_BCLK, ctl0, ctl1, clken);
+}
+
+static uint32_t _CSCompareClocks(const CS_ClockFrequencies *a,
+                                 const CS_ClockFrequencies *b) {
+  uint32_t clocks = 0;
+
+  if (a->mclk != b->mclk)
+    clocks |= CS_MCLK;
+  if (a->hsmclk != b->hsmclk)
+    clocks |= CS_HSMCLK;
+  if (a->smclk != b->smclk)
+    clocks |= CS_SMCLK;
+  if (a->aclk != b->aclk)
+    clocks |= CS_ACLK;
+  if (a->bclk != b->bclk)
+    clocks |= CS_BCLK;
+
+  return clocks;
+}
+
+static void _CSNotify(bool post) {
+  CS_ClockNotifier *notifier;
+
+  for (notifier = clockNotifiers; notifier; notifier = notifier->next) {
+    if (!(notifier->clocks & clockChange.clocks))
+      continue;
+    if (post && notifier->postChange)
+      notifier->postChange(&clockChange);
+    else if (!post && notifier->preChange)
+      notifier->preChange(&clockChange);
+  }
+}
+
+/* Starts the change of one API call, from the register values it is about
+ * to write */
+static void _CSBeginRegisterChange(uint32_t ctl0, uint32_t ctl1,
+                                   uint32_t clken) {
+  CS_ClockFrequencies expected = {0};
+
+  /* Only the outermost change passes the frequencies on */
+  if (clockChangeDepth == 0 && clockNotifiers) {
+    _CSComputeClocks(ctl0, ctl1, clken, &expected);
+  }
+  CS_beginClockChange(&expected);
+}
+
 //******************************************************************************
 // Internal function for getting DCO nominal frequency
 //******************************************************************************
-static uint32_t _CSGetDOCFrequency(void) {
+static uint32_t _CSGetDOCFrequency(uint32_t ctl0) {
   uint32_t dcoFreq;
 
-  switch (CS->CTL0 & CS_CTL0_DCORSEL_MASK) {
+  switch (ctl0 & CS_CTL0_DCORSEL_MASK) {
   case CS_CTL0_DCORSEL_0:
     dcoFreq = 1500000;
     break;
@@ -189,14 +447,84 @@ static uint32_t _CSGetDOCFrequency(void) {
 
 void CS_setExternalClockSourceFrequency(uint32_t lfxt_XT_CLK_frequency,
                                         uint32_t hfxt_XT_CLK_frequency) {
+  CS_ClockFrequencies expected;
+  uint32_t            oldHFXT = hfxtFreq;
+  uint32_t            oldLFXT = lfxtFreq;
+
+  /* The crystal frequencies are not in the registers, the new clocks are
+   * computed with them in place */
   hfxtFreq = hfxt_XT_CLK_frequency;
   lfxtFreq = lfxt_XT_CLK_frequency;
+  _CSComputeClocks(CS->CTL0, CS->CTL1, CS->CLKEN, &expected);
+  hfxtFreq = oldHFXT;
+  lfxtFreq = oldLFXT;
+
+  CS_beginClockChange(&expected);
+  hfxtFreq        = hfxt_XT_CLK_frequency;
+  lfxtFreq        = lfxt_XT_CLK_frequency;
+  clockCacheValid = 0;
+  CS_endClockChange();
+}
+
+/* CTL1 with the source and divider of one clock signal in place */
+static uint32_t _CSSetClockSignal(uint32_t ctl1, uint32_t selectedClockSignal,
+                                  uint32_t clockSource,
+                                  uint32_t clockSourceDivider) {
+  switch (selectedClockSignal) {
+  case CS_ACLK:
+    ctl1 = ((clockSourceDivider >> CS_ACLK_DIV_BITPOS) |
+            (clockSource << CS_ACLK_SRC_BITPOS)) |
+           (ctl1 & ~(CS_CTL1_SELA_MASK | CS_CTL1_DIVA_MASK));
+    break;
+  case CS_MCLK:
+    ctl1 = ((clockSourceDivider >> CS_MCLK_DIV_BITPOS) |
+            (clockSource << CS_MCLK_SRC_BITPOS)) |
+           (ctl1 & ~(CS_CTL1_SELM_MASK | CS_CTL1_DIVM_MASK));
+    break;
+  case CS_SMCLK:
+    ctl1 = ((clockSourceDivider >> CS_SMCLK_DIV_BITPOS) |
+            (clockSource << CS_HSMCLK_SRC_BITPOS)) |
+           (ctl1 & ~(CS_CTL1_DIVS_MASK | CS_CTL1_SELS_MASK));
+    break;
+  case CS_HSMCLK:
+    ctl1 = ((clockSourceDivider >> CS_HSMCLK_DIV_BITPOS) |
+            (clockSource << CS_HSMCLK_SRC_BITPOS)) |
+           (ctl1 & ~(CS_CTL1_DIVHS_MASK | CS_CTL1_SELS_MASK));
+    break;
+  case CS_BCLK:
+    if (clockSource == CS_REFOCLK_SELECT)
+      ctl1 |= CS_CTL1_SELB;
+    else
+      ctl1 &= ~CS_CTL1_SELB;
+    break;
+  }
+
+  return ctl1;
+}
+
+/* Writes the source and divider of one clock signal over CTL1 as it is
+ * now, not as it was when the change began: the notifiers, or an
+ * interrupt, may have changed another clock since */
+static void _CSWriteClockSignal(uint32_t selectedClockSignal,
+                                uint32_t clockSource,
+                                uint32_t clockSourceDivider) {
+  uint32_t mask;
+
+  mask     = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  CS->CTL1 = _CSSetClockSignal(CS->CTL1, selectedClockSignal, clockSource,
+                               clockSourceDivider);
+  Interrupt_exitCritical(mask);
 }
 
 void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
                         uint32_t clockSourceDivider) {
   ASSERT(_CSIsClockDividerValid(clockSourceDivider));
 
+  _CSBeginRegisterChange(CS->CTL0,
+                         _CSSetClockSignal(CS->CTL1, selectedClockSignal,
+                                           clockSource, clockSourceDivider),
+                         CS->CLKEN);
+
   /* Unlocking the CS Module */
   CS->KEY = CS_KEY;
 
@@ -215,9 +543,7 @@ void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
       ;
 
     /* Setting the divider and source */
-    CS->CTL1 = ((clockSourceDivider >> CS_ACLK_DIV_BITPOS) |
-                (clockSource << CS_ACLK_SRC_BITPOS)) |
-               (CS->CTL1 & ~(CS_CTL1_SELA_MASK | CS_CTL1_DIVA_MASK));
+    _CSWriteClockSignal(selectedClockSignal, clockSource, clockSourceDivider);
 
     /* Waiting for ACLK to be ready again */
     while (!BITBAND_PERI(CS->STAT, CS_STAT_ACLK_READY_OFS))
@@ -232,9 +558,7 @@ void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
     while (!BITBAND_PERI(CS->STAT, CS_STAT_MCLK_READY_OFS))
       ;
 
-    CS->CTL1 = ((clockSourceDivider >> CS_MCLK_DIV_BITPOS) |
-                (clockSource << CS_MCLK_SRC_BITPOS)) |
-               (CS->CTL1 & ~(CS_CTL1_SELM_MASK | CS_CTL1_DIVM_MASK));
+    _CSWriteClockSignal(selectedClockSignal, clockSource, clockSourceDivider);
 
     /* Waiting for MCLK to be ready */
     while (!BITBAND_PERI(CS->STAT, CS_STAT_MCLK_READY_OFS))
@@ -248,9 +572,7 @@ void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
     while (!BITBAND_PERI(CS->STAT, CS_STAT_SMCLK_READY_OFS))
       ;
 
-    CS->CTL1 = ((clockSourceDivider >> CS_SMCLK_DIV_BITPOS) |
-                (clockSource << CS_HSMCLK_SRC_BITPOS)) |
-               (CS->CTL1 & ~(CS_CTL1_DIVS_MASK | CS_CTL1_SELS_MASK));
+    _CSWriteClockSignal(selectedClockSignal, clockSource, clockSourceDivider);
 
     /* Waiting for SMCLK to be ready */
     while (!BITBAND_PERI(CS->STAT, CS_STAT_SMCLK_READY_OFS))
@@ -264,9 +586,7 @@ void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
     while (!BITBAND_PERI(CS->STAT, CS_STAT_HSMCLK_READY_OFS))
       ;
 
-    CS->CTL1 = ((clockSourceDivider >> CS_HSMCLK_DIV_BITPOS) |
-                (clockSource << CS_HSMCLK_SRC_BITPOS)) |
-               (CS->CTL1 & ~(CS_CTL1_DIVHS_MASK | CS_CTL1_SELS_MASK));
+    _CSWriteClockSignal(selectedClockSignal, clockSource, clockSourceDivider);
 
     /* Waiting for HSMCLK to be ready */
     while (!BITBAND_PERI(CS->STAT, CS_STAT_HSMCLK_READY_OFS))
@@ -305,6 +625,8 @@ void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
 
   /* Locking the module */
   BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+  CS_endClockChange();
 }
 
 bool CS_startHFXT(bool bypassMode) {
@@ -441,6 +763,205 @@ bool CS_startLFXTWithTimeout(uint32_t xtDrive, uint32_t timeout) {
   return true;
 }
 
+/* The CS interrupt goes to the NMI while the CS is an NMI source. It is
+ * taken off for as long as any crystal is being started */
+static void _CSHoldCrystalNMI(void) {
+  if (crystalPending[0] || crystalPending[1])
+    return;
+
+#ifdef __MCU_HAS_SYSCTL_A__
+  crystalNMIStatus = SysCtl_A_getNMISourceStatus() & SYSCTL_A_CS_SRC;
+  SysCtl_A_disableNMISource(SYSCTL_A_CS_SRC);
+#else
+  crystalNMIStatus = SysCtl_getNMISourceStatus() & SYSCTL_CS_SRC;
+  SysCtl_disableNMISource(SYSCTL_CS_SRC);
+#endif
+}
+
+static void _CSReleaseCrystalNMI(void) {
+  if (crystalPending[0] || crystalPending[1])
+    return;
+
+#ifdef __MCU_HAS_SYSCTL_A__
+  SysCtl_A_enableNMISource(crystalNMIStatus);
+#else
+  SysCtl_enableNMISource(crystalNMIStatus);
+#endif
+}
+
+static void _CSEndCrystalStart(uint_fast8_t crystal, bool stable) {
+  uint_fast8_t index = crystal - CS_HFXT_FAULT_COUNTER;
+  uint32_t     xtDrive;
+  uint32_t     mask;
+
+  mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  if (!crystalPending[index]) {
+    Interrupt_exitCritical(mask);
+    return;
+  }
+  xtDrive = crystalStart[index].xtDrive;
+
+  /* Unlocking the module */
+  CS->KEY = CS_KEY;
+
+  CS->IE &= ~CS_CRYSTAL_COUNT(crystal);
+  if (crystal == CS_HFXT_FAULT_COUNTER) {
+    BITBAND_PERI(CS->CTL3, CS_CTL3_FCNTHF_EN_OFS) = 0;
+    if (!stable)
+      BITBAND_PERI(CS->CTL2, CS_CTL2_HFXT_EN_OFS) = 0;
+    else if (!(xtDrive & CS_HFXT_BYPASS))
+      BITBAND_PERI(CS->CTL2, CS_CTL2_HFXTDRIVE_OFS) =
+          ((CS->CTL2 & CS_CTL2_HFXTFREQ_MASK) != CS_CTL2_HFXTFREQ_0);
+  } else {
+    BITBAND_PERI(CS->CTL3, CS_CTL3_FCNTLF_EN_OFS) = 0;
+    if (!stable)
+      BITBAND_PERI(CS->CTL2, CS_CTL2_LFXT_EN_OFS) = 0;
+    else if (xtDrive != CS_LFXT_BYPASS)
+      CS->CTL2 = ((CS->CTL2 & ~CS_LFXT_DRIVE3) | xtDrive);
+  }
+  CS->CLRIFG = CS_CRYSTAL_COUNT(crystal);
+
+  /* Locking the module */
+  BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+  crystalPending[index] = false;
+  _CSReleaseCrystalNMI();
+  Interrupt_exitCritical(mask);
+
+  if (crystalStart[index].ready) {
+    crystalInReady = true;
+    crystalStart[index].ready(stable);
+    crystalInReady = false;
+  }
+}
+
+bool CS_startCrystal(const CS_CrystalStart *start) {
+  uint_fast8_t crystal = start->crystal;
+  uint_fast8_t index   = crystal - CS_HFXT_FAULT_COUNTER;
+  uint32_t     xtDrive = start->xtDrive;
+  uint32_t     mask;
+
+  ASSERT(crystal == CS_HFXT_FAULT_COUNTER ||
+         crystal == CS_LFXT_FAULT_COUNTER);
+  ASSERT(start->countValue == CS_FAULT_COUNTER_4096_CYCLES ||
+         start->countValue == CS_FAULT_COUNTER_8192_CYCLES ||
+         start->countValue == CS_FAULT_COUNTER_16384_CYCLES ||
+         start->countValue == CS_FAULT_COUNTER_32768_CYCLES);
+  ASSERT(crystal == CS_HFXT_FAULT_COUNTER ||
+         ((xtDrive == CS_LFXT_DRIVE0) || (xtDrive == CS_LFXT_DRIVE1) ||
+          (xtDrive == CS_LFXT_DRIVE2) || (xtDrive == CS_LFXT_DRIVE3) ||
+          (xtDrive == CS_LFXT_BYPASS)));
+  ASSERT(crystal == CS_LFXT_FAULT_COUNTER ||
+         ((xtDrive == 0) || (xtDrive == CS_HFXT_BYPASS)));
+  ASSERT(crystal == CS_HFXT_FAULT_COUNTER || lfxtFreq != 0);
+
+  mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  if (crystalPending[index]) {
+    Interrupt_exitCritical(mask);
+    return false;
+  }
+  _CSHoldCrystalNMI();
+  crystalPending[index] = true;
+  crystalStart[index]   = *start;
+  crystalFaults[index]  = 0;
+
+  /* Unlocking the module */
+  CS->KEY = CS_KEY;
+
+  /* At maximum drive until stable, the fault counter from the first
+   * oscillation */
+  if (crystal == CS_HFXT_FAULT_COUNTER) {
+    CS->CTL2 = (CS->CTL2 & ~(CS_CTL2_HFXTFREQ_MASK | CS_CTL2_HFXTBYPASS)) |
+               _CSGetHFXTFrequency() | CS_CTL2_HFXTDRIVE |
+               (xtDrive & CS_HFXT_BYPASS);
+    CS->CTL3 = (CS->CTL3 & ~CS_CTL3_FCNTHF_MASK) | (start->countValue << 4) |
+               CS_CTL3_FCNTHF_EN | CS_CTL3_RFCNTHF;
+  } else {
+    if (xtDrive == CS_LFXT_BYPASS)
+      CS->CTL2 |= CS_CTL2_LFXTBYPASS;
+    else
+      CS->CTL2 = (CS->CTL2 & ~CS_CTL2_LFXTBYPASS) | CS_LFXT_DRIVE3;
+    CS->CTL3 = (CS->CTL3 & ~CS_CTL3_FCNTLF_MASK) | start->countValue |
+               CS_CTL3_FCNTLF_EN | CS_CTL3_RFCNTLF;
+  }
+  CS->CLRIFG  = CS_CRYSTAL_COUNT(crystal) | CS_CRYSTAL_FAULT(crystal);
+  CS->IE     |= CS_CRYSTAL_COUNT(crystal);
+  if (crystal == CS_HFXT_FAULT_COUNTER)
+    BITBAND_PERI(CS->CTL2, CS_CTL2_HFXT_EN_OFS) = 1;
+  else
+    BITBAND_PERI(CS->CTL2, CS_CTL2_LFXT_EN_OFS) = 1;
+
+  /* Locking the module */
+  BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+  Interrupt_exitCritical(mask);
+
+  /* Below the driver critical sections, which would not hold off the CS
+   * interrupt at its reset priority of 0 */
+  Interrupt_setPriority(INT_CS, INTERRUPT_PRIORITY_SYSTEM);
+  Interrupt_enableInterrupt(INT_CS);
+
+  return true;
+}
+
+void CS_cancelCrystalStart(uint_fast8_t crystal) {
+  ASSERT(crystal == CS_HFXT_FAULT_COUNTER ||
+         crystal == CS_LFXT_FAULT_COUNTER);
+
+  _CSEndCrystalStart(crystal, false);
+}
+
+bool CS_isCrystalStarting(uint_fast8_t crystal) {
+  ASSERT(crystal == CS_HFXT_FAULT_COUNTER ||
+         crystal == CS_LFXT_FAULT_COUNTER);
+
+  return crystalPending[crystal - CS_HFXT_FAULT_COUNTER];
+}
+
+void CS_handleCrystalInterrupt(void) {
+  uint_fast8_t crystal;
+  uint_fast8_t index;
+  uint_fast8_t limit;
+  uint32_t     mask;
+  bool         stable;
+
+  for (crystal = CS_HFXT_FAULT_COUNTER; crystal <= CS_LFXT_FAULT_COUNTER;
+       crystal++) {
+    index = crystal - CS_HFXT_FAULT_COUNTER;
+
+    mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+    if (!crystalPending[index] || !(CS->IFG & CS_CRYSTAL_COUNT(crystal))) {
+      Interrupt_exitCritical(mask);
+      continue;
+    }
+
+    /* Unlocking the module */
+    CS->KEY = CS_KEY;
+
+    /* A fault that is still there is flagged again as soon as cleared */
+    CS->CLRIFG = CS_CRYSTAL_COUNT(crystal) | CS_CRYSTAL_FAULT(crystal);
+    stable     = !(CS->IFG & CS_CRYSTAL_FAULT(crystal));
+    if (!stable) {
+      if (crystal == CS_HFXT_FAULT_COUNTER)
+        BITBAND_PERI(CS->CTL3, CS_CTL3_RFCNTHF_OFS) = 1;
+      else
+        BITBAND_PERI(CS->CTL3, CS_CTL3_RFCNTLF_OFS) = 1;
+    }
+
+    /* Locking the module */
+    BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+    limit = crystalStart[index].faultLimit;
+    if (!stable && (limit == 0 || ++crystalFaults[index] < limit)) {
+      Interrupt_exitCritical(mask);
+      continue;
+    }
+    Interrupt_exitCritical(mask);
+
+    _CSEndCrystalStart(crystal, stable);
+  }
+}
+
 void CS_enableClockRequest(uint32_t selectClock) {
   ASSERT(selectClock == CS_ACLK || selectClock == CS_HSMCLK ||
          selectClock == CS_SMCLK || selectClock == CS_MCLK);
@@ -471,6 +992,11 @@ void CS_setReferenceOscillatorFrequency(uint8_t referenceFrequency) {
   ASSERT(referenceFrequency == CS_REFO_32KHZ ||
          referenceFrequency == CS_REFO_128KHZ);
 
+  _CSBeginRegisterChange(CS->CTL0, CS->CTL1,
+                         referenceFrequency
+                             ? (CS->CLKEN | CS_CLKEN_REFOFSEL)
+                             : (CS->CLKEN & ~CS_CLKEN_REFOFSEL));
+
   /* Unlocking the module */
   CS->KEY = CS_KEY;
 
@@ -478,9 +1004,13 @@ void CS_setReferenceOscillatorFrequency(uint8_t referenceFrequency) {
 
   /* Locking the module */
   BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+  CS_endClockChange();
 }
 
 void CS_enableDCOExternalResistor(void) {
+  _CSBeginRegisterChange(CS->CTL0 | CS_CTL0_DCORES, CS->CTL1, CS->CLKEN);
+
   /* Unlocking the module */
   CS->KEY = CS_KEY;
 
@@ -488,6 +1018,8 @@ void CS_enableDCOExternalResistor(void) {
 
   /* Locking the module */
   BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+  CS_endClockChange();
 }
 
 void CS_setDCOExternalResistorCalibration(uint_fast8_t calData,
@@ -516,6 +1048,8 @@ void CS_setDCOExternalResistorCalibration(uint_fast8_t calData,
 }
 
 void CS_disableDCOExternalResistor(void) {
+  _CSBeginRegisterChange(CS->CTL0 & ~CS_CTL0_DCORES, CS->CTL1, CS->CLKEN);
+
   /* Unlocking the module */
   CS->KEY = CS_KEY;
 
@@ -523,6 +1057,8 @@ void CS_disableDCOExternalResistor(void) {
 
   /* Locking the module */
   BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
+
+  CS_endClockChange();
 }
 
 void CS_setDCOCenteredFrequency(uint32_t dcoFreq) {
@@ -530,6 +1066,9 @@ void CS_setDCOCenteredFrequency(uint32_t dcoFreq) {
          dcoFreq == CS_DCO_FREQUENCY_6 || dcoFreq == CS_DCO_FREQUENCY_12 ||
          dcoFreq == CS_DCO_FREQUENCY_24 || dcoFreq == CS_DCO_FREQUENCY_48);
 
+  _CSBeginRegisterChange((CS->CTL0 & ~CS_CTL0_DCORSEL_MASK) | dcoFreq,
+                         CS->CTL1, CS->CLKEN);
+
   /* Unlocking the CS Module */
   CS->KEY = CS_KEY;
 
@@ -538,222 +1077,212 @@ void CS_setDCOCenteredFrequency(uint32_t dcoFreq) {
 
   /* Locking the CS Module */
   BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
-}
-
-void CS_tuneDCOFrequency(int16_t tuneParameter) {
-  CS->KEY = CS_KEY;
 
-  uint16_t dcoTuneMask   = 0x1FFF;
-  uint16_t dcoTuneSigned = 0x1000;
+  CS_endClockChange();
+}
 
-  dcoTuneMask   = 0x3FF;
-  dcoTuneSigned = 0x200;
+/* CTL0 with a DCO tune in place */
+static uint32_t _CSTuneDCO(uint32_t ctl0, int16_t tuneParameter) {
+  uint16_t dcoTuneMask   = 0x3FF;
+  uint16_t dcoTuneSigned = 0x200;
 
   if (tuneParameter < 0) {
-    CS->CTL0 = ((CS->CTL0 & ~dcoTuneMask) | (tuneParameter & dcoTuneMask) |
-                dcoTuneSigned);
+    return ((ctl0 & ~dcoTuneMask) | (tuneParameter & dcoTuneMask) |
+            dcoTuneSigned);
   } else {
-    CS->CTL0 = ((CS->CTL0 & ~dcoTuneMask) | (tuneParameter & dcoTuneMask));
+    return ((ctl0 & ~dcoTuneMask) | (tuneParameter & dcoTuneMask));
   }
-
-  BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
 }
 
-uint32_t CS_getDCOFrequency(void) {
-  float        dcoConst;
-  int32_t      calVal;
-  uint32_t     centeredFreq;
-  int16_t      dcoTune;
-  uint_fast8_t tlvLength;
-  uint32_t     retVal;
+void CS_tuneDCOFrequency(int16_t tuneParameter) {
+  _CSBeginRegisterChange(_CSTuneDCO(CS->CTL0, tuneParameter), CS->CTL1,
+                         CS->CLKEN);
 
-#ifdef __MCU_HAS_SYSCTL_A__
-  SysCtl_A_CSCalTLV_Info *csInfo;
+  CS->KEY = CS_KEY;
 
-  /* Parsing the TLV and getting the trim information */
-  SysCtl_A_getTLVInfo(TLV_TAG_CS, 0, &tlvLength, (uint32_t **)&csInfo);
-#else
-  SysCtl_CSCalTLV_Info *csInfo;
+  CS->CTL0 = _CSTuneDCO(CS->CTL0, tuneParameter);
 
-  /* Parsing the TLV and getting the trim information */
-  SysCtl_getTLVInfo(TLV_TAG_CS, 0, &tlvLength, (uint32_t **)&csInfo);
-#endif
+  BITBAND_PERI(CS->KEY, CS_KEY_KEY_OFS) = 1;
 
-  centeredFreq = _CSGetDOCFrequency();
+  CS_endClockChange();
+}
 
-  if (tlvLength == 0) {
-    return centeredFreq;
-  }
+static uint32_t _CSComputeDCOFrequency(uint32_t ctl0) {
+  uint32_t centeredFreq;
+  uint32_t scale;
+  int16_t  dcoTune;
+  int64_t  denominator;
 
-  dcoTune = CS->CTL0 & 0x3FF;
+  centeredFreq = _CSGetDOCFrequency(ctl0);
+
+  dcoTune = ctl0 & 0x3FF;
   if (dcoTune & 0x200) {
     dcoTune = dcoTune | 0xFE00;
   }
 
   if (dcoTune == 0)
-    return (uint32_t)centeredFreq;
-
-  /* DCORSEL = 5  */
-  if (centeredFreq == 48000000) {
-    /* External Resistor */
-    if (BITBAND_PERI(CS->CTL0, CS_CTL0_DCORES_OFS)) {
-      dcoConst = *((float *)&csInfo->rDCOER_CONSTK_RSEL5);
-      calVal   = csInfo->rDCOER_FCAL_RSEL5;
-    }
-    /* Internal Resistor */
-    else {
-      dcoConst = *((float *)&csInfo->rDCOIR_CONSTK_RSEL5);
-      calVal   = csInfo->rDCOIR_FCAL_RSEL5;
-    }
+    return centeredFreq;
+
+  /* DCORSEL = 5 or DCORSEL = 4, for the resistor in use */
+  scale = _CSGetDCOScale(ctl0 & CS_CTL0_DCORES, centeredFreq == 48000000);
+  if (scale == 0) {
+    return centeredFreq;
   }
-  /* DCORSEL = 4 */
-  else {
-    /* External Resistor */
-    if (BITBAND_PERI(CS->CTL0, CS_CTL0_DCORES_OFS)) {
-      dcoConst = *((float *)&csInfo->rDCOER_CONSTK_RSEL04);
-      calVal   = csInfo->rDCOER_FCAL_RSEL04;
-    }
-    /* Internal Resistor */
-    else {
-      dcoConst = *((float *)&csInfo->rDCOIR_CONSTK_RSEL04);
-      calVal   = csInfo->rDCOIR_FCAL_RSEL04;
-    }
+
+  denominator = (int64_t)scale - ((int64_t)dcoTune << CS_DCO_SCALE_SHIFT);
+  if (denominator <= 0) {
+    return centeredFreq;
   }
-  retVal =
-      (uint32_t)((centeredFreq) / (1 - ((dcoConst * dcoTune) /
-                                        ((1 + dcoConst * (768 - calVal))))));
 
-  return retVal;
+  return (uint32_t)(((uint64_t)centeredFreq * scale) / (uint64_t)denominator);
 }
 
-void CS_setDCOFrequency(uint32_t dcoFrequency) {
-  int32_t nomFreq, calVal, dcoSigned;
-  int16_t dcoTune;
-  float   dcoConst;
-  bool    rsel5 = false;
-  dcoSigned     = (int32_t)dcoFrequency;
-  uint_fast8_t tlvLength;
-
-#ifdef __MCU_HAS_SYSCTL_A__
-  SysCtl_A_CSCalTLV_Info *csInfo;
-
-  /* Parsing the TLV and getting the trim information */
-  SysCtl_A_getTLVInfo(TLV_TAG_CS, 0, &tlvLength, (uint32_t **)&csInfo);
-#else
-  SysCtl_CSCalTLV_Info *csInfo;
+uint32_t CS_getDCOFrequency(void) {
+  return _CSGetClock(CS_CACHE_DCO);
+}
 
-  /* Parsing the TLV and getting the trim information */
-  SysCtl_getTLVInfo(TLV_TAG_CS, 0, &tlvLength, (uint32_t **)&csInfo);
-#endif
+void CS_setDCOFrequency(uint32_t dcoFrequency) {
+  int32_t  nomFreq, dcoSigned;
+  int16_t  dcoTune = 0;
+  uint32_t centered;
+  uint32_t scale;
+  bool     rsel5 = false;
+  dcoSigned      = (int32_t)dcoFrequency;
 
   if (dcoFrequency < 2000000) {
-    nomFreq = CS_15MHZ;
-    CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_1_5);
+    nomFreq  = CS_15MHZ;
+    centered = CS_DCO_FREQUENCY_1_5;
   } else if (dcoFrequency < 4000000) {
-    nomFreq = CS_3MHZ;
-    CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_3);
+    nomFreq  = CS_3MHZ;
+    centered = CS_DCO_FREQUENCY_3;
   } else if (dcoFrequency < 8000000) {
-    nomFreq = CS_6MHZ;
-    CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_6);
+    nomFreq  = CS_6MHZ;
+    centered = CS_DCO_FREQUENCY_6;
   } else if (dcoFrequency < 16000000) {
-    nomFreq = CS_12MHZ;
-    CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_12);
+    nomFreq  = CS_12MHZ;
+    centered = CS_DCO_FREQUENCY_12;
   } else if (dcoFrequency < 32000000) {
-    nomFreq = CS_24MHZ;
-    CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_24);
+    nomFreq  = CS_24MHZ;
+    centered = CS_DCO_FREQUENCY_24;
   } else if (dcoFrequency < 640000001) {
-    nomFreq = CS_48MHZ;
-    CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_48);
-    rsel5 = true;
+    nomFreq  = CS_48MHZ;
+    centered = CS_DCO_FREQUENCY_48;
+    rsel5    = true;
   } else {
     ASSERT(false);
     return;
   }
 
-  if (dcoFrequency == nomFreq || tlvLength == 0) {
-    CS_tuneDCOFrequency(0);
-    return;
-  }
+  /* DCORSEL = 5 or DCORSEL = 4, for the resistor in use */
+  scale = _CSGetDCOScale(BITBAND_PERI(CS->CTL0, CS_CTL0_DCORES_OFS), rsel5);
 
-  if (rsel5) {
-    /* External Resistor*/
-    if (BITBAND_PERI(CS->CTL0, CS_CTL0_DCORES_OFS)) {
-      dcoConst = *((float *)&csInfo->rDCOER_CONSTK_RSEL5);
-      calVal   = csInfo->rDCOER_FCAL_RSEL5;
-    }
-    /* Internal Resistor */
-    else {
-      dcoConst = *((float *)&csInfo->rDCOIR_CONSTK_RSEL5);
-      calVal   = csInfo->rDCOIR_FCAL_RSEL5;
-    }
+  if (dcoSigned != nomFreq && scale != 0) {
+    /* Truncated toward zero */
+    dcoTune = (int16_t)(((int64_t)(dcoSigned - nomFreq) * scale) /
+                        ((int64_t)dcoSigned << CS_DCO_SCALE_SHIFT));
   }
-  /* DCORSEL = 4 */
-  else {
-    /* External Resistor */
-    if (BITBAND_PERI(CS->CTL0, CS_CTL0_DCORES_OFS)) {
-      dcoConst = *((float *)&csInfo->rDCOER_CONSTK_RSEL04);
-      calVal   = csInfo->rDCOER_FCAL_RSEL04;
-    }
-    /* Internal Resistor */
-    else {
-      dcoConst = *((float *)&csInfo->rDCOIR_CONSTK_RSEL04);
-      calVal   = csInfo->rDCOIR_FCAL_RSEL04;
-    }
-  }
-
-  dcoTune = (int16_t)(((dcoSigned - nomFreq) *
-                       (1.0f + dcoConst * (768.0f - calVal))) /
-                      (dcoSigned * dcoConst));
 
+  /* One change for the range and the tune together */
+  _CSBeginRegisterChange(
+      _CSTuneDCO((CS->CTL0 & ~CS_CTL0_DCORSEL_MASK) | centered, dcoTune),
+      CS->CTL1, CS->CLKEN);
+  CS_setDCOCenteredFrequency(centered);
   CS_tuneDCOFrequency(dcoTune);
+  CS_endClockChange();
 }
 
-uint32_t CS_getBCLK(void) {
-  if (BITBAND_PERI(CS->CTL1, CS_CTL1_SELB_OFS))
-    return _CSComputeCLKFrequency(CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
-  else
-    return _CSComputeCLKFrequency(CS_LFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
-}
+uint32_t CS_getBCLK(void) { return _CSGetClock(CS_CACHE_BCLK); }
 
-uint32_t CS_getHSMCLK(void) {
-  uint32_t wSource, wDivider;
+uint32_t CS_getHSMCLK(void) { return _CSGetClock(CS_CACHE_HSMCLK); }
 
-  wSource  = (CS->CTL1 & CS_CTL1_SELS_MASK) >> CS_HSMCLK_SRC_BITPOS;
-  wDivider = ((CS->CTL1 & CS_CTL1_DIVHS_MASK) << CS_HSMCLK_DIV_BITPOS);
+uint32_t CS_getACLK(void) { return _CSGetClock(CS_CACHE_ACLK); }
 
-  return _CSComputeCLKFrequency(wSource, wDivider);
-}
+uint32_t CS_getSMCLK(void) { return _CSGetClock(CS_CACHE_SMCLK); }
 
-uint32_t CS_getACLK(void) {
-  uint32_t wSource, wDivider;
+uint32_t CS_getMCLK(void) { return _CSGetClock(CS_CACHE_MCLK); }
 
-  wSource  = (CS->CTL1 & CS_CTL1_SELA_MASK) >> CS_ACLK_SRC_BITPOS;
-  wDivider = ((CS->CTL1 & CS_CTL1_DIVA_MASK) << CS_ACLK_DIV_BITPOS);
+/* The list is walked by clock changes made from interrupts, it must never
+ * be seen half linked */
+void CS_registerClockNotifier(CS_ClockNotifier *notifier) {
+  uint32_t mask;
 
-  return _CSComputeCLKFrequency(wSource, wDivider);
+  mask           = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  notifier->next = clockNotifiers;
+  clockNotifiers = notifier;
+  Interrupt_exitCritical(mask);
 }
 
-uint32_t CS_getSMCLK(void) {
-  uint32_t wDivider, wSource;
+void CS_unregisterClockNotifier(CS_ClockNotifier *notifier) {
+  CS_ClockNotifier **link;
+  uint32_t           mask;
 
-  wSource  = (CS->CTL1 & CS_CTL1_SELS_MASK) >> CS_HSMCLK_SRC_BITPOS;
-  wDivider = ((CS->CTL1 & CS_CTL1_DIVS_MASK));
+  mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  for (link = &clockNotifiers; *link; link = &(*link)->next) {
+    if (*link == notifier) {
+      *link = notifier->next;
+      break;
+    }
+  }
+  Interrupt_exitCritical(mask);
+}
+
+void CS_beginClockChange(const CS_ClockFrequencies *expected) {
+  /* There is one change in progress, not one per context: a change begun
+   * from an interrupt taken in the middle of another is not a nest */
+  ASSERT(clockChangeDepth == 0 ||
+         (__get_IPSR() & 0x1FF) == clockChangeContext);
 
-  return _CSComputeCLKFrequency(wSource, wDivider);
+  /* A crystal's ready callback, from the CS interrupt or a cancel, leaves
+   * the clocks to the application */
+  ASSERT(!crystalInReady);
+
+  if (clockChangeDepth++ != 0) {
+    return;
+  }
+  clockChangeContext = __get_IPSR() & 0x1FF;
+
+  /* Nothing to compute without notifiers */
+  clockChangeNotified = (clockNotifiers != 0);
+  if (!clockChangeNotified) {
+    return;
+  }
+
+  clockChange.oldFrequency.mclk   = CS_getMCLK();
+  clockChange.oldFrequency.hsmclk = CS_getHSMCLK();
+  clockChange.oldFrequency.smclk  = CS_getSMCLK();
+  clockChange.oldFrequency.aclk   = CS_getACLK();
+  clockChange.oldFrequency.bclk   = CS_getBCLK();
+  clockChange.newFrequency        = *expected;
+  clockChange.clocks =
+      _CSCompareClocks(&clockChange.oldFrequency, &clockChange.newFrequency);
+
+  _CSNotify(false);
 }
 
-uint32_t CS_getMCLK(void) {
-  uint32_t wSource, wDivider;
+void CS_endClockChange(void) {
+  ASSERT(clockChangeDepth != 0 &&
+         (__get_IPSR() & 0x1FF) == clockChangeContext);
 
-  wSource  = (CS->CTL1 & CS_CTL1_SELM_MASK) << CS_MCLK_SRC_BITPOS;
-  wDivider = ((CS->CTL1 & CS_CTL1_DIVM_MASK) << CS_MCLK_DIV_BITPOS);
+  if (--clockChangeDepth != 0 || !clockChangeNotified) {
+    return;
+  }
 
-  return _CSComputeCLKFrequency(wSource, wDivider);
+  /* What the clocks came to, which a crystal fault can make differ from
+   * what was expected */
+  clockChange.newFrequency.mclk   = CS_getMCLK();
+  clockChange.newFrequency.hsmclk = CS_getHSMCLK();
+  clockChange.newFrequency.smclk  = CS_getSMCLK();
+  clockChange.newFrequency.aclk   = CS_getACLK();
+  clockChange.newFrequency.bclk   = CS_getBCLK();
+  clockChange.clocks |=
+      _CSCompareClocks(&clockChange.oldFrequency, &clockChange.newFrequency);
+
+  _CSNotify(true);
 }
 
 void CS_enableFaultCounter(uint_fast8_t counterSelect) {
   ASSERT(counterSelect == CS_HFXT_FAULT_COUNTER ||
-         counterSelect == CS_HFXT_FAULT_COUNTER);
+         counterSelect == CS_LFXT_FAULT_COUNTER);
 
   /* Unlocking the module */
   CS->KEY = CS_KEY;
@@ -770,7 +1299,7 @@ void CS_enableFaultCounter(uint_fast8_t counterSelect) {
 
 void CS_disableFaultCounter(uint_fast8_t counterSelect) {
   ASSERT(counterSelect == CS_HFXT_FAULT_COUNTER ||
-         counterSelect == CS_HFXT_FAULT_COUNTER);
+         counterSelect == CS_LFXT_FAULT_COUNTER);
 
   /* Unlocking the module */
   CS->KEY = CS_KEY;
@@ -787,7 +1316,7 @@ void CS_disableFaultCounter(uint_fast8_t counterSelect) {
 
 void CS_resetFaultCounter(uint_fast8_t counterSelect) {
   ASSERT(counterSelect == CS_HFXT_FAULT_COUNTER ||
-         counterSelect == CS_HFXT_FAULT_COUNTER);
+         counterSelect == CS_LFXT_FAULT_COUNTER);
 
   /* Unlocking the module */
   CS->KEY = CS_KEY;
@@ -804,7 +1333,7 @@ void CS_resetFaultCounter(uint_fast8_t counterSelect) {
 
 void CS_startFaultCounter(uint_fast8_t counterSelect, uint_fast8_t countValue) {
   ASSERT(counterSelect == CS_HFXT_FAULT_COUNTER ||
-         counterSelect == CS_HFXT_FAULT_COUNTER);
+         counterSelect == CS_LFXT_FAULT_COUNTER);
 
   ASSERT(countValue == CS_FAULT_COUNTER_4096_CYCLES ||
          countValue == CS_FAULT_COUNTER_8192_CYCLES ||
@@ -152,6 +152,84 @@ extern "C" {
 #define CS_OVER32MHZ  0x01
 #define CS_UNDER32MHZ 0x02
 
+//*****************************************************************************
+//
+// Clock change notifications.
+//
+// Drivers that derive baud rates, reloads or dividers from a clock register
+// a notifier for the clocks they use. Every function of this API that
+// changes a clock frequency calls the notifiers of the clocks that change:
+// preChange before the change, to quiesce, and postChange after it, to
+// recompute. Both are given the old and the new frequencies.
+//
+// A change of several steps is bracketed by CS_beginClockChange() and
+// CS_endClockChange(), so that the notifiers see it once. Changes nest,
+// only the outermost one is notified.
+//
+// The change in progress is a single state, not one per context. A change
+// must not begin in an interrupt taken while another is in progress, which
+// a DEBUG build ASSERTs.
+// The notifications come from the caller's context, so clocks are best
+// changed from thread context only. They cover this API only: the ROM
+// versions of these functions, and direct register writes, are not seen.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \typedef CS_ClockFrequencies
+//! \brief Frequencies of the clock signals, in Hz.
+//
+//*****************************************************************************
+typedef struct _CS_ClockFrequencies {
+  uint32_t mclk;
+  uint32_t hsmclk;
+  uint32_t smclk;
+  uint32_t aclk;
+  uint32_t bclk;
+} CS_ClockFrequencies;
+
+//*****************************************************************************
+//
+//! \typedef CS_ClockChange
+//! \brief A clock change, as passed to the notifiers.
+//
+//*****************************************************************************
+typedef struct _CS_ClockChange {
+  uint32_t            clocks; /* CS_MCLK, CS_SMCLK... of the clocks changing */
+  CS_ClockFrequencies oldFrequency;
+  CS_ClockFrequencies newFrequency;
+} CS_ClockChange;
+
+//*****************************************************************************
+//
+//! \typedef CS_ClockNotifier
+//! \brief Callbacks of a driver that depends on some clocks. Allocated by the
+//!        caller; either callback may be null.
+//
+//*****************************************************************************
+typedef struct _CS_ClockNotifier {
+  uint32_t clocks; /* CS_MCLK, CS_SMCLK... of the clocks it depends on */
+  void (*preChange)(const CS_ClockChange *change);
+  void (*postChange)(const CS_ClockChange *change);
+  struct _CS_ClockNotifier *next; /* private */
+} CS_ClockNotifier;
+
+//*****************************************************************************
+//
+//! \typedef CS_CrystalStart
+//! \brief A crystal started in the background, see
+//! \link CS_startCrystal \endlink.
+//
+//*****************************************************************************
+typedef struct _CS_CrystalStart {
+  uint_fast8_t crystal;    /* CS_HFXT_FAULT_COUNTER or CS_LFXT_FAULT_COUNTER */
+  uint32_t     xtDrive;    /* CS_LFXT_DRIVEx, or CS_x_BYPASS */
+  uint_fast8_t countValue; /* CS_FAULT_COUNTER_x_CYCLES */
+  uint_fast8_t faultLimit; /* faulty counts before giving up, 0 for none */
+  void (*ready)(bool stable); /* in interrupt context, no clock changes */
+} CS_CrystalStart;
+
 //******************************************************************************
 //
 //! This function sets the external clock sources LFXT and HFXT crystal
@@ -212,6 +290,9 @@ extern void CS_setExternalClockSourceFrequency(uint32_t lfxt_XT_CLK_frequency,
 //!           - \b CS_CLOCK_DIVIDER_64,
 //!           - \b CS_CLOCK_DIVIDER_128
 //!
+//! The clock change notifiers of the clocks whose frequency this changes
+//! are called before and after, as for the other clock changing functions.
+//!
 //! \return NONE
 //
 //******************************************************************************
@@ -396,6 +477,11 @@ extern uint32_t CS_getSMCLK(void);
 //! CS_setExternalClockSourceFrequency API was invoked before in case LFXT or
 //! HFXT is being used.
 //!
+//! The frequency of this and the other clock getters is computed once and
+//! answered from a cache until the CS registers change, except for clocks
+//! sourced from LFXT or HFXT, whose fault fallback is checked on every call.
+//! To follow changes rather than poll, register a clock change notifier.
+//!
 //! \return Current MCLK frequency in Hz
 //
 //******************************************************************************
@@ -461,10 +547,9 @@ extern void CS_setDCOCenteredFrequency(uint32_t dcoFreq);
 //!
 //! \param dcoFrequency Frequency in Hz that the user wants to set the DCO to.
 //!
-//! \note This function uses floating point math to calculate the DCO tuning
-//!         parameter. If efficiency is a concern, the user should use the
-//!         \link FPU_enableModule \endlink function (if available) to enable
-//!         the floating point co-processor.
+//! \note The DCO tuning parameter is computed in integer math, from
+//!         calibration constants read from the TLV once, so no floating
+//!         point support is needed.
 //!
 //! \return None
 //
@@ -539,10 +624,9 @@ extern void CS_setDCOExternalResistorCalibration(uint_fast8_t uiCalData,
 //! function will grab any constant/calibration data from the DDDS table
 //! without any user interaction needed.
 //!
-//! \note This function uses floating point math to calculate the DCO tuning
-//!         parameter. If efficiency is a concern, the user should use the
-//!         \link FPU_enableModule \endlink function (if available) to enable
-//!         the floating point co-processor.
+//! \note The DCO tuning parameter is computed in integer math, from
+//!         calibration constants read from the TLV once, so no floating
+//!         point support is needed.
 //!
 //! \return Current DCO frequency in Hz
 //
@@ -568,10 +652,9 @@ extern uint32_t CS_getDCOFrequency(void);
 //! \param dcoFrequency Frequency in Hz (1500000 - 64000000) that the user wants
 //!         to set the DCO to.
 //!
-//! \note This function uses floating point math to calculate the DCO tuning
-//!         parameter. If efficiency is a concern, the user should use the
-//!         \link FPU_enableModule \endlink function (if available) to enable
-//!         the floating point co-processor.
+//! \note The DCO tuning parameter is computed in integer math, from
+//!         calibration constants read from the TLV once, so no floating
+//!         point support is needed.
 //!
 //! \return None
 //
@@ -803,6 +886,153 @@ extern void CS_registerInterrupt(void (*intHandler)(void));
 //*****************************************************************************
 extern void CS_unregisterInterrupt(void);
 
+//*****************************************************************************
+//
+//! Adds a clock change notifier.
+//!
+//! \param notifier is the notifier, which must stay valid until removed.
+//!        Its \e clocks field is a logical OR of the clocks it depends on:
+//!        - \b CS_MCLK,
+//!        - \b CS_HSMCLK,
+//!        - \b CS_SMCLK,
+//!        - \b CS_ACLK,
+//!        - \b CS_BCLK
+//!
+//! Only changes that alter the frequency of one of those clocks call it.
+//! Do not add or remove notifiers from a notifier callback.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CS_registerClockNotifier(CS_ClockNotifier *notifier);
+
+//*****************************************************************************
+//
+//! Removes a clock change notifier.
+//!
+//! \param notifier is a notifier added with
+//!        \link CS_registerClockNotifier \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CS_unregisterClockNotifier(CS_ClockNotifier *notifier);
+
+//*****************************************************************************
+//
+//! Starts a clock change of several steps, calling the preChange notifiers
+//! of the clocks that are expected to change.
+//!
+//! \param expected is the frequencies of all the clocks once the change is
+//!        done.
+//!
+//! The clock functions called until the matching
+//! \link CS_endClockChange \endlink notify nothing themselves.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CS_beginClockChange(const CS_ClockFrequencies *expected);
+
+//*****************************************************************************
+//
+//! Ends a clock change started with \link CS_beginClockChange \endlink,
+//! calling the postChange notifiers with the frequencies the clocks came
+//! to.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CS_endClockChange(void);
+
+//*****************************************************************************
+//
+//! Starts a crystal without waiting for it to stabilize.
+//!
+//! \param start is the crystal to start, copied:
+//!     - \e crystal is \b CS_HFXT_FAULT_COUNTER or \b CS_LFXT_FAULT_COUNTER
+//!     - \e xtDrive is, for LFXT, the drive strength to run at once stable,
+//!       \b CS_LFXT_DRIVE0 to \b CS_LFXT_DRIVE3, or \b CS_LFXT_BYPASS; for
+//!       HFXT, 0 or \b CS_HFXT_BYPASS. The start itself is at the maximum
+//!       drive, as with \link CS_startLFXT \endlink and
+//!       \link CS_startHFXT \endlink.
+//!     - \e countValue is how many crystal cycles without a fault make it
+//!       stable, \b CS_FAULT_COUNTER_4096_CYCLES to
+//!       \b CS_FAULT_COUNTER_32768_CYCLES
+//!     - \e faultLimit is how many counts may end on a fault before it is
+//!       given up, 0 for no limit
+//!     - \e ready is called with true once it is stable, false if it was
+//!       given up or cancelled
+//!
+//! The clocks keep running from their current sources meanwhile. The fault
+//! counter of the crystal counts its cycles from the moment it starts
+//! oscillating, and raises its interrupt when \e countValue have gone by.
+//! If no fault was flagged in the meantime the crystal is stable: its
+//! drive is lowered and \e ready is called. Otherwise the counter starts
+//! over.
+//!
+//! \e ready runs in the CS interrupt, or in the caller of
+//! \link CS_cancelCrystalStart \endlink, and must not change clocks: there
+//! is a single clock change in progress, which thread context may be in
+//! the middle of, and a DEBUG build ASSERTs. It sets a flag for the
+//! application to switch the clocks over from thread context, with
+//! \link CS_initClockSignal \endlink.
+//!
+//! A crystal that never oscillates never completes a count. Bound the
+//! start with a deadline of the application's, on a clock that does not
+//! depend on the crystal, and \link CS_cancelCrystalStart \endlink.
+//!
+//! Until every crystal started is done, the CS is disabled as an NMI
+//! source, so that its interrupt goes to the NVIC, where it is enabled at
+//! \b INTERRUPT_PRIORITY_SYSTEM, below the driver critical sections.
+//! Call
+//! \link CS_handleCrystalInterrupt \endlink from CS_IRQHandler, \e ready
+//! runs from there. Call \link CS_setExternalClockSourceFrequency
+//! \endlink first, as for the blocking starts.
+//!
+//! \return false if that crystal is already being started; nothing was
+//!         done.
+//
+//*****************************************************************************
+extern bool CS_startCrystal(const CS_CrystalStart *start);
+
+//*****************************************************************************
+//
+//! Gives up a start of \link CS_startCrystal \endlink: disables the crystal
+//! and calls its \e ready callback with false.
+//!
+//! \param crystal is \b CS_HFXT_FAULT_COUNTER or \b CS_LFXT_FAULT_COUNTER.
+//!
+//! Does nothing if that crystal is not being started.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CS_cancelCrystalStart(uint_fast8_t crystal);
+
+//*****************************************************************************
+//
+//! Returns whether a crystal is being started by
+//! \link CS_startCrystal \endlink.
+//!
+//! \param crystal is \b CS_HFXT_FAULT_COUNTER or \b CS_LFXT_FAULT_COUNTER.
+//!
+//! \return true until its \e ready callback has been called.
+//
+//*****************************************************************************
+extern bool CS_isCrystalStarting(uint_fast8_t crystal);
+
+//*****************************************************************************
+//
+//! Handles the fault counter interrupts of the crystals started by
+//! \link CS_startCrystal \endlink. Call it from CS_IRQHandler; other CS
+//! interrupt flags are left for the caller.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void CS_handleCrystalInterrupt(void);
+
 //*****************************************************************************
 //
 // Mark the end of the C bindings section for C++ compilers.
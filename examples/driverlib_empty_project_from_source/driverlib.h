@@ -35,16 +35,21 @@
 /* Common Modules */
 #include <ti/devices/msp432p4xx/driverlib/adc14.h>
 #include <ti/devices/msp432p4xx/driverlib/aes256.h>
+#include <ti/devices/msp432p4xx/driverlib/capture_meter.h>
 #include <ti/devices/msp432p4xx/driverlib/comp_e.h>
 #include <ti/devices/msp432p4xx/driverlib/cpu.h>
 #include <ti/devices/msp432p4xx/driverlib/crc32.h>
 #include <ti/devices/msp432p4xx/driverlib/cs.h>
 #include <ti/devices/msp432p4xx/driverlib/dma.h>
+#include <ti/devices/msp432p4xx/driverlib/dvfs.h>
 #include <ti/devices/msp432p4xx/driverlib/eusci.h>
 #include <ti/devices/msp432p4xx/driverlib/fpu.h>
 #include <ti/devices/msp432p4xx/driverlib/gpio.h>
+#include <ti/devices/msp432p4xx/driverlib/gpio_fast.h>
 #include <ti/devices/msp432p4xx/driverlib/i2c.h>
+#include <ti/devices/msp432p4xx/driverlib/i2c_regmap.h>
 #include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt_profile.h>
 #include <ti/devices/msp432p4xx/driverlib/mpu.h>
 #include <ti/devices/msp432p4xx/driverlib/pcm.h>
 #include <ti/devices/msp432p4xx/driverlib/pmap.h>
@@ -54,12 +59,16 @@
 #include <ti/devices/msp432p4xx/driverlib/rom.h>
 #include <ti/devices/msp432p4xx/driverlib/rom_map.h>
 #include <ti/devices/msp432p4xx/driverlib/rtc_c.h>
+#include <ti/devices/msp432p4xx/driverlib/soft_timer.h>
 #include <ti/devices/msp432p4xx/driverlib/spi.h>
 #include <ti/devices/msp432p4xx/driverlib/systick.h>
 #include <ti/devices/msp432p4xx/driverlib/timer32.h>
 #include <ti/devices/msp432p4xx/driverlib/timer_a.h>
+#include <ti/devices/msp432p4xx/driverlib/timestamp.h>
 #include <ti/devices/msp432p4xx/driverlib/uart.h>
+#include <ti/devices/msp432p4xx/driverlib/warmboot.h>
 #include <ti/devices/msp432p4xx/driverlib/wdt_a.h>
+#include <ti/devices/msp432p4xx/driverlib/wdt_supervisor.h>
 
 /* Device specific modules */
 #if defined(__MCU_HAS_SYSCTL_A__)
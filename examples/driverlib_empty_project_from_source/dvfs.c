@@ -0,0 +1,209 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/cs.h>
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/dvfs.h>
+#include <ti/devices/msp432p4xx/driverlib/flash_a.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#include <ti/devices/msp432p4xx/driverlib/pcm.h>
+#include <ti/devices/msp432p4xx/driverlib/timestamp.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+typedef struct {
+  uint32_t mclk;
+  uint32_t smclk;
+  uint32_t dcoFrequency; // CS_DCO_FREQUENCY_x
+  uint32_t smclkDivider; // CS_CLOCK_DIVIDER_x
+  uint8_t  coreVoltage;  // PCM_VCOREx
+  uint8_t  waitStates;
+} DVFS_Level;
+
+// Lowest core voltage and flash wait states of the MSP432P4111 for each
+// MCLK, from its datasheet
+static const DVFS_Level DVFS_levels[DVFS_LEVEL_COUNT] = {
+    {3000000, 3000000, CS_DCO_FREQUENCY_3, CS_CLOCK_DIVIDER_1, PCM_VCORE0, 0},
+    {12000000, 12000000, CS_DCO_FREQUENCY_12, CS_CLOCK_DIVIDER_1, PCM_VCORE0,
+     0},
+    {24000000, 24000000, CS_DCO_FREQUENCY_24, CS_CLOCK_DIVIDER_1, PCM_VCORE0,
+     1},
+    {48000000, 24000000, CS_DCO_FREQUENCY_48, CS_CLOCK_DIVIDER_2, PCM_VCORE1,
+     3},
+};
+
+static DVFS_Config  DVFS_config;
+static uint_fast8_t DVFS_level;
+
+// Load of the window starting at DVFS_windowStart
+static uint64_t     DVFS_windowStart;
+static uint64_t     DVFS_idleMicroseconds;
+static uint_fast8_t DVFS_load;
+
+static void DVFS_setWaitStates(uint32_t waitStates) {
+  FlashCtl_A_setWaitState(FLASH_A_BANK0, waitStates);
+  FlashCtl_A_setWaitState(FLASH_A_BANK1, waitStates);
+}
+
+static bool DVFS_switch(const DVFS_Level *to) {
+  uint32_t waitStates = FlashCtl_A_getWaitState(FLASH_A_BANK0);
+  uint32_t mask;
+
+  // Up to the limits of whichever of the two clocks needs more, so that
+  // they hold before, during and after the switch
+  if (to->coreVoltage > PCM_getCoreVoltageLevel())
+    if (!PCM_setCoreVoltageLevel(to->coreVoltage))
+      return false;
+  if (to->waitStates > waitStates)
+    DVFS_setWaitStates(to->waitStates);
+
+  mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  // SMCLK divided down before the DCO speeds up under it
+  if (to->smclkDivider > (CS->CTL1 & CS_CTL1_DIVS_MASK))
+    CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, to->smclkDivider);
+  CS_setDCOCenteredFrequency(to->dcoFrequency);
+  CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_initClockSignal(CS_HSMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, to->smclkDivider);
+  Interrupt_exitCritical(mask);
+
+  Timestamp_rescale();
+
+  // Down to what the new clock needs. Failing to lower the core voltage
+  // only costs power.
+  if (to->waitStates < waitStates)
+    DVFS_setWaitStates(to->waitStates);
+  if (to->coreVoltage < PCM_getCoreVoltageLevel())
+    PCM_setCoreVoltageLevel(to->coreVoltage);
+
+  return true;
+}
+
+static bool DVFS_change(uint_fast8_t level) {
+  CS_ClockFrequencies expected;
+  bool                switched;
+
+  expected.mclk   = DVFS_levels[level].mclk;
+  expected.hsmclk = DVFS_levels[level].mclk;
+  expected.smclk  = DVFS_levels[level].smclk;
+  expected.aclk   = CS_getACLK();
+  expected.bclk   = CS_getBCLK();
+
+  // One change for the notifiers, however many clock calls it takes. If
+  // the switch fails they are told the clocks they already had.
+  CS_beginClockChange(&expected);
+  switched = DVFS_switch(&DVFS_levels[level]);
+  if (switched) {
+    DVFS_level = level;
+  }
+  CS_endClockChange();
+
+  return switched;
+}
+
+bool DVFS_init(const DVFS_Config *config, uint_fast8_t level) {
+  ASSERT(config->raiseLoad > config->lowerLoad && config->raiseLoad <= 100);
+  ASSERT(config->minimumLevel <= config->maximumLevel &&
+         config->maximumLevel < DVFS_LEVEL_COUNT);
+  ASSERT(level < DVFS_LEVEL_COUNT);
+
+  DVFS_config           = *config;
+  DVFS_windowStart      = Timestamp_getMicroseconds();
+  DVFS_idleMicroseconds = 0;
+  DVFS_load             = 0;
+
+  // The levels are the centered DCO frequencies
+  CS_tuneDCOFrequency(0);
+
+  // Whatever the clocks were, take the level over in full
+  DVFS_level = level;
+  return DVFS_change(level);
+}
+
+bool DVFS_setLevel(uint_fast8_t level) {
+  ASSERT(level < DVFS_LEVEL_COUNT);
+
+  if (level == DVFS_level)
+    return true;
+
+  return DVFS_change(level);
+}
+
+uint_fast8_t DVFS_getLevel(void) { return DVFS_level; }
+
+uint32_t DVFS_getLevelFrequency(uint_fast8_t level) {
+  ASSERT(level < DVFS_LEVEL_COUNT);
+
+  return DVFS_levels[level].mclk;
+}
+
+uint_fast8_t DVFS_getLoad(void) { return DVFS_load; }
+
+static void DVFS_govern(uint_fast8_t load) {
+  uint_fast8_t level = DVFS_level;
+  uint32_t     projected;
+
+  if (load > DVFS_config.raiseLoad && level < DVFS_config.maximumLevel) {
+    level++;
+  } else if (load < DVFS_config.lowerLoad &&
+             level > DVFS_config.minimumLevel) {
+    // Only if the same work fits the lower level without going straight
+    // back up
+    projected = (uint32_t)load * DVFS_levels[level].mclk /
+                DVFS_levels[level - 1].mclk;
+    if (projected <= DVFS_config.raiseLoad)
+      level--;
+  }
+
+  if (level != DVFS_level)
+    DVFS_change(level);
+}
+
+void DVFS_idle(void) {
+  uint64_t now     = Timestamp_getMicroseconds();
+  uint64_t elapsed = now - DVFS_windowStart;
+
+  if (elapsed >= DVFS_config.windowMicroseconds) {
+    if (DVFS_idleMicroseconds > elapsed)
+      DVFS_idleMicroseconds = elapsed;
+    DVFS_load = (uint_fast8_t)(((elapsed - DVFS_idleMicroseconds) * 100) /
+                               elapsed);
+
+    DVFS_windowStart      = now;
+    DVFS_idleMicroseconds = 0;
+    DVFS_govern(DVFS_load);
+
+    // The change itself counts as busy
+    now = Timestamp_getMicroseconds();
+  }
+
+  PCM_gotoLPM0();
+  DVFS_idleMicroseconds += Timestamp_getMicroseconds() - now;
+}
@@ -0,0 +1,212 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef DVFS_H_
+#define DVFS_H_
+
+//*****************************************************************************
+//
+//! \addtogroup dvfs_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Dynamic voltage and frequency scaling.
+//
+// The DCO runs MCLK, HSMCLK and SMCLK at one of a few performance levels,
+// each with the lowest core voltage and flash wait states that support it.
+// Changing level orders the steps so that neither limit is ever exceeded:
+// going up, the core voltage and wait states are raised before the clock,
+// going down they are lowered after it.
+//
+// The governor measures load in the idle loop. The application calls
+// \link DVFS_idle \endlink whenever it has nothing to do, which sleeps in
+// LPM0 and accounts the time slept. Once per window the busy fraction is
+// compared with two thresholds: above the upper one the governor goes up
+// a level, below the lower one it goes down a level, provided the same
+// work would not push the lower level over the upper threshold.
+//
+// Drivers that derive dividers from a clock register a clock change
+// notifier with the CS API (cs.h). A level change is one change to them,
+// whatever the steps it takes.
+//
+// Requirements:
+//  - the time base of timestamp.h started, it measures the windows
+//  - MCLK, HSMCLK and SMCLK left to this module
+//  - levels only changed from thread context, not from interrupts
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Performance levels, MCLK frequency. SMCLK is MCLK, but 24 MHz at the
+// 48 MHz level, its maximum.
+//
+//*****************************************************************************
+#define DVFS_LEVEL_3MHZ  0
+#define DVFS_LEVEL_12MHZ 1
+#define DVFS_LEVEL_24MHZ 2
+#define DVFS_LEVEL_48MHZ 3
+#define DVFS_LEVEL_COUNT 4
+
+//*****************************************************************************
+//
+//! \typedef DVFS_Config
+//! \brief Governor settings, see \link DVFS_init \endlink.
+//
+//*****************************************************************************
+typedef struct _DVFS_Config {
+  uint32_t     windowMicroseconds;
+  uint_fast8_t raiseLoad; /* percent busy */
+  uint_fast8_t lowerLoad; /* percent busy */
+  uint_fast8_t minimumLevel;
+  uint_fast8_t maximumLevel;
+} DVFS_Config;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Sets up the governor and switches to a first level.
+//!
+//! \param config is the governor set up:
+//!     - \e windowMicroseconds is how long load is measured before a
+//!       decision, a few milliseconds up
+//!     - \e raiseLoad, from 1 to 100, is the busy percentage over which the
+//!       level goes up
+//!     - \e lowerLoad, below \e raiseLoad, is the one under which it goes
+//!       down
+//!     - \e minimumLevel and \e maximumLevel bound the levels it picks
+//! \param level is the level to start at, one of the \b DVFS_LEVEL_ values.
+//!
+//! \return false if the core voltage could not be changed, the device then
+//!         stays at its current clocks.
+//
+//*****************************************************************************
+extern bool DVFS_init(const DVFS_Config *config, uint_fast8_t level);
+
+//*****************************************************************************
+//
+//! Switches to a level, whatever the load.
+//!
+//! \param level is one of the \b DVFS_LEVEL_ values.
+//!
+//! The clock change notifiers are called before and after the change, from
+//! the caller's context. The clock itself changes with interrupts up to
+//! \b INTERRUPT_CRITICAL_DRIVER masked; the core voltage change around it
+//! takes up to a few hundred microseconds with interrupts enabled.
+//!
+//! \return false if the core voltage could not be changed, the level is
+//!         then unchanged.
+//
+//*****************************************************************************
+extern bool DVFS_setLevel(uint_fast8_t level);
+
+//*****************************************************************************
+//
+//! Returns the current level.
+//!
+//! \return One of the \b DVFS_LEVEL_ values.
+//
+//*****************************************************************************
+extern uint_fast8_t DVFS_getLevel(void);
+
+//*****************************************************************************
+//
+//! Returns the MCLK frequency of a level.
+//!
+//! \param level is one of the \b DVFS_LEVEL_ values.
+//!
+//! \return Frequency in Hz.
+//
+//*****************************************************************************
+extern uint32_t DVFS_getLevelFrequency(uint_fast8_t level);
+
+//*****************************************************************************
+//
+//! Returns the busy percentage of the last complete window.
+//!
+//! \return 0 to 100.
+//
+//*****************************************************************************
+extern uint_fast8_t DVFS_getLoad(void);
+
+//*****************************************************************************
+//
+//! Idles in LPM0 until an interrupt, accounting the time as idle, after
+//! letting the governor change level if a window has ended.
+//!
+//! Call it from the idle loop in place of \link PCM_gotoLPM0 \endlink.
+//! To avoid sleeping through work an interrupt queued just before, call it
+//! with interrupts disabled after checking for work; it still wakes on the
+//! interrupt, which then runs once interrupts are enabled again.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void DVFS_idle(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* DVFS_H_ */
@@ -57,6 +57,70 @@ static const uint32_t __getBurstProgramRegs[16] = {
     (uint32_t)&FLCTL_A->PRGBRST_DATA3_0, (uint32_t)&FLCTL_A->PRGBRST_DATA3_1,
     (uint32_t)&FLCTL_A->PRGBRST_DATA3_2, (uint32_t)&FLCTL_A->PRGBRST_DATA3_3};
 
+/* Physical banks: bank 0 holds the lower half of main and of info memory,
+ * bank 1 the upper halves */
+#define FLASH_A_BANK0   0
+#define FLASH_A_BANK1   1
+#define FLASH_A_NO_BANK 0xFF
+
+/* Set in the saved state when the operation fell back to PRIMASK */
+#define FLASH_A_CRITICAL_PRIMASK 0x80000000
+
+static uint_fast8_t _FlashCtl_A_getBank(uint32_t addr) {
+  uint32_t flashSize = SysCtl_A_getFlashSize();
+
+  if (addr < flashSize)
+    return addr < flashSize / 2 ? FLASH_A_BANK0 : FLASH_A_BANK1;
+
+  if (addr >= __INFO_FLASH_A_TECH_START__ &&
+      addr < __INFO_FLASH_A_TECH_START__ + SysCtl_A_getInfoFlashSize())
+    return addr < __INFO_FLASH_A_TECH_MIDDLE__ ? FLASH_A_BANK0 : FLASH_A_BANK1;
+
+  return FLASH_A_NO_BANK;
+}
+
+/* One bit per physical bank the address is in, none outside flash */
+static uint_fast8_t _FlashCtl_A_getBankMask(uint32_t addr) {
+  uint_fast8_t bank = _FlashCtl_A_getBank(addr);
+
+  return bank == FLASH_A_NO_BANK ? 0 : 1 << bank;
+}
+
+/* Holds off the interrupts at or below INTERRUPT_CRITICAL_FLASH for an
+ * operation on the banks holding firstAddr and lastAddr. The more urgent ones
+ * keep running, unless one of them that is enabled has its vector or its
+ * handler in those banks: reading it mid-operation would fetch garbage, so
+ * everything is then held off with PRIMASK instead. Only the handler entry
+ * is checked, not the code it calls. */
+static uint32_t _FlashCtl_A_enterCritical(uint32_t firstAddr,
+                                          uint32_t lastAddr) {
+  uint_fast8_t banks = _FlashCtl_A_getBankMask(firstAddr) |
+                       _FlashCtl_A_getBankMask(lastAddr);
+  uint32_t     vector, handler;
+  uint32_t     ii;
+
+  for (ii = FAULT_SYSTICK; ii < (NUM_INTERRUPTS + 1); ii++) {
+    if (Interrupt_getPriority(ii) >= INTERRUPT_CRITICAL_FLASH ||
+        !Interrupt_isEnabled(ii))
+      continue;
+
+    vector  = SCB->VTOR + (ii * 4);
+    handler = *(uint32_t *)vector & ~1;
+    if ((_FlashCtl_A_getBankMask(vector) & banks) ||
+        (_FlashCtl_A_getBankMask(handler) & banks))
+      return FLASH_A_CRITICAL_PRIMASK | Interrupt_disableMaster();
+  }
+
+  return Interrupt_enterCritical(INTERRUPT_CRITICAL_FLASH);
+}
+
+static void _FlashCtl_A_exitCritical(uint32_t state) {
+  if (!(state & FLASH_A_CRITICAL_PRIMASK))
+    Interrupt_exitCritical(state);
+  else if (!(state & ~FLASH_A_CRITICAL_PRIMASK))
+    Interrupt_enableMaster();
+}
+
 static void __saveProtectionRegisters(__FlashCtl_ProtectionRegister *pReg) {
   pReg->B0_INFO_R0 = FLCTL_A->BANK0_INFO_WEPROT;
   pReg->B1_INFO_R0 = FLCTL_A->BANK1_INFO_WEPROT;
@@ -612,14 +676,15 @@ bool FlashCtl_A_verifyMemory(void *verifyAddr, uint32_t length,
 
   ASSERT(pattern == FLASH_A_0_PATTERN || pattern == FLASH_A_1_PATTERN);
 
-  /* Saving interrupt context and disabling interrupts for program
-   * operation
+  /* Casting and determining the memory that we need to use */
+  addr = (uint32_t)verifyAddr;
+
+  /* Saving the interrupt mask and holding off everything at or below the
+   * flash critical level for the operation, or everything if a more urgent
+   * interrupt has its vector or handler in the banks operated on.
    */
-  intStatus = CPU_primask();
-  Interrupt_disableMaster();
+  intStatus = _FlashCtl_A_enterCritical(addr, addr + length - 1);
 
-  /* Casting and determining the memory that we need to use */
-  addr       = (uint32_t)verifyAddr;
   memoryType = (addr >= SysCtl_A_getFlashSize()) ? FLASH_A_INFO_SPACE
                                                  : FLASH_A_MAIN_SPACE;
 
@@ -760,8 +825,7 @@ FlashVerifyCleanup:
     FlashCtl_A_setWaitState(endBank, b1WaitState);
   }
 
-  if (intStatus == 0)
-    Interrupt_enableMaster();
+  _FlashCtl_A_exitCritical(intStatus);
 
   return res;
 }
@@ -928,11 +992,11 @@ bool FlashCtl_A_eraseSector(uint32_t addr) {
   SysCtl_A_FlashTLV_Info *flInfo;
   bool                    res;
 
-  /* Saving interrupt context and disabling interrupts for program
-   * operation
+  /* Saving the interrupt mask and holding off everything at or below the
+   * flash critical level for the operation, or everything if a more urgent
+   * interrupt has its vector or handler in the banks operated on.
    */
-  intStatus = CPU_primask();
-  Interrupt_disableMaster();
+  intStatus = _FlashCtl_A_enterCritical(addr, addr);
 
   /* Assuming Failure */
   res = false;
@@ -1004,8 +1068,7 @@ SectorEraseCleanup:
 
   BITBAND_PERI(FLCTL_A->ERASE_CTLSTAT, FLCTL_A_ERASE_CTLSTAT_CLR_STAT_OFS) = 1;
 
-  if (intStatus == 0)
-    Interrupt_enableMaster();
+  _FlashCtl_A_exitCritical(intStatus);
 
   return res;
 }
@@ -1050,11 +1113,12 @@ bool FlashCtl_A_programMemory(void *src, void *dest, uint32_t length) {
   uint_fast8_t            mTries, tlvLength;
   SysCtl_A_FlashTLV_Info *flInfo;
 
-  /* Saving interrupt context and disabling interrupts for program
-   * operation
+  /* Saving the interrupt mask and holding off everything at or below the
+   * flash critical level for the operation, or everything if a more urgent
+   * interrupt has its vector or handler in the banks operated on.
    */
-  intStatus = CPU_primask();
-  Interrupt_disableMaster();
+  intStatus = _FlashCtl_A_enterCritical((uint32_t)dest,
+                                        (uint32_t)dest + length - 1);
 
   /* Parsing the TLV and getting the maximum erase pulses */
   SysCtl_A_getTLVInfo(TLV_TAG_FLASHCTL, 0, &tlvLength, (uint32_t **)&flInfo);
@@ -1137,8 +1201,7 @@ bool FlashCtl_A_programMemory(void *src, void *dest, uint32_t length) {
 
 FlashProgramCleanUp:
 
-  if (intStatus == 0)
-    Interrupt_enableMaster();
+  _FlashCtl_A_exitCritical(intStatus);
 
   FlashCtl_A_disableWordProgramming();
   return res;
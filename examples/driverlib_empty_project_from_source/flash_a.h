@@ -332,10 +332,14 @@ extern bool FlashCtl_A_isMemoryProtected(uint32_t addr);
 //!
 //!  \note This function is blocking and will not exit until operation has
 //!  either completed or failed due to an error. Furthermore, given the
-//!  complex verification requirements of the flash controller, master
-//!  interrupts are disabled throughout execution of this function. The original
-//!  interrupt context is saved at the start of execution and restored prior
-//!  to exit of the API.
+//!  complex verification requirements of the flash controller, interrupts
+//!  at or below \b INTERRUPT_CRITICAL_FLASH are held off throughout
+//!  execution of this function. More urgent interrupts keep running,
+//!  except that if an enabled one has its vector or handler in a bank being
+//!  operated on, all interrupts are held off instead. Code they call, and
+//!  data they read, must still not be in that bank. The original interrupt
+//!  mask is saved at the start of execution and restored prior to exit of
+//!  the API.
 //!
 //!  \note Due to the hardware limitations of the flash controller, this
 //!  function cannot verify a memory adress in the same flash bank that it
@@ -400,10 +404,14 @@ extern void FlashCtl_A_initiateMassErase(void);
 //!
 //!  \note This function is blocking and will not exit until operation has
 //!  either completed or failed due to an error. Furthermore, given the
-//!  complex verification requirements of the flash controller, master
-//!  interrupts are disabled throughout execution of this function. The original
-//!  interrupt context is saved at the start of execution and restored prior
-//!  to exit of the API.
+//!  complex verification requirements of the flash controller, interrupts
+//!  at or below \b INTERRUPT_CRITICAL_FLASH are held off throughout
+//!  execution of this function. More urgent interrupts keep running,
+//!  except that if an enabled one has its vector or handler in a bank being
+//!  operated on, all interrupts are held off instead. Code they call, and
+//!  data they read, must still not be in that bank. The original interrupt
+//!  mask is saved at the start of execution and restored prior to exit of
+//!  the API.
 //!
 //!  \note Due to the hardware limitations of the flash controller, this
 //!  function cannot erase a memory adress in the same flash bank that it
@@ -435,10 +443,14 @@ extern bool FlashCtl_A_eraseSector(uint32_t addr);
 //!
 //!  \note This function is blocking and will not exit until operation has
 //!  either completed or failed due to an error. Furthermore, given the
-//!  complex verification requirements of the flash controller, master
-//!  interrupts are disabled throughout execution of this function. The original
-//!  interrupt context is saved at the start of execution and restored prior
-//!  to exit of the API.
+//!  complex verification requirements of the flash controller, interrupts
+//!  at or below \b INTERRUPT_CRITICAL_FLASH are held off throughout
+//!  execution of this function. More urgent interrupts keep running,
+//!  except that if an enabled one has its vector or handler in a bank being
+//!  operated on, all interrupts are held off instead. Code they call, and
+//!  data they read, must still not be in that bank. The original interrupt
+//!  mask is saved at the start of execution and restored prior to exit of
+//!  the API.
 //!
 //!  \note Due to the hardware limitations of the flash controller, this
 //!  function cannot program a memory adress in the same flash bank that it
@@ -0,0 +1,172 @@
+#ifndef GPIO_FAST_H_
+#define GPIO_FAST_H_
+
+//*****************************************************************************
+//
+//! \addtogroup gpio_fast_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/driverlib/gpio.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+//*****************************************************************************
+//
+// Compile-time resolved GPIO access.
+//
+// The GPIO_* functions in gpio.c look the port base up in a table and do a
+// 16-bit read-modify-write for every call. The macros below take a pin
+// handle built from constants, so the compiler folds the register address at
+// build time (at any optimization level) and emits:
+//
+//  - one store through the bit-band alias for GPIO_FAST_SET_HIGH/LOW/WRITE
+//  - one load through the bit-band alias for GPIO_FAST_READ
+//  - one byte store per register for GPIO_FAST_PORT_WRITE and one halfword
+//    store for GPIO_FAST_PAIR_WRITE, configuring up to 8 or 16 pins at once
+//
+// Bit-band stores are atomic with respect to interrupts, so the pin macros
+// need no critical section. GPIO_FAST_TOGGLE is a byte read-modify-write
+// since the port has no toggle register.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Register offsets inside a port pair (PA = P1/P2, ..., PJ)
+//
+//*****************************************************************************
+#define GPIO_FAST_OFS_IN   0x00
+#define GPIO_FAST_OFS_OUT  0x02
+#define GPIO_FAST_OFS_DIR  0x04
+#define GPIO_FAST_OFS_REN  0x06
+#define GPIO_FAST_OFS_DS   0x08
+#define GPIO_FAST_OFS_SEL0 0x0A
+#define GPIO_FAST_OFS_SEL1 0x0C
+#define GPIO_FAST_OFS_SELC 0x16
+#define GPIO_FAST_OFS_IES  0x18
+#define GPIO_FAST_OFS_IE   0x1A
+#define GPIO_FAST_OFS_IFG  0x1C
+
+#define GPIO_FAST_DIO_BASE     0x40004C00
+#define GPIO_FAST_PJ_BASE      0x40004D20
+#define GPIO_FAST_PERIPH_BASE  0x40000000
+#define GPIO_FAST_BITBAND_BASE 0x42000000
+
+//*****************************************************************************
+//
+//! Builds a pin handle from a \b GPIO_PORT_Px constant and a bit number 0-7
+//
+//*****************************************************************************
+#define GPIO_FAST_PIN(port, bit) (((port) << 4) | (bit))
+
+#define GPIO_FAST_PORT_OF(pin) ((pin) >> 4)
+#define GPIO_FAST_BIT_OF(pin)  ((pin) & 0x07)
+#define GPIO_FAST_MASK_OF(pin) (1 << GPIO_FAST_BIT_OF(pin))
+
+//*****************************************************************************
+//
+//! Byte address of an 8-bit port register, \e port is a \b GPIO_PORT_Px
+//! constant and \e ofs a \b GPIO_FAST_OFS_x offset
+//
+//*****************************************************************************
+#define GPIO_FAST_PORT_ADDR(port, ofs)                                         \
+  (((port) == GPIO_PORT_PJ)                                                    \
+       ? (GPIO_FAST_PJ_BASE + (ofs))                                           \
+       : (GPIO_FAST_DIO_BASE + ((((port) - 1) >> 1) * 0x20) +                  \
+          (((port) - 1) & 1) + (ofs)))
+
+#define GPIO_FAST_BITBAND_ADDR(pin, ofs)                                       \
+  (GPIO_FAST_BITBAND_BASE +                                                    \
+   ((GPIO_FAST_PORT_ADDR(GPIO_FAST_PORT_OF(pin), ofs) -                        \
+     GPIO_FAST_PERIPH_BASE)                                                    \
+    << 5) +                                                                    \
+   (GPIO_FAST_BIT_OF(pin) << 2))
+
+#define GPIO_FAST_BIT(pin, ofs)                                                \
+  (*((volatile uint32_t *)GPIO_FAST_BITBAND_ADDR(pin, ofs)))
+#define GPIO_FAST_REG8(port, ofs)                                              \
+  (*((volatile uint8_t *)GPIO_FAST_PORT_ADDR(port, ofs)))
+#define GPIO_FAST_REG16(pair, ofs)                                             \
+  (*((volatile uint16_t *)GPIO_FAST_PORT_ADDR(pair, ofs)))
+
+//*****************************************************************************
+//
+// Single pin access, one instruction per register touched
+//
+//*****************************************************************************
+#define GPIO_FAST_SET_HIGH(pin)     (GPIO_FAST_BIT(pin, GPIO_FAST_OFS_OUT) = 1)
+#define GPIO_FAST_SET_LOW(pin)      (GPIO_FAST_BIT(pin, GPIO_FAST_OFS_OUT) = 0)
+#define GPIO_FAST_WRITE(pin, value)                                            \
+  (GPIO_FAST_BIT(pin, GPIO_FAST_OFS_OUT) = (value))
+#define GPIO_FAST_READ(pin)         (GPIO_FAST_BIT(pin, GPIO_FAST_OFS_IN))
+#define GPIO_FAST_TOGGLE(pin)                                                  \
+  (GPIO_FAST_REG8(GPIO_FAST_PORT_OF(pin), GPIO_FAST_OFS_OUT) ^=                \
+   GPIO_FAST_MASK_OF(pin))
+
+#define GPIO_FAST_SET_AS_OUTPUT(pin)                                           \
+  do {                                                                         \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_SEL0) = 0;                                \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_SEL1) = 0;                                \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_DIR)  = 1;                                \
+  } while (0)
+
+#define GPIO_FAST_SET_AS_INPUT(pin)                                            \
+  do {                                                                         \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_SEL0) = 0;                                \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_SEL1) = 0;                                \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_DIR)  = 0;                                \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_REN)  = 0;                                \
+  } while (0)
+
+#define GPIO_FAST_SET_AS_INPUT_PULLUP(pin)                                     \
+  do {                                                                         \
+    GPIO_FAST_SET_AS_INPUT(pin);                                               \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_OUT) = 1;                                 \
+    GPIO_FAST_BIT(pin, GPIO_FAST_OFS_REN) = 1;                                 \
+  } while (0)
+
+//*****************************************************************************
+//
+// Whole-port access for batched configuration. \e port is a \b GPIO_PORT_Px
+// constant, \e pair one of \b GPIO_PORT_PA ... \b GPIO_PORT_PE or
+// \b GPIO_PORT_PJ, with the odd port in the low byte.
+//
+//*****************************************************************************
+#define GPIO_FAST_PORT_WRITE(port, ofs, value)                                 \
+  (GPIO_FAST_REG8(port, ofs) = (value))
+#define GPIO_FAST_PORT_SET(port, ofs, mask)                                    \
+  (GPIO_FAST_REG8(port, ofs) |= (mask))
+#define GPIO_FAST_PORT_CLEAR(port, ofs, mask)                                  \
+  (GPIO_FAST_REG8(port, ofs) &= ~(mask))
+#define GPIO_FAST_PAIR_WRITE(pair, ofs, value)                                 \
+  (GPIO_FAST_REG16(pair, ofs) = (value))
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* GPIO_FAST_H_ */
@@ -29,7 +29,9 @@
  * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/cs.h>
 #include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/gpio.h>
 #include <ti/devices/msp432p4xx/driverlib/i2c.h>
 #include <ti/devices/msp432p4xx/driverlib/interrupt.h>
 
@@ -756,3 +758,409 @@ void I2C_slaveSendNAK(uint32_t moduleInstance) {
   BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0, EUSCI_B_CTLW0_TXNACK_OFS) =
       1;
 }
+
+//*****************************************************************************
+//
+// Wall-clock timeouts and bus recovery. Timeouts are measured against the
+// free-running DWT cycle counter scaled by the current MCLK, so a timeout in
+// microseconds means the same thing regardless of the DCO setting.
+//
+//*****************************************************************************
+#define I2C_NUM_INSTANCES        4
+#define I2C_RECOVERY_CLOCKS      9
+#define I2C_RECOVERY_HALF_PERIOD 5 // us, ~100kHz bit-banged SCL
+
+static I2C_ErrorCounters            I2C_errorCounters[I2C_NUM_INSTANCES];
+static const I2C_BusRecoveryConfig *I2C_recoveryConfig[I2C_NUM_INSTANCES];
+
+static uint_fast8_t I2C_getInstanceIndex(uint32_t moduleInstance) {
+  switch (moduleInstance) {
+  case EUSCI_B0_BASE:
+    return 0;
+  case EUSCI_B1_BASE:
+    return 1;
+#ifdef EUSCI_B2_BASE
+  case EUSCI_B2_BASE:
+    return 2;
+#endif
+#ifdef EUSCI_B3_BASE
+  case EUSCI_B3_BASE:
+    return 3;
+#endif
+  default:
+    ASSERT(false);
+    return 0;
+  }
+}
+
+static void I2C_startCycleCounter(void) {
+  // Make sure the cycle counter is running
+  if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+}
+
+static uint32_t I2C_microsecondsToCycles(uint32_t us) {
+  // Rounded up so a timeout is never short, whatever the MCLK frequency
+  uint64_t cycles = ((uint64_t)us * CS_getMCLK() + 999999) / 1000000;
+
+  return cycles > UINT32_MAX ? UINT32_MAX : (uint32_t)cycles;
+}
+
+static uint32_t I2C_startTimeout(uint32_t timeoutUs, uint32_t *limit) {
+  I2C_startCycleCounter();
+
+  *limit = I2C_microsecondsToCycles(timeoutUs);
+  return DWT->CYCCNT;
+}
+
+static bool I2C_isTimeoutExpired(uint32_t start, uint32_t limit) {
+  // Unsigned subtraction keeps this correct across counter wrap
+  return (DWT->CYCCNT - start) >= limit;
+}
+
+// The counter must be running, see I2C_startCycleCounter
+static void I2C_delayCycles(uint32_t cycles) {
+  uint32_t start = DWT->CYCCNT;
+
+  while (!I2C_isTimeoutExpired(start, cycles))
+    ;
+}
+
+static void I2C_releaseLine(uint_fast8_t port, uint_fast16_t pin) {
+  // External pull-up takes the line high
+  GPIO_setAsInputPin(port, pin);
+}
+
+static void I2C_driveLineLow(uint_fast8_t port, uint_fast16_t pin) {
+  // Load OUT before DIR so the line never glitches high
+  GPIO_setOutputLowOnPin(port, pin);
+  GPIO_setAsOutputPin(port, pin);
+}
+
+static bool I2C_handleTimeout(uint32_t moduleInstance) {
+  uint_fast8_t index = I2C_getInstanceIndex(moduleInstance);
+
+  I2C_errorCounters[index].timeouts++;
+
+  if (I2C_recoveryConfig[index] != 0)
+    I2C_recoverBus(moduleInstance);
+
+  return false;
+}
+
+void I2C_setBusRecoveryConfig(uint32_t                     moduleInstance,
+                              const I2C_BusRecoveryConfig *config) {
+  I2C_recoveryConfig[I2C_getInstanceIndex(moduleInstance)] = config;
+}
+
+bool I2C_recoverBus(uint32_t moduleInstance) {
+  uint_fast8_t                 index  = I2C_getInstanceIndex(moduleInstance);
+  const I2C_BusRecoveryConfig *config = I2C_recoveryConfig[index];
+  uint_fast16_t                slaveAddress, interruptMask, timeoutSetting;
+  uint_fast8_t                 i;
+  uint32_t                     halfPeriod;
+  bool                         released;
+
+  ASSERT(config != 0);
+
+  if (config == 0)
+    return false;
+
+  // MCLK looked up once for the whole sequence
+  halfPeriod = I2C_microsecondsToCycles(I2C_RECOVERY_HALF_PERIOD);
+  I2C_startCycleCounter();
+
+  // Save settings that I2C_initMaster does not restore
+  slaveAddress   = EUSCI_B_CMSIS(moduleInstance)->I2CSA;
+  interruptMask  = EUSCI_B_CMSIS(moduleInstance)->IE;
+  timeoutSetting = EUSCI_B_CMSIS(moduleInstance)->CTLW1 & EUSCI_B_CTLW1_CLTO_3;
+
+  // Take the pins away from the eUSCI module
+  I2C_disableModule(moduleInstance);
+  I2C_releaseLine(config->sdaPort, config->sdaPin);
+  I2C_releaseLine(config->sclPort, config->sclPin);
+
+  // Clock SCL until the slave lets go of SDA
+  for (i = 0; i < I2C_RECOVERY_CLOCKS; i++) {
+    if (GPIO_getInputPinValue(config->sdaPort, config->sdaPin))
+      break;
+
+    I2C_driveLineLow(config->sclPort, config->sclPin);
+    I2C_delayCycles(halfPeriod);
+    I2C_releaseLine(config->sclPort, config->sclPin);
+    I2C_delayCycles(halfPeriod);
+  }
+
+  // Issue a STOP: SDA low -> high while SCL is high
+  I2C_driveLineLow(config->sclPort, config->sclPin);
+  I2C_delayCycles(halfPeriod);
+  I2C_driveLineLow(config->sdaPort, config->sdaPin);
+  I2C_delayCycles(halfPeriod);
+  I2C_releaseLine(config->sclPort, config->sclPin);
+  I2C_delayCycles(halfPeriod);
+  I2C_releaseLine(config->sdaPort, config->sdaPin);
+  I2C_delayCycles(halfPeriod);
+
+  released = GPIO_getInputPinValue(config->sdaPort, config->sdaPin) &&
+             GPIO_getInputPinValue(config->sclPort, config->sclPin);
+
+  // Hand the pins back and bring the module up again
+  GPIO_setAsPeripheralModuleFunctionInputPin(
+      config->sdaPort, config->sdaPin, config->pinFunction);
+  GPIO_setAsPeripheralModuleFunctionInputPin(
+      config->sclPort, config->sclPin, config->pinFunction);
+
+  I2C_initMaster(moduleInstance, config->masterConfig);
+  EUSCI_B_CMSIS(moduleInstance)->CTLW1 =
+      (EUSCI_B_CMSIS(moduleInstance)->CTLW1 & (~EUSCI_B_CTLW1_CLTO_3)) |
+      timeoutSetting;
+  EUSCI_B_CMSIS(moduleInstance)->I2CSA = slaveAddress;
+  I2C_enableModule(moduleInstance);
+  EUSCI_B_CMSIS(moduleInstance)->IE = interruptMask;
+
+  if (released)
+    I2C_errorCounters[index].recoveries++;
+  else
+    I2C_errorCounters[index].failedRecoveries++;
+
+  return released;
+}
+
+void I2C_getErrorCounters(uint32_t           moduleInstance,
+                          I2C_ErrorCounters *counters) {
+  *counters = I2C_errorCounters[I2C_getInstanceIndex(moduleInstance)];
+}
+
+void I2C_clearErrorCounters(uint32_t moduleInstance) {
+  uint_fast8_t index = I2C_getInstanceIndex(moduleInstance);
+
+  I2C_errorCounters[index].timeouts         = 0;
+  I2C_errorCounters[index].nacks            = 0;
+  I2C_errorCounters[index].recoveries       = 0;
+  I2C_errorCounters[index].failedRecoveries = 0;
+}
+
+bool I2C_masterSendSingleByteWithTimeoutUs(uint32_t moduleInstance,
+                                           uint8_t  txData,
+                                           uint32_t timeoutUs) {
+  uint_fast16_t txieStatus;
+  uint32_t      start, limit;
+
+  ASSERT(timeoutUs > 0);
+
+  // Store current TXIE status
+  txieStatus = EUSCI_B_CMSIS(moduleInstance)->IE & EUSCI_B_IE_TXIE0;
+
+  // Disable transmit interrupt enable
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IE, EUSCI_B_IE_TXIE0_OFS) = 0;
+
+  // Send start condition.
+  EUSCI_B_CMSIS(moduleInstance)->CTLW0 |=
+      EUSCI_B_CTLW0_TR + EUSCI_B_CTLW0_TXSTT;
+
+  // Poll for transmit interrupt flag.
+  start = I2C_startTimeout(timeoutUs, &limit);
+  while (!(EUSCI_B_CMSIS(moduleInstance)->IFG & EUSCI_B_IFG_TXIFG)) {
+    if (I2C_isTimeoutExpired(start, limit)) {
+      EUSCI_B_CMSIS(moduleInstance)->IE |= txieStatus;
+      return I2C_handleTimeout(moduleInstance);
+    }
+  }
+
+  // Send single byte data.
+  EUSCI_B_CMSIS(moduleInstance)->TXBUF = txData;
+
+  // Poll for transmit interrupt flag, same budget as the start.
+  start = DWT->CYCCNT;
+  while (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                       EUSCI_B_IFG_TXIFG0_OFS)) {
+    if (I2C_isTimeoutExpired(start, limit)) {
+      EUSCI_B_CMSIS(moduleInstance)->IE |= txieStatus;
+      return I2C_handleTimeout(moduleInstance);
+    }
+  }
+
+  // Send stop condition.
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0, EUSCI_B_CTLW0_TXSTP_OFS) =
+      1;
+
+  // Clear transmit interrupt flag before enabling interrupt again
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG, EUSCI_B_IFG_TXIFG0_OFS) = 0;
+
+  // Reinstate transmit interrupt enable
+  EUSCI_B_CMSIS(moduleInstance)->IE |= txieStatus;
+
+  return true;
+}
+
+bool I2C_masterSendMultiByteStartWithTimeoutUs(uint32_t moduleInstance,
+                                               uint8_t  txData,
+                                               uint32_t timeoutUs) {
+  uint_fast16_t txieStatus;
+  uint32_t      start, limit;
+
+  ASSERT(timeoutUs > 0);
+
+  // Store current transmit interrupt enable
+  txieStatus = EUSCI_B_CMSIS(moduleInstance)->IE & EUSCI_B_IE_TXIE0;
+
+  // Disable transmit interrupt enable
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IE, EUSCI_B_IE_TXIE0_OFS) = 0;
+
+  // Send start condition.
+  EUSCI_B_CMSIS(moduleInstance)->CTLW0 |=
+      EUSCI_B_CTLW0_TR + EUSCI_B_CTLW0_TXSTT;
+
+  // Poll for transmit interrupt flag and start condition flag.
+  start = I2C_startTimeout(timeoutUs, &limit);
+  while (BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0,
+                      EUSCI_B_CTLW0_TXSTT_OFS) ||
+         !BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                       EUSCI_B_IFG_TXIFG0_OFS)) {
+    if (I2C_isTimeoutExpired(start, limit)) {
+      EUSCI_B_CMSIS(moduleInstance)->IE |= txieStatus;
+      return I2C_handleTimeout(moduleInstance);
+    }
+  }
+
+  // Send single byte data.
+  EUSCI_B_CMSIS(moduleInstance)->TXBUF = txData;
+
+  // Reinstate transmit interrupt enable
+  EUSCI_B_CMSIS(moduleInstance)->IE |= txieStatus;
+
+  return true;
+}
+
+bool I2C_masterSendMultiByteNextWithTimeoutUs(uint32_t moduleInstance,
+                                              uint8_t  txData,
+                                              uint32_t timeoutUs) {
+  uint32_t start, limit;
+
+  ASSERT(timeoutUs > 0);
+
+  // If interrupts are not used, poll for flags
+  if (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IE, EUSCI_B_IE_TXIE0_OFS)) {
+    // Poll for transmit interrupt flag.
+    start = I2C_startTimeout(timeoutUs, &limit);
+    while (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                         EUSCI_B_IFG_TXIFG0_OFS)) {
+      if (I2C_isTimeoutExpired(start, limit))
+        return I2C_handleTimeout(moduleInstance);
+    }
+  }
+
+  // Send single byte data.
+  EUSCI_B_CMSIS(moduleInstance)->TXBUF = txData;
+
+  return true;
+}
+
+bool I2C_masterSendMultiByteFinishWithTimeoutUs(uint32_t moduleInstance,
+                                                uint8_t  txData,
+                                                uint32_t timeoutUs) {
+  uint32_t start, limit;
+
+  ASSERT(timeoutUs > 0);
+
+  // If interrupts are not used, poll for flags
+  if (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IE, EUSCI_B_IE_TXIE0_OFS)) {
+    // Poll for transmit interrupt flag.
+    start = I2C_startTimeout(timeoutUs, &limit);
+    while (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                         EUSCI_B_IFG_TXIFG0_OFS)) {
+      if (I2C_isTimeoutExpired(start, limit))
+        return I2C_handleTimeout(moduleInstance);
+    }
+  }
+
+  // Send single byte data.
+  EUSCI_B_CMSIS(moduleInstance)->TXBUF = txData;
+
+  // Poll for transmit interrupt flag.
+  start = I2C_startTimeout(timeoutUs, &limit);
+  while (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                       EUSCI_B_IFG_TXIFG0_OFS) &&
+         !BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                       EUSCI_B_IFG_NACKIFG_OFS)) {
+    if (I2C_isTimeoutExpired(start, limit))
+      return I2C_handleTimeout(moduleInstance);
+  }
+
+  if (BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                   EUSCI_B_IFG_NACKIFG_OFS)) {
+    I2C_errorCounters[I2C_getInstanceIndex(moduleInstance)].nacks++;
+
+    // Release the bus, the slave will not take more
+    BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0,
+                 EUSCI_B_CTLW0_TXSTP_OFS) = 1;
+    return false;
+  }
+
+  // Send stop condition.
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0, EUSCI_B_CTLW0_TXSTP_OFS) =
+      1;
+
+  return true;
+}
+
+bool I2C_masterSendMultiByteStopWithTimeoutUs(uint32_t moduleInstance,
+                                              uint32_t timeoutUs) {
+  uint32_t start, limit;
+
+  ASSERT(timeoutUs > 0);
+
+  // If interrupts are not used, poll for flags
+  if (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IE, EUSCI_B_IE_TXIE0_OFS)) {
+    // Poll for transmit interrupt flag.
+    start = I2C_startTimeout(timeoutUs, &limit);
+    while (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                         EUSCI_B_IFG_TXIFG0_OFS)) {
+      if (I2C_isTimeoutExpired(start, limit))
+        return I2C_handleTimeout(moduleInstance);
+    }
+  }
+
+  // Send stop condition.
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0, EUSCI_B_CTLW0_TXSTP_OFS) =
+      1;
+
+  return true;
+}
+
+bool I2C_masterReceiveMultiByteFinishWithTimeoutUs(uint32_t moduleInstance,
+                                                   uint8_t *rxData,
+                                                   uint32_t timeoutUs) {
+  uint32_t start, limit;
+
+  ASSERT(timeoutUs > 0);
+
+  // Send stop condition.
+  BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0, EUSCI_B_CTLW0_TXSTP_OFS) =
+      1;
+
+  // Wait for Stop to finish
+  start = I2C_startTimeout(timeoutUs, &limit);
+  while (BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->CTLW0,
+                      EUSCI_B_CTLW0_TXSTP_OFS)) {
+    if (I2C_isTimeoutExpired(start, limit))
+      return I2C_handleTimeout(moduleInstance);
+  }
+
+  // Wait for RX buffer
+  start = I2C_startTimeout(timeoutUs, &limit);
+  while (!BITBAND_PERI(EUSCI_B_CMSIS(moduleInstance)->IFG,
+                       EUSCI_B_IFG_RXIFG_OFS)) {
+    if (I2C_isTimeoutExpired(start, limit))
+      return I2C_handleTimeout(moduleInstance);
+  }
+
+  // Capture data from receive buffer after setting stop bit due to
+  // MSP430 I2C critical timing.
+  *rxData = (EUSCI_B_CMSIS(moduleInstance)->RXBUF & EUSCI_B_RXBUF_RXBUF_MASK);
+
+  return true;
+}
@@ -125,6 +125,37 @@ typedef struct {
   uint_fast8_t autoSTOPGeneration;
 } eUSCI_I2C_MasterConfig;
 
+//*****************************************************************************
+//
+//! \typedef I2C_BusRecoveryConfig
+//! \brief Pins and master configuration used by \link I2C_recoverBus
+//!        \endlink to free a bus held low by a slave and reinitialize the
+//!        module. See \link I2C_setBusRecoveryConfig \endlink.
+//
+//*****************************************************************************
+typedef struct {
+  const eUSCI_I2C_MasterConfig *masterConfig;
+  uint_fast8_t                  sclPort;
+  uint_fast16_t                 sclPin;
+  uint_fast8_t                  sdaPort;
+  uint_fast16_t                 sdaPin;
+  uint_fast8_t                  pinFunction;
+} I2C_BusRecoveryConfig;
+
+//*****************************************************************************
+//
+//! \typedef I2C_ErrorCounters
+//! \brief Per-module error counters maintained by the *WithTimeoutUs
+//!        functions and \link I2C_recoverBus \endlink.
+//
+//*****************************************************************************
+typedef struct {
+  uint32_t timeouts;
+  uint32_t nacks;
+  uint32_t recoveries;
+  uint32_t failedRecoveries;
+} I2C_ErrorCounters;
+
 //*****************************************************************************
 //
 //! Initializes the I2C Master block.
@@ -1398,6 +1429,279 @@ extern void I2C_unregisterInterrupt(uint32_t moduleInstance);
 //*****************************************************************************
 extern void I2C_slaveSendNAK(uint32_t moduleInstance);
 
+//*****************************************************************************
+//
+//! Registers the pins and master configuration used for bus recovery
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param config is a pointer to the recovery configuration. The structure
+//!        is not copied and must stay valid while recovery is enabled. Pass
+//!        NULL to disable automatic recovery.
+//!
+//! Once a configuration is registered, every *WithTimeoutUs function that
+//! times out runs \link I2C_recoverBus \endlink before returning false.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void I2C_setBusRecoveryConfig(uint32_t moduleInstance,
+                                     const I2C_BusRecoveryConfig *config);
+
+//*****************************************************************************
+//
+//! Frees a bus held low by a slave and reinitializes the master
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! The SCL and SDA pins are switched to GPIO, SCL is clocked up to nine
+//! times until the slave releases SDA, a STOP condition is generated and the
+//! module is brought back up with \link I2C_initMaster \endlink. The slave
+//! address, clock low timeout and interrupt enables are preserved.
+//!
+//! Modified registers are \b UCBxCTLW0, \b UCBxCTLW1, \b UCBxBRW,
+//! \b UCBxI2CSA, \b UCBxIE and the port SEL/DIR/OUT registers of both pins
+//!
+//! \return true if both lines read high after recovery, false otherwise.
+//
+//*****************************************************************************
+extern bool I2C_recoverBus(uint32_t moduleInstance);
+
+//*****************************************************************************
+//
+//! Reads the error counters of an I2C module
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param counters is filled with the current counter values
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void I2C_getErrorCounters(uint32_t           moduleInstance,
+                                 I2C_ErrorCounters *counters);
+
+//*****************************************************************************
+//
+//! Resets the error counters of an I2C module to zero
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void I2C_clearErrorCounters(uint32_t moduleInstance);
+
+//*****************************************************************************
+//
+//! Does single byte transmission from Master to Slave with a wall-clock
+//! timeout
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param txData is the data byte to be transmitted
+//!
+//! \param timeoutUs is the time to wait in microseconds, for the start and
+//!        again for the byte. See
+//!        \link I2C_masterSendMultiByteStartWithTimeoutUs \endlink.
+//!
+//! Modified registers are \b UCBxIE, \b UCBxCTLW0, \b UCBxIFG,
+//! \b UCBxTXBUF
+//!
+//! \return true on success, false on timeout.
+//
+//*****************************************************************************
+extern bool I2C_masterSendSingleByteWithTimeoutUs(uint32_t moduleInstance,
+                                                  uint8_t  txData,
+                                                  uint32_t timeoutUs);
+
+//*****************************************************************************
+//
+//! Starts multi-byte transmission from Master to Slave with a wall-clock
+//! timeout
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param txData is the first data byte to be transmitted
+//!
+//! \param timeoutUs is the time to wait in microseconds. It is measured with
+//!        the DWT cycle counter and the current MCLK frequency, so it does
+//!        not depend on the DCO setting. Must not exceed 2^32 / MCLK(MHz).
+//!
+//! On timeout the error counter is incremented and, if a configuration was
+//! registered with \link I2C_setBusRecoveryConfig \endlink, the bus is
+//! recovered.
+//!
+//! Modified registers are \b UCBxIE, \b UCBxCTLW0, \b UCBxTXBUF
+//!
+//! \return true on success, false on timeout.
+//
+//*****************************************************************************
+extern bool I2C_masterSendMultiByteStartWithTimeoutUs(uint32_t moduleInstance,
+                                                      uint8_t  txData,
+                                                      uint32_t timeoutUs);
+
+//*****************************************************************************
+//
+//! Continues multi-byte transmission from Master to Slave with a wall-clock
+//! timeout
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param txData is the next data byte to be transmitted
+//!
+//! \param timeoutUs is the time to wait in microseconds. See
+//!        \link I2C_masterSendMultiByteStartWithTimeoutUs \endlink.
+//!
+//! Modified registers are \b UCBxTXBUF
+//!
+//! \return true on success, false on timeout.
+//
+//*****************************************************************************
+extern bool I2C_masterSendMultiByteNextWithTimeoutUs(uint32_t moduleInstance,
+                                                     uint8_t  txData,
+                                                     uint32_t timeoutUs);
+
+//*****************************************************************************
+//
+//! Finishes multi-byte transmission from Master to Slave with a wall-clock
+//! timeout
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param txData is the last data byte to be transmitted
+//!
+//! \param timeoutUs is the time to wait in microseconds for each step. See
+//!        \link I2C_masterSendMultiByteStartWithTimeoutUs \endlink.
+//!
+//! A NAK from the slave increments the NAK counter, sends a STOP to release
+//! the bus and returns false without attempting recovery.
+//!
+//! Modified registers are \b UCBxTXBUF, \b UCBxCTLW0
+//!
+//! \return true on success, false on timeout or NAK.
+//
+//*****************************************************************************
+extern bool I2C_masterSendMultiByteFinishWithTimeoutUs(uint32_t moduleInstance,
+                                                       uint8_t  txData,
+                                                       uint32_t timeoutUs);
+
+//*****************************************************************************
+//
+//! Sends a STOP after multi-byte transmission with a wall-clock timeout
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param timeoutUs is the time to wait in microseconds. See
+//!        \link I2C_masterSendMultiByteStartWithTimeoutUs \endlink.
+//!
+//! Modified registers are \b UCBxCTLW0
+//!
+//! \return true on success, false on timeout.
+//
+//*****************************************************************************
+extern bool I2C_masterSendMultiByteStopWithTimeoutUs(uint32_t moduleInstance,
+                                                     uint32_t timeoutUs);
+
+//*****************************************************************************
+//
+//! Finishes multi-byte reception at the Master with a wall-clock timeout
+//!
+//! \param moduleInstance is the instance of the eUSCI B (I2C) module. Valid
+//! parameters vary from part to part, but can include:
+//!         - \b EUSCI_B0_BASE
+//!         - \b EUSCI_B1_BASE
+//!         - \b EUSCI_B2_BASE
+//!         - \b EUSCI_B3_BASE
+//!  <br>It is important to note that for eUSCI modules, only "B" modules such
+//!  as EUSCI_B0 can be used. "A" modules such as EUSCI_A0 do not support the
+//!  I2C mode.
+//!
+//! \param rxData is filled with the last received byte
+//!
+//! \param timeoutUs is the time to wait in microseconds for each step. See
+//!        \link I2C_masterSendMultiByteStartWithTimeoutUs \endlink.
+//!
+//! Modified registers are \b UCBxCTLW0
+//!
+//! \return true on success, false on timeout.
+//
+//*****************************************************************************
+extern bool I2C_masterReceiveMultiByteFinishWithTimeoutUs(
+    uint32_t moduleInstance, uint8_t *rxData, uint32_t timeoutUs);
+
 /* Backwards Compatibility Layer */
 #define EUSCI_B_I2C_slaveInit               I2C_initSlave
 #define EUSCI_B_I2C_enable                  I2C_enableModule
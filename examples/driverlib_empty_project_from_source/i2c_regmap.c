@@ -0,0 +1,263 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/dma.h>
+#include <ti/devices/msp432p4xx/driverlib/i2c.h>
+#include <ti/devices/msp432p4xx/driverlib/i2c_regmap.h>
+
+#include <string.h>
+
+// Largest transfer a single uDMA control structure can describe
+#define I2C_REGMAP_MAX_DMA_TRANSFER 1024
+
+// Served once the master reads past the end of the map
+static const uint8_t I2C_RegMap_padByte = 0xFF;
+
+// Swallows bytes written past the end of the receive buffer
+static uint8_t I2C_RegMap_sinkByte;
+
+static void I2C_RegMap_armReceive(I2C_RegMap *map) {
+  const I2C_RegMapConfig *config = map->config;
+  void                   *rxbuf =
+      (void *)I2C_getReceiveBufferAddressForDMA(config->moduleInstance);
+
+  DMA_disableChannel(config->rxChannel);
+  DMA_disableChannelAttribute(config->rxChannel, UDMA_ATTR_ALTSELECT);
+
+  // Primary fills the receive buffer, alternate discards any overflow so the
+  // bus is never stretched waiting for the CPU
+  DMA_setChannelControl(UDMA_PRI_SELECT | config->rxChannel,
+                        UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 |
+                            UDMA_ARB_1);
+  DMA_setChannelTransfer(UDMA_PRI_SELECT | config->rxChannel,
+                         UDMA_MODE_PINGPONG, rxbuf, config->rxBuffer,
+                         config->rxBufferSize);
+  DMA_setChannelControl(UDMA_ALT_SELECT | config->rxChannel,
+                        UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_NONE |
+                            UDMA_ARB_1);
+  DMA_setChannelTransfer(UDMA_ALT_SELECT | config->rxChannel, UDMA_MODE_BASIC,
+                         rxbuf, &I2C_RegMap_sinkByte,
+                         I2C_REGMAP_MAX_DMA_TRANSFER);
+
+  DMA_enableChannel(config->rxChannel);
+}
+
+static void I2C_RegMap_applyWrite(I2C_RegMap *map, uint_fast16_t first,
+                                  const uint8_t *data, uint_fast16_t length) {
+  const I2C_RegMapConfig *config = map->config;
+  uint_fast16_t           last   = first + length;
+  uint_fast16_t           lo, hi;
+  uint_fast8_t            i;
+
+  if (last > config->shadowSize)
+    last = config->shadowSize;
+
+  for (i = 0; i < config->numRanges; i++) {
+    const I2C_RegMapRange *range = &config->ranges[i];
+
+    lo = (range->start > first) ? range->start : first;
+    hi = (range->start + range->length < last) ? range->start + range->length
+                                               : last;
+    if (lo >= hi)
+      continue;
+
+    memcpy(&config->shadow[lo], &data[lo - first], hi - lo);
+
+    if (range->callback)
+      range->callback(lo, hi - lo);
+  }
+}
+
+static void I2C_RegMap_finishWrite(I2C_RegMap *map) {
+  const I2C_RegMapConfig *config = map->config;
+  uint_fast16_t           received, pointer;
+
+  received = config->rxBufferSize -
+             DMA_getChannelSize(UDMA_PRI_SELECT | config->rxChannel);
+  if (received == 0)
+    return;
+
+  // First byte of every write is the register address
+  pointer = config->rxBuffer[0];
+
+  if (received > 1) {
+    I2C_RegMap_applyWrite(map, pointer, &config->rxBuffer[1], received - 1);
+    pointer += received - 1;
+  }
+
+  map->pointer = (pointer >= config->shadowSize) ? 0 : pointer;
+
+  I2C_RegMap_armReceive(map);
+}
+
+static void I2C_RegMap_startRead(I2C_RegMap *map) {
+  const I2C_RegMapConfig *config = map->config;
+  uint_fast16_t           start  = map->pointer;
+  void                   *txbuf =
+      (void *)I2C_getTransmitBufferAddressForDMA(config->moduleInstance);
+
+  DMA_disableChannel(config->txChannel);
+  DMA_disableChannelAttribute(config->txChannel, UDMA_ATTR_ALTSELECT);
+
+  // The CPU loads the first byte below; DMA picks up from the next one and
+  // falls through to the pad byte once the map is exhausted
+  map->readLength = config->shadowSize - start - 1;
+
+  if (map->readLength > 0) {
+    DMA_setChannelControl(UDMA_PRI_SELECT | config->txChannel,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE |
+                              UDMA_ARB_1);
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | config->txChannel,
+                           UDMA_MODE_PINGPONG, &config->shadow[start + 1],
+                           txbuf, map->readLength);
+    DMA_setChannelControl(UDMA_ALT_SELECT | config->txChannel,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_NONE |
+                              UDMA_ARB_1);
+    DMA_setChannelTransfer(UDMA_ALT_SELECT | config->txChannel,
+                           UDMA_MODE_BASIC, (void *)&I2C_RegMap_padByte, txbuf,
+                           I2C_REGMAP_MAX_DMA_TRANSFER);
+  } else {
+    DMA_setChannelControl(UDMA_PRI_SELECT | config->txChannel,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_NONE |
+                              UDMA_ARB_1);
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | config->txChannel,
+                           UDMA_MODE_BASIC, (void *)&I2C_RegMap_padByte, txbuf,
+                           I2C_REGMAP_MAX_DMA_TRANSFER);
+  }
+
+  map->reading = true;
+  DMA_enableChannel(config->txChannel);
+
+  // Writing TXBUF releases the clock stretch; the next TXIFG edge after the
+  // byte moves to the shift register triggers the DMA
+  I2C_slavePutData(config->moduleInstance, config->shadow[start]);
+}
+
+static void I2C_RegMap_finishRead(I2C_RegMap *map) {
+  const I2C_RegMapConfig *config = map->config;
+  uint_fast16_t           remaining, pointer;
+
+  DMA_disableChannel(config->txChannel);
+  map->reading = false;
+
+  if (map->readLength == 0) {
+    map->pointer = 0;
+    return;
+  }
+
+  remaining = DMA_getChannelSize(UDMA_PRI_SELECT | config->txChannel);
+  if (remaining == 0) {
+    // Master read to the end of the map
+    map->pointer = 0;
+    return;
+  }
+
+  // The first byte came from the CPU and the last byte loaded by DMA was
+  // prefetched into TXBUF but never clocked out
+  pointer      = map->pointer + (map->readLength - remaining);
+  map->pointer = (pointer >= config->shadowSize) ? 0 : pointer;
+}
+
+void I2C_RegMap_init(I2C_RegMap *map, const I2C_RegMapConfig *config) {
+  ASSERT(config->shadowSize > 0 && config->shadowSize <= 256);
+  ASSERT(config->rxBufferSize > 0 &&
+         config->rxBufferSize <= I2C_REGMAP_MAX_DMA_TRANSFER);
+  ASSERT(DMA_getControlBase() != 0);
+
+  map->config     = config;
+  map->pointer    = 0;
+  map->reading    = false;
+  map->readLength = 0;
+
+  I2C_initSlave(config->moduleInstance, config->slaveAddress,
+                EUSCI_B_I2C_OWN_ADDRESS_OFFSET0,
+                EUSCI_B_I2C_OWN_ADDRESS_ENABLE);
+
+  DMA_assignChannel(config->txChannel);
+  DMA_assignChannel(config->rxChannel);
+  DMA_disableChannelAttribute(config->txChannel,
+                              UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                  UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+  DMA_disableChannelAttribute(config->rxChannel,
+                              UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                  UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+
+  I2C_enableModule(config->moduleInstance);
+
+  // Data bytes move by DMA only; the CPU sees START and STOP
+  I2C_disableInterrupt(config->moduleInstance,
+                       EUSCI_B_I2C_TRANSMIT_INTERRUPT0 |
+                           EUSCI_B_I2C_RECEIVE_INTERRUPT0);
+  I2C_RegMap_armReceive(map);
+
+  I2C_clearInterruptFlag(config->moduleInstance,
+                         EUSCI_B_I2C_START_INTERRUPT |
+                             EUSCI_B_I2C_STOP_INTERRUPT);
+  I2C_enableInterrupt(config->moduleInstance,
+                      EUSCI_B_I2C_START_INTERRUPT | EUSCI_B_I2C_STOP_INTERRUPT);
+}
+
+void I2C_RegMap_handleInterrupt(I2C_RegMap *map) {
+  uint32_t      moduleInstance = map->config->moduleInstance;
+  uint_fast16_t status;
+
+  status = I2C_getEnabledInterruptStatus(moduleInstance);
+  I2C_clearInterruptFlag(moduleInstance, status);
+
+  // A STOP closes whatever transaction was running before a new START
+  if (status & EUSCI_B_I2C_STOP_INTERRUPT) {
+    if (map->reading)
+      I2C_RegMap_finishRead(map);
+    else
+      I2C_RegMap_finishWrite(map);
+  }
+
+  if (status & EUSCI_B_I2C_START_INTERRUPT) {
+    if (map->reading)
+      I2C_RegMap_finishRead(map);
+
+    // Covers the register address written before a repeated START
+    I2C_RegMap_finishWrite(map);
+
+    if (I2C_getMode(moduleInstance) == EUSCI_B_I2C_TRANSMIT_MODE)
+      I2C_RegMap_startRead(map);
+  }
+}
+
+void I2C_RegMap_update(I2C_RegMap *map, uint_fast16_t address,
+                       const uint8_t *data, uint_fast16_t length) {
+  ASSERT(address + length <= map->config->shadowSize);
+
+  memcpy(&map->config->shadow[address], data, length);
+}
+
+bool I2C_RegMap_isReading(const I2C_RegMap *map) { return map->reading; }
@@ -0,0 +1,217 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef I2C_REGMAP_H_
+#define I2C_REGMAP_H_
+
+//*****************************************************************************
+//
+//! \addtogroup i2c_regmap_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/driverlib/i2c.h>
+
+//*****************************************************************************
+//
+//! \typedef I2C_RegMapWriteCallback
+//! \brief Called from the eUSCI interrupt after a master write touched a
+//!        registered range. \e address and \e length describe the part of the
+//!        range that was written; the new values are already in the shadow.
+//
+//*****************************************************************************
+typedef void (*I2C_RegMapWriteCallback)(uint_fast16_t address,
+                                        uint_fast16_t length);
+
+//*****************************************************************************
+//
+//! \typedef I2C_RegMapRange
+//! \brief A writable window of the register map. Shadow bytes outside all
+//!        ranges are read-only for the bus master.
+//
+//*****************************************************************************
+typedef struct {
+  uint_fast16_t           start;
+  uint_fast16_t           length;
+  I2C_RegMapWriteCallback callback;
+} I2C_RegMapRange;
+
+//*****************************************************************************
+//
+//! \typedef I2C_RegMapConfig
+//! \brief Configuration for \link I2C_RegMap_init \endlink. The structure and
+//!        every buffer it points to must stay valid while the map is running.
+//!
+//! - \e shadow is the register file served to the master, at most 256 bytes
+//!   since the register address is a single byte.
+//! - \e rxBuffer receives one write transaction (address byte plus data),
+//!   at most 1024 bytes.
+//! - \e txChannel and \e rxChannel are the DMA channel mappings of the eUSCI
+//!   module, for example \b DMA_CH0_EUSCIB0TX0 and \b DMA_CH1_EUSCIB0RX0.
+//
+//*****************************************************************************
+typedef struct {
+  uint32_t               moduleInstance;
+  uint_fast16_t          slaveAddress;
+  uint8_t               *shadow;
+  uint_fast16_t          shadowSize;
+  uint8_t               *rxBuffer;
+  uint_fast16_t          rxBufferSize;
+  uint32_t               txChannel;
+  uint32_t               rxChannel;
+  const I2C_RegMapRange *ranges;
+  uint_fast8_t           numRanges;
+} I2C_RegMapConfig;
+
+//*****************************************************************************
+//
+//! \typedef I2C_RegMap
+//! \brief Run-time state of a register map. Allocated by the application and
+//!        initialized with \link I2C_RegMap_init \endlink.
+//
+//*****************************************************************************
+typedef struct {
+  const I2C_RegMapConfig *config;
+  volatile uint_fast16_t  pointer;
+  volatile bool           reading;
+  uint_fast16_t           readLength;
+} I2C_RegMap;
+
+//*****************************************************************************
+//
+//! Initializes an I2C slave that exposes a register map
+//!
+//! \param map is the register map state to initialize
+//!
+//! \param config is the register map configuration
+//!
+//! The eUSCI module is initialized as a slave with \link I2C_initSlave
+//! \endlink and both DMA channels are assigned to it. The master first writes
+//! a one-byte register address, then either writes data to consecutive
+//! registers or reads from them after a repeated START. The address pointer
+//! auto-increments and persists across transactions.
+//!
+//! Reads are served by DMA straight from the shadow buffer; the CPU only runs
+//! on START and STOP. Reads past the end of the map return 0xFF. Writes are
+//! collected by DMA and applied to the shadow on STOP or repeated START;
+//! bytes outside all registered ranges, or past the end of the map, are
+//! dropped.
+//!
+//! The DMA module must be enabled and its control table set with
+//! \link DMA_setControlBase \endlink before calling this function. The
+//! application must call \link I2C_RegMap_handleInterrupt \endlink from the
+//! eUSCI interrupt handler and enable the interrupt in the NVIC.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void I2C_RegMap_init(I2C_RegMap *map, const I2C_RegMapConfig *config);
+
+//*****************************************************************************
+//
+//! Services the START and STOP interrupts of a register map
+//!
+//! \param map is the register map
+//!
+//! This function must be called from the eUSCI interrupt handler of the
+//! module passed in the configuration. A START must be serviced within one
+//! byte time on the bus so that a repeated START between two writes is told
+//! apart from the data that follows it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void I2C_RegMap_handleInterrupt(I2C_RegMap *map);
+
+//*****************************************************************************
+//
+//! Updates registers in the shadow from the application
+//!
+//! \param map is the register map
+//!
+//! \param address is the first register to update
+//!
+//! \param data points to the new values
+//!
+//! \param length is the number of registers to update
+//!
+//! The copy is not synchronized with a read already in progress on the bus,
+//! so a master may observe a multi-byte value half updated. Masters that need
+//! coherent multi-byte values should read them in a single transaction after
+//! \link I2C_RegMap_isReading \endlink returns false.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void I2C_RegMap_update(I2C_RegMap *map, uint_fast16_t address,
+                              const uint8_t *data, uint_fast16_t length);
+
+//*****************************************************************************
+//
+//! Returns whether the master is currently reading the register map
+//!
+//! \param map is the register map
+//!
+//! \return true between a read START and the following STOP.
+//
+//*****************************************************************************
+extern bool I2C_RegMap_isReading(const I2C_RegMap *map);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* I2C_REGMAP_H_ */
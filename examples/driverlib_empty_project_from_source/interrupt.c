@@ -36,6 +36,9 @@
 #include <ti/devices/msp432p4xx/driverlib/cpu.h>
 #include <ti/devices/msp432p4xx/driverlib/debug.h>
 #include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#ifdef INTERRUPT_PROFILING
+#include <ti/devices/msp432p4xx/driverlib/interrupt_profile.h>
+#endif
 
 //*****************************************************************************
 //
@@ -110,6 +113,53 @@ static const uint32_t g_pulPendRegs[] = {NVIC_PEND0_R, NVIC_PEND1_R};
 //*****************************************************************************
 static const uint32_t g_pulUnpendRegs[] = {NVIC_UNPEND0_R, NVIC_UNPEND1_R};
 
+//*****************************************************************************
+//
+// Planned priority of each peripheral interrupt, indexed from INT_PSS.
+// Entries left out run at INTERRUPT_PRIORITY_BACKGROUND.
+//
+//*****************************************************************************
+static const uint8_t g_pucPriorityPlan[NUM_INTERRUPTS + 1 - INT_PSS] = {
+    [INT_PSS - INT_PSS]      = INTERRUPT_PRIORITY_SYSTEM,
+    [INT_CS - INT_PSS]       = INTERRUPT_PRIORITY_SYSTEM,
+    [INT_PCM - INT_PSS]      = INTERRUPT_PRIORITY_SYSTEM,
+    [INT_FLCTL - INT_PSS]    = INTERRUPT_PRIORITY_SYSTEM,
+    [INT_COMP_E0 - INT_PSS]  = INTERRUPT_PRIORITY_IO,
+    [INT_COMP_E1 - INT_PSS]  = INTERRUPT_PRIORITY_IO,
+    [INT_TA0_0 - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA0_N - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA1_0 - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA1_N - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA2_0 - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA2_N - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA3_0 - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_TA3_N - INT_PSS]    = INTERRUPT_PRIORITY_TIMER,
+    [INT_EUSCIA0 - INT_PSS]  = INTERRUPT_PRIORITY_FAST,
+    [INT_EUSCIA1 - INT_PSS]  = INTERRUPT_PRIORITY_FAST,
+    [INT_EUSCIA2 - INT_PSS]  = INTERRUPT_PRIORITY_FAST,
+    [INT_EUSCIA3 - INT_PSS]  = INTERRUPT_PRIORITY_FAST,
+    [INT_EUSCIB0 - INT_PSS]  = INTERRUPT_PRIORITY_COMM,
+    [INT_EUSCIB1 - INT_PSS]  = INTERRUPT_PRIORITY_COMM,
+    [INT_EUSCIB2 - INT_PSS]  = INTERRUPT_PRIORITY_COMM,
+    [INT_EUSCIB3 - INT_PSS]  = INTERRUPT_PRIORITY_COMM,
+    [INT_ADC14 - INT_PSS]    = INTERRUPT_PRIORITY_FAST,
+    [INT_T32_INT1 - INT_PSS] = INTERRUPT_PRIORITY_TIMER,
+    [INT_T32_INT2 - INT_PSS] = INTERRUPT_PRIORITY_TIMER,
+    [INT_T32_INTC - INT_PSS] = INTERRUPT_PRIORITY_TIMER,
+    [INT_RTC_C - INT_PSS]    = INTERRUPT_PRIORITY_SYSTEM,
+    [INT_DMA_ERR - INT_PSS]  = INTERRUPT_PRIORITY_DMA,
+    [INT_DMA_INT3 - INT_PSS] = INTERRUPT_PRIORITY_DMA,
+    [INT_DMA_INT2 - INT_PSS] = INTERRUPT_PRIORITY_DMA,
+    [INT_DMA_INT1 - INT_PSS] = INTERRUPT_PRIORITY_DMA,
+    [INT_DMA_INT0 - INT_PSS] = INTERRUPT_PRIORITY_DMA,
+    [INT_PORT1 - INT_PSS]    = INTERRUPT_PRIORITY_IO,
+    [INT_PORT2 - INT_PSS]    = INTERRUPT_PRIORITY_IO,
+    [INT_PORT3 - INT_PSS]    = INTERRUPT_PRIORITY_IO,
+    [INT_PORT4 - INT_PSS]    = INTERRUPT_PRIORITY_IO,
+    [INT_PORT5 - INT_PSS]    = INTERRUPT_PRIORITY_IO,
+    [INT_PORT6 - INT_PSS]    = INTERRUPT_PRIORITY_IO,
+};
+
 //*****************************************************************************
 //
 //! \internal
@@ -153,6 +203,15 @@ static __attribute__((section("vtable"))) void (
 #endif
 
 bool Interrupt_enableMaster(void) {
+#ifdef INTERRUPT_PROFILING
+  //
+  // Close the masked window while interrupts are still off, unless a
+  // critical section keeps it open.
+  //
+  if (CPU_basepriGet() == 0)
+    InterruptProfile_maskEnd();
+#endif
+
   //
   // Enable processor interrupts.
   //
@@ -160,21 +219,37 @@ bool Interrupt_enableMaster(void) {
 }
 
 bool Interrupt_disableMaster(void) {
+#ifdef INTERRUPT_PROFILING
+  bool wasDisabled;
+
+  //
+  // Disable processor interrupts, timing the window from the outermost call.
+  //
+  wasDisabled = CPU_cpsid();
+  if (!wasDisabled)
+    InterruptProfile_maskStart();
+
+  return (wasDisabled);
+#else
   //
   // Disable processor interrupts.
   //
   return (CPU_cpsid());
+#endif
 }
 
-void Interrupt_registerInterrupt(uint32_t interruptNumber,
-                                 void (*intHandler)(void)) {
+//*****************************************************************************
+//
+//! \internal
+//! Copies the active vector table to SRAM and points the NVIC at the copy, if
+//! that has not been done already.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void Interrupt_useRAMVectors(void) {
   uint32_t ulIdx, ulValue;
 
-  //
-  // Check the arguments.
-  //
-  ASSERT(interruptNumber < (NUM_INTERRUPTS + 1));
-
   //
   // Make sure that the RAM vector table is correctly aligned.
   //
@@ -198,10 +273,28 @@ void Interrupt_registerInterrupt(uint32_t interruptNumber,
     //
     SCB->VTOR = (uint32_t)g_pfnRAMVectors;
   }
+}
+
+void Interrupt_registerInterrupt(uint32_t interruptNumber,
+                                 void (*intHandler)(void)) {
+  //
+  // Check the arguments.
+  //
+  ASSERT(interruptNumber < (NUM_INTERRUPTS + 1));
+
+  //
+  // Nothing to do if the active table already dispatches to this handler,
+  // which is the case for handlers bound at link time. The vector table then
+  // stays in flash.
+  //
+  if (HWREG32(SCB->VTOR + (interruptNumber * 4)) == (uint32_t)intHandler) {
+    return;
+  }
 
   //
   // Save the interrupt handler.
   //
+  Interrupt_useRAMVectors();
   g_pfnRAMVectors[interruptNumber] = intHandler;
 }
 
@@ -212,8 +305,10 @@ void Interrupt_unregisterInterrupt(uint32_t interruptNumber) {
   ASSERT(interruptNumber < (NUM_INTERRUPTS + 1));
 
   //
-  // Reset the interrupt handler.
+  // Reset the interrupt handler. A handler bound at link time can only be
+  // replaced from the RAM table.
   //
+  Interrupt_useRAMVectors();
   g_pfnRAMVectors[interruptNumber] = IntDefaultHandler;
 }
 
@@ -483,6 +578,58 @@ void Interrupt_setPriorityMask(uint8_t priorityMask) {
 
 uint8_t Interrupt_getPriorityMask(void) { return (CPU_basepriGet()); }
 
+uint32_t Interrupt_enterCritical(uint8_t priorityMask) {
+  uint32_t previousMask;
+
+  //
+  // Check the arguments.
+  //
+  ASSERT(priorityMask != 0 && (priorityMask & 0x1F) == 0);
+
+  //
+  // Only ever tighten the mask. An interrupt taken between the read and the
+  // write restores BASEPRI before returning, so no lock is needed.
+  //
+  previousMask = CPU_basepriGet();
+  if (previousMask == 0 || priorityMask < previousMask)
+    CPU_basepriSet(priorityMask);
+
+#ifdef INTERRUPT_PROFILING
+  //
+  // Timed from the outermost section, as for Interrupt_disableMaster.
+  //
+  if (previousMask == 0)
+    InterruptProfile_maskStart();
+#endif
+
+  return (previousMask);
+}
+
+void Interrupt_exitCritical(uint32_t previousMask) {
+#ifdef INTERRUPT_PROFILING
+  //
+  // Closed while still masked, unless PRIMASK keeps it open.
+  //
+  if (previousMask == 0 && !CPU_primask())
+    InterruptProfile_maskEnd();
+#endif
+
+  CPU_basepriSet(previousMask);
+}
+
+void Interrupt_applyPriorityPlan(void) {
+  uint32_t ulIdx;
+
+  for (ulIdx = INT_PSS; ulIdx < (NUM_INTERRUPTS + 1); ulIdx++) {
+    Interrupt_setPriority(ulIdx,
+                          g_pucPriorityPlan[ulIdx - INT_PSS]
+                              ? g_pucPriorityPlan[ulIdx - INT_PSS]
+                              : INTERRUPT_PRIORITY_BACKGROUND);
+  }
+
+  Interrupt_setPriority(FAULT_SYSTICK, INTERRUPT_PRIORITY_TIMER);
+}
+
 void Interrupt_setVectorTableAddress(uint32_t addr) { SCB->VTOR = addr; }
 
 uint32_t Interrupt_getVectorTableAddress(void) { return SCB->VTOR; }
@@ -157,6 +157,63 @@ extern "C" {
 #define NVIC_PEND1_R            0xE000E204 // Interrupt 32-54 Set Pending
 #define NVIC_UNPEND0_R          0xE000E280 // Interrupt 0-31 Clear Pending
 #define NVIC_UNPEND1_R          0xE000E284 // Interrupt 32-54 Clear Pending
+
+//*****************************************************************************
+//
+//! Binds \e handler to a vector of the flash vector table at link time.
+//!
+//! \e vectorName is the handler name used by the startup file, for example
+//! \b PORT1_IRQHandler or \b TA0_0_IRQHandler. The startup file declares
+//! these names weak, so the binding overrides the default handler without
+//! touching the startup code. \e handler must be defined in the same
+//! translation unit.
+//!
+//! With GCC, Clang and the TI compiler \e vectorName is an alias of
+//! \e handler. A later call to \link Interrupt_registerInterrupt \endlink
+//! (or any XXX_registerInterrupt) with the same handler is then a no-op, so
+//! existing code keeps working while the vector table stays in flash. Only
+//! registering a different handler moves the table to SRAM.
+//!
+//! Other compilers get a trampoline instead: \e vectorName is a function
+//! that calls \e handler, one extra branch per interrupt. The vector holds
+//! the trampoline, not \e handler, so registering \e handler is not a no-op
+//! there and moves the table to SRAM; leave the registration out when
+//! building with them.
+//
+//*****************************************************************************
+#if defined(__GNUC__) || defined(__clang__) || defined(__TI_COMPILER_VERSION__)
+#define INTERRUPT_BIND_HANDLER(vectorName, handler)                            \
+  extern void vectorName(void) __attribute__((alias(#handler)))
+#else
+#define INTERRUPT_BIND_HANDLER(vectorName, handler)                            \
+  void vectorName(void) { handler(); }
+#endif
+
+//*****************************************************************************
+//
+// Priority plan. The MSP432 implements the upper 3 priority bits, so there
+// are eight levels, 0x00 (most urgent) to 0xE0. Every interrupt resets to
+// 0x00, which BASEPRI cannot mask, so \link Interrupt_applyPriorityPlan
+// \endlink moves all peripherals down to their planned level and
+// INTERRUPT_PRIORITY_TOP is left for interrupts the application promotes
+// explicitly.
+//
+// INTERRUPT_CRITICAL_x are the masks passed to \link Interrupt_enterCritical
+// \endlink: the level named and everything less urgent is held off.
+//
+//*****************************************************************************
+#define INTERRUPT_PRIORITY_TOP        0x00 /* never masked by BASEPRI */
+#define INTERRUPT_PRIORITY_FAST       0x20 /* ADC14, eUSCI_A (UART RX) */
+#define INTERRUPT_PRIORITY_DMA        0x40 /* DMA completion */
+#define INTERRUPT_PRIORITY_TIMER      0x60 /* Timer_A, Timer32, SysTick */
+#define INTERRUPT_PRIORITY_COMM       0x80 /* eUSCI_B (I2C, SPI) */
+#define INTERRUPT_PRIORITY_IO         0xA0 /* ports, comparators */
+#define INTERRUPT_PRIORITY_SYSTEM     0xC0 /* CS, PCM, PSS, flash, RTC */
+#define INTERRUPT_PRIORITY_BACKGROUND 0xE0 /* everything else */
+
+#define INTERRUPT_CRITICAL_FLASH  INTERRUPT_PRIORITY_DMA
+#define INTERRUPT_CRITICAL_DRIVER INTERRUPT_PRIORITY_TIMER
+
 //*****************************************************************************
 //
 // Prototypes for the APIs.
@@ -214,6 +271,10 @@ extern bool Interrupt_disableMaster(void);
 //!  of the user setting the ISR function pointer in the startup file. Refer
 //!  Refer to the Module Operation section for more details.
 //!
+//! If the active vector table already holds \e intHandler, as it does for a
+//! handler bound with \b INTERRUPT_BIND_HANDLER where that is an alias, the
+//! function returns without copying the table and the vectors stay in flash.
+//!
 //! See \link Interrupt_enableInterrupt \endlink for details about the interrupt
 //! parameter
 //!
@@ -233,6 +294,8 @@ extern void Interrupt_registerInterrupt(uint32_t interruptNumber,
 //! given interrupt is asserted to the processor.  The interrupt source is
 //! automatically disabled (via Interrupt_disableInterrupt()) if necessary.
 //!
+//! The vector table is moved to SRAM if it is still in flash.
+//!
 //! \sa Interrupt_registerInterrupt() for important information about
 //! registering interrupt handlers.
 //!
@@ -509,6 +572,53 @@ extern void Interrupt_setPriorityMask(uint8_t priorityMask);
 //*****************************************************************************
 extern uint8_t Interrupt_getPriorityMask(void);
 
+//*****************************************************************************
+//
+//! Enters a critical section that masks interrupts by priority
+//!
+//! \param priorityMask is the most urgent priority held off, one of the
+//!        \b INTERRUPT_CRITICAL_x or \b INTERRUPT_PRIORITY_x values other
+//!        than \b INTERRUPT_PRIORITY_TOP. Interrupts at this level and every
+//!        less urgent one are held off; only more urgent ones keep running.
+//!
+//! Unlike \link Interrupt_disableMaster \endlink this only raises BASEPRI,
+//! so a critical section entered inside a more restrictive one keeps the
+//! stricter mask. Sections nest as long as each
+//! \link Interrupt_exitCritical \endlink gets the value returned by the
+//! matching enter.
+//!
+//! \return The previous mask, to be passed to
+//!         \link Interrupt_exitCritical \endlink.
+//
+//*****************************************************************************
+extern uint32_t Interrupt_enterCritical(uint8_t priorityMask);
+
+//*****************************************************************************
+//
+//! Leaves a critical section entered with
+//! \link Interrupt_enterCritical \endlink
+//!
+//! \param previousMask is the value returned by the matching enter.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void Interrupt_exitCritical(uint32_t previousMask);
+
+//*****************************************************************************
+//
+//! Applies the priority plan to every interrupt
+//!
+//! Sets the priority of each peripheral interrupt and of SysTick to its
+//! \b INTERRUPT_PRIORITY_x level. Call it once at startup, before enabling
+//! interrupts, then promote any interrupt that must never be held off with
+//! \link Interrupt_setPriority \endlink and \b INTERRUPT_PRIORITY_TOP.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void Interrupt_applyPriorityPlan(void);
+
 //*****************************************************************************
 //
 //! Sets the address of the vector table. This function is for advanced users
@@ -0,0 +1,210 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/cpu.h>
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt_profile.h>
+#include <ti/devices/msp432p4xx/driverlib/uart.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+typedef struct {
+  uint32_t count;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint64_t totalCycles;
+} InterruptProfile_Entry;
+
+static void (*InterruptProfile_handlers[NUM_INTERRUPTS + 1])(void);
+static InterruptProfile_Entry InterruptProfile_table[NUM_INTERRUPTS + 1];
+
+static uint32_t InterruptProfile_maskStartCycles;
+static bool     InterruptProfile_masked;
+static uint32_t InterruptProfile_maxMaskedCycles;
+
+static void InterruptProfile_wrapper(void) {
+  uint32_t                interruptNumber = __get_IPSR() & 0x1FF;
+  InterruptProfile_Entry *entry = &InterruptProfile_table[interruptNumber];
+  uint32_t                start, cycles;
+
+  start = DWT->CYCCNT;
+  InterruptProfile_handlers[interruptNumber]();
+  cycles = DWT->CYCCNT - start;
+
+  // The same vector cannot nest with itself, so the entry is ours
+  if (entry->count == 0 || cycles < entry->minCycles)
+    entry->minCycles = cycles;
+  if (cycles > entry->maxCycles)
+    entry->maxCycles = cycles;
+  entry->totalCycles += cycles;
+  entry->count++;
+}
+
+static void InterruptProfile_putString(uint32_t moduleInstance,
+                                       const char *str) {
+  while (*str)
+    UART_transmitData(moduleInstance, *str++);
+}
+
+static void InterruptProfile_putNumber(uint32_t moduleInstance,
+                                       uint32_t value, uint_fast8_t width) {
+  char         buf[16];
+  uint_fast8_t i = sizeof(buf) - 1;
+
+  buf[i] = '\0';
+  do {
+    buf[--i]  = '0' + (value % 10);
+    value    /= 10;
+  } while (value && i);
+
+  while (width > (sizeof(buf) - 1) - i && i) {
+    buf[--i] = ' ';
+  }
+
+  InterruptProfile_putString(moduleInstance, &buf[i]);
+}
+
+void InterruptProfile_init(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  InterruptProfile_clear();
+}
+
+void InterruptProfile_attach(uint32_t interruptNumber) {
+  ASSERT(interruptNumber < (NUM_INTERRUPTS + 1));
+
+  if (HWREG32(SCB->VTOR + (interruptNumber * 4)) ==
+      (uint32_t)InterruptProfile_wrapper)
+    return;
+
+  InterruptProfile_handlers[interruptNumber] =
+      (void (*)(void))HWREG32(SCB->VTOR + (interruptNumber * 4));
+  Interrupt_registerInterrupt(interruptNumber, InterruptProfile_wrapper);
+}
+
+void InterruptProfile_detach(uint32_t interruptNumber) {
+  ASSERT(interruptNumber < (NUM_INTERRUPTS + 1));
+  ASSERT(InterruptProfile_handlers[interruptNumber] != 0);
+
+  Interrupt_registerInterrupt(interruptNumber,
+                              InterruptProfile_handlers[interruptNumber]);
+  InterruptProfile_handlers[interruptNumber] = 0;
+}
+
+void InterruptProfile_getStats(uint32_t                interruptNumber,
+                               InterruptProfile_Stats *stats) {
+  InterruptProfile_Entry *entry;
+  bool                    intDisabled;
+
+  ASSERT(interruptNumber < (NUM_INTERRUPTS + 1));
+
+  entry = &InterruptProfile_table[interruptNumber];
+
+  // Snapshot without a handler update landing halfway through
+  intDisabled = CPU_cpsid();
+  stats->count      = entry->count;
+  stats->minCycles  = entry->minCycles;
+  stats->maxCycles  = entry->maxCycles;
+  stats->meanCycles =
+      entry->count ? (uint32_t)(entry->totalCycles / entry->count) : 0;
+  if (!intDisabled)
+    CPU_cpsie();
+}
+
+uint32_t InterruptProfile_getMaxMaskedCycles(void) {
+  return InterruptProfile_maxMaskedCycles;
+}
+
+void InterruptProfile_clear(void) {
+  uint32_t i;
+  bool     intDisabled;
+
+  intDisabled = CPU_cpsid();
+  for (i = 0; i < (NUM_INTERRUPTS + 1); i++) {
+    InterruptProfile_table[i].count       = 0;
+    InterruptProfile_table[i].minCycles   = 0;
+    InterruptProfile_table[i].maxCycles   = 0;
+    InterruptProfile_table[i].totalCycles = 0;
+  }
+  InterruptProfile_maxMaskedCycles = 0;
+  if (!intDisabled)
+    CPU_cpsie();
+}
+
+void InterruptProfile_dump(uint32_t moduleInstance) {
+  InterruptProfile_Stats stats;
+  uint32_t               i;
+
+  InterruptProfile_putString(moduleInstance,
+                             "IRQ      count        min        max       mean"
+                             "\r\n");
+
+  for (i = 0; i < (NUM_INTERRUPTS + 1); i++) {
+    InterruptProfile_getStats(i, &stats);
+    if (stats.count == 0)
+      continue;
+
+    InterruptProfile_putNumber(moduleInstance, i, 3);
+    InterruptProfile_putNumber(moduleInstance, stats.count, 11);
+    InterruptProfile_putNumber(moduleInstance, stats.minCycles, 11);
+    InterruptProfile_putNumber(moduleInstance, stats.maxCycles, 11);
+    InterruptProfile_putNumber(moduleInstance, stats.meanCycles, 11);
+    InterruptProfile_putString(moduleInstance, "\r\n");
+  }
+
+  InterruptProfile_putString(moduleInstance, "max masked ");
+  InterruptProfile_putNumber(moduleInstance, InterruptProfile_maxMaskedCycles,
+                             0);
+  InterruptProfile_putString(moduleInstance, " cycles\r\n");
+}
+
+void InterruptProfile_maskStart(void) {
+  // PRIMASK and BASEPRI windows can nest, the outer one is timed
+  if (InterruptProfile_masked)
+    return;
+
+  InterruptProfile_maskStartCycles = DWT->CYCCNT;
+  InterruptProfile_masked          = true;
+}
+
+void InterruptProfile_maskEnd(void) {
+  uint32_t cycles;
+
+  if (!InterruptProfile_masked)
+    return;
+
+  cycles                  = DWT->CYCCNT - InterruptProfile_maskStartCycles;
+  InterruptProfile_masked = false;
+
+  if (cycles > InterruptProfile_maxMaskedCycles)
+    InterruptProfile_maxMaskedCycles = cycles;
+}
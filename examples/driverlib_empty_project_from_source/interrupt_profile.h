@@ -0,0 +1,214 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef INTERRUPT_PROFILE_H_
+#define INTERRUPT_PROFILE_H_
+
+//*****************************************************************************
+//
+//! \addtogroup interrupt_profile_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+
+//*****************************************************************************
+//
+// Interrupt execution-time profiler.
+//
+// Profiled vectors are redirected through a common wrapper in the SRAM vector
+// table. The wrapper timestamps entry and exit of the original handler with
+// the DWT cycle counter and accumulates the result in a fixed RAM table. The
+// measured time includes the wrapper call (a few cycles, constant) and any
+// higher priority interrupt that nested inside the handler.
+//
+// When driverlib is built with INTERRUPT_PROFILING defined,
+// Interrupt_disableMaster() and Interrupt_enableMaster() also record how long
+// PRIMASK stays set, and Interrupt_enterCritical() and
+// Interrupt_exitCritical() how long BASEPRI does, which covers the critical
+// sections of the flash, PCM and other drivers. A window opened by one and
+// nested in the other is timed from the first to open to the last to close.
+// Without the define those functions are unchanged.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \typedef InterruptProfile_Stats
+//! \brief Execution time of one interrupt, in MCLK cycles.
+//
+//*****************************************************************************
+typedef struct {
+  uint32_t count;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint32_t meanCycles;
+} InterruptProfile_Stats;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Starts the DWT cycle counter and clears all statistics.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void InterruptProfile_init(void);
+
+//*****************************************************************************
+//
+//! Starts profiling an interrupt.
+//!
+//! \param interruptNumber is the interrupt to profile, one of the \b INT_x
+//!        or \b FAULT_SYSTICK values from interrupt.h.
+//!
+//! The handler currently in the active vector table, whether bound at link
+//! time or registered at run time, is recorded and the vector is pointed at
+//! the profiling wrapper with \link Interrupt_registerInterrupt \endlink,
+//! which moves the vector table to SRAM. A handler registered for the same
+//! interrupt afterwards replaces the wrapper and ends profiling.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void InterruptProfile_attach(uint32_t interruptNumber);
+
+//*****************************************************************************
+//
+//! Stops profiling an interrupt and restores its original handler.
+//!
+//! \param interruptNumber is the interrupt passed to
+//!        \link InterruptProfile_attach \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void InterruptProfile_detach(uint32_t interruptNumber);
+
+//*****************************************************************************
+//
+//! Reads the statistics of an interrupt.
+//!
+//! \param interruptNumber is the interrupt in question.
+//!
+//! \param stats receives the statistics. \e minCycles is 0 if the interrupt
+//!        has not run yet.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void InterruptProfile_getStats(uint32_t                interruptNumber,
+                                      InterruptProfile_Stats *stats);
+
+//*****************************************************************************
+//
+//! Returns the longest time interrupts were masked by
+//! \link Interrupt_disableMaster \endlink or
+//! \link Interrupt_enterCritical \endlink, in MCLK cycles.
+//!
+//! Always 0 unless driverlib is built with \b INTERRUPT_PROFILING.
+//!
+//! \return Longest masked window since the last clear.
+//
+//*****************************************************************************
+extern uint32_t InterruptProfile_getMaxMaskedCycles(void);
+
+//*****************************************************************************
+//
+//! Clears all statistics without detaching any interrupt.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void InterruptProfile_clear(void);
+
+//*****************************************************************************
+//
+//! Prints the statistics over a UART.
+//!
+//! \param moduleInstance is the eUSCI_A module, already initialized and
+//!        enabled.
+//!
+//! One line is printed per interrupt that has run, followed by the longest
+//! masked window. Output is polled with \link UART_transmitData \endlink, so
+//! this should be called from the main loop.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void InterruptProfile_dump(uint32_t moduleInstance);
+
+//*****************************************************************************
+//
+//! \internal
+//! Hooks called by Interrupt_disableMaster(), Interrupt_enableMaster(),
+//! Interrupt_enterCritical() and Interrupt_exitCritical() when driverlib is
+//! built with \b INTERRUPT_PROFILING.
+//
+//*****************************************************************************
+extern void InterruptProfile_maskStart(void);
+extern void InterruptProfile_maskEnd(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* INTERRUPT_PROFILE_H_ */
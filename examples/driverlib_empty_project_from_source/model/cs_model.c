@@ -0,0 +1,522 @@
+/*
+ * Host model of the DCO frequency computations in cs.c
+ *
+ * Sweeps CS_getDCOFrequency and CS_setDCOFrequency against the floating
+ * point formulas of the datasheet, which cs.c computes in fixed point, for
+ * a range of device calibrations. Build and run with `make cs` in this
+ * directory.
+ *
+ * The CS registers are plain memory and the calibration is the TLV the
+ * model hands to SysCtl_A_getTLVInfo. cs.c is included rather than linked
+ * so that its calibration, loaded once on a device, can be reloaded for the
+ * next one. Each calibration is a constant K and an FCAL, the same for
+ * both resistors and both DCORSEL groups, tried with each resistor.
+ * Checked:
+ *  - for every tune of every DCORSEL range that puts the DCO within a
+ *    factor of two of its centre, CS_getDCOFrequency is within one tune
+ *    step of the formula
+ *  - from 1 to 64 MHz in 1 kHz steps, CS_setDCOFrequency picks the range
+ *    of the datasheet and a tune within one of the formula's
+ *  - where that tune fits the register, reading the frequency back gives
+ *    the one asked for to within two tune steps
+ *  - with no calibration, or one that gives no scale, the DCO stays at the
+ *    centre of its range
+ *  - the clock cache follows CTL0 written around the API, and interrupts
+ *    are never left masked
+ *  - for every source and divider of every clock and every DCO range, the
+ *    notifiers of the clocks that change get one preChange with the
+ *    frequencies the change comes to, then one postChange; the others get
+ *    nothing
+ *  - a change of several calls nested in CS_beginClockChange and
+ *    CS_endClockChange notifies once, around all of them, and one begun
+ *    with a wrong prediction reports the clocks it came to
+ *  - notifiers are added and removed in a critical section, and an
+ *    unregistered one is no longer called
+ */
+#include "../cs.c"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TUNE_MIN   -512 // the 10-bit signed DCOTUNE
+#define TUNE_MAX   511
+#define SWEEP_FROM 1000000
+#define SWEEP_TO   64000000
+#define SWEEP_STEP 1000
+
+typedef struct {
+  float    k;
+  uint32_t fcal;
+} calibration;
+
+static const float    constants[] = {0.0018f, 0.0060f, 0.0111f};
+static const uint32_t fcals[]     = {0, 200, 500, 768, 900, 1023};
+
+static const uint32_t centres[] = {1500000,  3000000,  6000000,
+                                   12000000, 24000000, 48000000};
+
+CS_Type model_cs;
+
+typedef struct {
+  CS_ClockNotifier notifier;
+  uint32_t         pres, posts;
+  CS_ClockChange   pre, post;
+} watcher;
+
+static SysCtl_A_CSCalTLV_Info tlv;
+static uint_fast8_t           tlvLength;
+static bool                   masked;
+static uint32_t               criticalDepth, criticals;
+static uint32_t               errors, reads, settings, changes;
+static double                 worst; // in tune steps
+static watcher                fast, slow;
+
+static void fail(const char *what, uint32_t value) {
+  if (errors++ < 10) {
+    printf("%s: %u\n", what, (unsigned)value);
+  }
+}
+
+// stand-ins for the rest of driverlib
+
+volatile uint32_t *model_bitband(volatile uint32_t *reg, int bit) {
+  static volatile uint32_t cell;
+
+  cell = (*reg >> bit) & 1;
+  return &cell;
+}
+
+void __error__(char *pcFilename, unsigned long line) {
+  if (errors++ < 10) {
+    printf("ASSERT at %s:%lu\n", pcFilename, line);
+  }
+}
+
+uint32_t CPU_cpsid(void) {
+  uint32_t was = masked;
+
+  masked = true;
+  return was;
+}
+
+uint32_t CPU_cpsie(void) {
+  uint32_t was = masked;
+
+  masked = false;
+  return was;
+}
+
+uint32_t Interrupt_enterCritical(uint8_t priorityMask) {
+  (void)priorityMask;
+  criticals++;
+  return criticalDepth++;
+}
+
+void Interrupt_exitCritical(uint32_t previousMask) {
+  if (criticalDepth-- != previousMask + 1) {
+    fail("critical sections unbalanced", previousMask);
+  }
+}
+void Interrupt_enableInterrupt(uint32_t interruptNumber) {
+  (void)interruptNumber;
+}
+void Interrupt_disableInterrupt(uint32_t interruptNumber) {
+  (void)interruptNumber;
+}
+void Interrupt_setPriority(uint32_t interruptNumber, uint8_t priority) {
+  (void)interruptNumber;
+  (void)priority;
+}
+void Interrupt_registerInterrupt(uint32_t interruptNumber,
+                                 void (*intHandler)(void)) {
+  (void)interruptNumber;
+  (void)intHandler;
+}
+void Interrupt_unregisterInterrupt(uint32_t interruptNumber) {
+  (void)interruptNumber;
+}
+
+void SysCtl_A_disableNMISource(uint_fast8_t flags) { (void)flags; }
+void SysCtl_A_enableNMISource(uint_fast8_t flags) { (void)flags; }
+uint_fast8_t SysCtl_A_getNMISourceStatus(void) { return 0; }
+
+void SysCtl_A_getTLVInfo(uint_fast8_t tag, uint_fast8_t instance,
+                         uint_fast8_t *length, uint32_t **data_address) {
+  if (tag != TLV_TAG_CS || instance != 0) {
+    fail("TLV tag", tag);
+  }
+  *length       = tlvLength;
+  *data_address = (uint32_t *)&tlv;
+}
+
+// the device
+
+static uint32_t bits(float k) {
+  uint32_t word;
+
+  memcpy(&word, &k, sizeof word);
+  return word;
+}
+
+static void load(const calibration *c) {
+  tlvLength                = c ? sizeof tlv / sizeof(uint32_t) : 0;
+  tlv.rDCOIR_CONSTK_RSEL04 = c ? bits(c->k) : 0;
+  tlv.rDCOIR_CONSTK_RSEL5  = c ? bits(c->k) : 0;
+  tlv.rDCOER_CONSTK_RSEL04 = c ? bits(c->k) : 0;
+  tlv.rDCOER_CONSTK_RSEL5  = c ? bits(c->k) : 0;
+  tlv.rDCOIR_FCAL_RSEL04   = c ? c->fcal : 0;
+  tlv.rDCOIR_FCAL_RSEL5    = c ? c->fcal : 0;
+  tlv.rDCOER_FCAL_RSEL04   = c ? c->fcal : 0;
+  tlv.rDCOER_FCAL_RSEL5    = c ? c->fcal : 0;
+
+  // a device with another calibration, straight out of reset
+  dcoCalLoaded = false;
+  memset(&model_cs, 0, sizeof model_cs);
+  model_cs.CTL0 = CS_CTL0_DCORSEL_1;
+  model_cs.CTL1 = CS_CTL1_SELM_3 | (CS_CTL1_SELM_3 << 4);
+  model_cs.STAT = 0x1F000000; // every clock ready
+}
+
+static void check_masked(void) {
+  if (masked) {
+    fail("interrupts left masked", model_cs.CTL0);
+    masked = false;
+  }
+}
+
+// the datasheet formulas, with S = 1 / K + 768 - FCAL
+
+static double formula_s(const calibration *c) {
+  return c ? 1.0 / c->k + 768.0 - c->fcal : 0;
+}
+
+static double formula_frequency(double centre, double s, int tune) {
+  return centre * s / (s - tune);
+}
+
+static int formula_tune(double f, double centre, double s) {
+  return (int)((f - centre) * s / f); // truncated toward zero
+}
+
+static int register_tune(uint32_t ctl0) {
+  int tune = ctl0 & 0x3FF;
+
+  return tune & 0x200 ? tune - 0x400 : tune;
+}
+
+static void sweep_get(const calibration *c, uint32_t resistor) {
+  double s = formula_s(c);
+
+  for (uint32_t range = 0; range < 6; range++) {
+    double centre = centres[range];
+
+    for (int tune = TUNE_MIN; tune <= TUNE_MAX; tune++) {
+      uint32_t f;
+
+      model_cs.CTL0 = resistor | (range << CS_CTL0_DCORSEL_OFS) |
+                      (tune & 0x3FF);
+      f = CS_getDCOFrequency();
+      check_masked();
+      reads++;
+
+      if (s <= 0) {
+        if (f != centre) {
+          fail("uncalibrated DCO off its centre", f);
+        }
+      } else if (tune >= -s && tune <= s / 2) {
+        double step = formula_frequency(centre, s, tune + 1) -
+                      formula_frequency(centre, s, tune);
+        double error = fabs(f - formula_frequency(centre, s, tune)) / step;
+
+        if (error > 1) {
+          fail("DCO frequency off the formula", f);
+        }
+        if (error > worst) {
+          worst = error;
+        }
+      }
+    }
+  }
+}
+
+static void sweep_set(const calibration *c, uint32_t resistor) {
+  double s = formula_s(c);
+
+  model_cs.CTL0 = resistor;
+  for (uint32_t f = SWEEP_FROM; f <= SWEEP_TO; f += SWEEP_STEP) {
+    uint32_t range = f < 2000000    ? 0
+                     : f < 4000000  ? 1
+                     : f < 8000000  ? 2
+                     : f < 16000000 ? 3
+                     : f < 32000000 ? 4
+                                    : 5;
+    double   centre = centres[range];
+    int      tune, expected;
+
+    CS_setDCOFrequency(f);
+    check_masked();
+    settings++;
+
+    tune     = register_tune(model_cs.CTL0);
+    expected = s > 0 ? formula_tune(f, centre, s) : 0;
+    if ((model_cs.CTL0 & CS_CTL0_DCORSEL_MASK) >> CS_CTL0_DCORSEL_OFS !=
+            range ||
+        (model_cs.CTL0 & CS_CTL0_DCORES) != resistor) {
+      fail("wrong range or resistor", f);
+    }
+    // a tune outside the register is cut down to it the way cs.c does
+    if (tune != register_tune(_CSTuneDCO(0, expected - 1)) &&
+        tune != register_tune(_CSTuneDCO(0, expected)) &&
+        tune != register_tune(_CSTuneDCO(0, expected + 1))) {
+      fail("DCO tune off the formula", f);
+    }
+
+    if (s > 0 && expected >= TUNE_MIN && expected < TUNE_MAX &&
+        expected >= -s && expected < s / 2) {
+      double step = formula_frequency(centre, s, expected + 1) -
+                    formula_frequency(centre, s, expected);
+
+      if (fabs((double)CS_getDCOFrequency() - f) > 2 * step) {
+        fail("DCO frequency read back off the one set", f);
+      }
+    }
+  }
+}
+
+// the notifiers
+
+static void record(watcher *w, bool post, const CS_ClockChange *change) {
+  if (criticalDepth != 0 || masked) {
+    fail("notifier called in a critical section", change->clocks);
+  }
+  if (!(change->clocks & w->notifier.clocks)) {
+    fail("notifier called for other clocks", change->clocks);
+  }
+  if (post) {
+    w->post = *change;
+    if (++w->posts != w->pres) {
+      fail("postChange without its preChange", w->posts);
+    }
+  } else {
+    w->pre = *change;
+    if (++w->pres != w->posts + 1) {
+      fail("preChange twice", w->pres);
+    }
+  }
+}
+
+static void fast_pre(const CS_ClockChange *change) {
+  record(&fast, false, change);
+}
+static void fast_post(const CS_ClockChange *change) {
+  record(&fast, true, change);
+}
+static void slow_pre(const CS_ClockChange *change) {
+  record(&slow, false, change);
+}
+static void slow_post(const CS_ClockChange *change) {
+  record(&slow, true, change);
+}
+
+static void current(CS_ClockFrequencies *f) {
+  f->mclk   = CS_getMCLK();
+  f->hsmclk = CS_getHSMCLK();
+  f->smclk  = CS_getSMCLK();
+  f->aclk   = CS_getACLK();
+  f->bclk   = CS_getBCLK();
+}
+
+static void check_same(const char *what, const CS_ClockFrequencies *a,
+                       const CS_ClockFrequencies *b) {
+  uint32_t clocks = _CSCompareClocks(a, b);
+
+  if (clocks) {
+    fail(what, clocks);
+  }
+}
+
+// One change, from the frequencies before to those now, that each watcher
+// saw from its counts at the start on
+static void check_watched(watcher *w, uint32_t pres,
+                          const CS_ClockFrequencies *before,
+                          const CS_ClockFrequencies *after) {
+  uint32_t changed = _CSCompareClocks(before, after) & w->notifier.clocks;
+
+  if (w->pres != pres + (changed != 0) || w->posts != w->pres) {
+    fail("notifier calls", changed);
+    return;
+  }
+  if (!changed) {
+    return;
+  }
+  if ((w->pre.clocks & changed) != changed ||
+      (w->post.clocks & changed) != changed) {
+    fail("changing clocks not reported", changed);
+  }
+  check_same("old frequencies", &w->pre.oldFrequency, before);
+  check_same("predicted frequencies", &w->pre.newFrequency, after);
+  check_same("reported frequencies", &w->post.newFrequency, after);
+}
+
+static void change_clock(uint32_t clock, uint32_t source, uint32_t divider) {
+  CS_ClockFrequencies before, after;
+  uint32_t            fastPres = fast.pres, slowPres = slow.pres;
+
+  current(&before);
+  CS_initClockSignal(clock, source, divider);
+  check_masked();
+  current(&after);
+  check_watched(&fast, fastPres, &before, &after);
+  check_watched(&slow, slowPres, &before, &after);
+  changes++;
+}
+
+static void sweep_notifiers(void) {
+  static const uint32_t sources[]  = {CS_VLOCLK_SELECT, CS_REFOCLK_SELECT,
+                                      CS_DCOCLK_SELECT, CS_MODOSC_SELECT};
+  static const uint32_t clocks[]   = {CS_MCLK, CS_HSMCLK, CS_SMCLK};
+  static const uint32_t dcoFreqs[] = {
+      CS_DCO_FREQUENCY_1_5, CS_DCO_FREQUENCY_3,  CS_DCO_FREQUENCY_6,
+      CS_DCO_FREQUENCY_12,  CS_DCO_FREQUENCY_24, CS_DCO_FREQUENCY_48};
+  CS_ClockFrequencies before, after, target;
+  uint32_t            ctl0, ctl1, fastPres, slowPres, entered;
+
+  load(&(calibration){0.0060f, 768});
+  fast.notifier = (CS_ClockNotifier){CS_MCLK | CS_HSMCLK | CS_SMCLK,
+                                     fast_pre, fast_post, NULL};
+  slow.notifier = (CS_ClockNotifier){CS_ACLK | CS_BCLK, slow_pre, slow_post,
+                                     NULL};
+  entered       = criticals;
+  CS_registerClockNotifier(&fast.notifier);
+  CS_registerClockNotifier(&slow.notifier);
+  if (criticals != entered + 2) {
+    fail("notifier registered outside a critical section", criticals);
+  }
+
+  // every source and divider of every clock, from every DCO range
+  for (size_t r = 0; r < sizeof dcoFreqs / sizeof dcoFreqs[0]; r++) {
+    fastPres = fast.pres;
+    slowPres = slow.pres;
+    current(&before);
+    CS_setDCOCenteredFrequency(dcoFreqs[r]);
+    current(&after);
+    check_watched(&fast, fastPres, &before, &after);
+    check_watched(&slow, slowPres, &before, &after);
+    changes++;
+
+    for (size_t c = 0; c < sizeof clocks / sizeof clocks[0]; c++) {
+      for (size_t s = 0; s < sizeof sources / sizeof sources[0]; s++) {
+        for (uint32_t d = 0; d < 8; d++) {
+          change_clock(clocks[c], sources[s], d << 28);
+        }
+      }
+    }
+    for (size_t s = 0; s < 2; s++) {
+      for (uint32_t d = 0; d < 8; d++) {
+        change_clock(CS_ACLK, sources[s], d << 28);
+      }
+    }
+  }
+
+  // several calls in one change: where they lead, done once unnested
+  ctl0 = model_cs.CTL0;
+  ctl1 = model_cs.CTL1;
+  CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_12);
+  CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_4);
+  CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_2);
+  current(&target);
+  model_cs.CTL0 = ctl0;
+  model_cs.CTL1 = ctl1;
+
+  fastPres = fast.pres;
+  slowPres = slow.pres;
+  current(&before);
+  CS_beginClockChange(&target);
+  if (fast.pres != fastPres + 1 || slow.pres != slowPres + 1) {
+    fail("preChange not called at the start of the change", fast.pres);
+  }
+  CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_12);
+  CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_beginClockChange(&target);
+  CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_4);
+  CS_endClockChange();
+  CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_2);
+  if (fast.posts != fastPres || slow.posts != slowPres) {
+    fail("postChange called inside the change", fast.posts);
+  }
+  CS_endClockChange();
+  current(&after);
+  check_same("nested change did not end where it did unnested", &after,
+             &target);
+  check_watched(&fast, fastPres, &before, &after);
+  check_watched(&slow, slowPres, &before, &after);
+  changes++;
+
+  // a change predicted wrong: the notifiers hear about the clocks it came to
+  model_cs.CTL0 = ctl0;
+  model_cs.CTL1 = ctl1;
+  fastPres      = fast.pres;
+  current(&before);
+  target.mclk = before.mclk;
+  CS_beginClockChange(&target);
+  CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_endClockChange();
+  current(&after);
+  if (fast.pres != fastPres + 1 || fast.posts != fast.pres ||
+      !(fast.post.clocks & CS_MCLK)) {
+    fail("mispredicted change not reported", fast.post.clocks);
+  }
+  check_same("mispredicted change reported wrong", &fast.post.newFrequency,
+             &after);
+  changes++;
+
+  // removed, the notifier hears nothing more
+  entered = criticals;
+  CS_unregisterClockNotifier(&fast.notifier);
+  if (criticals != entered + 1) {
+    fail("notifier unregistered outside a critical section", criticals);
+  }
+  fastPres = fast.pres;
+  CS_initClockSignal(CS_MCLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_2);
+  if (fast.pres != fastPres) {
+    fail("unregistered notifier called", fast.pres);
+  }
+  CS_unregisterClockNotifier(&slow.notifier);
+  if (clockNotifiers != NULL || criticalDepth != 0) {
+    fail("notifiers left registered", criticalDepth);
+  }
+}
+
+static void device(const calibration *c) {
+  load(c);
+  sweep_get(c, 0);
+  sweep_get(c, CS_CTL0_DCORES);
+  sweep_set(c, 0);
+  sweep_set(c, CS_CTL0_DCORES);
+}
+
+int main(void) {
+  uint32_t devices = 0;
+
+  // no calibration, and one whose S is negative
+  device(NULL);
+  device(&(calibration){0.03f, 1023});
+  devices += 2;
+
+  for (size_t i = 0; i < sizeof constants / sizeof constants[0]; i++) {
+    for (size_t j = 0; j < sizeof fcals / sizeof fcals[0]; j++) {
+      device(&(calibration){constants[i], fcals[j]});
+      devices++;
+    }
+  }
+  sweep_notifiers();
+
+  printf("%u devices, %u reads, %u settings, worst read %.3f of a tune "
+         "step, %u notified changes, %u errors\n",
+         (unsigned)devices, (unsigned)reads, (unsigned)settings, worst,
+         (unsigned)changes, (unsigned)errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,359 @@
+/*
+ * Host model of the background power state transitions in pcm.c
+ *
+ * Runs PCM_startPowerStateTransition and PCM_pollPowerStateTransition
+ * between every pair of active mode states on a simulated PCM. Build and run
+ * with `make pcm` in this directory.
+ *
+ * The PCM takes a request when PMR_BUSY is next read, the way the device
+ * sets it as the request is written, stays busy for a few polls and then
+ * moves to the requested state. It rejects the steps the device cannot
+ * take, the core voltage changing outside LDO mode or LF and DC-DC mode
+ * without LDO in between, and can be told to reject a step it would take or
+ * to have the DC-DC fail to start, falling back to LDO mode. Checked:
+ *  - every path up and down, through DC-DC and LF mode, reaches the target
+ *    and only takes steps the PCM accepts
+ *  - changeClocks runs once, before the first step when the target supports
+ *    less, otherwise when the target core voltage is reached outside LF
+ *    mode; the clocks are never left running in a state that does not
+ *    support them
+ *  - complete is told once, after changeClocks, whether the target was
+ *    reached; a rejected step or a DC-DC failure stops the transition there
+ *  - a start while a transition is pending or the PCM is busy is refused
+ *    without a callback, and a poll from within a step does nothing
+ */
+#include "../pcm.c"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROUNDS    100
+#define MAX_POLLS 1000
+
+#define VOLTAGE(state) PCM_STATE_VOLTAGE(state)
+#define MODE(state)    PCM_STATE_MODE(state)
+
+PCM_Type model_pcm;
+SCB_Type model_scb;
+
+static const uint8_t states[] = {PCM_AM_LDO_VCORE0,  PCM_AM_LDO_VCORE1,
+                                 PCM_AM_DCDC_VCORE0, PCM_AM_DCDC_VCORE1,
+                                 PCM_AM_LF_VCORE0,   PCM_AM_LF_VCORE1};
+
+static uint8_t  request;  // the last request the PCM took
+static uint8_t  stepTo;   // of the step under way
+static uint32_t busyFor;  // polls
+static uint32_t rejectAt; // request to reject, 0 for none
+static bool     dcdcFails;
+static uint32_t requests;
+static bool     failedStep; // rejected, or the DC-DC failed
+
+static uint8_t  to;       // of the transition under way
+static uint8_t  clocks;   // the state the clocks are set for
+static uint8_t  clocksAt; // the state changeClocks ran in
+static uint8_t  voltageAt; // the first state at the target voltage, not LF
+static uint32_t clockChanges, completions;
+static bool     succeeded;
+
+static uint32_t criticalDepth;
+static uint32_t errors, transitions, steps, rejects, dcdcFailures, refusals;
+
+static void fail(const char *what, uint32_t value) {
+  if (errors++ < 10) {
+    printf("%s: %u\n", what, (unsigned)value);
+  }
+}
+
+static uint8_t state(void) {
+  return (PCM->CTL0 & PCM_CTL0_CPM_MASK) >> PCM_CTL0_CPM_OFS;
+}
+
+static void set_state(uint8_t s) {
+  PCM->CTL0 = (PCM->CTL0 & ~(PCM_CTL0_CPM_MASK | PCM_CTL0_AMR_MASK)) |
+              (uint32_t)s << PCM_CTL0_CPM_OFS | s;
+  request = s;
+}
+
+// Whether the clocks set for one state may run in another: those for LF
+// mode in any, the others at the same core voltage or above, outside LF mode
+static bool supports(uint8_t s, uint8_t clocksFor) {
+  return MODE(clocksFor) == PCM_LF_MODE ||
+         (VOLTAGE(s) >= VOLTAGE(clocksFor) && MODE(s) != PCM_LF_MODE);
+}
+
+static bool can_step(uint8_t from, uint8_t next) {
+  if (VOLTAGE(from) != VOLTAGE(next)) {
+    return MODE(from) == PCM_LDO_MODE && MODE(next) == PCM_LDO_MODE;
+  }
+  return MODE(from) == PCM_LDO_MODE || MODE(next) == PCM_LDO_MODE;
+}
+
+// the PCM
+
+static void take_request(void) {
+  uint8_t amr = PCM->CTL0 & PCM_CTL0_AMR_MASK;
+
+  if (amr == request) {
+    return;
+  }
+  if (PCM->CTL1 & PCM_CTL1_PMR_BUSY) {
+    fail("PCM written while busy", amr);
+  }
+  if (clocks != to && VOLTAGE(state()) == VOLTAGE(to) &&
+      MODE(state()) != PCM_LF_MODE) {
+    fail("step taken before changing the clocks", amr);
+  }
+  requests++;
+
+  if (!can_step(state(), amr) || requests == rejectAt) {
+    if (requests != rejectAt) {
+      fail("step the PCM cannot take", amr);
+    }
+    PCM->IFG |= PCM_IE_AM_INVALID_TR_IE;
+    set_state(state());
+    failedStep = true;
+    rejects++;
+    return;
+  }
+
+  request = amr;
+  stepTo  = amr;
+  busyFor = 1 + rand() % 8;
+  PCM->CTL1 |= PCM_CTL1_PMR_BUSY;
+}
+
+// The end of a step: the requested state, or LDO mode if the DC-DC fails
+static void finish_step(void) {
+  PCM->CTL1 &= ~PCM_CTL1_PMR_BUSY;
+
+  if (MODE(stepTo) == PCM_DCDC_MODE && dcdcFails) {
+    PCM->IFG |= PCM_IE_DCDC_ERROR_IE;
+    set_state(stepTo & ~0x0C);
+    failedStep = true;
+    dcdcFailures++;
+    return;
+  }
+  set_state(stepTo);
+  steps++;
+
+  if (voltageAt == PCM_NO_STEP && VOLTAGE(state()) == VOLTAGE(to) &&
+      MODE(state()) != PCM_LF_MODE) {
+    voltageAt = state();
+  }
+}
+
+// One poll's worth of time
+static void run_pcm(void) {
+  PCM->IFG &= ~PCM->CLRIFG;
+  PCM->CLRIFG = 0;
+
+  if (!(PCM->CTL1 & PCM_CTL1_PMR_BUSY) || --busyFor) {
+    return;
+  }
+  finish_step();
+
+  if (!supports(state(), clocks)) {
+    fail("clocks running in a state that does not support them", state());
+  }
+}
+
+volatile uint32_t *model_bitband(volatile uint32_t *reg, int bit) {
+  static volatile uint32_t cell;
+
+  if (reg == &PCM->CTL1) {
+    take_request();
+  }
+  cell = (*reg >> bit) & 1;
+  return &cell;
+}
+
+// stand-ins for the rest of driverlib
+
+void __error__(char *pcFilename, unsigned long line) {
+  if (errors++ < 10) {
+    printf("ASSERT at %s:%lu\n", pcFilename, line);
+  }
+}
+
+uint32_t Interrupt_enterCritical(uint8_t priorityMask) {
+  (void)priorityMask;
+  return criticalDepth++;
+}
+
+void Interrupt_exitCritical(uint32_t previousMask) {
+  if (criticalDepth-- != previousMask + 1) {
+    fail("critical sections unbalanced", previousMask);
+  }
+}
+
+bool Interrupt_enableMaster(void) { return false; }
+bool Interrupt_disableMaster(void) { return false; }
+void Interrupt_enableInterrupt(uint32_t interruptNumber) {
+  (void)interruptNumber;
+}
+void Interrupt_disableInterrupt(uint32_t interruptNumber) {
+  (void)interruptNumber;
+}
+void Interrupt_registerInterrupt(uint32_t interruptNumber,
+                                 void (*intHandler)(void)) {
+  (void)interruptNumber;
+  (void)intHandler;
+}
+void Interrupt_unregisterInterrupt(uint32_t interruptNumber) {
+  (void)interruptNumber;
+}
+
+void CPU_wfi(void) {}
+void WDT_A_holdTimer(void) {}
+void RTC_C_holdClock(void) {}
+
+// the application
+
+static void change_clocks(void) {
+  uint32_t before = requests;
+
+  if (!supports(state(), clocks) || !supports(state(), to)) {
+    fail("clocks changed in a state that does not support both", state());
+  }
+  if (completions) {
+    fail("clocks changed after complete", to);
+  }
+  clocks   = to;
+  clocksAt = state();
+  clockChanges++;
+
+  // an interrupt polling in the middle of the step
+  if (rand() % 2) {
+    PCM_pollPowerStateTransition();
+    if (requests != before || (PCM->CTL0 & PCM_CTL0_AMR_MASK) != request) {
+      fail("poll stepped within a step", to);
+    }
+  }
+}
+
+static void completed(bool success) {
+  completions++;
+  succeeded = success;
+}
+
+// One transition, with the PCM failing it as told; false if it was refused
+static bool transition(uint8_t from, uint8_t target) {
+  PCM_Transition t = {target, change_clocks, completed};
+  bool           down, expected;
+  uint32_t       polls;
+
+  set_state(from);
+  to           = target;
+  clocks       = from;
+  clocksAt     = PCM_NO_STEP;
+  voltageAt    = PCM_NO_STEP;
+  clockChanges = 0;
+  completions  = 0;
+  requests     = 0;
+  failedStep   = false;
+
+  if (!PCM_startPowerStateTransition(&t)) {
+    fail("transition refused", from << 8 | target);
+    return false;
+  }
+  transitions++;
+
+  // a second one is refused, the first left alone
+  if (PCM_isPowerStateTransitionPending() && rand() % 8 == 0) {
+    PCM_Transition other = {states[rand() % 6], change_clocks, completed};
+
+    if (PCM_startPowerStateTransition(&other)) {
+      fail("second transition started", other.powerState);
+    }
+    refusals++;
+  }
+
+  for (polls = 0; PCM_isPowerStateTransitionPending() && polls < MAX_POLLS;
+       polls++) {
+    run_pcm();
+    for (int i = rand() % 3; i > 0; i--) {
+      PCM_pollPowerStateTransition();
+    }
+  }
+  while (PCM->CTL1 & PCM_CTL1_PMR_BUSY) {
+    run_pcm();
+  }
+
+  if (PCM_isPowerStateTransitionPending()) {
+    fail("transition never completed", from << 8 | target);
+    return true;
+  }
+  if (completions != 1) {
+    fail("complete not told once", completions);
+  }
+  if (criticalDepth != 0) {
+    fail("critical section left open", criticalDepth);
+  }
+
+  expected = !failedStep;
+  if (succeeded != expected || (state() == target) != expected) {
+    fail("outcome off the PCM", from << 8 | target);
+  }
+
+  // down: in the old state; up: in the first one at the new voltage
+  down = !(VOLTAGE(target) > VOLTAGE(from) ||
+           (MODE(from) == PCM_LF_MODE && MODE(target) != PCM_LF_MODE));
+  if (down) {
+    if (clockChanges != 1 || clocksAt != from) {
+      fail("clocks not changed before the first step", from << 8 | target);
+    }
+  } else if (clockChanges > 1 || clocksAt != voltageAt) {
+    fail("clocks not changed at the new voltage", from << 8 | target);
+  }
+  return true;
+}
+
+// A start while the PCM is busy with a change of its own
+static void busy_start(void) {
+  PCM_Transition t = {states[rand() % 6], change_clocks, completed};
+
+  set_state(PCM_AM_LDO_VCORE0);
+  to           = PCM_AM_LDO_VCORE0;
+  clocks       = PCM_AM_LDO_VCORE0;
+  clockChanges = 0;
+  completions  = 0;
+  requests     = 0;
+  rejectAt     = 0;
+
+  PCM->CTL0 = (PCM->CTL0 & ~PCM_CTL0_AMR_MASK) | PCM_AM_LDO_VCORE1;
+  take_request();
+  if (PCM_startPowerStateTransition(&t)) {
+    fail("transition started on a busy PCM", t.powerState);
+  }
+  if (clockChanges || completions || PCM_isPowerStateTransitionPending()) {
+    fail("refused transition ran", t.powerState);
+  }
+  refusals++;
+
+  while (PCM->CTL1 & PCM_CTL1_PMR_BUSY) {
+    run_pcm();
+  }
+}
+
+int main(void) {
+  srand(432);
+  PCM->CTL0 = PCM_KEY;
+
+  for (uint32_t round = 0; round < ROUNDS; round++) {
+    for (int f = 0; f < 6; f++) {
+      for (int t = 0; t < 6; t++) {
+        uint32_t pick = rand() % 4;
+
+        dcdcFails = pick == 2;
+        rejectAt  = pick == 3 ? 1 + rand() % 3 : 0;
+        transition(states[f], states[t]);
+      }
+    }
+    busy_start();
+  }
+
+  printf("%u transitions, %u steps, %u rejected, %u DC-DC failures, "
+         "%u refused, %u errors\n",
+         (unsigned)transitions, (unsigned)steps, (unsigned)rejects,
+         (unsigned)dcdcFailures, (unsigned)refusals, (unsigned)errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,341 @@
+/*
+ * Host model of the timing wheel in soft_timer.c
+ *
+ * Runs the service on a simulated Timer_A against a plain list of deadlines,
+ * with random starts, stops and restarts from the thread and from the
+ * callbacks. Build and run with `make soft_timer` in this directory.
+ *
+ * The counter jumps from one event to the next: the compare match, the
+ * interrupt taken up to LATENCY counts after it, or the next thread action,
+ * which may come in between. A timer may so expire up to LATENCY counts
+ * late, rounded up to ticks. The tick count starts below 2^32 so that it
+ * wraps during the run. Checked:
+ *  - every timer expires in the first interrupt at or after the tick it is
+ *    due, once per start or period, and never after it was stopped
+ *  - the compare register is never left past the next due timer
+ *  - delays beyond the reach of the wheel, 2^24 ticks, are placed again and
+ *    expire on time
+ *  - the interrupt comes at least once a second, so the 16-bit count never
+ *    wraps unseen, and SoftTimer_getTicks follows the counter
+ *  - SoftTimer_isActive agrees with the reference, and the critical
+ *    sections balance
+ */
+#include "../soft_timer.c"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TIMERS       32 // started and stopped at random
+#define FAR_TIMERS   8  // left alone, beyond the wheel
+#define COMPARE_REG  TIMER_A_CAPTURECOMPARE_REGISTER_3
+#define CCR_INDEX    3
+#define LATENCY      100  // counts, about three ticks
+#define SPACING      8192 // counts between thread actions, at most
+#define START        0xFE000000UL
+#define RUN_TICKS    (1UL << 26)
+#define MAX_INTERVAL (32768 + LATENCY) // counts between interrupts
+
+typedef struct {
+  SoftTimer_Timer timer;
+  bool            active;
+  uint32_t        due, period;
+  uint32_t        distance; // from the start or the last expiry
+} model_timer;
+
+uint32_t model_timer_a[4][0x100];
+
+static model_timer   timers[TIMERS + FAR_TIMERS];
+static Timer_A_Type *ta;
+static void          (*handler)(void);
+static uint64_t      counts;    // since SoftTimer_init
+static uint64_t      deliverAt; // of the pending interrupt
+static uint64_t      lastInterrupt;
+static uint32_t      criticalDepth;
+static uint32_t      errors, starts, stops, expiries, interrupts, longest;
+static uint32_t      farExpiries;
+
+static void fail(const char *what, uint32_t value) {
+  if (errors++ < 10) {
+    printf("%s: %u\n", what, (unsigned)value);
+  }
+}
+
+// stand-ins for the rest of driverlib
+
+void __error__(char *pcFilename, unsigned long line) {
+  if (errors++ < 10) {
+    printf("ASSERT at %s:%lu\n", pcFilename, line);
+  }
+}
+
+uint32_t Interrupt_enterCritical(uint8_t priorityMask) {
+  (void)priorityMask;
+  return criticalDepth++;
+}
+
+void Interrupt_exitCritical(uint32_t previousMask) {
+  if (criticalDepth-- != previousMask + 1) {
+    fail("critical sections unbalanced", previousMask);
+  }
+}
+
+void Interrupt_setPriority(uint32_t interruptNumber, uint8_t priority) {
+  (void)interruptNumber;
+  (void)priority;
+}
+
+uint32_t CS_getACLK(void) { return 32768; }
+
+void Timer_A_stopTimer(uint32_t timer) {
+  TIMER_A_CMSIS(timer)->CTL &= ~TIMER_A_CTL_MC_3;
+}
+
+void Timer_A_configureContinuousMode(uint32_t timer,
+                                     const Timer_A_ContinuousModeConfig *c) {
+  TIMER_A_CMSIS(timer)->CTL = c->clockSource | c->timerClear;
+  if (c->timerClear) {
+    TIMER_A_CMSIS(timer)->R = 0;
+  }
+}
+
+void Timer_A_enableCaptureCompareInterrupt(uint32_t      timer,
+                                           uint_fast16_t ccr) {
+  TIMER_A_CMSIS(timer)->CCTL[(ccr >> 1) - 1] |= TIMER_A_CCTLN_CCIE;
+}
+
+void Timer_A_registerInterrupt(uint32_t timer, uint_fast8_t interruptSelect,
+                               void (*intHandler)(void)) {
+  (void)timer;
+  if (interruptSelect != TIMER_A_CCRX_AND_OVERFLOW_INTERRUPT) {
+    fail("registered on TAx_0", interruptSelect);
+  }
+  handler = intHandler;
+}
+
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode) {
+  TIMER_A_CMSIS(timer)->CTL |= timerMode;
+}
+
+uint16_t Timer_A_getCounterValue(uint32_t timer) {
+  return TIMER_A_CMSIS(timer)->R;
+}
+
+// the reference
+
+static uint32_t now(void) { return START + (uint32_t)(counts / 32); }
+
+static uint32_t random_ticks(void) {
+  uint32_t pick = rand() % 100;
+
+  return pick < 50   ? rand() % 65
+         : pick < 75 ? rand() % 4097
+         : pick < 90 ? rand() % (1UL << 20)
+         : pick < 99 ? rand() % (1UL << 24)
+                     : (1UL << 24) + rand() % (3UL << 24);
+}
+
+static void start_with(model_timer *m, uint32_t delay, uint32_t period) {
+  SoftTimer_start(&m->timer, delay, period);
+  m->active   = true;
+  m->due      = now() + (delay ? delay : 1);
+  m->period   = period;
+  m->distance = delay;
+  starts++;
+}
+
+static void start(model_timer *m) {
+  start_with(m, random_ticks(), rand() % 2 ? 0 : 16 + random_ticks());
+}
+
+static void start_far(model_timer *m) {
+  start_with(m, SOFTTIMER_MAX_DELTA + rand() % (2 * SOFTTIMER_MAX_DELTA), 0);
+}
+
+static void stop(model_timer *m) {
+  SoftTimer_stop(&m->timer);
+  m->active = false;
+  stops++;
+}
+
+static void expired(void *arg) {
+  model_timer *m = arg;
+  uint32_t     late;
+
+  late = now() - m->due;
+  if (!m->active) {
+    fail("stopped timer expired", (uint32_t)(m - timers));
+  } else if ((int32_t)late < 0 || late > LATENCY / 32 + 1) {
+    fail("timer expired off its tick", late);
+  }
+  if (m->distance >= SOFTTIMER_MAX_DELTA) {
+    farExpiries++;
+  }
+  expiries++;
+
+  if (m->period) {
+    m->due += m->period;
+    m->distance = m->period;
+  } else {
+    m->active = false;
+  }
+
+  if (m >= &timers[TIMERS]) {
+    start_far(m);
+    return;
+  }
+
+  // a callback may start or stop any timer, itself included
+  switch (rand() % 8) {
+  case 0:
+    stop(m);
+    break;
+  case 1:
+    start(m);
+    break;
+  case 2:
+    start(&timers[rand() % TIMERS]);
+    break;
+  case 3:
+    stop(&timers[rand() % TIMERS]);
+    break;
+  }
+}
+
+static void check_state(void) {
+  for (int i = 0; i < TIMERS + FAR_TIMERS; i++) {
+    model_timer *m = &timers[i];
+
+    if (SoftTimer_isActive(&m->timer) != m->active) {
+      fail("SoftTimer_isActive off the reference", i);
+    }
+    // pending or due at or after the tick the compare register is set for
+    if (m->active && !(ta->CCTL[CCR_INDEX] & TIMER_A_CCTLN_CCIFG) &&
+        (int32_t)(m->due - SoftTimer_wake) < 0) {
+      fail("compare register past a due timer", i);
+    }
+  }
+  if (criticalDepth != 0) {
+    fail("critical section left open", criticalDepth);
+  }
+}
+
+static void interrupt(void) {
+  if (counts - lastInterrupt > MAX_INTERVAL) {
+    fail("interrupt came too late", (uint32_t)(counts - lastInterrupt));
+  }
+  if (counts - lastInterrupt > longest) {
+    longest = (uint32_t)(counts - lastInterrupt);
+  }
+  lastInterrupt = counts;
+  interrupts++;
+
+  handler();
+
+  for (int i = 0; i < TIMERS + FAR_TIMERS; i++) {
+    if (timers[i].active && (int32_t)(timers[i].due - now()) <= 0) {
+      fail("due timer left pending", i);
+    }
+  }
+  check_state();
+}
+
+static void thread_action(void) {
+  model_timer *m = &timers[rand() % TIMERS];
+
+  if (rand() % 4) {
+    start(m);
+  } else {
+    stop(m);
+  }
+  if (SoftTimer_getTicks() != now()) {
+    fail("SoftTimer_getTicks off the counter", SoftTimer_getTicks());
+  }
+  check_state();
+}
+
+// Moves the counter on by n counts, flagging a compare match on the way
+static void advance(uint64_t n) {
+  while (n) {
+    uint32_t toMatch = (uint16_t)(ta->CCR[CCR_INDEX] - ta->R);
+    uint32_t step;
+
+    if (toMatch == 0) {
+      toMatch = 0x10000;
+    }
+    step = n < toMatch ? (uint32_t)n : toMatch;
+    ta->R += step;
+    counts += step;
+    n -= step;
+    if (step == toMatch && !(ta->CCTL[CCR_INDEX] & TIMER_A_CCTLN_CCIFG)) {
+      ta->CCTL[CCR_INDEX] |= TIMER_A_CCTLN_CCIFG;
+      deliverAt = counts + rand() % (LATENCY + 1);
+    }
+  }
+}
+
+int main(void) {
+  uint64_t actionAt;
+
+  srand(432);
+
+  SoftTimer_init(TIMER_A1_BASE, COMPARE_REG);
+  ta = TIMER_A_CMSIS(TIMER_A1_BASE);
+  if (!(ta->CTL & TIMER_A_CTL_MC_2) || !(ta->CTL & TIMER_A_CTL_SSEL__ACLK) ||
+      !(ta->CCTL[CCR_INDEX] & TIMER_A_CCTLN_CCIE) || !handler) {
+    fail("Timer_A not set up", ta->CTL);
+  }
+
+  // a tick count about to wrap
+  SoftTimer_baseTick = START;
+  SoftTimer_tick     = START;
+  SoftTimer_program(START + SOFTTIMER_MAX_SLEEP);
+
+  for (int i = 0; i < TIMERS + FAR_TIMERS; i++) {
+    SoftTimer_create(&timers[i].timer, expired, &timers[i]);
+  }
+  for (int i = TIMERS; i < TIMERS + FAR_TIMERS; i++) {
+    start_far(&timers[i]);
+  }
+
+  actionAt = 1 + rand() % SPACING;
+  while (counts / 32 < RUN_TICKS) {
+    bool     pending = ta->CCTL[CCR_INDEX] & TIMER_A_CCTLN_CCIFG;
+    uint64_t next;
+
+    // pended by the driver itself, for a tick already begun
+    if (pending && deliverAt < counts) {
+      deliverAt = counts;
+    }
+    next = pending && deliverAt < actionAt ? deliverAt : actionAt;
+
+    if (!pending) {
+      uint32_t toMatch = (uint16_t)(ta->CCR[CCR_INDEX] - ta->R);
+
+      if (counts + (toMatch ? toMatch : 0x10000) <= next) {
+        advance(toMatch ? toMatch : 0x10000);
+        continue;
+      }
+    }
+    advance(next - counts);
+    if (pending && next == deliverAt) {
+      if (next != actionAt || rand() % 2) {
+        interrupt();
+        continue;
+      }
+    }
+    if (counts == actionAt) {
+      thread_action();
+      actionAt = counts + 1 + rand() % SPACING;
+    }
+  }
+
+  if (farExpiries == 0) {
+    fail("no timer beyond the wheel expired", 0);
+  }
+
+  printf("%u starts, %u stops, %u expiries (%u beyond the wheel), "
+         "%u interrupts, longest %u counts apart, %u errors\n",
+         (unsigned)starts, (unsigned)stops, (unsigned)expiries,
+         (unsigned)farExpiries, (unsigned)interrupts, (unsigned)longest,
+         (unsigned)errors);
+  return errors ? 1 : 0;
+}
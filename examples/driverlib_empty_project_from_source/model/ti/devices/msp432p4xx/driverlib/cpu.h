@@ -0,0 +1,2 @@
+/* The cpu.h of this project, for the host models */
+#include "../../../../../cpu.h"
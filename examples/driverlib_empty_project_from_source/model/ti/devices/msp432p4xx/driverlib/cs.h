@@ -0,0 +1,2 @@
+/* The cs.h of this project, for the host models */
+#include "../../../../../cs.h"
@@ -0,0 +1,2 @@
+/* The debug.h of this project, for the host models */
+#include "../../../../../debug.h"
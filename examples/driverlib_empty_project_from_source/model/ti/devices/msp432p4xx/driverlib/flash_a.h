@@ -0,0 +1,2 @@
+/* The flash_a.h of this project, for the host models */
+#include "../../../../../flash_a.h"
@@ -0,0 +1,2 @@
+/* The interrupt.h of this project, for the host models */
+#include "../../../../../interrupt.h"
@@ -0,0 +1,2 @@
+/* The pcm.h of this project, for the host models */
+#include "../../../../../pcm.h"
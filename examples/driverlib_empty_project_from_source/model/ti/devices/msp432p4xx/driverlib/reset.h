@@ -0,0 +1,2 @@
+/* The reset.h of this project, for the host models */
+#include "../../../../../reset.h"
@@ -0,0 +1,2 @@
+/* The rtc_c.h of this project, for the host models */
+#include "../../../../../rtc_c.h"
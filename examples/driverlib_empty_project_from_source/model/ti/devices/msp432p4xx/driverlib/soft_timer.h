@@ -0,0 +1,2 @@
+/* The soft_timer.h of this project, for the host models */
+#include "../../../../../soft_timer.h"
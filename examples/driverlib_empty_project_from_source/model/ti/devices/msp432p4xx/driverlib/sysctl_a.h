@@ -0,0 +1,2 @@
+/* The sysctl_a.h of this project, for the host models */
+#include "../../../../../sysctl_a.h"
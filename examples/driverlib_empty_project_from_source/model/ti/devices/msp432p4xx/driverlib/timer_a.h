@@ -0,0 +1,2 @@
+/* The timer_a.h of this project, for the host models */
+#include "../../../../../timer_a.h"
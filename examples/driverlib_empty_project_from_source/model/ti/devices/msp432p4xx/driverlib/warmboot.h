@@ -0,0 +1,2 @@
+/* The warmboot.h of this project, for the host models */
+#include "../../../../../warmboot.h"
@@ -0,0 +1,2 @@
+/* The wdt_a.h of this project, for the host models */
+#include "../../../../../wdt_a.h"
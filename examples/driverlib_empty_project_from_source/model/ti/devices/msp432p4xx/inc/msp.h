@@ -0,0 +1,242 @@
+/*
+ * Host stand-in for the parts of the MSP432P4111 device header that the
+ * modelled sources and the driverlib headers they include use, with the
+ * same names and values. The registers are plain memory the models set up
+ * and read.
+ */
+#ifndef MODEL_MSP_H_
+#define MODEL_MSP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define __MCU_HAS_SYSCTL_A__
+#define __MCU_HAS_FLCTL_A__
+
+typedef struct {
+  volatile uint32_t KEY;
+  volatile uint32_t CTL0;
+  volatile uint32_t CTL1;
+  volatile uint32_t CTL2;
+  volatile uint32_t CTL3;
+  volatile uint32_t CLKEN;
+  volatile uint32_t STAT;
+  volatile uint32_t IE;
+  volatile uint32_t IFG;
+  volatile uint32_t CLRIFG;
+  volatile uint32_t SETIFG;
+  volatile uint32_t DCOERCAL0;
+  volatile uint32_t DCOERCAL1;
+} CS_Type;
+
+extern CS_Type model_cs;
+#define CS (&model_cs)
+
+// the models run in thread mode
+static inline uint32_t __get_IPSR(void) { return 0; }
+
+// Reads give the bit, writes are dropped: on the paths the models run the
+// only bit-band writes lock the module
+extern volatile uint32_t *model_bitband(volatile uint32_t *reg, int bit);
+#define BITBAND_PERI(x, b) (*model_bitband(&(x), (b)))
+
+#define CS_KEY_KEY_OFS 0
+#define CS_KEY_VAL     0x0000695A
+
+#define CS_CTL0_DCORSEL_OFS  16
+#define CS_CTL0_DCORSEL_MASK 0x00070000
+#define CS_CTL0_DCORSEL_0    0x00000000
+#define CS_CTL0_DCORSEL_1    0x00010000
+#define CS_CTL0_DCORSEL_2    0x00020000
+#define CS_CTL0_DCORSEL_3    0x00030000
+#define CS_CTL0_DCORSEL_4    0x00040000
+#define CS_CTL0_DCORSEL_5    0x00050000
+#define CS_CTL0_DCORES_OFS   22
+#define CS_CTL0_DCORES       0x00400000
+#define CS_CTL0_DCOEN        0x00800000
+
+#define CS_CTL1_SELM_MASK  0x00000007
+#define CS_CTL1_SELM_0     0x00000000
+#define CS_CTL1_SELM_1     0x00000001
+#define CS_CTL1_SELM_2     0x00000002
+#define CS_CTL1_SELM_3     0x00000003
+#define CS_CTL1_SELM_4     0x00000004
+#define CS_CTL1_SELM_5     0x00000005
+#define CS_CTL1_SELS_MASK  0x00000070
+#define CS_CTL1_SELA_MASK  0x00000700
+#define CS_CTL1_SELB_OFS   12
+#define CS_CTL1_SELB       0x00001000
+#define CS_CTL1_DIVM_MASK  0x00070000
+#define CS_CTL1_DIVHS_MASK 0x00700000
+#define CS_CTL1_DIVA_MASK  0x07000000
+#define CS_CTL1_DIVS_MASK  0x70000000
+#define CS_CTL1_DIVS_0     0x00000000
+#define CS_CTL1_DIVS_1     0x10000000
+#define CS_CTL1_DIVS_2     0x20000000
+#define CS_CTL1_DIVS_3     0x30000000
+#define CS_CTL1_DIVS_4     0x40000000
+#define CS_CTL1_DIVS_5     0x50000000
+#define CS_CTL1_DIVS_6     0x60000000
+#define CS_CTL1_DIVS_7     0x70000000
+
+#define CS_CTL2_LFXTDRIVE_0    0x00000000
+#define CS_CTL2_LFXTDRIVE_1    0x00000001
+#define CS_CTL2_LFXTDRIVE_2    0x00000002
+#define CS_CTL2_LFXTDRIVE_3    0x00000003
+#define CS_CTL2_LFXT_EN_OFS    8
+#define CS_CTL2_LFXTBYPASS_OFS 9
+#define CS_CTL2_LFXTBYPASS     0x00000200
+#define CS_CTL2_HFXTDRIVE_OFS  16
+#define CS_CTL2_HFXTDRIVE      0x00010000
+#define CS_CTL2_HFXTFREQ_MASK  0x00700000
+#define CS_CTL2_HFXTFREQ_0     0x00000000
+#define CS_CTL2_HFXTFREQ_1     0x00100000
+#define CS_CTL2_HFXTFREQ_2     0x00200000
+#define CS_CTL2_HFXTFREQ_3     0x00300000
+#define CS_CTL2_HFXTFREQ_4     0x00400000
+#define CS_CTL2_HFXTFREQ_5     0x00500000
+#define CS_CTL2_HFXTFREQ_6     0x00600000
+#define CS_CTL2_HFXTBYPASS_OFS 24
+#define CS_CTL2_HFXTBYPASS     0x01000000
+#define CS_CTL2_HFXT_EN_OFS    25
+
+#define CS_CTL3_FCNTLF_MASK    0x00000003
+#define CS_CTL3_FCNTLF_0       0x00000000
+#define CS_CTL3_FCNTLF_1       0x00000001
+#define CS_CTL3_FCNTLF_2       0x00000002
+#define CS_CTL3_FCNTLF_3       0x00000003
+#define CS_CTL3_RFCNTLF_OFS    2
+#define CS_CTL3_RFCNTLF        0x00000004
+#define CS_CTL3_FCNTLF_EN_OFS  3
+#define CS_CTL3_FCNTLF_EN      0x00000008
+#define CS_CTL3_FCNTHF_MASK    0x00000030
+#define CS_CTL3_RFCNTHF_OFS    6
+#define CS_CTL3_RFCNTHF        0x00000040
+#define CS_CTL3_FCNTHF_EN_OFS  7
+#define CS_CTL3_FCNTHF_EN      0x00000080
+
+#define CS_CLKEN_ACLK_EN      0x00000001
+#define CS_CLKEN_MCLK_EN      0x00000002
+#define CS_CLKEN_HSMCLK_EN    0x00000004
+#define CS_CLKEN_SMCLK_EN     0x00000008
+#define CS_CLKEN_REFOFSEL_OFS 15
+#define CS_CLKEN_REFOFSEL     0x00008000
+
+#define CS_STAT_ACLK_READY_OFS   24
+#define CS_STAT_MCLK_READY_OFS   25
+#define CS_STAT_HSMCLK_READY_OFS 26
+#define CS_STAT_SMCLK_READY_OFS  27
+#define CS_STAT_BCLK_READY_OFS   28
+#define CS_STAT_BCLK_READY       0x10000000
+
+#define CS_IE_LFXTIE     0x00000001
+#define CS_IE_HFXTIE     0x00000002
+#define CS_IE_DCOR_OPNIE 0x00000040
+#define CS_IE_FCNTLFIE   0x00000100
+#define CS_IE_FCNTHFIE   0x00000200
+
+#define CS_IFG_LFXTIFG_OFS 0
+#define CS_IFG_LFXTIFG     0x00000001
+#define CS_IFG_HFXTIFG_OFS 1
+#define CS_IFG_HFXTIFG     0x00000002
+#define CS_IFG_DCOR_SHTIFG 0x00000020
+#define CS_IFG_FCNTLFIFG   0x00000100
+#define CS_IFG_FCNTHFIFG   0x00000200
+
+#define CS_CLRIFG_CLR_LFXTIFG_OFS 0
+#define CS_CLRIFG_CLR_LFXTIFG     0x00000001
+#define CS_CLRIFG_CLR_HFXTIFG_OFS 1
+#define CS_CLRIFG_CLR_HFXTIFG     0x00000002
+
+#define CS_DCOERCAL0_DCO_FCAL_RSEL04_OFS  16
+#define CS_DCOERCAL0_DCO_FCAL_RSEL04_MASK 0x03FF0000
+#define CS_DCOERCAL1_DCO_FCAL_RSEL5_MASK  0x000003FF
+
+// Timer_A instances 0x400 apart, as on the device. The driver passes their
+// addresses as uint32_t, which holds them in a model linked with -no-pie.
+typedef struct {
+  volatile uint16_t CTL;
+  volatile uint16_t CCTL[7];
+  volatile uint16_t R;
+  volatile uint16_t CCR[7];
+  volatile uint16_t EX0;
+  uint16_t          RESERVED0[6];
+  volatile uint16_t IV;
+} Timer_A_Type;
+
+extern uint32_t model_timer_a[4][0x100];
+#define TIMER_A0_BASE ((uint32_t)(uintptr_t)model_timer_a[0])
+#define TIMER_A1_BASE ((uint32_t)(uintptr_t)model_timer_a[1])
+#define TIMER_A2_BASE ((uint32_t)(uintptr_t)model_timer_a[2])
+#define TIMER_A3_BASE ((uint32_t)(uintptr_t)model_timer_a[3])
+
+#define TIMER_A_CTL_IE          0x0002
+#define TIMER_A_CTL_CLR         0x0004
+#define TIMER_A_CTL_MC_0        0x0000
+#define TIMER_A_CTL_MC_1        0x0010
+#define TIMER_A_CTL_MC_2        0x0020
+#define TIMER_A_CTL_MC_3        0x0030
+#define TIMER_A_CTL_SSEL__TACLK 0x0000
+#define TIMER_A_CTL_SSEL__ACLK  0x0100
+#define TIMER_A_CTL_SSEL__SMCLK 0x0200
+#define TIMER_A_CTL_SSEL__INCLK 0x0300
+#define TIMER_A_CCTLN_CCIFG     0x0001
+#define TIMER_A_CCTLN_CCIE      0x0010
+
+typedef struct {
+  volatile uint32_t CTL0;
+  volatile uint32_t CTL1;
+  volatile uint32_t IE;
+  volatile uint32_t IFG;
+  volatile uint32_t CLRIFG;
+} PCM_Type;
+
+extern PCM_Type model_pcm;
+#define PCM (&model_pcm)
+
+#define PCM_CTL0_AMR_MASK        0x0000000F
+#define PCM_CTL0_LPMR_MASK       0x000000F0
+#define PCM_CTL0_LPMR_10         0x000000A0
+#define PCM_CTL0_LPMR_12         0x000000C0
+#define PCM_CTL0_CPM_OFS         8
+#define PCM_CTL0_CPM_MASK        0x00003F00
+#define PCM_CTL0_KEY_MASK        0xFFFF0000
+#define PCM_CTL1_FORCE_LPM_ENTRY 0x00000004
+#define PCM_CTL1_PMR_BUSY_OFS    8
+#define PCM_CTL1_PMR_BUSY        0x00000100
+#define PCM_CTL1_KEY_VAL         0x695A0000
+
+#define PCM_IE_LPM_INVALID_TR_IE  0x00000001
+#define PCM_IE_LPM_INVALID_CLK_IE 0x00000002
+#define PCM_IE_AM_INVALID_TR_IE   0x00000004
+#define PCM_IE_DCDC_ERROR_IE      0x00000040
+
+typedef struct {
+  volatile uint32_t SCR;
+} SCB_Type;
+
+extern SCB_Type model_scb;
+#define SCB (&model_scb)
+
+#define SCB_SCR_SLEEPDEEP_Msk 0x00000004
+
+#define RSTCTL_PCMRESET_STAT_LPM35 0x00000004
+#define RSTCTL_PCMRESET_STAT_LPM45 0x00000008
+
+// SRAM as the models lay it out, low enough for uint32_t addresses
+typedef struct {
+  volatile uint32_t SRAM_NUMBLOCKS;
+} SYSCTL_A_Type;
+
+extern SYSCTL_A_Type model_sysctl_a;
+#define SYSCTL_A (&model_sysctl_a)
+
+extern uint32_t model_sram[];
+#define SRAM_BASE ((uint32_t)(uintptr_t)model_sram)
+
+#define SYSCTL_A_NMI_CTLSTAT_CS_SRC  0x00000001
+#define SYSCTL_A_NMI_CTLSTAT_PSS_SRC 0x00000002
+#define SYSCTL_A_NMI_CTLSTAT_PCM_SRC 0x00000004
+#define SYSCTL_A_NMI_CTLSTAT_PIN_SRC 0x00000008
+
+#endif // MODEL_MSP_H_
@@ -0,0 +1,311 @@
+/*
+ * Host model of the warm boot path in warmboot.c
+ *
+ * Saves a context from random register values, "resets" the device by
+ * putting everything back to its reset values, and restores. Build and run
+ * with `make warmboot` in this directory.
+ *
+ * The CS, PCM and peripheral registers are plain memory and the retained
+ * SRAM an array the model keeps through its resets. Checked:
+ *  - after an LPM3.5 wake the restore brings back the CS registers, the
+ *    listed 8, 16 and 32-bit registers, the power state and the wait states
+ *    of both banks, with the voltage and wait states up before the clocks
+ *  - it then clears the reset flags and releases the I/O, so a second
+ *    restore is refused
+ *  - a cold reset, an LPM4.5 wake, a register list of another length,
+ *    address or size, changed application state and any single bit flipped
+ *    in the context are refused without touching anything
+ *  - a save whose SRAM retention fails leaves no context to restore, and
+ *    retention is asked for exactly the context and the application state
+ */
+#include "../warmboot.c"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROUNDS     1000
+#define REGS       12 // listed, of the model peripheral's
+#define STATE_SIZE 40
+#define SRAM_WORDS 0x4000 // 64 KB, 32 blocks of 2 KB
+
+typedef struct {
+  volatile uint8_t  byte[4];
+  volatile uint16_t half[4];
+  volatile uint32_t word[4];
+} peripheral;
+
+typedef struct {
+  WarmBoot_Context context;
+  uint8_t          state[STATE_SIZE];
+} retained;
+
+CS_Type       model_cs;
+PCM_Type      model_pcm;
+SYSCTL_A_Type model_sysctl_a;
+uint32_t      model_sram[SRAM_WORDS];
+
+static peripheral        device;
+static WarmBoot_Register registers[REGS];
+static uint32_t          resetSource;
+static uint8_t           powerState;
+static uint32_t          waitStates[2];
+static bool              retentionFails;
+static uint32_t          retainedFrom[2], retainedTo[2], retentions;
+static uint32_t          errors, saves, restores, refusals;
+
+static void fail(const char *what, uint32_t value) {
+  if (errors++ < 10) {
+    printf("%s: %u\n", what, (unsigned)value);
+  }
+}
+
+// stand-ins for the rest of driverlib
+
+void __error__(char *pcFilename, unsigned long line) {
+  if (errors++ < 10) {
+    printf("ASSERT at %s:%lu\n", pcFilename, line);
+  }
+}
+
+uint32_t ResetCtl_getPCMSource(void) { return resetSource; }
+void     ResetCtl_clearPCMFlags(void) { resetSource = 0; }
+
+uint8_t PCM_getPowerState(void) { return powerState; }
+
+bool PCM_setPowerState(uint_fast8_t state) {
+  if (model_cs.CTL0 != 0 || model_cs.CTL1 != 0) {
+    fail("power state set after the clocks", state);
+  }
+  powerState = state;
+  return true;
+}
+
+uint32_t FlashCtl_A_getWaitState(uint32_t bank) { return waitStates[bank]; }
+
+void FlashCtl_A_setWaitState(uint32_t bank, uint32_t waitState) {
+  if (model_cs.CTL0 != 0 || model_cs.CTL1 != 0) {
+    fail("wait states set after the clocks", waitState);
+  }
+  waitStates[bank] = waitState;
+}
+
+uint_least32_t SysCtl_A_getSRAMSize(void) { return sizeof model_sram; }
+
+bool SysCtl_A_enableSRAMRetention(uint32_t startAddr, uint32_t endAddr) {
+  if (retentions < 2) {
+    retainedFrom[retentions] = startAddr;
+    retainedTo[retentions]   = endAddr;
+  }
+  retentions++;
+  return !retentionFails;
+}
+
+// the device
+
+static uint32_t random32(void) {
+  return (uint32_t)rand() << 16 ^ (uint32_t)rand();
+}
+
+// The registers as the application leaves them before shutting down
+static void configure(void) {
+  static const uint8_t states[] = {PCM_AM_LDO_VCORE0, PCM_AM_LDO_VCORE1,
+                                   PCM_AM_DCDC_VCORE0, PCM_AM_DCDC_VCORE1,
+                                   PCM_AM_LF_VCORE0, PCM_AM_LF_VCORE1};
+
+  for (int i = 0; i < 4; i++) {
+    device.byte[i] = (uint8_t)random32();
+    device.half[i] = (uint16_t)random32();
+    device.word[i] = random32();
+  }
+  model_cs.CTL0  = random32() | 1; // never the reset values
+  model_cs.CTL1  = random32() | 1;
+  model_cs.CTL2  = random32();
+  model_cs.CLKEN = random32();
+  powerState     = states[rand() % 6];
+  waitStates[0]  = rand() % 4;
+  waitStates[1]  = waitStates[0];
+}
+
+// What a wake from LPMx.5 leaves of it: the retained SRAM only
+static void reset(uint32_t source) {
+  memset((void *)&device, 0, sizeof device);
+  memset(&model_cs, 0, sizeof model_cs);
+  memset(&model_pcm, 0, sizeof model_pcm);
+  powerState    = PCM_AM_LDO_VCORE0;
+  waitStates[0] = 0;
+  waitStates[1] = 0;
+  resetSource   = source;
+}
+
+// A random list of the peripheral's registers, no two the same
+static void pick_registers(void) {
+  bool used[12] = {false};
+
+  for (int i = 0; i < REGS; i++) {
+    int r;
+
+    do {
+      r = rand() % 12;
+    } while (used[r]);
+    used[r] = true;
+
+    if (r < 4) {
+      registers[i] = (WarmBoot_Register)WARMBOOT_REGISTER(device.byte[r]);
+    } else if (r < 8) {
+      registers[i] = (WarmBoot_Register)WARMBOOT_REGISTER(device.half[r - 4]);
+    } else {
+      registers[i] = (WarmBoot_Register)WARMBOOT_REGISTER(device.word[r - 8]);
+    }
+  }
+}
+
+typedef struct {
+  peripheral device;
+  CS_Type    cs;
+  uint8_t    powerState;
+  uint32_t   waitStates[2];
+  uint32_t   resetSource;
+  uint32_t   pcmCtl1;
+} snapshot;
+
+static void take(snapshot *s) {
+  memcpy(&s->device, (const void *)&device, sizeof device);
+  memcpy(&s->cs, &model_cs, sizeof model_cs);
+  s->powerState    = powerState;
+  s->waitStates[0] = waitStates[0];
+  s->waitStates[1] = waitStates[1];
+  s->resetSource   = resetSource;
+  s->pcmCtl1       = model_pcm.CTL1;
+}
+
+static bool same(const snapshot *a, const snapshot *b) {
+  return !memcmp(&a->device, &b->device, sizeof a->device) &&
+         a->cs.CTL0 == b->cs.CTL0 && a->cs.CTL1 == b->cs.CTL1 &&
+         a->cs.CTL2 == b->cs.CTL2 && a->cs.CLKEN == b->cs.CLKEN &&
+         a->powerState == b->powerState &&
+         a->waitStates[0] == b->waitStates[0] &&
+         a->waitStates[1] == b->waitStates[1];
+}
+
+// A restore that must be refused, leaving everything as it was
+static void refuse(const char *what, retained *r,
+                   const WarmBoot_Register *list, uint_fast8_t count) {
+  snapshot before, after;
+
+  take(&before);
+  if (WarmBoot_restore(&r->context, list, count, r->state, STATE_SIZE)) {
+    fail(what, count);
+  }
+  take(&after);
+  if (!same(&before, &after) || after.resetSource != before.resetSource ||
+      after.pcmCtl1 != before.pcmCtl1) {
+    fail("refused restore touched the device", count);
+  }
+  refusals++;
+}
+
+static void round_trip(retained *r) {
+  WarmBoot_Register changed[REGS];
+  snapshot          saved, restored;
+  uint_fast8_t      wakeReason;
+  uint8_t           good[STATE_SIZE];
+
+  pick_registers();
+  configure();
+  for (int i = 0; i < STATE_SIZE; i++) {
+    r->state[i] = (uint8_t)rand();
+  }
+
+  retentions = 0;
+  if (!WarmBoot_save(&r->context, registers, REGS, r->state, STATE_SIZE)) {
+    fail("save failed", 0);
+  }
+  if (retentions != 2 ||
+      retainedFrom[0] != (uint32_t)(uintptr_t)&r->context ||
+      retainedTo[0] != retainedFrom[0] + sizeof r->context - 1 ||
+      retainedFrom[1] != (uint32_t)(uintptr_t)r->state ||
+      retainedTo[1] != retainedFrom[1] + STATE_SIZE - 1) {
+    fail("retention not asked for the context and state", retentions);
+  }
+  take(&saved);
+  saves++;
+
+  // wakes that must not restore
+  reset(0);
+  refuse("restored after a cold reset", r, registers, REGS);
+  reset(RESET_LPM45);
+  wakeReason = WarmBoot_getWakeReason();
+  if (wakeReason != WARMBOOT_LPM45) {
+    fail("LPM4.5 wake not seen", wakeReason);
+  }
+  refuse("restored after an LPM4.5 wake", r, registers, REGS);
+
+  // contexts that must not restore
+  reset(RESET_LPM35);
+  refuse("restored with a shorter list", r, registers, REGS - 1);
+  memcpy(changed, registers, sizeof changed);
+  changed[rand() % REGS].address += 4;
+  refuse("restored with another register", r, changed, REGS);
+  memcpy(changed, registers, sizeof changed);
+  changed[rand() % REGS].size ^= 6;
+  refuse("restored with another register size", r, changed, REGS);
+
+  memcpy(good, r->state, STATE_SIZE);
+  r->state[rand() % STATE_SIZE] ^= 1 << (rand() % 8);
+  refuse("restored with changed state", r, registers, REGS);
+  memcpy(r->state, good, STATE_SIZE);
+
+  for (size_t i = 0; i < sizeof r->context; i++) {
+    uint8_t *byte = (uint8_t *)&r->context + i;
+    uint8_t  bit  = 1 << (rand() % 8);
+
+    *byte ^= bit;
+    refuse("restored a corrupted context", r, registers, REGS);
+    *byte ^= bit;
+  }
+
+  // intact: restored, once
+  if (!WarmBoot_restore(&r->context, registers, REGS, r->state,
+                        STATE_SIZE)) {
+    fail("intact context not restored", saves);
+  }
+  take(&restored);
+  if (!same(&saved, &restored)) {
+    fail("restore did not bring the registers back", saves);
+  }
+  if (restored.resetSource != 0 || restored.pcmCtl1 != PCM_CTL1_KEY_VAL) {
+    fail("I/O not released", restored.pcmCtl1);
+  }
+  if (model_cs.KEY != 0 ||
+      model_cs.CLRIFG != (CS_CLRIFG_CLR_LFXTIFG | CS_CLRIFG_CLR_HFXTIFG)) {
+    fail("CS left unlocked or crystal faults kept", model_cs.KEY);
+  }
+  restores++;
+  refuse("restored twice", r, registers, REGS);
+
+  // no retention, no context
+  retentionFails = true;
+  configure();
+  if (WarmBoot_save(&r->context, registers, REGS, r->state, STATE_SIZE)) {
+    fail("save without retention succeeded", 0);
+  }
+  retentionFails = false;
+  reset(RESET_LPM35);
+  refuse("restored a context saved without retention", r, registers, REGS);
+}
+
+int main(void) {
+  retained *r;
+
+  srand(432);
+  model_sysctl_a.SRAM_NUMBLOCKS = 32;
+  r = (retained *)model_sram;
+
+  for (uint32_t round = 0; round < ROUNDS; round++) {
+    round_trip(r);
+  }
+
+  printf("%u saves, %u restores, %u refusals, %u errors\n", (unsigned)saves,
+         (unsigned)restores, (unsigned)refusals, (unsigned)errors);
+  return errors ? 1 : 0;
+}
@@ -352,6 +352,113 @@ bool PCM_setPowerStateNonBlocking(uint_fast8_t powerState) {
   return __PCM_setPowerStateAdvanced(powerState, 0, false);
 }
 
+/* The active mode states encode the core voltage in bit 0 and the power
+ * mode in bits 2 and 3 */
+#define PCM_STATE_VOLTAGE(state) ((state)&0x01)
+#define PCM_STATE_MODE(state)    (((state) >> 2) & 0x03)
+
+#define PCM_NO_STEP 0xFF
+
+static PCM_Transition PCM_transition;
+static volatile bool  PCM_transitionPending;
+static volatile bool  PCM_transitionStepping;
+static bool           PCM_transitionClocksAfter;
+static uint8_t        PCM_transitionFrom; /* state before the last step */
+
+static void __PCM_finishTransition(bool success) {
+  void (*complete)(bool success) = PCM_transition.complete;
+
+  PCM_transitionPending = false;
+  if (complete)
+    complete(success);
+}
+
+static void __PCM_stepTransition(void) {
+  uint_fast8_t state   = PCM_getPowerState();
+  uint_fast8_t voltage = PCM_STATE_VOLTAGE(PCM_transition.powerState);
+
+  /* The PCM ignores a step it cannot take, and falls back to LDO mode when
+   * the DC-DC fails to start */
+  if (state == PCM_transitionFrom) {
+    __PCM_finishTransition(false);
+    return;
+  }
+
+  if (PCM_transitionClocksAfter && PCM_getCoreVoltageLevel() == voltage &&
+      PCM_getPowerMode() != PCM_LF_MODE) {
+    PCM_transitionClocksAfter = false;
+    if (PCM_transition.changeClocks)
+      PCM_transition.changeClocks();
+  }
+
+  if (state == PCM_transition.powerState) {
+    __PCM_finishTransition(true);
+    return;
+  }
+
+  /* One step, the same ones PCM_setPowerState takes */
+  PCM_transitionFrom = state;
+  if (PCM_getCoreVoltageLevel() != voltage)
+    PCM_setCoreVoltageLevelNonBlocking(voltage);
+  else
+    PCM_setPowerModeNonBlocking(PCM_STATE_MODE(PCM_transition.powerState));
+}
+
+bool PCM_startPowerStateTransition(const PCM_Transition *transition) {
+  uint_fast8_t state = PCM_getPowerState();
+  uint_fast8_t to    = transition->powerState;
+  uint32_t     mask;
+
+  ASSERT(to == PCM_AM_LDO_VCORE0 || to == PCM_AM_LDO_VCORE1 ||
+         to == PCM_AM_DCDC_VCORE0 || to == PCM_AM_DCDC_VCORE1 ||
+         to == PCM_AM_LF_VCORE0 || to == PCM_AM_LF_VCORE1);
+
+  mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  if (PCM_transitionPending || BITBAND_PERI(PCM->CTL1, PCM_CTL1_PMR_BUSY_OFS)) {
+    Interrupt_exitCritical(mask);
+    return false;
+  }
+  PCM_transitionPending  = true;
+  PCM_transitionStepping = true;
+  Interrupt_exitCritical(mask);
+
+  PCM_transition     = *transition;
+  PCM_transitionFrom = PCM_NO_STEP;
+
+  /* Clocks go up once the state supports them, down before it stops */
+  PCM_transitionClocksAfter =
+      PCM_STATE_VOLTAGE(to) > PCM_STATE_VOLTAGE(state) ||
+      (PCM_STATE_MODE(state) == PCM_LF_MODE &&
+       PCM_STATE_MODE(to) != PCM_LF_MODE);
+  if (!PCM_transitionClocksAfter && PCM_transition.changeClocks)
+    PCM_transition.changeClocks();
+
+  __PCM_stepTransition();
+  PCM_transitionStepping = false;
+
+  return true;
+}
+
+void PCM_pollPowerStateTransition(void) {
+  uint32_t mask = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+
+  /* A failed step is picked up from the state, the flags only woke us */
+  PCM_clearInterruptFlag(PCM_AM_INVALIDTRANSITION | PCM_DCDCERROR);
+
+  if (!PCM_transitionPending || PCM_transitionStepping ||
+      BITBAND_PERI(PCM->CTL1, PCM_CTL1_PMR_BUSY_OFS)) {
+    Interrupt_exitCritical(mask);
+    return;
+  }
+  PCM_transitionStepping = true;
+  Interrupt_exitCritical(mask);
+
+  __PCM_stepTransition();
+  PCM_transitionStepping = false;
+}
+
+bool PCM_isPowerStateTransitionPending(void) { return PCM_transitionPending; }
+
 bool PCM_shutdownDevice(uint32_t shutdownMode) {
   uint32_t shutdownModeBits =
       (shutdownMode == PCM_LPM45) ? PCM_CTL0_LPMR_12 : PCM_CTL0_LPMR_10;
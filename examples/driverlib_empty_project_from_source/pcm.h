@@ -94,6 +94,19 @@ extern "C" {
 #define PCM_SM_INVALIDCLOCK      PCM_IE_LPM_INVALID_CLK_IE
 #define PCM_SM_INVALIDTRANSITION PCM_IE_LPM_INVALID_TR_IE
 
+//*****************************************************************************
+//
+//! \typedef PCM_Transition
+//! \brief An active mode power state change done in the background, see
+//! \link PCM_startPowerStateTransition \endlink.
+//
+//*****************************************************************************
+typedef struct _PCM_Transition {
+  uint_fast8_t powerState; /* PCM_AM_x */
+  void (*changeClocks)(void);
+  void (*complete)(bool success);
+} PCM_Transition;
+
 //*****************************************************************************
 //
 // Prototypes for the APIs.
@@ -392,6 +405,66 @@ extern uint8_t PCM_getPowerState(void);
 //******************************************************************************
 extern bool PCM_setPowerStateNonBlocking(uint_fast8_t powerState);
 
+//******************************************************************************
+//
+//! Starts changing the active mode power state in the background.
+//!
+//! \param transition is the change, copied:
+//!     - \e powerState is the active mode state to go to, one of the
+//!       \b PCM_AM_ values
+//!     - \e changeClocks, or 0, changes the clocks to what the new state is
+//!       for. It is called at the step where both the old and new clocks are
+//!       supported: before the first step when the new state supports less
+//!       (a lower core voltage, or low frequency mode), otherwise as soon as
+//!       the new core voltage is reached, before any remaining power mode
+//!       step.
+//!     - \e complete, or 0, is told whether the state was reached
+//!
+//! Like \link PCM_setPowerState \endlink the change goes through LDO mode
+//! when the core voltage changes, one step at a time, but each step is
+//! started with the NonBlocking variants and picked up when it is done by
+//! \link PCM_pollPowerStateTransition \endlink, so interrupts keep being
+//! serviced during the tens to hundreds of microseconds a step takes.
+//!
+//! If a step fails, the change stops there and \e complete is told false.
+//! Clocks already changed stay changed, and clocks that were to go up
+//! once the core voltage was reached are not changed.
+//!
+//! \return false if a transition is already under way, or the PCM is busy
+//!         with a change of its own; nothing was started.
+//
+//******************************************************************************
+extern bool PCM_startPowerStateTransition(const PCM_Transition *transition);
+
+//******************************************************************************
+//
+//! Moves the transition started by \link PCM_startPowerStateTransition
+//! \endlink on once its current step is done.
+//!
+//! The PCM raises no interrupt when a step completes, only when one fails
+//! (\b PCM_AM_INVALIDTRANSITION, \b PCM_DCDCERROR). Call this function from
+//! a periodic interrupt or the main loop, and, for failures to be reported
+//! at once, from the PCM interrupt with those two enabled. \e changeClocks
+//! and \e complete run from the context of the call that gets there.
+//!
+//! A call made while another is running, from an interrupt that preempted
+//! it, returns at once; the transition only moves on at the next call.
+//!
+//! \return None.
+//
+//******************************************************************************
+extern void PCM_pollPowerStateTransition(void);
+
+//******************************************************************************
+//
+//! Returns whether a transition started by \link
+//! PCM_startPowerStateTransition \endlink is still under way.
+//!
+//! \return true until its \e complete callback has been called.
+//
+//******************************************************************************
+extern bool PCM_isPowerStateTransitionPending(void);
+
 //******************************************************************************
 //
 //! Transitions the device into LPM3.5/LPM4.5 mode.
@@ -476,18 +476,11 @@
 // Macros for the CS API.
 //
 //*****************************************************************************
-#ifdef ROM_CS_initClockSignal
-#define MAP_CS_initClockSignal ROM_CS_initClockSignal
-#else
+/* The clock changing functions always run from flash, the ROM versions
+ * would not call the clock change notifiers */
 #define MAP_CS_initClockSignal CS_initClockSignal
-#endif
-#ifdef ROM_CS_setReferenceOscillatorFrequency
-#define MAP_CS_setReferenceOscillatorFrequency                                 \
-  ROM_CS_setReferenceOscillatorFrequency
-#else
 #define MAP_CS_setReferenceOscillatorFrequency                                 \
   CS_setReferenceOscillatorFrequency
-#endif
 #ifdef ROM_CS_enableClockRequest
 #define MAP_CS_enableClockRequest ROM_CS_enableClockRequest
 #else
@@ -498,26 +491,10 @@
 #else
 #define MAP_CS_disableClockRequest CS_disableClockRequest
 #endif
-#ifdef ROM_CS_setDCOCenteredFrequency
-#define MAP_CS_setDCOCenteredFrequency ROM_CS_setDCOCenteredFrequency
-#else
 #define MAP_CS_setDCOCenteredFrequency CS_setDCOCenteredFrequency
-#endif
-#ifdef ROM_CS_tuneDCOFrequency
-#define MAP_CS_tuneDCOFrequency ROM_CS_tuneDCOFrequency
-#else
 #define MAP_CS_tuneDCOFrequency CS_tuneDCOFrequency
-#endif
-#ifdef ROM_CS_enableDCOExternalResistor
-#define MAP_CS_enableDCOExternalResistor ROM_CS_enableDCOExternalResistor
-#else
 #define MAP_CS_enableDCOExternalResistor CS_enableDCOExternalResistor
-#endif
-#ifdef ROM_CS_disableDCOExternalResistor
-#define MAP_CS_disableDCOExternalResistor ROM_CS_disableDCOExternalResistor
-#else
 #define MAP_CS_disableDCOExternalResistor CS_disableDCOExternalResistor
-#endif
 #ifdef ROM_CS_enableInterrupt
 #define MAP_CS_enableInterrupt ROM_CS_enableInterrupt
 #else
@@ -538,16 +515,10 @@
 #else
 #define MAP_CS_getInterruptStatus CS_getInterruptStatus
 #endif
-#ifdef ROM_CS_setDCOFrequency
-#define MAP_CS_setDCOFrequency ROM_CS_setDCOFrequency
-#else
 #define MAP_CS_setDCOFrequency CS_setDCOFrequency
-#endif
-#ifdef ROM_CS_getDCOFrequency
-#define MAP_CS_getDCOFrequency ROM_CS_getDCOFrequency
-#else
+/* The ROM version recomputes the frequency on every call instead of
+ * using the cached one */
 #define MAP_CS_getDCOFrequency CS_getDCOFrequency
-#endif
 #ifdef ROM_CS_enableFaultCounter
 #define MAP_CS_enableFaultCounter ROM_CS_enableFaultCounter
 #else
@@ -628,13 +599,8 @@
 #else
 #define MAP_CS_startLFXTWithTimeout CS_startLFXTWithTimeout
 #endif
-#ifdef ROM_CS_setExternalClockSourceFrequency
-#define MAP_CS_setExternalClockSourceFrequency                                 \
-  ROM_CS_setExternalClockSourceFrequency
-#else
 #define MAP_CS_setExternalClockSourceFrequency                                 \
   CS_setExternalClockSourceFrequency
-#endif
 #ifdef ROM_CS_setDCOExternalResistorCalibration
 #define MAP_CS_setDCOExternalResistorCalibration                               \
   ROM_CS_setDCOExternalResistorCalibration
@@ -0,0 +1,358 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/cs.h>
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#include <ti/devices/msp432p4xx/driverlib/soft_timer.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+#define SOFTTIMER_COUNTS_PER_TICK 32
+#define SOFTTIMER_LEVELS          4
+#define SOFTTIMER_SLOT_BITS       6
+#define SOFTTIMER_SLOTS           (1 << SOFTTIMER_SLOT_BITS)
+#define SOFTTIMER_SLOT_MASK       (SOFTTIMER_SLOTS - 1)
+#define SOFTTIMER_MAX_DELTA                                                    \
+  (1UL << (SOFTTIMER_LEVELS * SOFTTIMER_SLOT_BITS))
+
+// Longest the compare register is left, well inside the 2048 ticks the
+// 16-bit count takes to wrap
+#define SOFTTIMER_MAX_SLEEP SOFTTIMER_TICKS_PER_SECOND
+
+// Level of a timer taken off the wheel by the interrupt, about to expire
+#define SOFTTIMER_LEVEL_EXPIRING SOFTTIMER_LEVELS
+
+static Timer_A_Type *SoftTimer_timer;
+static uint_fast8_t  SoftTimer_ccr;
+
+// The tick count is extended from the 16-bit Timer_A count: baseCount is
+// the count at the start of tick baseTick, moved up by the interrupt
+static uint16_t SoftTimer_baseCount;
+static uint32_t SoftTimer_baseTick;
+
+// Next tick to process. The slots of each level are indexed by the expiry
+// ticks of their timers, relative to it.
+static uint32_t         SoftTimer_tick;
+static SoftTimer_Timer *SoftTimer_wheel[SOFTTIMER_LEVELS][SOFTTIMER_SLOTS];
+static uint32_t         SoftTimer_pending[SOFTTIMER_LEVELS];
+
+// The compare register is set for this tick. Nothing is due before it.
+static uint32_t SoftTimer_wake;
+
+static uint32_t SoftTimer_now(void) {
+  uint16_t count = Timer_A_getCounterValue((uint32_t)SoftTimer_timer);
+
+  return SoftTimer_baseTick +
+         (uint16_t)(count - SoftTimer_baseCount) / SOFTTIMER_COUNTS_PER_TICK;
+}
+
+static void SoftTimer_link(SoftTimer_Timer **head, SoftTimer_Timer *softTimer) {
+  softTimer->next = *head;
+  if (*head)
+    (*head)->pprev = &softTimer->next;
+  *head            = softTimer;
+  softTimer->pprev = head;
+}
+
+static void SoftTimer_unlink(SoftTimer_Timer *softTimer) {
+  *softTimer->pprev = softTimer->next;
+  if (softTimer->next)
+    softTimer->next->pprev = softTimer->pprev;
+  softTimer->pprev = NULL;
+
+  if (softTimer->level < SOFTTIMER_LEVELS)
+    SoftTimer_pending[softTimer->level]--;
+}
+
+// Returns the tick at which the timer needs the interrupt next: when it
+// expires on level 0, when its slot is moved down otherwise
+static uint32_t SoftTimer_insert(SoftTimer_Timer *softTimer) {
+  uint32_t     expires = softTimer->expires;
+  uint32_t     delta   = expires - SoftTimer_tick;
+  uint_fast8_t level;
+
+  // Overdue timers go in the slot processed next. Those too far out for
+  // the wheel go as far as it reaches and are placed again from there.
+  if ((int32_t)delta < 0) {
+    expires = SoftTimer_tick;
+    delta   = 0;
+  } else if (delta >= SOFTTIMER_MAX_DELTA) {
+    delta   = SOFTTIMER_MAX_DELTA - 1;
+    expires = SoftTimer_tick + delta;
+  }
+
+  level = 0;
+  while (delta >> (SOFTTIMER_SLOT_BITS * (level + 1)))
+    level++;
+
+  softTimer->level = level;
+  SoftTimer_pending[level]++;
+  SoftTimer_link(&SoftTimer_wheel[level][(expires >>
+                                          (SOFTTIMER_SLOT_BITS * level)) &
+                                         SOFTTIMER_SLOT_MASK],
+                 softTimer);
+
+  return expires & ~((1UL << (SOFTTIMER_SLOT_BITS * level)) - 1);
+}
+
+// Moves the timers of a slot down the wheel, returns the slot index
+static uint_fast8_t SoftTimer_cascade(uint_fast8_t level) {
+  uint_fast8_t     index;
+  SoftTimer_Timer *softTimer;
+
+  index = (SoftTimer_tick >> (SOFTTIMER_SLOT_BITS * level)) &
+          SOFTTIMER_SLOT_MASK;
+
+  while ((softTimer = SoftTimer_wheel[level][index]) != NULL) {
+    SoftTimer_unlink(softTimer);
+    SoftTimer_insert(softTimer);
+  }
+
+  return index;
+}
+
+// True if a level above 0 has timers to move down at the start of tick,
+// which must be on a slot boundary of level 0
+static bool SoftTimer_cascadeDue(uint32_t tick) {
+  uint_fast8_t level, index;
+
+  for (level = 1; level < SOFTTIMER_LEVELS; level++) {
+    index = (tick >> (SOFTTIMER_SLOT_BITS * level)) & SOFTTIMER_SLOT_MASK;
+    if (SoftTimer_wheel[level][index])
+      return true;
+    if (index)
+      break;
+  }
+
+  return false;
+}
+
+// First tick from SoftTimer_tick with a level 0 slot to expire or a cascade
+// to do, no further than limit
+static uint32_t SoftTimer_nextEvent(uint32_t limit) {
+  uint32_t tick = SoftTimer_tick;
+
+  // Level 0 only holds timers for the next SOFTTIMER_SLOTS ticks
+  if (SoftTimer_pending[0]) {
+    for (; tick != SoftTimer_tick + SOFTTIMER_SLOTS; tick++) {
+      if ((int32_t)(tick - limit) >= 0)
+        return limit;
+      if (!(tick & SOFTTIMER_SLOT_MASK) && SoftTimer_cascadeDue(tick))
+        return tick;
+      if (SoftTimer_wheel[0][tick & SOFTTIMER_SLOT_MASK])
+        return tick;
+    }
+  }
+
+  // From there on only the cascades, on level 0 slot boundaries
+  tick = (tick + SOFTTIMER_SLOT_MASK) & ~(uint32_t)SOFTTIMER_SLOT_MASK;
+  for (; (int32_t)(tick - limit) < 0; tick += SOFTTIMER_SLOTS) {
+    if (SoftTimer_cascadeDue(tick))
+      return tick;
+  }
+
+  return limit;
+}
+
+// Sets the compare register for the start of tick wake, or pends the
+// interrupt if that has already passed
+static void SoftTimer_program(uint32_t wake) {
+  uint_fast8_t index = SoftTimer_ccr;
+
+  SoftTimer_wake = wake;
+  SoftTimer_timer->CCR[index] =
+      SoftTimer_baseCount +
+      (uint16_t)((wake - SoftTimer_baseTick) * SOFTTIMER_COUNTS_PER_TICK);
+
+  if ((int32_t)(SoftTimer_now() - wake) >= 0)
+    SoftTimer_timer->CCTL[index] |= TIMER_A_CCTLN_CCIFG;
+}
+
+void SoftTimer_init(uint32_t timer, uint_fast16_t compareRegister) {
+  const Timer_A_ContinuousModeConfig continuousConfig = {
+      TIMER_A_CLOCKSOURCE_ACLK, TIMER_A_CLOCKSOURCE_DIVIDER_1,
+      TIMER_A_TAIE_INTERRUPT_DISABLE, TIMER_A_DO_CLEAR};
+  uint_fast8_t instance, level, index;
+
+  ASSERT(timer == TIMER_A0_BASE || timer == TIMER_A1_BASE ||
+         timer == TIMER_A2_BASE || timer == TIMER_A3_BASE);
+  ASSERT(compareRegister >= TIMER_A_CAPTURECOMPARE_REGISTER_0 &&
+         compareRegister <= TIMER_A_CAPTURECOMPARE_REGISTER_6);
+  ASSERT(CS_getACLK() == 32768);
+
+  instance = (timer - TIMER_A0_BASE) >> 10;
+
+  Timer_A_stopTimer(timer);
+
+  SoftTimer_timer     = TIMER_A_CMSIS(timer);
+  SoftTimer_ccr       = (compareRegister >> 1) - 1;
+  SoftTimer_baseCount = 0;
+  SoftTimer_baseTick  = 0;
+  SoftTimer_tick      = 0;
+
+  for (level = 0; level < SOFTTIMER_LEVELS; level++) {
+    SoftTimer_pending[level] = 0;
+    for (index = 0; index < SOFTTIMER_SLOTS; index++)
+      SoftTimer_wheel[level][index] = NULL;
+  }
+
+  Timer_A_configureContinuousMode(timer, &continuousConfig);
+  SoftTimer_timer->CCTL[SoftTimer_ccr] = 0;
+  SoftTimer_program(SOFTTIMER_MAX_SLEEP);
+  Timer_A_enableCaptureCompareInterrupt(timer, compareRegister);
+
+  if (compareRegister == TIMER_A_CAPTURECOMPARE_REGISTER_0) {
+    Interrupt_setPriority(INT_TA0_0 + 2 * instance, INTERRUPT_PRIORITY_TIMER);
+    Timer_A_registerInterrupt(timer, TIMER_A_CCR0_INTERRUPT,
+                              SoftTimer_handleInterrupt);
+  } else {
+    Interrupt_setPriority(INT_TA0_N + 2 * instance, INTERRUPT_PRIORITY_TIMER);
+    Timer_A_registerInterrupt(timer, TIMER_A_CCRX_AND_OVERFLOW_INTERRUPT,
+                              SoftTimer_handleInterrupt);
+  }
+
+  Timer_A_startCounter(timer, TIMER_A_CONTINUOUS_MODE);
+}
+
+void SoftTimer_create(SoftTimer_Timer *softTimer,
+                      SoftTimer_Callback callback, void *arg) {
+  softTimer->next     = NULL;
+  softTimer->pprev    = NULL;
+  softTimer->callback = callback;
+  softTimer->arg      = arg;
+  softTimer->expires  = 0;
+  softTimer->period   = 0;
+  softTimer->level    = 0;
+}
+
+void SoftTimer_start(SoftTimer_Timer *softTimer, uint32_t delay,
+                     uint32_t period) {
+  uint32_t basePri, event;
+
+  ASSERT(delay < 0x80000000 && period < 0x80000000);
+
+  if (delay == 0)
+    delay = 1;
+
+  basePri = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+
+  if (softTimer->pprev)
+    SoftTimer_unlink(softTimer);
+
+  softTimer->expires = SoftTimer_now() + delay;
+  softTimer->period  = period;
+  event              = SoftTimer_insert(softTimer);
+
+  // Only something to do before the wake tick needs the compare register
+  // moved
+  if ((int32_t)(event - SoftTimer_wake) < 0)
+    SoftTimer_program(event);
+
+  Interrupt_exitCritical(basePri);
+}
+
+void SoftTimer_stop(SoftTimer_Timer *softTimer) {
+  uint32_t basePri;
+
+  // The compare register is left alone, waking up for nothing costs less
+  // than finding the next deadline
+  basePri = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  if (softTimer->pprev)
+    SoftTimer_unlink(softTimer);
+  Interrupt_exitCritical(basePri);
+}
+
+bool SoftTimer_isActive(const SoftTimer_Timer *softTimer) {
+  return softTimer->pprev != NULL;
+}
+
+uint32_t SoftTimer_getTicks(void) {
+  uint32_t basePri, ticks;
+
+  basePri = Interrupt_enterCritical(INTERRUPT_CRITICAL_DRIVER);
+  ticks   = SoftTimer_now();
+  Interrupt_exitCritical(basePri);
+
+  return ticks;
+}
+
+void SoftTimer_handleInterrupt(void) {
+  SoftTimer_Timer *expired, *softTimer;
+  uint32_t         now, elapsed;
+  uint_fast8_t     index;
+
+  if (!(SoftTimer_timer->CCTL[SoftTimer_ccr] & TIMER_A_CCTLN_CCIFG))
+    return;
+  SoftTimer_timer->CCTL[SoftTimer_ccr] &= ~TIMER_A_CCTLN_CCIFG;
+
+  elapsed = (uint16_t)(Timer_A_getCounterValue((uint32_t)SoftTimer_timer) -
+                       SoftTimer_baseCount) /
+            SOFTTIMER_COUNTS_PER_TICK;
+  SoftTimer_baseTick += elapsed;
+  SoftTimer_baseCount += elapsed * SOFTTIMER_COUNTS_PER_TICK;
+
+  // Nothing was due before the wake tick, skip straight to it
+  now = SoftTimer_baseTick;
+  if ((int32_t)(SoftTimer_wake - SoftTimer_tick) > 0 &&
+      (int32_t)(now - SoftTimer_wake) >= 0)
+    SoftTimer_tick = SoftTimer_wake;
+
+  while ((int32_t)(now - SoftTimer_tick) >= 0) {
+    index = SoftTimer_tick & SOFTTIMER_SLOT_MASK;
+    if (!index && !SoftTimer_cascade(1) && !SoftTimer_cascade(2))
+      SoftTimer_cascade(3);
+
+    // Take the slot off the wheel so that callbacks starting timers for
+    // this same tick put them in the next one instead
+    expired = SoftTimer_wheel[0][index];
+    if (expired) {
+      expired->pprev            = &expired;
+      SoftTimer_wheel[0][index] = NULL;
+      for (softTimer = expired; softTimer; softTimer = softTimer->next) {
+        SoftTimer_pending[0]--;
+        softTimer->level = SOFTTIMER_LEVEL_EXPIRING;
+      }
+    }
+    SoftTimer_tick++;
+
+    // A callback may stop any timer still on the list
+    while ((softTimer = expired) != NULL) {
+      SoftTimer_unlink(softTimer);
+      if (softTimer->period) {
+        softTimer->expires += softTimer->period;
+        SoftTimer_insert(softTimer);
+      }
+      softTimer->callback(softTimer->arg);
+    }
+  }
+
+  SoftTimer_program(SoftTimer_nextEvent(now + SOFTTIMER_MAX_SLEEP));
+}
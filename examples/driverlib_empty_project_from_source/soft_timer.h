@@ -0,0 +1,245 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef SOFT_TIMER_H_
+#define SOFT_TIMER_H_
+
+//*****************************************************************************
+//
+//! \addtogroup soft_timer_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/driverlib/timer_a.h>
+
+//*****************************************************************************
+//
+// Software timers on one Timer_A capture compare register.
+//
+// The Timer_A counts ACLK, which must be 32768 Hz, in continuous mode. One
+// of its capture compare registers is reprogrammed to the next tick at which
+// something is due, so any number of timers cost one compare channel. The
+// other capture compare registers of the same Timer_A are left free for
+// compare or capture use, as long as the timer mode is not changed.
+//
+// Timers are kept in a hierarchical timing wheel: four levels of 64 slots,
+// each level 64 times coarser than the one below. Starting and stopping a
+// timer is O(1) and the interrupt only moves timers down a level when the
+// time they are due comes within reach of the finer one.
+//
+// The interrupt is taken at least once a second, even with nothing pending,
+// to keep extending the 16-bit count.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Ticks of the service, 32 ACLK cycles each.
+//
+//*****************************************************************************
+#define SOFTTIMER_TICKS_PER_SECOND 1024
+
+//*****************************************************************************
+//
+// Converts milliseconds to ticks, rounding up.
+//
+//*****************************************************************************
+#define SOFTTIMER_MS(ms)                                                       \
+  ((uint32_t)((((uint64_t)(ms)) * SOFTTIMER_TICKS_PER_SECOND + 999) / 1000))
+
+//*****************************************************************************
+//
+// Called from the Timer_A interrupt when a timer expires.
+//
+//*****************************************************************************
+typedef void (*SoftTimer_Callback)(void *arg);
+
+//*****************************************************************************
+//
+//! \typedef SoftTimer_Timer
+//! \brief A software timer. Allocated by the caller, set up with
+//!        \link SoftTimer_create \endlink; the members are private.
+//
+//*****************************************************************************
+typedef struct _SoftTimer_Timer {
+  struct _SoftTimer_Timer  *next;
+  struct _SoftTimer_Timer **pprev; /* NULL while not pending */
+  SoftTimer_Callback        callback;
+  void                     *arg;
+  uint32_t                  expires;
+  uint32_t                  period;
+  uint8_t                   level;
+} SoftTimer_Timer;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Starts the service on a Timer_A capture compare register.
+//!
+//! \param timer is the instance of the Timer_A module. Valid parameters
+//! vary from part to part, but can include:
+//!         - \b TIMER_A0_BASE
+//!         - \b TIMER_A1_BASE
+//!         - \b TIMER_A2_BASE
+//!         - \b TIMER_A3_BASE
+//! \param compareRegister is the capture compare register to use, one of
+//!        \b TIMER_A_CAPTURECOMPARE_REGISTER_0 to
+//!        \b TIMER_A_CAPTURECOMPARE_REGISTER_6
+//!
+//! The Timer_A is cleared and started in continuous mode from ACLK. Its
+//! interrupt, TAx_0 for register 0 and TAx_N otherwise, is set to
+//! \b INTERRUPT_PRIORITY_TIMER, registered with
+//! \link Timer_A_registerInterrupt \endlink and enabled.
+//!
+//! TAx_N is shared by registers 1 to 6 and the overflow. If other sources
+//! on it are in use, register a handler of your own for the vector after
+//! calling this function, and have it call
+//! \link SoftTimer_handleInterrupt \endlink, which ignores the interrupt
+//! unless its own register asked for it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void SoftTimer_init(uint32_t timer, uint_fast16_t compareRegister);
+
+//*****************************************************************************
+//
+//! Sets up a timer, not pending.
+//!
+//! \param softTimer is the timer.
+//! \param callback is called from the Timer_A interrupt each time the timer
+//!        expires. It may start or stop any timer, itself included.
+//! \param arg is passed to \e callback.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void SoftTimer_create(SoftTimer_Timer *softTimer,
+                             SoftTimer_Callback callback, void *arg);
+
+//*****************************************************************************
+//
+//! Starts a timer, restarting it if it was already pending.
+//!
+//! \param softTimer is the timer.
+//! \param delay is the number of ticks until it first expires, from 1 to
+//!        2^31 - 1. A delay of 0 counts as 1.
+//! \param period is the number of ticks between later expiries, or 0 to
+//!        expire only once.
+//!
+//! Periodic timers are due at exact multiples of \e period from the first
+//! expiry, however late the callbacks run.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void SoftTimer_start(SoftTimer_Timer *softTimer, uint32_t delay,
+                            uint32_t period);
+
+//*****************************************************************************
+//
+//! Stops a timer. Nothing happens if it was not pending.
+//!
+//! \param softTimer is the timer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void SoftTimer_stop(SoftTimer_Timer *softTimer);
+
+//*****************************************************************************
+//
+//! Tells whether a timer is pending.
+//!
+//! \param softTimer is the timer.
+//!
+//! \return true between \link SoftTimer_start \endlink and its last expiry
+//!         or \link SoftTimer_stop \endlink.
+//
+//*****************************************************************************
+extern bool SoftTimer_isActive(const SoftTimer_Timer *softTimer);
+
+//*****************************************************************************
+//
+//! Returns the number of ticks since \link SoftTimer_init \endlink.
+//!
+//! \return Tick count, wrapping after about 48 days.
+//
+//*****************************************************************************
+extern uint32_t SoftTimer_getTicks(void);
+
+//*****************************************************************************
+//
+//! Handles the Timer_A interrupt, running the callbacks of the timers that
+//! are due. Only for calling from a TAx_N handler shared with other sources,
+//! see \link SoftTimer_init \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void SoftTimer_handleInterrupt(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* SOFT_TIMER_H_ */
@@ -90,6 +90,43 @@
 uint32_t SystemCoreClock =
     __SYSTEM_CLOCK; /*!< System Clock Frequency (Core Clock)*/
 
+/*----------------------------------------------------------------------------
+   DCO calibration in fixed point, fraction bits
+ *---------------------------------------------------------------------------*/
+#define __DCO_SCALE_SHIFT 12
+
+/**
+ * Compute (1 / K + 768 - FCAL) in fixed point
+ *
+ * @param  constK  DCO constant K from the TLV, an IEEE single
+ * @param  fcal    DCO frequency calibration from the TLV
+ * @return the value with __DCO_SCALE_SHIFT fraction bits, 0 if K is unusable
+ *
+ * @brief  Integer form of the DCO calibration, so SystemCoreClockUpdate()
+ *         needs no floating point support.
+ */
+static uint32_t dcoScale(uint32_t constK, uint32_t fcal) {
+  uint32_t exponent = (constK >> 23) & 0xFF;
+  uint32_t mantissa = (constK & 0x7FFFFF) | 0x800000;
+  int32_t  shift    = 150 + __DCO_SCALE_SHIFT - (int32_t)exponent;
+  uint64_t inverse;
+  int64_t  scale;
+
+  /* K = mantissa * 2^(exponent - 150) */
+  if ((constK & 0x80000000) || exponent == 0 || exponent == 0xFF ||
+      shift < 0 || shift > 63) {
+    return 0;
+  }
+  inverse = ((1ULL << shift) + mantissa / 2) / mantissa;
+
+  scale = (int64_t)inverse +
+          ((int64_t)(768 - (int32_t)fcal) << __DCO_SCALE_SHIFT);
+  if (scale <= 0 || scale > 0xFFFFFFFF) {
+    return 0;
+  }
+  return (uint32_t)scale;
+}
+
 /**
  * Update SystemCoreClock variable
  *
@@ -101,9 +138,9 @@ uint32_t SystemCoreClock =
  */
 void SystemCoreClockUpdate(void) {
   uint32_t source = 0, divider = 0, dividerValue = 0, centeredFreq = 0,
-           calVal  = 0;
-  int16_t dcoTune  = 0;
-  float   dcoConst = 0.0;
+           scale  = 0;
+  int16_t dcoTune     = 0;
+  int64_t denominator = 0;
 
   divider      = (CS->CTL1 & CS_CTL1_DIVM_MASK) >> CS_CTL1_DIVM_OFS;
   dividerValue = 1 << divider;
@@ -173,19 +210,23 @@ void SystemCoreClockUpdate(void) {
       }
 
       if (BITBAND_PERI(CS->CTL0, CS_CTL0_DCORES_OFS)) {
-        dcoConst = *((volatile const float *)&TLV->DCOER_CONSTK_RSEL04);
-        calVal   = TLV->DCOER_FCAL_RSEL04;
+        scale = dcoScale(TLV->DCOER_CONSTK_RSEL04, TLV->DCOER_FCAL_RSEL04);
       }
       /* Internal Resistor */
       else {
-        dcoConst = *((volatile const float *)&TLV->DCOIR_CONSTK_RSEL04);
-        calVal   = TLV->DCOIR_FCAL_RSEL04;
+        scale = dcoScale(TLV->DCOIR_CONSTK_RSEL04, TLV->DCOIR_FCAL_RSEL04);
       }
 
-      SystemCoreClock =
-          (uint32_t)((centeredFreq) /
-                     (1 - ((dcoConst * dcoTune) /
-                           (8 * (1 + dcoConst * (768 - calVal))))));
+      /* f = fCenter / (1 - tune / (8 * scale)) */
+      denominator = ((int64_t)scale << 3) -
+                    ((int64_t)dcoTune << __DCO_SCALE_SHIFT);
+      if (scale == 0 || denominator <= 0) {
+        SystemCoreClock = centeredFreq;
+      } else {
+        SystemCoreClock =
+            (uint32_t)((((uint64_t)centeredFreq * scale) << 3) /
+                       (uint64_t)denominator);
+      }
     }
     break;
   case CS_CTL1_SELM__MODOSC:
@@ -0,0 +1,213 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/cpu.h>
+#include <ti/devices/msp432p4xx/driverlib/cs.h>
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/interrupt.h>
+#include <ti/devices/msp432p4xx/driverlib/timestamp.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+#define TIMESTAMP_CS_CTL1_MCLK (CS_CTL1_SELM_MASK | CS_CTL1_DIVM_MASK)
+
+// Cycles from baseCycles on are worth multiplier / 2^shift microseconds
+// each. baseMicroseconds is exact, the fraction left over is kept in
+// baseRemainder in units of 1 / mclk microseconds.
+typedef struct {
+  uint64_t baseCycles;
+  uint64_t baseMicroseconds;
+  uint32_t baseRemainder;
+  uint32_t mclk;
+  uint32_t multiplier;
+  uint32_t shift;
+  uint32_t csCtl0;
+  uint32_t csCtl1;
+} Timestamp_Segment;
+
+static Timer32_Type     *Timestamp_timer;
+static volatile uint32_t Timestamp_overflows;
+
+// Written with interrupts disabled into the segment not in use, which is
+// then published by bumping the generation. A reader that sees the
+// generation move while it reads starts over.
+static Timestamp_Segment Timestamp_segments[2];
+static volatile uint32_t Timestamp_generation;
+
+static uint64_t Timestamp_readCycles(void) {
+  uint32_t overflows, value, raw;
+
+  do {
+    overflows = Timestamp_overflows;
+    value     = Timestamp_timer->VALUE;
+    raw       = Timestamp_timer->RIS;
+  } while (overflows != Timestamp_overflows);
+
+  // Wrapped without the interrupt having run yet. A value near the reload
+  // was read after the wrap, one near zero before it.
+  if ((raw & TIMER32_RIS_RAW_IFG) && value >= 0x80000000)
+    overflows++;
+
+  return ((uint64_t)overflows << 32) | (0xFFFFFFFF - value);
+}
+
+static void Timestamp_setClock(Timestamp_Segment *segment, uint32_t mclk,
+                               uint32_t csCtl0, uint32_t csCtl1) {
+  uint32_t shift = 32;
+
+  // Largest shift with the multiplier under 2^31: segments last at most a
+  // little over 2^32 cycles, so the product in the readers fits 64 bits
+  while ((((uint64_t)1000000 << shift) / mclk) >= 0x80000000)
+    shift--;
+
+  segment->mclk       = mclk;
+  segment->multiplier = (uint32_t)(((uint64_t)1000000 << shift) / mclk);
+  segment->shift      = shift;
+  segment->csCtl0     = csCtl0;
+  segment->csCtl1     = csCtl1;
+}
+
+// Must be called with interrupts disabled
+static void Timestamp_startSegment(uint64_t cycles, uint32_t mclk,
+                                   uint32_t csCtl0, uint32_t csCtl1) {
+  const Timestamp_Segment *old;
+  Timestamp_Segment       *next;
+  uint64_t                 scaled;
+
+  old  = &Timestamp_segments[Timestamp_generation & 1];
+  next = &Timestamp_segments[(Timestamp_generation + 1) & 1];
+
+  // Close the old segment exactly. Its length is bounded by the wrap
+  // interrupt, so scaled stays far below 2^64.
+  scaled = (cycles - old->baseCycles) * 1000000 + old->baseRemainder;
+
+  next->baseCycles       = cycles;
+  next->baseMicroseconds = old->baseMicroseconds + scaled / old->mclk;
+  next->baseRemainder    = scaled % old->mclk;
+  if (mclk != old->mclk)
+    next->baseRemainder =
+        (uint32_t)(((uint64_t)next->baseRemainder * mclk) / old->mclk);
+
+  Timestamp_setClock(next, mclk, csCtl0, csCtl1);
+  Timestamp_generation++;
+}
+
+void Timestamp_init(uint32_t timer) {
+  uint32_t interruptNumber;
+
+  ASSERT(timer == TIMER32_0_BASE || timer == TIMER32_1_BASE);
+
+  interruptNumber = (timer == TIMER32_0_BASE) ? TIMER32_0_INTERRUPT
+                                              : TIMER32_1_INTERRUPT;
+
+  Timer32_haltTimer(timer);
+  Timer32_disableInterrupt(timer);
+
+  Timestamp_timer      = TIMER32_CMSIS(timer);
+  Timestamp_overflows  = 0;
+  Timestamp_generation = 0;
+
+  Timestamp_segments[0].baseCycles       = 0;
+  Timestamp_segments[0].baseMicroseconds = 0;
+  Timestamp_segments[0].baseRemainder    = 0;
+  Timestamp_setClock(&Timestamp_segments[0], CS_getMCLK(), CS->CTL0,
+                     CS->CTL1 & TIMESTAMP_CS_CTL1_MCLK);
+
+  Timer32_initModule(timer, TIMER32_PRESCALER_1, TIMER32_32BIT,
+                     TIMER32_PERIODIC_MODE);
+  Timer32_setCount(timer, 0xFFFFFFFF);
+  Timer32_clearInterruptFlag(timer);
+
+  Interrupt_setPriority(interruptNumber, INTERRUPT_PRIORITY_TIMER);
+  Timer32_registerInterrupt(interruptNumber, Timestamp_handleOverflow);
+  Timer32_enableInterrupt(timer);
+  Timer32_startTimer(timer, false);
+}
+
+uint64_t Timestamp_getCycles(void) { return Timestamp_readCycles(); }
+
+uint64_t Timestamp_getMicroseconds(void) {
+  const Timestamp_Segment *segment;
+  uint32_t                 generation;
+  uint64_t                 microseconds;
+
+  do {
+    generation = Timestamp_generation;
+    segment    = &Timestamp_segments[generation & 1];
+
+    if (CS->CTL0 != segment->csCtl0 ||
+        (CS->CTL1 & TIMESTAMP_CS_CTL1_MCLK) != segment->csCtl1) {
+      Timestamp_rescale();
+      continue;
+    }
+
+    microseconds = segment->baseMicroseconds +
+                   (((Timestamp_readCycles() - segment->baseCycles) *
+                     segment->multiplier) >>
+                    segment->shift);
+  } while (generation != Timestamp_generation);
+
+  return microseconds;
+}
+
+void Timestamp_rescale(void) {
+  uint32_t csCtl0 = CS->CTL0;
+  uint32_t csCtl1 = CS->CTL1 & TIMESTAMP_CS_CTL1_MCLK;
+  uint32_t mclk   = CS_getMCLK();
+  bool     intDisabled;
+
+  intDisabled = CPU_cpsid();
+  Timestamp_startSegment(Timestamp_readCycles(), mclk, csCtl0, csCtl1);
+  if (!intDisabled)
+    CPU_cpsie();
+}
+
+void Timestamp_handleOverflow(void) {
+  const Timestamp_Segment *segment;
+  uint64_t                 wrap;
+  bool                     intDisabled;
+
+  // Clearing the flag and counting the wrap must look like one step to a
+  // higher priority reader
+  intDisabled             = CPU_cpsid();
+  Timestamp_timer->INTCLR = 0x01;
+  Timestamp_overflows     = Timestamp_overflows + 1;
+  wrap                    = (uint64_t)Timestamp_overflows << 32;
+
+  // Start a new segment at the wrap, same clock, unless a rescale already
+  // did after it
+  segment = &Timestamp_segments[Timestamp_generation & 1];
+  if (segment->baseCycles < wrap)
+    Timestamp_startSegment(wrap, segment->mclk, segment->csCtl0,
+                           segment->csCtl1);
+
+  if (!intDisabled)
+    CPU_cpsie();
+}
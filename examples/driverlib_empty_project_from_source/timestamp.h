@@ -0,0 +1,170 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef TIMESTAMP_H_
+#define TIMESTAMP_H_
+
+//*****************************************************************************
+//
+//! \addtogroup timestamp_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/driverlib/timer32.h>
+
+//*****************************************************************************
+//
+// 64-bit monotonic time base.
+//
+// One Timer32 counts MCLK cycles down from 0xFFFFFFFF in periodic mode and
+// its wrap interrupt extends the count to 64 bits. The readers never mask
+// interrupts: they detect a wrap that happened while they were reading, or
+// one whose interrupt has not run yet, and correct for it. They are safe from
+// threads, any interrupt priority and with interrupts disabled, as long as
+// interrupts are not held off for more than half a Timer32 period (about 44
+// seconds at 48 MHz).
+//
+// Microseconds stay continuous across MCLK changes. Each change starts a new
+// segment converted at the new frequency, picked up either by an explicit
+// \link Timestamp_rescale \endlink right after the change or, failing that,
+// by the next read noticing the CS registers changed. That read, and the
+// rescale itself, mask interrupts for the few cycles it takes to switch
+// segments.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Starts the time base on a Timer32, at zero.
+//!
+//! \param timer is the Timer32 to take over, \b TIMER32_0_BASE or
+//!        \b TIMER32_1_BASE.
+//!
+//! The wrap interrupt is registered with
+//! \link Interrupt_registerInterrupt \endlink at
+//! \b INTERRUPT_PRIORITY_TIMER and enabled. To keep the vector table in
+//! flash, bind the handler instead with
+//! \code
+//! INTERRUPT_BIND_HANDLER(T32_INT1_IRQHandler, Timestamp_handleOverflow)
+//! \endcode
+//! (T32_INT2_IRQHandler for \b TIMER32_1_BASE). The registration then
+//! finds it already in place, where the binding is an alias; with a
+//! trampoline binding the table still moves to SRAM (see interrupt.h).
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void Timestamp_init(uint32_t timer);
+
+//*****************************************************************************
+//
+//! Returns the number of MCLK cycles since \link Timestamp_init \endlink.
+//!
+//! The count runs at whatever MCLK was at the time, so differences are only
+//! cycles of work done, not time, if MCLK changed in between.
+//!
+//! \return 64-bit cycle count.
+//
+//*****************************************************************************
+extern uint64_t Timestamp_getCycles(void);
+
+//*****************************************************************************
+//
+//! Returns the number of microseconds since \link Timestamp_init \endlink.
+//!
+//! Costs a few dozen cycles: one Timer32 read, a check of the CS registers
+//! and a multiply, no division.
+//!
+//! \return 64-bit microsecond count.
+//
+//*****************************************************************************
+extern uint64_t Timestamp_getMicroseconds(void);
+
+//*****************************************************************************
+//
+//! Starts converting at the current MCLK frequency.
+//!
+//! Call it right after changing MCLK so that the cycles counted before the
+//! change are converted at the old frequency and those after at the new one.
+//! Without the call, the next read notices the change, at the cost of
+//! converting the cycles in between at the old frequency.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void Timestamp_rescale(void);
+
+//*****************************************************************************
+//
+//! Handles the Timer32 wrap interrupt. Only for binding into the vector
+//! table, see \link Timestamp_init \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void Timestamp_handleOverflow(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* TIMESTAMP_H_ */
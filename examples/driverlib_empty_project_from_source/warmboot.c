@@ -0,0 +1,208 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/flash_a.h>
+#include <ti/devices/msp432p4xx/driverlib/pcm.h>
+#include <ti/devices/msp432p4xx/driverlib/reset.h>
+#include <ti/devices/msp432p4xx/driverlib/sysctl_a.h>
+#include <ti/devices/msp432p4xx/driverlib/warmboot.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+#include <stddef.h>
+
+#define WARMBOOT_MAGIC 0x574D4254 // "WMBT"
+
+#define WARMBOOT_FNV_OFFSET 0x811C9DC5
+#define WARMBOOT_FNV_PRIME  0x01000193
+
+static uint32_t WarmBoot_hash(uint32_t hash, const void *data, uint32_t size) {
+  const uint8_t *byte = (const uint8_t *)data;
+
+  while (size--) {
+    hash ^= *byte++;
+    hash *= WARMBOOT_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+// Over the register list as well as the values, so that a context saved by
+// a build with a different list is not restored into the wrong registers
+static uint32_t WarmBoot_checksum(const WarmBoot_Context *context,
+                                  const WarmBoot_Register *registers,
+                                  uint_fast8_t count, const void *appState,
+                                  uint32_t appSize) {
+  uint32_t     hash = WARMBOOT_FNV_OFFSET;
+  uint_fast8_t i;
+
+  hash = WarmBoot_hash(hash, &context->csCtl0,
+                       sizeof(WarmBoot_Context) -
+                           offsetof(WarmBoot_Context, csCtl0));
+  for (i = 0; i < count; i++) {
+    hash = WarmBoot_hash(hash, &registers[i].address,
+                         sizeof(registers[i].address));
+    hash = WarmBoot_hash(hash, &registers[i].size, sizeof(registers[i].size));
+  }
+  if (appState)
+    hash = WarmBoot_hash(hash, appState, appSize);
+
+  return hash;
+}
+
+static bool WarmBoot_retain(const void *start, uint32_t size) {
+  uint32_t end = (uint32_t)start + size - 1;
+
+  // LPM3.5 keeps only the first block
+  ASSERT(end < SRAM_BASE + SysCtl_A_getSRAMSize() / SYSCTL_A->SRAM_NUMBLOCKS);
+
+  return SysCtl_A_enableSRAMRetention((uint32_t)start, end);
+}
+
+uint_fast8_t WarmBoot_getWakeReason(void) {
+  uint32_t source = ResetCtl_getPCMSource();
+
+  if (source & RESET_LPM35)
+    return WARMBOOT_LPM35;
+  if (source & RESET_LPM45)
+    return WARMBOOT_LPM45;
+
+  return WARMBOOT_COLD;
+}
+
+bool WarmBoot_save(WarmBoot_Context *context,
+                   const WarmBoot_Register *registers, uint_fast8_t count,
+                   const void *appState, uint32_t appSize) {
+  uint_fast8_t i;
+  uintptr_t    address;
+
+  ASSERT(count <= WARMBOOT_MAX_REGISTERS);
+
+  context->magic = 0;
+  if (!WarmBoot_retain(context, sizeof(WarmBoot_Context)))
+    return false;
+  if (appState && !WarmBoot_retain(appState, appSize))
+    return false;
+
+  context->csCtl0        = CS->CTL0;
+  context->csCtl1        = CS->CTL1;
+  context->csCtl2        = CS->CTL2;
+  context->csClken       = CS->CLKEN;
+  context->powerState    = PCM_getPowerState();
+  context->waitStates    = FlashCtl_A_getWaitState(FLASH_A_BANK0);
+  context->registerCount = count;
+
+  for (i = 0; i < WARMBOOT_MAX_REGISTERS; i++) {
+    if (i >= count) {
+      context->registers[i] = 0;
+      continue;
+    }
+
+    address = registers[i].address;
+    switch (registers[i].size) {
+    case 1:
+      context->registers[i] = *(volatile uint8_t *)address;
+      break;
+    case 2:
+      context->registers[i] = *(volatile uint16_t *)address;
+      break;
+    default:
+      context->registers[i] = *(volatile uint32_t *)address;
+      break;
+    }
+  }
+
+  context->checksum =
+      WarmBoot_checksum(context, registers, count, appState, appSize);
+  context->magic = WARMBOOT_MAGIC;
+
+  return true;
+}
+
+bool WarmBoot_restore(const WarmBoot_Context *context,
+                      const WarmBoot_Register *registers, uint_fast8_t count,
+                      const void *appState, uint32_t appSize) {
+  uint_fast8_t i;
+  uintptr_t    address;
+  uint32_t     value;
+
+  if (WarmBoot_getWakeReason() != WARMBOOT_LPM35)
+    return false;
+  if (context->magic != WARMBOOT_MAGIC || context->registerCount != count ||
+      context->checksum !=
+          WarmBoot_checksum(context, registers, count, appState, appSize))
+    return false;
+
+  // Out of the wake the device runs at 3 MHz from the DCO, LDO VCORE0 with
+  // no wait states: voltage and wait states up before the clocks
+  if (context->powerState != PCM_getPowerState())
+    if (!PCM_setPowerState(context->powerState))
+      return false;
+  FlashCtl_A_setWaitState(FLASH_A_BANK0, context->waitStates);
+  FlashCtl_A_setWaitState(FLASH_A_BANK1, context->waitStates);
+
+  // The crystal pins among them, before the crystals are enabled
+  for (i = 0; i < count; i++) {
+    address = registers[i].address;
+    value   = context->registers[i];
+    switch (registers[i].size) {
+    case 1:
+      *(volatile uint8_t *)address = (uint8_t)value;
+      break;
+    case 2:
+      *(volatile uint16_t *)address = (uint16_t)value;
+      break;
+    default:
+      *(volatile uint32_t *)address = value;
+      break;
+    }
+  }
+
+  // Crystals enabled without waiting for them, see warmboot.h
+  CS->KEY    = CS_KEY_VAL;
+  CS->CTL2   = context->csCtl2;
+  CS->CTL0   = context->csCtl0;
+  CS->CLKEN  = context->csClken;
+  CS->CTL1   = context->csCtl1;
+  CS->CLRIFG = CS_CLRIFG_CLR_LFXTIFG | CS_CLRIFG_CLR_HFXTIFG;
+  CS->KEY    = 0;
+
+  WarmBoot_releaseIO();
+
+  return true;
+}
+
+void WarmBoot_releaseIO(void) {
+  ResetCtl_clearPCMFlags();
+
+  // Writing the key alone clears LOCKLPM5
+  PCM->CTL1 = PCM_CTL1_KEY_VAL;
+}
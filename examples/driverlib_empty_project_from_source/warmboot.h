@@ -0,0 +1,248 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef WARMBOOT_H_
+#define WARMBOOT_H_
+
+//*****************************************************************************
+//
+//! \addtogroup warmboot_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Warm boot from LPM3.5.
+//
+// Waking from LPM3.5 or LPM4.5 is a reset: the application starts over from
+// main with every peripheral at its reset value, except the RTC and the
+// watchdog, which kept running, and the I/O, which stays latched until
+// released. Instead of redoing the full initialisation, the application
+// saves a context just before shutting down and restores it on the next
+// wake:
+//  - the power state, flash wait states and CS configuration
+//  - a list of peripheral registers it chooses, GPIO among them
+//  - a block of its own state
+//
+// Restoring writes the clock registers back as they were. A crystal that
+// was enabled is enabled again but not waited for: LFXT keeps oscillating
+// through LPM3.5 while it clocks the RTC, so its fault clears within a few
+// cycles, and until HFXT, which always stops, is stable the CS runs the
+// clocks selected from it from its fail-safe source.
+//
+// LPM3.5 keeps only the first SRAM block powered, so the context and the
+// application state must be placed there, out of the sections the startup
+// code initialises. WARMBOOT_RETAINED places a variable in a .retained
+// section for the linker script to put at the start of SRAM, uninitialised.
+// LPM4.5 keeps no SRAM at all: waking from it is always a cold boot.
+//
+// Requirements:
+//  - the context and application state in the first SRAM block
+//  - the crystal frequencies set again with
+//    \link CS_setExternalClockSourceFrequency \endlink after a warm boot,
+//    they are not part of the context
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Wake reasons, see \link WarmBoot_getWakeReason \endlink.
+//
+//*****************************************************************************
+#define WARMBOOT_COLD  0 /* power up or any other reset */
+#define WARMBOOT_LPM35 1
+#define WARMBOOT_LPM45 2
+
+//*****************************************************************************
+//
+// Most registers a context holds.
+//
+//*****************************************************************************
+#define WARMBOOT_MAX_REGISTERS 24
+
+//*****************************************************************************
+//
+// Places a variable in the section kept through LPM3.5. The linker script
+// must put .retained in the first SRAM block and leave it uninitialised.
+//
+//*****************************************************************************
+#if defined(__IAR_SYSTEMS_ICC__)
+#define WARMBOOT_RETAINED __no_init
+#else
+#define WARMBOOT_RETAINED __attribute__((section(".retained")))
+#endif
+
+//*****************************************************************************
+//
+//! \typedef WarmBoot_Register
+//! \brief A peripheral register to save and restore, see
+//! \link WarmBoot_save \endlink. Build one with WARMBOOT_REGISTER.
+//
+//*****************************************************************************
+typedef struct _WarmBoot_Register {
+  uintptr_t    address;
+  uint_fast8_t size; /* 1, 2 or 4 bytes */
+} WarmBoot_Register;
+
+#define WARMBOOT_REGISTER(reg)                                                 \
+  { (uintptr_t) & (reg), sizeof(reg) }
+
+//*****************************************************************************
+//
+//! \typedef WarmBoot_Context
+//! \brief What a warm boot restores, written by
+//! \link WarmBoot_save \endlink. Only ever declared, WARMBOOT_RETAINED.
+//
+//*****************************************************************************
+typedef struct _WarmBoot_Context {
+  uint32_t magic;
+  uint32_t checksum; /* of the rest and the application state */
+  uint32_t csCtl0;
+  uint32_t csCtl1;
+  uint32_t csCtl2;
+  uint32_t csClken;
+  uint8_t  powerState; /* PCM_AM_x */
+  uint8_t  waitStates;
+  uint8_t  registerCount;
+  uint32_t registers[WARMBOOT_MAX_REGISTERS];
+} WarmBoot_Context;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Returns what the device woke from.
+//!
+//! Only meaningful until the reset flags are cleared, which
+//! \link WarmBoot_restore \endlink and \link WarmBoot_releaseIO \endlink do.
+//!
+//! \return \b WARMBOOT_LPM35, \b WARMBOOT_LPM45 or \b WARMBOOT_COLD.
+//
+//*****************************************************************************
+extern uint_fast8_t WarmBoot_getWakeReason(void);
+
+//*****************************************************************************
+//
+//! Saves a context for the next wake from LPM3.5.
+//!
+//! \param context is where to save it, WARMBOOT_RETAINED.
+//! \param registers lists the peripheral registers to save.
+//! \param count is the length of \e registers, up to
+//!        \b WARMBOOT_MAX_REGISTERS.
+//! \param appState is the application state to validate with the context,
+//!        WARMBOOT_RETAINED, or 0.
+//! \param appSize is the size of \e appState in bytes.
+//!
+//! Call it last before \link PCM_shutdownDevice \endlink, once the
+//! registers hold what the application wants back. It also enables
+//! retention of the context and the state in LPM3 and LPM4, for
+//! applications that use them through deeper sleeps as well.
+//!
+//! \return false if SRAM retention could not be enabled, the next wake is
+//!         then a cold boot.
+//
+//*****************************************************************************
+extern bool WarmBoot_save(WarmBoot_Context *context,
+                          const WarmBoot_Register *registers,
+                          uint_fast8_t count, const void *appState,
+                          uint32_t appSize);
+
+//*****************************************************************************
+//
+//! Restores a context saved before LPM3.5, if the device woke from LPM3.5
+//! and the context and state are intact.
+//!
+//! \param context, \e registers, \e count, \e appState and \e appSize are
+//!        as passed to \link WarmBoot_save \endlink.
+//!
+//! Call it first thing in main. In order it restores the power state, the
+//! flash wait states, the registers, in the order of \e registers, and the
+//! clocks, then releases the I/O. List the GPIO first and the registers
+//! that start a peripheral after those that configure it; the peripherals
+//! run from the clocks out of reset until the clocks are restored, a few
+//! cycles later.
+//!
+//! \return true if the context was restored, the application state is then
+//!         valid. Otherwise nothing was touched: the application does a
+//!         cold boot and calls \link WarmBoot_releaseIO \endlink once it
+//!         has set up its I/O.
+//
+//*****************************************************************************
+extern bool WarmBoot_restore(const WarmBoot_Context *context,
+                             const WarmBoot_Register *registers,
+                             uint_fast8_t count, const void *appState,
+                             uint32_t appSize);
+
+//*****************************************************************************
+//
+//! Releases the I/O latched through LPM3.5 or LPM4.5 and clears the reset
+//! flags. Without a wake from either, does nothing harmful.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WarmBoot_releaseIO(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* WARMBOOT_H_ */
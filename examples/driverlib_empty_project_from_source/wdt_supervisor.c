@@ -0,0 +1,189 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#include <ti/devices/msp432p4xx/driverlib/debug.h>
+#include <ti/devices/msp432p4xx/driverlib/reset.h>
+#include <ti/devices/msp432p4xx/driverlib/timestamp.h>
+#include <ti/devices/msp432p4xx/driverlib/wdt_a.h>
+#include <ti/devices/msp432p4xx/driverlib/wdt_supervisor.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+// Record states: written by the monitor before the reset, or kept by init
+// for the reset count. Anything else is what SRAM holds at power up.
+#define WDTSUPERVISOR_TRIPPED 0x57445452 // "WDTR"
+#define WDTSUPERVISOR_KEPT    0x5744544B // "WDTK"
+
+// Watchdog time-out, among the hard and soft reset sources alike
+#define WDTSUPERVISOR_TIMEOUT RESET_SRC_1
+
+// Elapsed times are compared modulo 2^32 microseconds
+#define WDTSUPERVISOR_MAX_DEADLINE_MS (0x7FFFFFFF / 1000)
+
+static WDTSUPERVISOR_NOINIT WDTSupervisor_Record WDTSupervisor_record;
+
+static uint_fast8_t WDTSupervisor_cause = WDTSUPERVISOR_NO_TRIP;
+
+// A deadline of 0 marks a task not added
+static uint32_t          WDTSupervisor_deadlines[WDTSUPERVISOR_MAX_TASKS];
+static volatile uint32_t WDTSupervisor_checkIns[WDTSUPERVISOR_MAX_TASKS];
+static volatile bool     WDTSupervisor_supervised[WDTSUPERVISOR_MAX_TASKS];
+
+static volatile bool WDTSupervisor_running;
+static bool          WDTSupervisor_tripped;
+
+static uint32_t WDTSupervisor_now(void) {
+  return (uint32_t)Timestamp_getMicroseconds();
+}
+
+void WDTSupervisor_init(uint_fast8_t clockSelect,
+                        uint_fast8_t clockIterations) {
+  WDTSupervisor_Record *record = &WDTSupervisor_record;
+  uint_fast8_t          i;
+
+  WDT_A_holdTimer();
+
+  if (record->magic != WDTSUPERVISOR_TRIPPED &&
+      record->magic != WDTSUPERVISOR_KEPT)
+    record->resets = 0;
+
+  if ((ResetCtl_getHardResetSource() | ResetCtl_getSoftResetSource()) &
+      WDTSUPERVISOR_TIMEOUT) {
+    // The watchdog ran out with every task on time
+    if (record->magic != WDTSUPERVISOR_TRIPPED) {
+      record->task         = WDTSUPERVISOR_MONITOR;
+      record->microseconds = 0;
+    }
+    record->resets++;
+    WDTSupervisor_cause = record->task;
+
+    ResetCtl_clearHardResetSource(WDTSUPERVISOR_TIMEOUT);
+    ResetCtl_clearSoftResetSource(WDTSUPERVISOR_TIMEOUT);
+  } else {
+    WDTSupervisor_cause = WDTSUPERVISOR_NO_TRIP;
+  }
+  record->magic = WDTSUPERVISOR_KEPT;
+
+  WDTSupervisor_running = false;
+  WDTSupervisor_tripped = false;
+  for (i = 0; i < WDTSUPERVISOR_MAX_TASKS; i++) {
+    WDTSupervisor_supervised[i] = false;
+    WDTSupervisor_deadlines[i]  = 0;
+  }
+
+  WDT_A_setTimeoutReset(WDT_A_HARD_RESET);
+  WDT_A_initWatchdogTimer(clockSelect, clockIterations);
+}
+
+uint_fast8_t WDTSupervisor_getResetCause(void) { return WDTSupervisor_cause; }
+
+const WDTSupervisor_Record *WDTSupervisor_getRecord(void) {
+  return &WDTSupervisor_record;
+}
+
+void WDTSupervisor_addTask(uint_fast8_t task, uint32_t deadlineMilliseconds) {
+  ASSERT(task < WDTSUPERVISOR_MAX_TASKS);
+  ASSERT(deadlineMilliseconds > 0 &&
+         deadlineMilliseconds <= WDTSUPERVISOR_MAX_DEADLINE_MS);
+
+  WDTSupervisor_deadlines[task] = deadlineMilliseconds * 1000;
+  WDTSupervisor_resumeTask(task);
+}
+
+void WDTSupervisor_checkIn(uint_fast8_t task) {
+  ASSERT(task < WDTSUPERVISOR_MAX_TASKS);
+
+  // A single store of the time read, no lock needed against the monitor
+  WDTSupervisor_checkIns[task] = WDTSupervisor_now();
+}
+
+void WDTSupervisor_suspendTask(uint_fast8_t task) {
+  ASSERT(task < WDTSUPERVISOR_MAX_TASKS);
+
+  WDTSupervisor_supervised[task] = false;
+}
+
+void WDTSupervisor_resumeTask(uint_fast8_t task) {
+  ASSERT(task < WDTSUPERVISOR_MAX_TASKS && WDTSupervisor_deadlines[task]);
+
+  // Checked in before the monitor looks at it again
+  WDTSupervisor_checkIn(task);
+  WDTSupervisor_supervised[task] = true;
+}
+
+void WDTSupervisor_start(void) {
+  uint_fast8_t i;
+
+  for (i = 0; i < WDTSUPERVISOR_MAX_TASKS; i++)
+    if (WDTSupervisor_deadlines[i])
+      WDTSupervisor_checkIn(i);
+
+  WDTSupervisor_running = true;
+  WDT_A_clearTimer();
+  WDT_A_startTimer();
+}
+
+static void WDTSupervisor_trip(uint_fast8_t task, uint32_t microseconds) {
+  WDTSupervisor_Record *record = &WDTSupervisor_record;
+
+  WDTSupervisor_tripped = true;
+  record->task          = task;
+  record->microseconds  = microseconds;
+  record->magic         = WDTSUPERVISOR_TRIPPED;
+}
+
+bool WDTSupervisor_service(void) {
+  uint_fast8_t i;
+  uint32_t     checkIn;
+  uint32_t     elapsed;
+
+  if (WDTSupervisor_tripped)
+    return false;
+  if (!WDTSupervisor_running)
+    return true;
+
+  for (i = 0; i < WDTSUPERVISOR_MAX_TASKS; i++) {
+    if (!WDTSupervisor_supervised[i])
+      continue;
+
+    // The check in first: one that comes in between only shortens the
+    // elapsed time, where read the other way round it would wrap
+    checkIn = WDTSupervisor_checkIns[i];
+    elapsed = WDTSupervisor_now() - checkIn;
+    if (elapsed > WDTSupervisor_deadlines[i]) {
+      WDTSupervisor_trip(i, elapsed);
+      return false;
+    }
+  }
+
+  WDT_A_clearTimer();
+
+  return true;
+}
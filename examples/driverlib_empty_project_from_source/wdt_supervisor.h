@@ -0,0 +1,278 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+#ifndef WDT_SUPERVISOR_H_
+#define WDT_SUPERVISOR_H_
+
+//*****************************************************************************
+//
+//! \addtogroup wdt_supervisor_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Watchdog supervision of several tasks.
+//
+// Clearing the watchdog from one place only proves that place still runs.
+// Here each task checks in on its own, and the watchdog is cleared only while
+// every task has checked in within its deadline. A task is whatever the
+// application wants watched: the main loop, an interrupt that should keep
+// coming, a state machine that should keep moving.
+//
+// The monitor, \link WDTSupervisor_service \endlink, is called periodically
+// from a low priority context, the lowest priority interrupt or the idle
+// loop, so that it also stops when anything above it hogs the CPU. The first
+// time it finds a task late it writes a record of it to a section the
+// startup code leaves alone and stops clearing the watchdog. The reset then
+// comes within one watchdog period and is still a watchdog time-out, and on
+// the next boot \link WDTSupervisor_init \endlink hands the record back.
+// A watchdog reset with no record means the monitor itself stopped.
+//
+// Deadlines are measured with the time base of timestamp.h, independently of
+// the watchdog period. That period only needs to be longer than the interval
+// between two calls of the monitor, with some margin.
+//
+// Requirements:
+//  - the time base of timestamp.h started before the tasks are added
+//  - the watchdog left to this module, set up by WDTSupervisor_init
+//  - a .noinit section in the linker script, uninitialised and not cleared
+//    by the startup code, for the record; see WDTSUPERVISOR_NOINIT
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Most tasks supervised, with identifiers from 0 to
+// WDTSUPERVISOR_MAX_TASKS - 1.
+//
+//*****************************************************************************
+#define WDTSUPERVISOR_MAX_TASKS 8
+
+//*****************************************************************************
+//
+// Causes of the previous reset other than a task, see
+// \link WDTSupervisor_getResetCause \endlink.
+//
+//*****************************************************************************
+#define WDTSUPERVISOR_NO_TRIP 0xFF /* not a watchdog time-out */
+#define WDTSUPERVISOR_MONITOR 0xFE /* the monitor stopped clearing it */
+
+//*****************************************************************************
+//
+// Places a variable in the section kept through resets. The linker script
+// must leave .noinit uninitialised.
+//
+//*****************************************************************************
+#if defined(__IAR_SYSTEMS_ICC__)
+#define WDTSUPERVISOR_NOINIT __no_init
+#else
+#define WDTSUPERVISOR_NOINIT __attribute__((section(".noinit")))
+#endif
+
+//*****************************************************************************
+//
+//! \typedef WDTSupervisor_Record
+//! \brief What the monitor writes before the reset, see
+//! \link WDTSupervisor_getRecord \endlink.
+//
+//*****************************************************************************
+typedef struct _WDTSupervisor_Record {
+  uint32_t magic;
+  uint32_t task;         /* late task, or WDTSUPERVISOR_MONITOR */
+  uint32_t microseconds; /* since its last check in, when found late */
+  uint32_t resets;       /* watchdog resets since power up, this one too */
+} WDTSupervisor_Record;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Finds out whether the watchdog caused the last reset and sets it up,
+//! held.
+//!
+//! \param clockSelect is the watchdog clock, one of the
+//!        \b WDT_A_CLOCKSOURCE_ values.
+//! \param clockIterations is its period, one of the
+//!        \b WDT_A_CLOCKITERATIONS_ values.
+//!
+//! Call it early in main, before anything clears the reset flags. It clears
+//! the watchdog time-out flags itself. The time-out is set to a hard reset,
+//! which stops the peripherals as well as the CPU.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WDTSupervisor_init(uint_fast8_t clockSelect,
+                               uint_fast8_t clockIterations);
+
+//*****************************************************************************
+//
+//! Returns what caused the last reset.
+//!
+//! \return The task found late, \b WDTSUPERVISOR_MONITOR if the watchdog
+//!         timed out with no task late, or \b WDTSUPERVISOR_NO_TRIP if the
+//!         reset was not a watchdog time-out.
+//
+//*****************************************************************************
+extern uint_fast8_t WDTSupervisor_getResetCause(void);
+
+//*****************************************************************************
+//
+//! Returns the record of the last watchdog reset.
+//!
+//! \return The record, valid as long as
+//!         \link WDTSupervisor_getResetCause \endlink is not
+//!         \b WDTSUPERVISOR_NO_TRIP. Its \e resets count is kept until the
+//!         next power up.
+//
+//*****************************************************************************
+extern const WDTSupervisor_Record *WDTSupervisor_getRecord(void);
+
+//*****************************************************************************
+//
+//! Adds a task to supervise, checked in.
+//!
+//! \param task is its identifier, below \b WDTSUPERVISOR_MAX_TASKS. Keep it
+//!        the same from one build to the next for the records to make sense.
+//! \param deadlineMilliseconds is the longest the task may go without
+//!        checking in, up to a few minutes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WDTSupervisor_addTask(uint_fast8_t task,
+                                  uint32_t deadlineMilliseconds);
+
+//*****************************************************************************
+//
+//! Tells the monitor a task is alive.
+//!
+//! \param task is the identifier given to \link WDTSupervisor_addTask
+//!        \endlink.
+//!
+//! Costs a read of the time base of timestamp.h and a store, a few dozen
+//! cycles, and takes no lock against the monitor, so it may be called from
+//! any context, interrupts of any priority included. One read costs more:
+//! the first after an MCLK change not followed by
+//! \link Timestamp_rescale \endlink starts a new time segment itself, which
+//! calls \link CS_getMCLK \endlink and masks interrupts for a few cycles.
+//! Calling Timestamp_rescale right after changing MCLK keeps that out of the
+//! check ins.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WDTSupervisor_checkIn(uint_fast8_t task);
+
+//*****************************************************************************
+//
+//! Stops supervising a task until \link WDTSupervisor_resumeTask \endlink,
+//! for a task that waits on something with no bound, such as a command.
+//!
+//! \param task is the identifier given to \link WDTSupervisor_addTask
+//!        \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WDTSupervisor_suspendTask(uint_fast8_t task);
+
+//*****************************************************************************
+//
+//! Supervises a task again, checked in.
+//!
+//! \param task is the identifier given to \link WDTSupervisor_addTask
+//!        \endlink.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WDTSupervisor_resumeTask(uint_fast8_t task);
+
+//*****************************************************************************
+//
+//! Checks in every task and starts the watchdog.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void WDTSupervisor_start(void);
+
+//*****************************************************************************
+//
+//! The monitor: clears the watchdog if every supervised task is within its
+//! deadline.
+//!
+//! Call it periodically from one low priority context, more often than the
+//! watchdog period. Once a task is found late it records it and never
+//! clears the watchdog again.
+//!
+//! \return false once a task has been found late, the reset is then coming.
+//
+//*****************************************************************************
+extern bool WDTSupervisor_service(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif /* WDT_SUPERVISOR_H_ */
@@ -0,0 +1,139 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 GPIO - Fast Pin Access Benchmark
+ *
+ * Description: Compares the table-driven DriverLib GPIO calls against the
+ * compile-time resolved macros in gpio_fast.h. Each routine drives P1.0
+ * (LED1) BENCH_ITERATIONS times and is timed with the DWT cycle counter.
+ * Results land in the benchResults structure; inspect it in the debugger
+ * once P2.1 (green LED) turns on. Run "make size" in the gcc directory to
+ * print the code size and disassembly of every bench_* routine.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.0  |---> P1.0 LED (toggled by the benchmark)
+ *            |            P2.1  |---> P2.1 LED (benchmark done)
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include <ti/devices/msp432p4xx/driverlib/gpio_fast.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BENCH_ITERATIONS 1000
+
+#define LED1       GPIO_FAST_PIN(GPIO_PORT_P1, 0)
+#define LED2_GREEN GPIO_FAST_PIN(GPIO_PORT_P2, 1)
+
+/* Cycles per operation, averaged over BENCH_ITERATIONS */
+typedef struct {
+  uint32_t driverlibSetClear;
+  uint32_t fastSetClear;
+  uint32_t driverlibConfigure;
+  uint32_t fastConfigure;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+__attribute__((noinline)) void bench_driverlibSetClear(void) {
+  GPIO_setOutputHighOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+}
+
+__attribute__((noinline)) void bench_fastSetClear(void) {
+  GPIO_FAST_SET_HIGH(LED1);
+  GPIO_FAST_SET_LOW(LED1);
+}
+
+/* Three RGB LED pins on P2 as GPIO outputs, driven low */
+__attribute__((noinline)) void bench_driverlibConfigure(void) {
+  GPIO_setAsOutputPin(GPIO_PORT_P2, GPIO_PIN0 | GPIO_PIN1 | GPIO_PIN2);
+  GPIO_setOutputLowOnPin(GPIO_PORT_P2, GPIO_PIN0 | GPIO_PIN1 | GPIO_PIN2);
+}
+
+__attribute__((noinline)) void bench_fastConfigure(void) {
+  GPIO_FAST_PORT_CLEAR(GPIO_PORT_P2, GPIO_FAST_OFS_SEL0, 0x07);
+  GPIO_FAST_PORT_CLEAR(GPIO_PORT_P2, GPIO_FAST_OFS_SEL1, 0x07);
+  GPIO_FAST_PORT_CLEAR(GPIO_PORT_P2, GPIO_FAST_OFS_OUT, 0x07);
+  GPIO_FAST_PORT_SET(GPIO_PORT_P2, GPIO_FAST_OFS_DIR, 0x07);
+}
+
+/* Measures the empty routine too, so both loops are the same code */
+__attribute__((noinline)) void bench_empty(void) {}
+
+__attribute__((noinline)) static uint32_t bench_loop(void (*routine)(void)) {
+  uint32_t start, i;
+
+  start = DWT->CYCCNT;
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    routine();
+  }
+
+  return DWT->CYCCNT - start;
+}
+
+/* Less the cost of the loop and the call, measured with an empty routine */
+static uint32_t bench_run(void (*routine)(void)) {
+  uint32_t overhead = bench_loop(bench_empty);
+
+  return (bench_loop(routine) - overhead) / BENCH_ITERATIONS;
+}
+
+int main(void) {
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  /* Start the cycle counter */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT       = 0;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  GPIO_FAST_SET_AS_OUTPUT(LED1);
+
+  benchResults.driverlibSetClear  = bench_run(bench_driverlibSetClear);
+  benchResults.fastSetClear       = bench_run(bench_fastSetClear);
+  benchResults.driverlibConfigure = bench_run(bench_driverlibConfigure);
+  benchResults.fastConfigure      = bench_run(bench_fastConfigure);
+
+  GPIO_FAST_SET_HIGH(LED2_GREEN);
+
+  while (1) {
+    MAP_PCM_gotoLPM0();
+  }
+}
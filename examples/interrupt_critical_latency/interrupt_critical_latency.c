@@ -0,0 +1,205 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Interrupt - Critical Section Latency
+ *
+ * Description: Measures worst-case interrupt latency while the flash driver
+ * programs a sector and the I2C master runs transactions. The priority plan
+ * is applied with Interrupt_applyPriorityPlan and TA0_0 is promoted to
+ * INTERRUPT_PRIORITY_TOP, which the flash critical sections (BASEPRI at
+ * INTERRUPT_CRITICAL_FLASH) never mask. TA1_0 stays at its planned
+ * INTERRUPT_PRIORITY_TIMER level for comparison and is held off for the
+ * duration of each flash operation.
+ *
+ * Both timers run in up mode from SMCLK (= MCLK, 3 MHz), so the counter
+ * value read first thing in the handler is the entry latency in cycles.
+ * TA1 latency saturates at one period (~21 ms). Results land in the
+ * benchResults structure; inspect it in the debugger once P2.1 (green LED)
+ * turns on.
+ *
+ * The last sector of flash bank 1 is erased and programmed; the code and
+ * the TA0_0 handler run from bank 0. Without pull-ups (or a device) on the
+ * I2C lines the transactions time out and exercise bus recovery instead.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.6  |<--> SDA (UCB0)
+ *            |            P1.7  |---> SCL (UCB0)
+ *            |            P2.1  |---> P2.1 LED (benchmark done)
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BENCH_ROUNDS       32
+#define BENCH_FLASH_SECTOR 0x001FF000
+#define BENCH_FLASH_LENGTH 256
+#define BENCH_I2C_ADDRESS  0x48
+#define BENCH_I2C_BYTES    16
+#define BENCH_I2C_TIMEOUT  2000
+
+#define TOP_PERIOD 300 /* 100 us */
+
+/* Worst entry latency in cycles and number of entries, per interrupt */
+typedef struct {
+  uint32_t topMaxCycles;
+  uint32_t topCount;
+  uint32_t timerMaxCycles;
+  uint32_t timerCount;
+  uint32_t flashFailures;
+  uint32_t i2cTimeouts;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+static uint8_t flashData[BENCH_FLASH_LENGTH];
+
+static const Timer_A_UpModeConfig topTimerConfig = {
+    TIMER_A_CLOCKSOURCE_SMCLK,         TIMER_A_CLOCKSOURCE_DIVIDER_1,
+    TOP_PERIOD - 1,                    TIMER_A_TAIE_INTERRUPT_DISABLE,
+    TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE, TIMER_A_DO_CLEAR};
+
+static const Timer_A_UpModeConfig lowTimerConfig = {
+    TIMER_A_CLOCKSOURCE_SMCLK,         TIMER_A_CLOCKSOURCE_DIVIDER_1,
+    0xFFFF,                            TIMER_A_TAIE_INTERRUPT_DISABLE,
+    TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE, TIMER_A_DO_CLEAR};
+
+static const eUSCI_I2C_MasterConfig i2cConfig = {
+    EUSCI_B_I2C_CLOCKSOURCE_SMCLK, 3000000, EUSCI_B_I2C_SET_DATA_RATE_100KBPS,
+    0, EUSCI_B_I2C_NO_AUTO_STOP};
+
+static const I2C_BusRecoveryConfig i2cRecovery = {
+    &i2cConfig,   GPIO_PORT_P1, GPIO_PIN7, GPIO_PORT_P1, GPIO_PIN6,
+    GPIO_PRIMARY_MODULE_FUNCTION};
+
+void TA0_0_IRQHandler(void) {
+  uint32_t latency = TIMER_A0->R;
+
+  TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+  if (latency > benchResults.topMaxCycles)
+    benchResults.topMaxCycles = latency;
+  benchResults.topCount++;
+}
+
+void TA1_0_IRQHandler(void) {
+  uint32_t latency = TIMER_A1->R;
+
+  TIMER_A1->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+  if (latency > benchResults.timerMaxCycles)
+    benchResults.timerMaxCycles = latency;
+  benchResults.timerCount++;
+}
+
+static void bench_flash(void) {
+  MAP_FlashCtl_A_unprotectMemory(BENCH_FLASH_SECTOR,
+                                 BENCH_FLASH_SECTOR + 4096 - 1);
+
+  if (!FlashCtl_A_eraseSector(BENCH_FLASH_SECTOR) ||
+      !FlashCtl_A_programMemory(flashData, (void *)BENCH_FLASH_SECTOR,
+                                BENCH_FLASH_LENGTH))
+    benchResults.flashFailures++;
+
+  MAP_FlashCtl_A_protectMemory(BENCH_FLASH_SECTOR,
+                               BENCH_FLASH_SECTOR + 4096 - 1);
+}
+
+static void bench_i2c(void) {
+  uint32_t i;
+  bool     ok;
+
+  MAP_I2C_setSlaveAddress(EUSCI_B0_BASE, BENCH_I2C_ADDRESS);
+
+  ok = I2C_masterSendMultiByteStartWithTimeoutUs(EUSCI_B0_BASE, 0,
+                                                 BENCH_I2C_TIMEOUT);
+  for (i = 1; ok && i < BENCH_I2C_BYTES - 1; i++)
+    ok = I2C_masterSendMultiByteNextWithTimeoutUs(EUSCI_B0_BASE, i,
+                                                  BENCH_I2C_TIMEOUT);
+  if (ok)
+    ok = I2C_masterSendMultiByteFinishWithTimeoutUs(EUSCI_B0_BASE, i,
+                                                    BENCH_I2C_TIMEOUT);
+  if (!ok)
+    benchResults.i2cTimeouts++;
+}
+
+int main(void) {
+  uint32_t i;
+
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  for (i = 0; i < BENCH_FLASH_LENGTH; i++)
+    flashData[i] = i;
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P2, GPIO_PIN1);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P2, GPIO_PIN1);
+
+  /* I2C master on UCB0 */
+  MAP_GPIO_setAsPeripheralModuleFunctionInputPin(
+      GPIO_PORT_P1, GPIO_PIN6 | GPIO_PIN7, GPIO_PRIMARY_MODULE_FUNCTION);
+  MAP_I2C_initMaster(EUSCI_B0_BASE, &i2cConfig);
+  I2C_setBusRecoveryConfig(EUSCI_B0_BASE, &i2cRecovery);
+  MAP_I2C_enableModule(EUSCI_B0_BASE);
+
+  /* Everything at its planned level, TA0_0 above all critical sections */
+  Interrupt_applyPriorityPlan();
+  MAP_Interrupt_setPriority(INT_TA0_0, INTERRUPT_PRIORITY_TOP);
+
+  MAP_Timer_A_configureUpMode(TIMER_A0_BASE, &topTimerConfig);
+  MAP_Timer_A_configureUpMode(TIMER_A1_BASE, &lowTimerConfig);
+  MAP_Interrupt_enableInterrupt(INT_TA0_0);
+  MAP_Interrupt_enableInterrupt(INT_TA1_0);
+  MAP_Timer_A_startCounter(TIMER_A0_BASE, TIMER_A_UP_MODE);
+  MAP_Timer_A_startCounter(TIMER_A1_BASE, TIMER_A_UP_MODE);
+  MAP_Interrupt_enableMaster();
+
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    bench_flash();
+    bench_i2c();
+  }
+
+  MAP_Interrupt_disableInterrupt(INT_TA0_0);
+  MAP_Interrupt_disableInterrupt(INT_TA1_0);
+  MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P2, GPIO_PIN1);
+
+  while (1) {
+    MAP_PCM_gotoLPM0();
+  }
+}
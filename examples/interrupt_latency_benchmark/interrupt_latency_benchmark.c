@@ -0,0 +1,139 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Interrupt - Vector Table Latency Benchmark
+ *
+ * Description: Measures interrupt entry latency with the vector table in
+ * flash and in SRAM. bench_flashHandler is bound to the T32_INT2 vector at
+ * link time with INTERRUPT_BIND_HANDLER, and the matching
+ * Interrupt_registerInterrupt call is shown to leave the table in flash.
+ * Registering bench_ramHandler instead moves the table to SRAM. Both
+ * handlers are identical, so the difference is the vector fetch.
+ *
+ * The interrupt is pended through NVIC->STIR with the DWT cycle counter
+ * captured just before; the handler captures it again as its first store.
+ * Results are averaged over BENCH_ITERATIONS at 48 MHz, where flash wait
+ * states are in play, and land in the benchResults structure. Inspect it in
+ * the debugger once P2.1 (green LED) turns on. Run "make size" in the gcc
+ * directory to print the code of both handlers.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P2.1  |---> P2.1 LED (benchmark done)
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BENCH_ITERATIONS 256
+#define BENCH_INTERRUPT  INT_T32_INT2
+
+/* Cycles from the STIR write to the first store in the handler */
+typedef struct {
+  uint32_t flashVectorCycles;
+  uint32_t ramVectorCycles;
+  uint32_t flashVtor;
+  uint32_t vtorAfterSameHandler;
+  uint32_t vtorAfterNewHandler;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+static volatile uint32_t entryCycles;
+
+void bench_flashHandler(void) { entryCycles = DWT->CYCCNT; }
+
+void bench_ramHandler(void) { entryCycles = DWT->CYCCNT; }
+
+INTERRUPT_BIND_HANDLER(T32_INT2_IRQHandler, bench_flashHandler);
+
+static uint32_t bench_run(void) {
+  uint32_t start, total, i;
+
+  total = 0;
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    entryCycles = 0;
+    start       = DWT->CYCCNT;
+    NVIC->STIR  = BENCH_INTERRUPT - 16;
+    while (entryCycles == 0) {}
+    total += entryCycles - start;
+  }
+
+  return total / BENCH_ITERATIONS;
+}
+
+int main(void) {
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  /* 48 MHz from the DCO, flash wait states as needed at that speed */
+  MAP_PCM_setCoreVoltageLevel(PCM_VCORE1);
+  MAP_FlashCtl_A_setWaitState(FLASH_A_BANK0, 3);
+  MAP_FlashCtl_A_setWaitState(FLASH_A_BANK1, 3);
+  MAP_CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_48);
+
+  /* Start the cycle counter */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT       = 0;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P2, GPIO_PIN1);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P2, GPIO_PIN1);
+
+  MAP_Interrupt_enableInterrupt(BENCH_INTERRUPT);
+  MAP_Interrupt_enableMaster();
+
+  /* Statically bound: registering the same handler keeps the flash table */
+  benchResults.flashVtor = SCB->VTOR;
+  Interrupt_registerInterrupt(BENCH_INTERRUPT, bench_flashHandler);
+  benchResults.vtorAfterSameHandler = SCB->VTOR;
+  benchResults.flashVectorCycles    = bench_run();
+
+  /* A different handler at run time falls back to the SRAM table */
+  Interrupt_registerInterrupt(BENCH_INTERRUPT, bench_ramHandler);
+  benchResults.vtorAfterNewHandler = SCB->VTOR;
+  benchResults.ramVectorCycles     = bench_run();
+
+  MAP_Interrupt_disableInterrupt(BENCH_INTERRUPT);
+  MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P2, GPIO_PIN1);
+
+  while (1) {
+    MAP_PCM_gotoLPM0();
+  }
+}
@@ -0,0 +1,209 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 PCM - Dynamic Voltage and Frequency Scaling Governor
+ *
+ * Description: A 1 ms tick from Timer_A1 on ACLK queues a fixed amount of
+ * work, which the main loop does and then idles in LPM0 through DVFS_idle.
+ * Every 2 seconds the work per tick changes, from a light load the 3 MHz
+ * level handles easily to one that needs 48 MHz. The governor measures the
+ * busy fraction every 10 ms and moves MCLK between 3, 12, 24 and 48 MHz,
+ * raising VCORE and flash wait states before speeding up and lowering them
+ * after slowing down.
+ *
+ * Timer_A0 blinks the LED on P1.0 at 5 Hz from SMCLK. Its clock change
+ * notifier stops it before each SMCLK change and derives its period from the
+ * new SMCLK after, so the blink rate never changes with the level. The step
+ * between 24 and 48 MHz leaves SMCLK, and so the blink, alone. A second
+ * notifier, on MCLK, counts the level changes.
+ * ACLK = REFO = 32 kHz, MCLK = HSMCLK = DCO, SMCLK = DCO up to 24 MHz
+ *
+ * benchResults holds, per workload, the level the governor settled at and
+ * the load measured there, plus the number of level changes and of ticks
+ * that found the previous tick's work still queued.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.0  |---> LED, 5 Hz at every level
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TICK_COUNT     (32768 / 1000) // ACLK counts per ~1 ms tick
+#define TICKS_PER_LOAD 2000
+#define LOADS          4
+#define BLINK_HZ       10 // toggles per second
+
+/* Loop iterations of work per tick, about 8 cycles each: roughly 13% of
+ * 3 MHz, 67% of 12 MHz, 67% of 24 MHz and 75% of 48 MHz */
+static const uint32_t workPerTick[LOADS] = {50, 1000, 2000, 4500};
+
+typedef struct {
+  uint8_t  level[LOADS];
+  uint8_t  load[LOADS];
+  uint32_t levelChanges;
+  uint32_t overruns;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+static volatile uint32_t pending;
+static volatile uint32_t ticks;
+
+/* Governor Configuration Parameter */
+static const DVFS_Config dvfsConfig = {
+    10000,            // load measured over 10 ms
+    80,               // up a level above 80% busy
+    30,               // down a level below 30% busy
+    DVFS_LEVEL_3MHZ,  // lowest level
+    DVFS_LEVEL_48MHZ  // highest level
+};
+
+/* Timer_A1 tick, on ACLK so it keeps its rate at every level */
+static const Timer_A_UpModeConfig tickConfig = {
+    TIMER_A_CLOCKSOURCE_ACLK,            // ACLK Clock Source
+    TIMER_A_CLOCKSOURCE_DIVIDER_1,       // ACLK/1 = 32.768 kHz
+    TICK_COUNT - 1,                      // ~1 ms
+    TIMER_A_TAIE_INTERRUPT_DISABLE,      // Disable Timer interrupt
+    TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE,  // Enable CCR0 interrupt
+    TIMER_A_DO_CLEAR                     // Clear value
+};
+
+/* Timer_A0 blink, on SMCLK, its period set by the notifier */
+static Timer_A_UpModeConfig blinkConfig = {
+    TIMER_A_CLOCKSOURCE_SMCLK,           // SMCLK Clock Source
+    TIMER_A_CLOCKSOURCE_DIVIDER_64,      // SMCLK/64
+    0,                                   // from SMCLK
+    TIMER_A_TAIE_INTERRUPT_DISABLE,      // Disable Timer interrupt
+    TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE,  // Enable CCR0 interrupt
+    TIMER_A_DO_CLEAR                     // Clear value
+};
+
+static void blinkStop(const CS_ClockChange *change) {
+  MAP_Timer_A_stopTimer(TIMER_A0_BASE);
+}
+
+static void blinkAt(uint32_t smclk) {
+  blinkConfig.timerPeriod = smclk / 64 / BLINK_HZ - 1;
+  MAP_Timer_A_configureUpMode(TIMER_A0_BASE, &blinkConfig);
+  MAP_Timer_A_startCounter(TIMER_A0_BASE, TIMER_A_UP_MODE);
+}
+
+static void blinkStart(const CS_ClockChange *change) {
+  blinkAt(change->newFrequency.smclk);
+}
+
+static void levelChanged(const CS_ClockChange *change) {
+  benchResults.levelChanges++;
+}
+
+static CS_ClockNotifier blinkNotifier = {CS_SMCLK, blinkStop, blinkStart};
+static CS_ClockNotifier levelNotifier = {CS_MCLK, 0, levelChanged};
+
+static void work(uint32_t iterations) {
+  volatile uint32_t count = iterations;
+
+  while (count)
+    count--;
+}
+
+int main(void) {
+  uint32_t load;
+
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+
+  /* ACLK from REFO at 32 kHz, untouched by the governor */
+  MAP_CS_setReferenceOscillatorFrequency(CS_REFO_32KHZ);
+  MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+  /* The governor measures load on the 64-bit time base */
+  Timestamp_init(TIMER32_0_BASE);
+
+  /* Blinking from the clocks out of reset, the notifier follows them */
+  blinkAt(CS_getSMCLK());
+  CS_registerClockNotifier(&blinkNotifier);
+  CS_registerClockNotifier(&levelNotifier);
+  DVFS_init(&dvfsConfig, DVFS_LEVEL_3MHZ);
+
+  MAP_Timer_A_configureUpMode(TIMER_A1_BASE, &tickConfig);
+  MAP_Interrupt_enableInterrupt(INT_TA0_0);
+  MAP_Interrupt_enableInterrupt(INT_TA1_0);
+  MAP_Timer_A_startCounter(TIMER_A1_BASE, TIMER_A_UP_MODE);
+
+  MAP_Interrupt_enableMaster();
+
+  while (1) {
+    /* Checked with interrupts off so a tick cannot slip in between the
+     * check and the sleep; DVFS_idle still wakes on it */
+    MAP_Interrupt_disableMaster();
+    if (pending == 0) {
+      DVFS_idle();
+      MAP_Interrupt_enableMaster();
+      continue;
+    }
+    pending--;
+    load = (ticks / TICKS_PER_LOAD) % LOADS;
+    MAP_Interrupt_enableMaster();
+
+    work(workPerTick[load]);
+
+    benchResults.level[load] = DVFS_getLevel();
+    benchResults.load[load]  = DVFS_getLoad();
+  }
+}
+
+void TA0_0_IRQHandler(void) {
+  MAP_Timer_A_clearCaptureCompareInterrupt(TIMER_A0_BASE,
+                                           TIMER_A_CAPTURECOMPARE_REGISTER_0);
+  MAP_GPIO_toggleOutputOnPin(GPIO_PORT_P1, GPIO_PIN0);
+}
+
+void TA1_0_IRQHandler(void) {
+  MAP_Timer_A_clearCaptureCompareInterrupt(TIMER_A1_BASE,
+                                           TIMER_A_CAPTURECOMPARE_REGISTER_0);
+  if (pending)
+    benchResults.overruns++;
+  pending++;
+  ticks++;
+}
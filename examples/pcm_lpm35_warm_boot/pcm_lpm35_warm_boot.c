@@ -0,0 +1,213 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 PCM - LPM3.5 Warm Boot
+ *
+ * Description: The device wakes from LPM3.5 once a second on the RTC
+ * prescaler interrupt, pulses the LED on P1.0 and shuts down again. Where
+ * pcm_lpm35_rtc_wakeup starts over from scratch on every wake, this example
+ * saves a context before each shutdown: the clocks, the GPIO and NVIC
+ * registers and its own state, in the first SRAM block, which LPM3.5 keeps.
+ * On the next wake WarmBoot_restore writes them back and releases the I/O,
+ * without going through the GPIO, LFXT and RTC set up again.
+ *
+ * To compare, every other wake ignores the context and does the full
+ * initialisation. The startup code starts the DWT cycle counter in
+ * Reset_Handler and benchResults, itself kept through LPM3.5, holds the
+ * cycles from there to ready, at MCLK = 3 MHz:
+ *  - powerUpCycles, the first boot, including the LFXT start up
+ *  - coldWakeCycles, a wake through the full initialisation
+ *  - warmWakeCycles, a wake through the restored context
+ * The time the device takes to come out of LPM3.5 before Reset_Handler is
+ * the same for both and not counted.
+ * ACLK = BCLK = LFXT = 32 kHz, MCLK = SMCLK = DCO = 3 MHz
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |              PJ.0|---- LFXT 32 kHz
+ *          --|RST           PJ.1|----
+ *            |                  |
+ *            |              P1.0|---> LED, lit from ready to shutdown
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LFXT_FREQUENCY 32768
+#define HFXT_FREQUENCY 48000000
+
+typedef struct {
+  uint32_t powerUpCycles;
+  uint32_t coldWakeCycles;
+  uint32_t warmWakeCycles;
+  uint32_t wakes;
+} BenchResults;
+
+WARMBOOT_RETAINED volatile BenchResults benchResults;
+
+/* The application's own state, only valid through warm boots */
+typedef struct {
+  uint32_t warmWakes;
+} AppState;
+
+static WARMBOOT_RETAINED AppState         appState;
+static WARMBOOT_RETAINED WarmBoot_Context context;
+
+/* GPIO first, then the RTC interrupt enable */
+static const WarmBoot_Register registers[] = {
+    WARMBOOT_REGISTER(PA->OUT),   WARMBOOT_REGISTER(PA->DIR),
+    WARMBOOT_REGISTER(PB->OUT),   WARMBOOT_REGISTER(PB->DIR),
+    WARMBOOT_REGISTER(PC->OUT),   WARMBOOT_REGISTER(PC->DIR),
+    WARMBOOT_REGISTER(PD->OUT),   WARMBOOT_REGISTER(PD->DIR),
+    WARMBOOT_REGISTER(PE->OUT),   WARMBOOT_REGISTER(PE->DIR),
+    WARMBOOT_REGISTER(PJ->OUT),   WARMBOOT_REGISTER(PJ->DIR),
+    WARMBOOT_REGISTER(PJ->SEL0),  WARMBOOT_REGISTER(PJ->SEL1),
+    WARMBOOT_REGISTER(NVIC->ISER[0]),
+};
+
+#define REGISTER_COUNT (sizeof(registers) / sizeof(registers[0]))
+
+/*
+ * Initializing calendar to 11/19/2013 (Tuesday) 10:10:00
+ */
+const RTC_C_Calendar calendarTime = {
+    0,   /* Seconds */
+    10,  /* Minutes */
+    10,  /* Hour */
+    2,   /* Day of Week */
+    19,  /* Day */
+    11,  /* Month */
+    2013 /* Year */
+};
+
+/* What pcm_lpm35_rtc_wakeup does on every boot */
+static void coldBoot(void) {
+  appState.warmWakes = 0;
+
+  /* Terminating all remaining pins to minimize power consumption */
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_PA, PIN_ALL16);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_PB, PIN_ALL16);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_PC, PIN_ALL16);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_PD, PIN_ALL16);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_PE, PIN_ALL16);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_PJ, PIN_ALL16);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_PA, PIN_ALL16);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_PB, PIN_ALL16);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_PC, PIN_ALL16);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_PD, PIN_ALL16);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_PE, PIN_ALL16);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_PJ, PIN_ALL16);
+
+  /* Configuring LFXTOUT and LFXTIN for XTAL operation */
+  MAP_GPIO_setAsPeripheralModuleFunctionInputPin(
+      GPIO_PORT_PJ, GPIO_PIN0 | GPIO_PIN1, GPIO_PRIMARY_MODULE_FUNCTION);
+
+  /* I/O set up again, the latch can go */
+  WarmBoot_releaseIO();
+
+  /* Starting LFXT, ACLK and BCLK from it */
+  MAP_CS_startLFXT(CS_LFXT_DRIVE0);
+  MAP_CS_initClockSignal(CS_ACLK, CS_LFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  MAP_CS_initClockSignal(CS_BCLK, CS_LFXTCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+  /* Initializing RTC to 11/19/2013 10:10:00, interrupt once a second from
+   * RT1PS: 32768 / 256 / 128 */
+  MAP_RTC_C_initCalendar(&calendarTime, RTC_C_FORMAT_BINARY);
+  MAP_RTC_C_definePrescaleEvent(RTC_C_PRESCALE_1, RTC_C_PSEVENTDIVIDER_128);
+  MAP_RTC_C_enableInterrupt(RTC_C_PRESCALE_TIMER1_INTERRUPT);
+  MAP_Interrupt_enableInterrupt(INT_RTC_C);
+  MAP_RTC_C_startClock();
+}
+
+int main(void) {
+  uint_fast8_t reason;
+  uint32_t     ready;
+  bool         warm = false;
+
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  reason = WarmBoot_getWakeReason();
+  if (reason != WARMBOOT_LPM35) {
+    benchResults.powerUpCycles  = 0;
+    benchResults.coldWakeCycles = 0;
+    benchResults.warmWakeCycles = 0;
+    benchResults.wakes          = 0;
+  }
+
+  /* Every other wake goes through the full initialisation, to compare */
+  if (benchResults.wakes & 1)
+    warm = WarmBoot_restore(&context, registers, REGISTER_COUNT, &appState,
+                            sizeof(appState));
+  if (!warm)
+    coldBoot();
+
+  /* Not kept through the reset */
+  MAP_CS_setExternalClockSourceFrequency(LFXT_FREQUENCY, HFXT_FREQUENCY);
+
+  ready = DWT->CYCCNT;
+  if (warm)
+    benchResults.warmWakeCycles = ready;
+  else if (reason == WARMBOOT_LPM35)
+    benchResults.coldWakeCycles = ready;
+  else
+    benchResults.powerUpCycles = ready;
+  benchResults.wakes++;
+  if (warm)
+    appState.warmWakes++;
+
+  /* The wake's RTC interrupt runs here if it has not yet */
+  MAP_Interrupt_enableMaster();
+
+  MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  __delay_cycles(30000);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+
+  /* Disabling high side voltage monitor/supervisor, reset by the wake */
+  MAP_PSS_disableHighSide();
+
+  /* Last, with the registers as the next wake should find them */
+  WarmBoot_save(&context, registers, REGISTER_COUNT, &appState,
+                sizeof(appState));
+  MAP_PCM_shutdownDevice(PCM_LPM35_VCORE0);
+}
+
+/* RTC ISR */
+void RTC_C_IRQHandler(void) {
+  MAP_RTC_C_clearInterruptFlag(MAP_RTC_C_getInterruptStatus());
+}
@@ -0,0 +1,214 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 PCM - Power State Transitions in the Background
+ *
+ * Description: Every half second Timer_A0 starts a change to the next of
+ * four active mode power states, each with the MCLK it supports:
+ *  - AM_LDO_VCORE0 at 12 MHz
+ *  - AM_DCDC_VCORE1 at 48 MHz
+ *  - AM_DCDC_VCORE0 at 24 MHz
+ *  - AM_LDO_VCORE1 at 48 MHz
+ * PCM_startPowerStateTransition takes the steps one at a time, and SysTick
+ * moves it on with PCM_pollPowerStateTransition as each step completes.
+ * The PCM interrupt, enabled for invalid transitions and DC-DC errors, polls
+ * as well so that a failure ends the change at once. The clocks change from
+ * the changeClocks callback: going up once the core voltage has been
+ * raised, going down before it is lowered.
+ *
+ * Where PCM_setPowerState would spin in its caller until the last step,
+ * the main loop here keeps running. benchResults counts the passes it makes
+ * while a change is under way, the changes completed and failed, and the
+ * longest change in microseconds.
+ * ACLK = REFO = 32 kHz, MCLK = HSMCLK = DCO, SMCLK = DCO up to 24 MHz
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.0  |---> LED, lit while a change is under way
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TICK_COUNT  (32768 / 2) // ACLK counts per half second
+#define POLL_CYCLES 1500        // MCLK cycles between SysTick polls
+
+typedef struct {
+  uint8_t  powerState;
+  uint32_t dcoFrequency; // CS_DCO_FREQUENCY_x
+  uint32_t smclkDivider; // CS_CLOCK_DIVIDER_x
+  uint8_t  waitStates;
+} Level;
+
+#define LEVELS 4
+
+/* Flash wait states of the MSP432P4111 for each MCLK, from its datasheet */
+static const Level levels[LEVELS] = {
+    {PCM_AM_LDO_VCORE0, CS_DCO_FREQUENCY_12, CS_CLOCK_DIVIDER_1, 0},
+    {PCM_AM_DCDC_VCORE1, CS_DCO_FREQUENCY_48, CS_CLOCK_DIVIDER_2, 3},
+    {PCM_AM_DCDC_VCORE0, CS_DCO_FREQUENCY_24, CS_CLOCK_DIVIDER_1, 1},
+    {PCM_AM_LDO_VCORE1, CS_DCO_FREQUENCY_48, CS_CLOCK_DIVIDER_2, 3},
+};
+
+typedef struct {
+  uint32_t passesDuringChange;
+  uint32_t changes;
+  uint32_t failures;
+  uint32_t longestMicroseconds;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+static uint_fast8_t level;
+static uint64_t     changeStart;
+
+/* Timer_A0 tick, on ACLK so it keeps its rate at every level */
+static const Timer_A_UpModeConfig tickConfig = {
+    TIMER_A_CLOCKSOURCE_ACLK,            // ACLK Clock Source
+    TIMER_A_CLOCKSOURCE_DIVIDER_1,       // ACLK/1 = 32.768 kHz
+    TICK_COUNT - 1,                      // 500 ms
+    TIMER_A_TAIE_INTERRUPT_DISABLE,      // Disable Timer interrupt
+    TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE,  // Enable CCR0 interrupt
+    TIMER_A_DO_CLEAR                     // Clear value
+};
+
+static void setWaitStates(uint32_t waitStates) {
+  MAP_FlashCtl_A_setWaitState(FLASH_A_BANK0, waitStates);
+  MAP_FlashCtl_A_setWaitState(FLASH_A_BANK1, waitStates);
+}
+
+/* Called by the PCM at the step where the old and new MCLK both hold */
+static void changeClocks(void) {
+  const Level *to         = &levels[level];
+  uint32_t     waitStates = MAP_FlashCtl_A_getWaitState(FLASH_A_BANK0);
+
+  if (to->waitStates > waitStates)
+    setWaitStates(to->waitStates);
+
+  /* SMCLK divided down before the DCO speeds up under it */
+  if (to->smclkDivider > (CS->CTL1 & CS_CTL1_DIVS_MASK))
+    MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, to->smclkDivider);
+  MAP_CS_setDCOCenteredFrequency(to->dcoFrequency);
+  MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, to->smclkDivider);
+  Timestamp_rescale();
+
+  if (to->waitStates < waitStates)
+    setWaitStates(to->waitStates);
+}
+
+static void changed(bool success) {
+  uint32_t elapsed = (uint32_t)(Timestamp_getMicroseconds() - changeStart);
+
+  if (success)
+    benchResults.changes++;
+  else
+    benchResults.failures++;
+  if (elapsed > benchResults.longestMicroseconds)
+    benchResults.longestMicroseconds = elapsed;
+
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+}
+
+static PCM_Transition transition = {PCM_AM_LDO_VCORE0, changeClocks, changed};
+
+int main(void) {
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+
+  /* ACLK from REFO at 32 kHz, MCLK and SMCLK from the DCO */
+  MAP_CS_setReferenceOscillatorFrequency(CS_REFO_32KHZ);
+  MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  MAP_CS_initClockSignal(CS_HSMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+  /* Changes are timed on the 64-bit time base */
+  Timestamp_init(TIMER32_0_BASE);
+
+  /* The first level, the hard way */
+  MAP_PCM_setPowerState(levels[0].powerState);
+  changeClocks();
+
+  /* SysTick and the PCM error interrupts move the changes on */
+  MAP_SysTick_setPeriod(POLL_CYCLES);
+  MAP_SysTick_enableInterrupt();
+  MAP_SysTick_enableModule();
+  MAP_PCM_clearInterruptFlag(PCM_AM_INVALIDTRANSITION | PCM_DCDCERROR);
+  MAP_PCM_enableInterrupt(PCM_AM_INVALIDTRANSITION | PCM_DCDCERROR);
+  MAP_Interrupt_enableInterrupt(INT_PCM);
+
+  MAP_Timer_A_configureUpMode(TIMER_A0_BASE, &tickConfig);
+  MAP_Interrupt_enableInterrupt(INT_TA0_0);
+  MAP_Timer_A_startCounter(TIMER_A0_BASE, TIMER_A_UP_MODE);
+
+  MAP_Interrupt_enableMaster();
+
+  while (1) {
+    /* Work the application would otherwise have waited out */
+    if (PCM_isPowerStateTransitionPending()) {
+      benchResults.passesDuringChange++;
+      continue;
+    }
+
+    MAP_PCM_gotoLPM0();
+  }
+}
+
+void TA0_0_IRQHandler(void) {
+  MAP_Timer_A_clearCaptureCompareInterrupt(TIMER_A0_BASE,
+                                           TIMER_A_CAPTURECOMPARE_REGISTER_0);
+  if (PCM_isPowerStateTransitionPending())
+    return;
+
+  level                 = (level + 1) % LEVELS;
+  transition.powerState = levels[level].powerState;
+  changeStart           = Timestamp_getMicroseconds();
+  MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  if (!PCM_startPowerStateTransition(&transition)) {
+    /* The PCM was busy, the next tick tries the same level again */
+    level = (level + LEVELS - 1) % LEVELS;
+    MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  }
+}
+
+void SysTick_Handler(void) { PCM_pollPowerStateTransition(); }
+
+void PCM_IRQHandler(void) { PCM_pollPowerStateTransition(); }
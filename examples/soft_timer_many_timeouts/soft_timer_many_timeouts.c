@@ -0,0 +1,196 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Soft Timer - Many Timeouts on One Compare Register
+ *
+ * Description: Timer_A0 runs in continuous mode from ACLK (REFO, 32 kHz) and
+ * its CCR1 carries every timer below; CCR0 and CCR2-4 as well as Timer_A1-3
+ * stay free. Between expiries the device sleeps in LPM3.
+ *
+ *  - four periodic timers blink the LEDs at 1, 2, 3 and 4 Hz
+ *  - 32 one-shot timeouts of 2 s, each restarted every 100 ms by a periodic
+ *    "traffic" timer before it can expire, the way a protocol stack guards
+ *    its connections; none should ever run out
+ *  - one one-shot timer that restarts itself with delays growing from 1 to
+ *    64 ticks and back, exercising the finest level of the wheel
+ *
+ * benchResults holds the cost of SoftTimer_start and SoftTimer_stop in MCLK
+ * cycles at 3 MHz, measured with SysTick on a wheel holding all the timers,
+ * the number of expiries so far and the number of guard timeouts that ran
+ * out, which stays at zero.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.0  |---> P1.0 LED (1 Hz)
+ *            |            P2.0  |---> P2.0 LED (2 Hz)
+ *            |            P2.1  |---> P2.1 LED (3 Hz)
+ *            |            P2.2  |---> P2.2 LED (4 Hz)
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GUARD_COUNT   32
+#define GUARD_MS      2000
+#define TRAFFIC_MS    100
+#define CHAIN_LONGEST 64
+
+typedef struct {
+  uint32_t startCost;
+  uint32_t stopCost;
+  uint32_t expiries;
+  uint32_t guardsExpired;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+typedef struct {
+  uint_fast8_t  port;
+  uint_fast16_t pin;
+  uint32_t      halfPeriodMs;
+} Blinker;
+
+static const Blinker blinkers[] = {
+    {GPIO_PORT_P1, GPIO_PIN0, 500},
+    {GPIO_PORT_P2, GPIO_PIN0, 250},
+    {GPIO_PORT_P2, GPIO_PIN1, 167},
+    {GPIO_PORT_P2, GPIO_PIN2, 125},
+};
+
+#define BLINKER_COUNT (sizeof(blinkers) / sizeof(blinkers[0]))
+
+static SoftTimer_Timer blinkTimers[BLINKER_COUNT];
+static SoftTimer_Timer guardTimers[GUARD_COUNT];
+static SoftTimer_Timer trafficTimer;
+static SoftTimer_Timer chainTimer;
+
+static void blink(void *arg) {
+  const Blinker *blinker = arg;
+
+  MAP_GPIO_toggleOutputOnPin(blinker->port, blinker->pin);
+  benchResults.expiries++;
+}
+
+static void guardExpired(void *arg) {
+  (void)arg;
+  benchResults.guardsExpired++;
+  benchResults.expiries++;
+}
+
+/* Restarts every guard, long before its timeout */
+static void traffic(void *arg) {
+  uint_fast8_t i;
+
+  (void)arg;
+  for (i = 0; i < GUARD_COUNT; i++)
+    SoftTimer_start(&guardTimers[i], SOFTTIMER_MS(GUARD_MS), 0);
+  benchResults.expiries++;
+}
+
+static void chain(void *arg) {
+  static uint32_t delay = 1;
+  static bool     growing = true;
+
+  (void)arg;
+  if (delay == CHAIN_LONGEST)
+    growing = false;
+  else if (delay == 1)
+    growing = true;
+  delay = growing ? delay + 1 : delay - 1;
+
+  SoftTimer_start(&chainTimer, delay, 0);
+  benchResults.expiries++;
+}
+
+int main(void) {
+  uint32_t     start;
+  uint_fast8_t i;
+
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  /* ACLK from REFO at 32 kHz, the clock the timers count */
+  MAP_CS_setReferenceOscillatorFrequency(CS_REFO_32KHZ);
+  MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+  for (i = 0; i < BLINKER_COUNT; i++) {
+    MAP_GPIO_setAsOutputPin(blinkers[i].port, blinkers[i].pin);
+    MAP_GPIO_setOutputLowOnPin(blinkers[i].port, blinkers[i].pin);
+  }
+
+  SoftTimer_init(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1);
+
+  for (i = 0; i < BLINKER_COUNT; i++) {
+    SoftTimer_create(&blinkTimers[i], blink, (void *)&blinkers[i]);
+    SoftTimer_start(&blinkTimers[i], SOFTTIMER_MS(blinkers[i].halfPeriodMs),
+                    SOFTTIMER_MS(blinkers[i].halfPeriodMs));
+  }
+
+  for (i = 0; i < GUARD_COUNT; i++) {
+    SoftTimer_create(&guardTimers[i], guardExpired, 0);
+    SoftTimer_start(&guardTimers[i], SOFTTIMER_MS(GUARD_MS), 0);
+  }
+
+  SoftTimer_create(&trafficTimer, traffic, 0);
+  SoftTimer_start(&trafficTimer, SOFTTIMER_MS(TRAFFIC_MS),
+                  SOFTTIMER_MS(TRAFFIC_MS));
+
+  SoftTimer_create(&chainTimer, chain, 0);
+  SoftTimer_start(&chainTimer, 1, 0);
+
+  /* SysTick counts down MCLK cycles for the measurements */
+  MAP_SysTick_setPeriod(0x01000000);
+  MAP_SysTick_enableModule();
+
+  start = SysTick->VAL;
+  SoftTimer_start(&guardTimers[0], SOFTTIMER_MS(GUARD_MS), 0);
+  benchResults.startCost = start - SysTick->VAL;
+
+  start = SysTick->VAL;
+  SoftTimer_stop(&guardTimers[0]);
+  benchResults.stopCost = start - SysTick->VAL;
+
+  SoftTimer_start(&guardTimers[0], SOFTTIMER_MS(GUARD_MS), 0);
+  MAP_SysTick_disableModule();
+
+  MAP_Interrupt_enableMaster();
+
+  while (1) {
+    MAP_PCM_gotoLPM3();
+  }
+}
@@ -0,0 +1,165 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Startup - Fast Reset Path
+ *
+ * Description: The startup code raises the clocks before initialising
+ * memory. Reset_Handler calls SystemInit first, set here for 48 MHz at
+ * VCORE1 with three flash wait states. It then copies .data and clears
+ * .bss four words at a time with ldm/stm, runs the constructors and calls
+ * main, skipping crt0, which would clear .bss a second time byte by byte.
+ * The stock startup copies .data at 3 MHz before SystemInit.
+ *
+ * The DWT cycle counter times each phase from reset: the clocks, .data,
+ * .bss and the constructors. The times are kept in .noinit, a section the
+ * startup code leaves alone, and main turns them into microseconds in
+ * benchResults. Building with STARTUP_BASELINE=1 passed to make gives the
+ * stock order, for comparison; crt0 then clears .bss and runs the
+ * constructors in one phase, reported as .bss. .noinit also keeps
+ * a boot count through resets other than power up: S1 triggers a hard
+ * reset, which keeps SRAM, and the count goes up by one.
+ *
+ * To compare the two, run "make clean all" and then
+ * "make clean all STARTUP_BASELINE=1" in gcc/. The objects do not depend on
+ * the flag, hence the clean. Load each build, reset the device, and read
+ * benchResults in the debugger once main has run. The two
+ * resetToMainMicroseconds values give the time saved from reset to main.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.1  |<--- S1, hard reset
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Phases timed by the startup code, see startup_msp432p4111_gcc.c */
+#define STARTUP_CLOCK  0
+#define STARTUP_DATA   1
+#define STARTUP_BSS    2
+#define STARTUP_CTORS  3
+#define STARTUP_PHASES 4
+
+extern uint32_t startupCycles[STARTUP_PHASES];
+
+/* MCLK in MHz during each phase: SystemInit runs at the reset 3 MHz until
+ * its last few writes, and the stock startup copies .data before it */
+#define CLOCK_MHZ 3
+#ifdef STARTUP_BASELINE
+#define DATA_MHZ 3
+#else
+#define DATA_MHZ 48
+#endif
+#define BSS_MHZ 48
+#define CTORS_MHZ 48
+
+#define BOOT_MAGIC 0xB0075AFE
+
+typedef struct {
+  uint32_t magic;
+  uint32_t count;
+} BootCount;
+
+typedef struct {
+  uint32_t clockMicroseconds;
+  uint32_t dataMicroseconds;
+  uint32_t bssMicroseconds;
+  uint32_t ctorsMicroseconds; /* 0 for the baseline, within bss there */
+  uint32_t resetToMainMicroseconds;
+  uint32_t bootCount;
+  uint32_t check;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+/* Kept through any reset but a power up */
+static BootCount bootCount __attribute__((section(".noinit")));
+
+/* Initialised and zeroed data for the startup code to set up: 4 KB of
+ * .data and 64 KB of .bss */
+static uint32_t table[1024] = {1, 2, 3, 4};
+static uint32_t buffer[16384];
+
+int main(void) {
+  uint32_t mainCycles = DWT->CYCCNT;
+
+  /* Halting the Watchdog, SystemInit already has */
+  MAP_WDT_A_holdTimer();
+
+#ifdef STARTUP_BASELINE
+  /* crt0 is timed from the end of SystemInit to here, the constructors it
+   * runs included */
+  startupCycles[STARTUP_BSS] = mainCycles - startupCycles[STARTUP_DATA] -
+                               startupCycles[STARTUP_CLOCK];
+#else
+  (void)mainCycles;
+#endif
+  benchResults.clockMicroseconds = startupCycles[STARTUP_CLOCK] / CLOCK_MHZ;
+  benchResults.dataMicroseconds  = startupCycles[STARTUP_DATA] / DATA_MHZ;
+  benchResults.bssMicroseconds   = startupCycles[STARTUP_BSS] / BSS_MHZ;
+  benchResults.ctorsMicroseconds = startupCycles[STARTUP_CTORS] / CTORS_MHZ;
+  benchResults.resetToMainMicroseconds =
+      benchResults.clockMicroseconds + benchResults.dataMicroseconds +
+      benchResults.bssMicroseconds + benchResults.ctorsMicroseconds;
+
+  /* A power up or a supply fault leaves SRAM undefined */
+  if (MAP_ResetCtl_getPSSSource() || bootCount.magic != BOOT_MAGIC) {
+    bootCount.magic = BOOT_MAGIC;
+    bootCount.count = 0;
+  }
+  bootCount.count++;
+  benchResults.bootCount = bootCount.count;
+  MAP_ResetCtl_clearPSSFlags();
+
+  /* The data is there to be initialised, reading it keeps it linked in */
+  benchResults.check = table[0] + table[3] + buffer[0] + buffer[16383];
+
+  /* S1 resets the device */
+  MAP_GPIO_setAsInputPinWithPullUpResistor(GPIO_PORT_P1, GPIO_PIN1);
+  MAP_GPIO_interruptEdgeSelect(GPIO_PORT_P1, GPIO_PIN1,
+                               GPIO_HIGH_TO_LOW_TRANSITION);
+  MAP_GPIO_clearInterruptFlag(GPIO_PORT_P1, GPIO_PIN1);
+  MAP_GPIO_enableInterrupt(GPIO_PORT_P1, GPIO_PIN1);
+  MAP_Interrupt_enableInterrupt(INT_PORT1);
+  MAP_Interrupt_enableMaster();
+
+  while (1) { MAP_PCM_gotoLPM0(); }
+}
+
+void PORT1_IRQHandler(void) { MAP_ResetCtl_initiateHardReset(); }
@@ -0,0 +1,188 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Timer_A - Capture Meter with DMA
+ *
+ * Description: Timer_A1 generates a 20 kHz PWM on P7.7 whose duty steps from
+ * 10% to 90% and back, once a second. Timer_A0 measures it on P2.5 through a
+ * capture meter: both edges are captured on CCR2 and moved by the DMA into a
+ * ring buffer, with no interrupt per edge. CCR1 of Timer_A0 interrupts twice
+ * per counter period to date the captures; the main loop wakes from LPM0 on
+ * those and measures the last 50 periods every 32nd time.
+ * ACLK = REFO = 32 kHz, MCLK = SMCLK = DCO = 12 MHz
+ *
+ * benchResults holds the last measurement: frequency, duty, period jitter
+ * and the number of edges captured, the duty the generator was set to, and
+ * the cost of CaptureMeter_getStatistics in MCLK cycles, measured with
+ * SysTick.
+ *
+ * Connect P7.7 to P2.5.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P7.7  |--- TA1.1 ---+
+ *            |                  |             |
+ *            |            P2.5  |<-- TA0.2 ---+
+ *            |                  |
+ *            |            P1.0  |---> LED, toggled per measurement
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SMCLK_FREQUENCY 12000000
+#define PWM_PERIOD      (SMCLK_FREQUENCY / 20000)
+#define MEASURED        50
+#define WAKES_PER_RUN   32
+#define RUNS_PER_STEP   (SMCLK_FREQUENCY / 32768 / WAKES_PER_RUN)
+
+typedef struct {
+  float    frequency;
+  float    duty;
+  float    jitter;
+  uint32_t edges;
+  float    dutySet;
+  uint32_t statisticsCost;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+/* DMA Control Table */
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(controlTable, 1024)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#pragma data_alignment = 1024
+#elif defined(__GNUC__)
+__attribute__((aligned(1024)))
+#elif defined(__CC_ARM)
+__align(1024)
+#endif
+uint8_t controlTable[1024];
+
+/* Timer_A1 PWM Configuration Parameter */
+static Timer_A_PWMConfig pwmConfig = {
+    TIMER_A_CLOCKSOURCE_SMCLK,         // SMCLK Clock Source
+    TIMER_A_CLOCKSOURCE_DIVIDER_1,     // SMCLK/1 = 12MHz
+    PWM_PERIOD - 1,                    // 20 kHz
+    TIMER_A_CAPTURECOMPARE_REGISTER_1, // TA1.1 on P7.7
+    TIMER_A_OUTPUTMODE_RESET_SET,      // high for dutyCycle counts
+    PWM_PERIOD / 10                    // 10%
+};
+
+/* Capture Meter Configuration Parameter */
+static const CaptureMeter_Config meterConfig = {
+    TIMER_A_CLOCKSOURCE_SMCLK,                   // SMCLK Clock Source
+    TIMER_A_CLOCKSOURCE_DIVIDER_1,               // SMCLK/1 = 12MHz
+    SMCLK_FREQUENCY,                             // counts per second
+    TIMER_A_CAPTURECOMPARE_REGISTER_2,           // CCR2, DMA capable
+    TIMER_A_CAPTUREMODE_RISING_AND_FALLING_EDGE, // both, for the duty
+    TIMER_A_CAPTURE_INPUTSELECT_CCIxA            // P2.5
+};
+
+static CaptureMeter_Meter meter;
+
+int main(void) {
+  CaptureMeter_Statistics statistics;
+  uint32_t                wakes, runs, start;
+  bool                    rising;
+
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  /* DCO at 12 MHz for MCLK and SMCLK, which VCORE0 and no flash wait
+   * states support */
+  MAP_CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_12);
+  MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setAsPeripheralModuleFunctionOutputPin(GPIO_PORT_P7, GPIO_PIN7,
+                                                  GPIO_PRIMARY_MODULE_FUNCTION);
+  MAP_GPIO_setAsPeripheralModuleFunctionInputPin(GPIO_PORT_P2, GPIO_PIN5,
+                                                 GPIO_PRIMARY_MODULE_FUNCTION);
+
+  /* The meter leaves the DMA set up to the application */
+  MAP_DMA_enableModule();
+  MAP_DMA_setControlBase(controlTable);
+
+  MAP_Timer_A_generatePWM(TIMER_A1_BASE, &pwmConfig);
+  CaptureMeter_init(TIMER_A0_BASE, &meter, &meterConfig);
+
+  /* SysTick counts down MCLK cycles for the measurements */
+  MAP_SysTick_setPeriod(0x01000000);
+  MAP_SysTick_enableModule();
+
+  MAP_Interrupt_enableMaster();
+
+  wakes  = 0;
+  runs   = 0;
+  rising = true;
+
+  while (1) {
+    /* Woken by the meter's CCR1 interrupt, every 32768 SMCLK cycles */
+    MAP_PCM_gotoLPM0();
+    if (++wakes < WAKES_PER_RUN)
+      continue;
+    wakes = 0;
+
+    start = SysTick->VAL;
+    if (CaptureMeter_getStatistics(&meter, MEASURED, &statistics)) {
+      benchResults.statisticsCost = (start - SysTick->VAL) & 0x00FFFFFF;
+      benchResults.frequency      = statistics.frequency;
+      benchResults.duty           = statistics.duty;
+      benchResults.jitter         = statistics.jitter;
+    }
+    benchResults.edges   = CaptureMeter_getCount(&meter);
+    benchResults.dutySet = (float)pwmConfig.dutyCycle / PWM_PERIOD;
+    MAP_GPIO_toggleOutputOnPin(GPIO_PORT_P1, GPIO_PIN0);
+
+    /* Step the generator's duty by 10% */
+    if (++runs < RUNS_PER_STEP)
+      continue;
+    runs = 0;
+    if (pwmConfig.dutyCycle >= PWM_PERIOD * 9 / 10)
+      rising = false;
+    else if (pwmConfig.dutyCycle <= PWM_PERIOD / 10)
+      rising = true;
+    pwmConfig.dutyCycle += rising ? PWM_PERIOD / 10 : -(PWM_PERIOD / 10);
+    MAP_Timer_A_setCompareValue(TIMER_A1_BASE,
+                                TIMER_A_CAPTURECOMPARE_REGISTER_1,
+                                pwmConfig.dutyCycle);
+  }
+}
@@ -0,0 +1,129 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 Timestamp - Monotonic Clock Across MCLK Changes
+ *
+ * Description: Timer32 0 is the 64-bit time base. P1.0 (red LED) toggles
+ * every 500 ms measured with Timestamp_getMicroseconds while MCLK alternates
+ * between 3 MHz and 12 MHz from the DCO every 4 seconds. The blink rate does
+ * not change with the clock.
+ *
+ * Going up, Timestamp_rescale is called right after the change. Going down it
+ * is left out and the next read notices the new DCO setting on its own; the
+ * cycles between the change and that read are converted at the old rate,
+ * which here is a few microseconds.
+ *
+ * benchResults holds the cost of each read in MCLK cycles at 3 MHz,
+ * measured between two Timestamp_getCycles calls (so including one of them),
+ * and the number of clock changes so far.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.0  |---> P1.0 LED (500 ms blink)
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BLINK_US  500000
+#define SWITCH_US 4000000
+
+typedef struct {
+  uint32_t getCyclesCost;
+  uint32_t getMicrosecondsCost;
+  uint32_t clockChanges;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+static uint32_t measureCost(uint64_t (*read)(void)) {
+  uint64_t start, end;
+
+  start = Timestamp_getCycles();
+  read();
+  end = Timestamp_getCycles();
+
+  return (uint32_t)(end - start);
+}
+
+int main(void) {
+  uint64_t nextBlink, nextSwitch, now;
+  bool     fast = false;
+
+  /* Halting the Watchdog */
+  MAP_WDT_A_holdTimer();
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+
+  /* MCLK from the DCO at 3 MHz to start with */
+  MAP_CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_3);
+  MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+  Timestamp_init(TIMER32_0_BASE);
+  MAP_Interrupt_enableMaster();
+
+  benchResults.getCyclesCost       = measureCost(Timestamp_getCycles);
+  benchResults.getMicrosecondsCost = measureCost(Timestamp_getMicroseconds);
+
+  nextBlink  = BLINK_US;
+  nextSwitch = SWITCH_US;
+
+  while (1) {
+    now = Timestamp_getMicroseconds();
+
+    if (now >= nextBlink) {
+      MAP_GPIO_toggleOutputOnPin(GPIO_PORT_P1, GPIO_PIN0);
+      nextBlink += BLINK_US;
+    }
+
+    if (now >= nextSwitch) {
+      fast = !fast;
+      if (fast) {
+        MAP_CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_12);
+        Timestamp_rescale();
+      } else {
+        MAP_CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_3);
+      }
+
+      benchResults.clockChanges++;
+      nextSwitch += SWITCH_US;
+    }
+  }
+}
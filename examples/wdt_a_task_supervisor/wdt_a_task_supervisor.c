@@ -0,0 +1,183 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*******************************************************************************
+ * MSP432 WDT - Task Supervisor
+ *
+ * Description: The watchdog stays on, and is cleared only while every task
+ * it supervises keeps checking in. There are two tasks:
+ *  - the main loop, which checks in every time it wakes and must do so
+ *    within 100 ms
+ *  - the blink interrupt, Timer32 1 every 250 ms, which toggles P1.0 and
+ *    must check in within 500 ms
+ *
+ * The monitor runs from SysTick every 10 ms at the lowest interrupt
+ * priority, and the watchdog times out after 512K SMCLK cycles, about
+ * 175 ms at 3 MHz. S1 makes the main loop spin without checking in, and S2
+ * stops the blink interrupt. Either way the monitor finds the task late,
+ * records it in .noinit RAM and stops clearing the watchdog, which resets
+ * the device.
+ *
+ * After the reset the RGB LED shows what tripped it: red for the main
+ * loop, green for the blink task and blue if the watchdog ran out with
+ * every task on time, the monitor itself having stopped. benchResults
+ * holds the task, how late it was found and the watchdog resets since
+ * power up.
+ *
+ *                MSP432P4111
+ *             ------------------
+ *         /|\|                  |
+ *          | |                  |
+ *          --|RST         P1.1  |<--- S1, stall the main loop
+ *            |            P1.4  |<--- S2, stop the blink task
+ *            |                  |
+ *            |            P1.0  |---> LED, blink task
+ *            |            P2.0  |---> RGB red, main loop tripped
+ *            |            P2.1  |---> RGB green, blink task tripped
+ *            |            P2.2  |---> RGB blue, monitor stopped
+ *            |                  |
+ *
+ ******************************************************************************/
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Standard Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Task identifiers, kept from one build to the next */
+#define TASK_MAIN  0
+#define TASK_BLINK 1
+
+#define MAIN_DEADLINE_MS  100
+#define BLINK_DEADLINE_MS 500
+
+/* At the 3 MHz MCLK */
+#define MONITOR_PERIOD 30000  /* 10 ms */
+#define BLINK_PERIOD   750000 /* 250 ms */
+
+typedef struct {
+  uint32_t resetCause; /* TASK_, WDTSUPERVISOR_MONITOR or _NO_TRIP */
+  uint32_t lateMicroseconds;
+  uint32_t watchdogResets;
+} BenchResults;
+
+volatile BenchResults benchResults;
+
+static volatile bool stallMain;
+
+int main(void) {
+  const WDTSupervisor_Record *record;
+  uint_fast8_t                cause;
+
+  /* The watchdog held and the last reset looked at before anything else */
+  WDTSupervisor_init(WDT_A_CLOCKSOURCE_SMCLK, WDT_A_CLOCKITERATIONS_512K);
+
+  cause  = WDTSupervisor_getResetCause();
+  record = WDTSupervisor_getRecord();
+  benchResults.resetCause = cause;
+  if (cause != WDTSUPERVISOR_NO_TRIP) {
+    benchResults.lateMicroseconds = record->microseconds;
+    benchResults.watchdogResets   = record->resets;
+  }
+
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  MAP_GPIO_setAsOutputPin(GPIO_PORT_P2, GPIO_PIN0 | GPIO_PIN1 | GPIO_PIN2);
+  MAP_GPIO_setOutputLowOnPin(GPIO_PORT_P2, GPIO_PIN0 | GPIO_PIN1 | GPIO_PIN2);
+  if (cause == TASK_MAIN)
+    MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P2, GPIO_PIN0);
+  else if (cause == TASK_BLINK)
+    MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P2, GPIO_PIN1);
+  else if (cause == WDTSUPERVISOR_MONITOR)
+    MAP_GPIO_setOutputHighOnPin(GPIO_PORT_P2, GPIO_PIN2);
+
+  /* S1 and S2 */
+  MAP_GPIO_setAsInputPinWithPullUpResistor(GPIO_PORT_P1,
+                                           GPIO_PIN1 | GPIO_PIN4);
+  MAP_GPIO_interruptEdgeSelect(GPIO_PORT_P1, GPIO_PIN1 | GPIO_PIN4,
+                               GPIO_HIGH_TO_LOW_TRANSITION);
+  MAP_GPIO_clearInterruptFlag(GPIO_PORT_P1, GPIO_PIN1 | GPIO_PIN4);
+  MAP_GPIO_enableInterrupt(GPIO_PORT_P1, GPIO_PIN1 | GPIO_PIN4);
+  MAP_Interrupt_enableInterrupt(INT_PORT1);
+
+  /* Deadlines are measured on Timer32 0 */
+  Timestamp_init(TIMER32_0_BASE);
+
+  WDTSupervisor_addTask(TASK_MAIN, MAIN_DEADLINE_MS);
+  WDTSupervisor_addTask(TASK_BLINK, BLINK_DEADLINE_MS);
+
+  /* The blink task on Timer32 1 */
+  MAP_Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT,
+                         TIMER32_PERIODIC_MODE);
+  MAP_Timer32_setCount(TIMER32_1_BASE, BLINK_PERIOD);
+  MAP_Timer32_enableInterrupt(TIMER32_1_BASE);
+  MAP_Interrupt_enableInterrupt(INT_T32_INT2);
+  MAP_Timer32_startTimer(TIMER32_1_BASE, false);
+
+  /* The monitor, below everything else */
+  MAP_Interrupt_setPriority(FAULT_SYSTICK, INTERRUPT_PRIORITY_BACKGROUND);
+  MAP_SysTick_setPeriod(MONITOR_PERIOD);
+  MAP_SysTick_enableModule();
+  MAP_SysTick_enableInterrupt();
+
+  WDTSupervisor_start();
+  MAP_Interrupt_enableMaster();
+
+  /* Every interrupt wakes the main loop, the monitor's among them */
+  while (1) {
+    WDTSupervisor_checkIn(TASK_MAIN);
+    while (stallMain) {}
+    MAP_PCM_gotoLPM0();
+  }
+}
+
+/* Blink task */
+void T32_INT2_IRQHandler(void) {
+  MAP_Timer32_clearInterruptFlag(TIMER32_1_BASE);
+  MAP_GPIO_toggleOutputOnPin(GPIO_PORT_P1, GPIO_PIN0);
+  WDTSupervisor_checkIn(TASK_BLINK);
+}
+
+/* Monitor */
+void SysTick_Handler(void) { WDTSupervisor_service(); }
+
+void PORT1_IRQHandler(void) {
+  uint32_t status;
+
+  status = MAP_GPIO_getEnabledInterruptStatus(GPIO_PORT_P1);
+  MAP_GPIO_clearInterruptFlag(GPIO_PORT_P1, status);
+
+  if (status & GPIO_PIN1)
+    stallMain = true;
+  if (status & GPIO_PIN4)
+    MAP_Timer32_disableInterrupt(TIMER32_1_BASE);
+}
@@ -1,5 +1,6 @@
 #include "adc_helper.h"
 #include "msp.h"
+#include "power.h"
 
 void adc_init(void) {
   // Ref_A settings
@@ -15,6 +16,7 @@ void adc_init(void) {
   ADC14->MCTL[0] |= 0x100;     // vref pos int buffer
   ADC14->MCTL[0] |= 22;        // channel 22
   ADC14->CTL0    |= 0x02;      // enable adc
+  power_load_on(ENERGY_REF);   // the reference stays on from here
   return;
 }
 
@@ -23,10 +25,12 @@ float temp_read(void) {
   uint32_t cal30    = TLV->ADC14_REF2P5V_TS30C; // calibration constant
   uint32_t cal85    = TLV->ADC14_REF2P5V_TS85C; // calibration constant
   float    calDiff  = cal85 - cal30;            // calibration difference
+  power_load_on(ENERGY_ADC);
   ADC14->CTL0      |= 0x01;                     // start conversion
   while ((ADC14->IFGR0) == 0) {
     // wait for conversion
   }
+  power_load_off(ENERGY_ADC);
   temp = ADC14->MEM[0];         // assign ADC value
   temp = (temp - cal30) * 55;   // math for temperature per manual
   temp = (temp / calDiff) + 30; // math for temperature per manual
@@ -0,0 +1,82 @@
+#include "board.h"
+#include <stdint.h>
+
+// a pin claimed by two rows would sum to more than the OR of the masks
+#define BOARD_CHECK_PORT(n)                                                    \
+  _Static_assert(BOARD_REG_SUM(n) == BOARD_REG_USED(n),                        \
+                 "board.h: pin on port " #n " is configured twice");           \
+  _Static_assert((BOARD_REG_USED(n) & ~0xFF) == 0,                             \
+                 "board.h: mask on port " #n " is wider than 8 bits")
+
+BOARD_CHECK_PORT(1);
+BOARD_CHECK_PORT(2);
+BOARD_CHECK_PORT(3);
+BOARD_CHECK_PORT(4);
+BOARD_CHECK_PORT(5);
+BOARD_CHECK_PORT(6);
+BOARD_CHECK_PORT(7);
+BOARD_CHECK_PORT(8);
+BOARD_CHECK_PORT(9);
+BOARD_CHECK_PORT(10);
+BOARD_CHECK_PORT(BOARD_PORT_J);
+
+// PJ has no interrupt registers
+_Static_assert(BOARD_REG_IE(BOARD_PORT_J) == 0,
+               "board.h: port J pins cannot interrupt");
+
+// Output latch and pulls first so a pin never glitches when DIR or SEL
+// changes, interrupt flags cleared before the enables go in. Ports missing
+// from the table are left alone, and every test below is a constant.
+#define BOARD_APPLY_PORT(px, n)                                                \
+  if (BOARD_REG_USED(n)) {                                                     \
+    px->OUT  = BOARD_REG_OUT(n);                                               \
+    px->REN  = BOARD_REG_REN(n);                                               \
+    px->DS   = BOARD_REG_DS(n);                                                \
+    px->DIR  = BOARD_REG_DIR(n);                                               \
+    px->SEL0 = BOARD_REG_SEL0(n);                                              \
+    px->SEL1 = BOARD_REG_SEL1(n);                                              \
+    px->IES  = BOARD_REG_IES(n);                                               \
+    px->IFG  = 0;                                                              \
+    px->IE   = BOARD_REG_IE(n);                                                \
+  }
+
+#define BOARD_APPLY_PORT_J()                                                   \
+  if (BOARD_REG_USED(BOARD_PORT_J)) {                                          \
+    PJ->OUT  = BOARD_REG_OUT(BOARD_PORT_J);                                    \
+    PJ->REN  = BOARD_REG_REN(BOARD_PORT_J);                                    \
+    PJ->DS   = BOARD_REG_DS(BOARD_PORT_J);                                     \
+    PJ->DIR  = BOARD_REG_DIR(BOARD_PORT_J);                                    \
+    PJ->SEL0 = BOARD_REG_SEL0(BOARD_PORT_J);                                   \
+    PJ->SEL1 = BOARD_REG_SEL1(BOARD_PORT_J);                                   \
+  }
+
+#define BOARD_PMAP_COUNT(port, pin, mapping) +1
+#define BOARD_PMAP_WRITE(port, pin, mapping)                                   \
+  ((volatile uint8_t *)P##port##MAP)[pin] = (mapping);
+
+static void board_apply_pmap(void) {
+  if ((0 BOARD_PMAP(BOARD_PMAP_COUNT)) == 0) {
+    return;
+  }
+  PMAP->KEYID  = PMAP_KEYID_VAL; // unlock
+  PMAP->CTL   |= PMAP_CTL_PRECFG;
+  BOARD_PMAP(BOARD_PMAP_WRITE)
+  PMAP->KEYID  = 0; // lock
+}
+
+void board_init(void) {
+  // mapped functions must be routed before the SEL bits hand the pins over
+  board_apply_pmap();
+
+  BOARD_APPLY_PORT(P1, 1)
+  BOARD_APPLY_PORT(P2, 2)
+  BOARD_APPLY_PORT(P3, 3)
+  BOARD_APPLY_PORT(P4, 4)
+  BOARD_APPLY_PORT(P5, 5)
+  BOARD_APPLY_PORT(P6, 6)
+  BOARD_APPLY_PORT(P7, 7)
+  BOARD_APPLY_PORT(P8, 8)
+  BOARD_APPLY_PORT(P9, 9)
+  BOARD_APPLY_PORT(P10, 10)
+  BOARD_APPLY_PORT_J()
+}
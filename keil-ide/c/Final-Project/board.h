@@ -0,0 +1,96 @@
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include "msp.h"
+
+// pin function: SEL0/SEL1 select the module, DIR the direction
+#define BOARD_SEL0          0x1
+#define BOARD_SEL1          0x2
+#define BOARD_DIR           0x4
+#define BOARD_IN            0
+#define BOARD_OUT           BOARD_DIR
+#define BOARD_PRIMARY_IN    BOARD_SEL0
+#define BOARD_PRIMARY_OUT   (BOARD_SEL0 | BOARD_DIR)
+#define BOARD_SECONDARY_IN  BOARD_SEL1
+#define BOARD_SECONDARY_OUT (BOARD_SEL1 | BOARD_DIR)
+#define BOARD_ANALOG        (BOARD_SEL0 | BOARD_SEL1)
+
+#define BOARD_PULL_NONE 0
+#define BOARD_PULL_UP   1
+#define BOARD_PULL_DOWN 2
+
+#define BOARD_DRIVE_REGULAR 0
+#define BOARD_DRIVE_HIGH    1
+
+#define BOARD_LOW  0
+#define BOARD_HIGH 1
+
+#define BOARD_EDGE_NONE    0
+#define BOARD_EDGE_RISING  1
+#define BOARD_EDGE_FALLING 2
+
+#define BOARD_PORT_J 11
+
+// Every pin the application uses, one row per group of pins that share a
+// configuration. Ports listed here are written whole, so any pin of a listed
+// port that is missing from the table goes back to its reset state
+// (GPIO input, no pull).
+// X(arg, port, pin mask, function, pull, drive, initial level, edge)
+#define BOARD_PINS(X, arg)                                                     \
+  /* S1 and S2, active low */                                                  \
+  X(arg, 1, BIT1 | BIT4, BOARD_IN, BOARD_PULL_UP, BOARD_DRIVE_REGULAR,         \
+    BOARD_HIGH, BOARD_EDGE_FALLING)                                            \
+  /* UART RX/TX to the debugger */                                             \
+  X(arg, 1, BIT2 | BIT3, BOARD_PRIMARY_IN, BOARD_PULL_NONE,                    \
+    BOARD_DRIVE_REGULAR, BOARD_LOW, BOARD_EDGE_NONE)                           \
+  /* RGB LED */                                                                \
+  X(arg, 2, BIT0 | BIT1 | BIT2, BOARD_OUT, BOARD_PULL_NONE,                    \
+    BOARD_DRIVE_REGULAR, BOARD_LOW, BOARD_EDGE_NONE)                           \
+  /* rotary encoder A and B to TA2.1 and TA2.2, open collector */              \
+  X(arg, 5, BIT6 | BIT7, BOARD_PRIMARY_IN, BOARD_PULL_UP,                      \
+    BOARD_DRIVE_REGULAR, BOARD_HIGH, BOARD_EDGE_NONE)
+
+// Port mapping controller entries, only ports 2, 3 and 7 are mappable
+// X(port, pin number, PMAP_xxx function)
+#define BOARD_PMAP(X)
+
+// per-port register values, folded to constants by the compiler
+#define BOARD_TERM_USED(cur, port, mask, func, pull, drive, level, edge)       \
+  | ((cur) == (port) ? (mask) : 0)
+#define BOARD_TERM_SUM(cur, port, mask, func, pull, drive, level, edge)        \
+  +((cur) == (port) ? (mask) : 0)
+#define BOARD_TERM_SEL0(cur, port, mask, func, pull, drive, level, edge)       \
+  | ((cur) == (port) && ((func) & BOARD_SEL0) ? (mask) : 0)
+#define BOARD_TERM_SEL1(cur, port, mask, func, pull, drive, level, edge)       \
+  | ((cur) == (port) && ((func) & BOARD_SEL1) ? (mask) : 0)
+#define BOARD_TERM_DIR(cur, port, mask, func, pull, drive, level, edge)        \
+  | ((cur) == (port) && ((func) & BOARD_DIR) ? (mask) : 0)
+#define BOARD_TERM_REN(cur, port, mask, func, pull, drive, level, edge)        \
+  | ((cur) == (port) && (pull) != BOARD_PULL_NONE ? (mask) : 0)
+#define BOARD_TERM_OUT(cur, port, mask, func, pull, drive, level, edge)        \
+  | ((cur) == (port) && (((func) & BOARD_DIR) ? (level) == BOARD_HIGH          \
+                                              : (pull) == BOARD_PULL_UP)       \
+         ? (mask)                                                              \
+         : 0)
+#define BOARD_TERM_DS(cur, port, mask, func, pull, drive, level, edge)         \
+  | ((cur) == (port) && (drive) == BOARD_DRIVE_HIGH ? (mask) : 0)
+#define BOARD_TERM_IE(cur, port, mask, func, pull, drive, level, edge)         \
+  | ((cur) == (port) && (edge) != BOARD_EDGE_NONE ? (mask) : 0)
+#define BOARD_TERM_IES(cur, port, mask, func, pull, drive, level, edge)        \
+  | ((cur) == (port) && (edge) == BOARD_EDGE_FALLING ? (mask) : 0)
+
+#define BOARD_REG_USED(port) (0 BOARD_PINS(BOARD_TERM_USED, port))
+#define BOARD_REG_SUM(port)  (0 BOARD_PINS(BOARD_TERM_SUM, port))
+#define BOARD_REG_SEL0(port) (0 BOARD_PINS(BOARD_TERM_SEL0, port))
+#define BOARD_REG_SEL1(port) (0 BOARD_PINS(BOARD_TERM_SEL1, port))
+#define BOARD_REG_DIR(port)  (0 BOARD_PINS(BOARD_TERM_DIR, port))
+#define BOARD_REG_REN(port)  (0 BOARD_PINS(BOARD_TERM_REN, port))
+#define BOARD_REG_OUT(port)  (0 BOARD_PINS(BOARD_TERM_OUT, port))
+#define BOARD_REG_DS(port)   (0 BOARD_PINS(BOARD_TERM_DS, port))
+#define BOARD_REG_IE(port)   (0 BOARD_PINS(BOARD_TERM_IE, port))
+#define BOARD_REG_IES(port)  (0 BOARD_PINS(BOARD_TERM_IES, port))
+
+// apply the whole table, one store per register per used port
+void board_init(void);
+
+#endif /* BOARD_H_ */
@@ -0,0 +1,151 @@
+#include "buttons.h"
+#include "debounce.h"
+#include "msp.h"
+#include "power.h"
+#include "uart_helper.h"
+
+#define BUTTON_MASK (BIT1 | BIT4)
+
+// 32768 Hz REFO / 164 = ~5 ms
+#define BUTTON_TICK_COUNT (164 - 1)
+
+// single producer (TA1_0 ISR), single consumer (main), size a power of two
+#define BUTTON_QUEUE_SIZE 16
+
+static const uint8_t button_pins[BUTTON_COUNT] = {BIT1, BIT4};
+
+static debounce_state   state[BUTTON_COUNT];
+static volatile uint8_t pressed;
+
+static button_event     queue[BUTTON_QUEUE_SIZE];
+static volatile uint8_t queue_head; // written by the ISR only
+static volatile uint8_t queue_tail; // written by main only
+static volatile uint32_t dropped;
+static void (*notify)(void);
+static bool ticking; // ACLK is kept for the tick while it runs
+
+static void queue_push(uint8_t button, uint8_t type) {
+  uint8_t head = queue_head;
+  if ((uint8_t)(head - queue_tail) == BUTTON_QUEUE_SIZE) {
+    dropped++;
+    return;
+  }
+  queue[head & (BUTTON_QUEUE_SIZE - 1)] = (button_event){button, type};
+  // the slot is plain memory: the head must not be seen before it
+  __DMB();
+  queue_head = head + 1;
+  if (notify) {
+    notify();
+  }
+}
+
+static void tick_start(void) {
+  if (!ticking) {
+    ticking = true;
+    power_require(POWER_NEED_ACLK);
+    power_load_on(ENERGY_TIMER_ACLK);
+  }
+  TIMER_A1->CTL = TIMER_A_CTL_SSEL__ACLK | TIMER_A_CTL_MC__UP | TIMER_A_CTL_CLR;
+}
+
+static void tick_stop(void) {
+  TIMER_A1->CTL = TIMER_A_CTL_SSEL__ACLK | TIMER_A_CTL_MC__STOP;
+  if (ticking) {
+    ticking = false;
+    power_release(POWER_NEED_ACLK);
+    power_load_off(ENERGY_TIMER_ACLK);
+  }
+}
+
+void buttons_init(void) {
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    debounce_reset(&state[i]);
+  }
+  pressed    = 0;
+  queue_head = queue_tail = 0;
+  dropped    = 0;
+  notify     = 0;
+
+  // ACLK from REFO so the tick keeps running in LPM3
+  CS->KEY  = CS_KEY_VAL;
+  CS->CTL1 = (CS->CTL1 & ~CS_CTL1_SELA_MASK) | CS_CTL1_SELA__REFOCLK;
+  CS->KEY  = 0;
+
+  tick_stop();
+  TIMER_A1->CCR[0]  = BUTTON_TICK_COUNT;
+  TIMER_A1->CCTL[0] = TIMER_A_CCTLN_CCIE;
+
+  NVIC_EnableIRQ(PORT1_IRQn);
+  NVIC_EnableIRQ(TA1_0_IRQn);
+
+  // a button already held at boot never gives an edge
+  if ((P1->IN & BUTTON_MASK) != BUTTON_MASK) {
+    P1->IE &= ~BUTTON_MASK;
+    tick_start();
+  }
+}
+
+// first edge of a press: hand the pins over to the tick until they settle;
+// the console's RX pin shares the port
+void PORT1_IRQHandler(void) {
+  if (P1->IFG & BUTTON_MASK) {
+    P1->IE  &= ~BUTTON_MASK;
+    P1->IFG &= ~BUTTON_MASK;
+    tick_start();
+  }
+  if (P1->IFG & P1->IE & UART_RX_PIN) {
+    uart_rx_edge();
+  }
+}
+
+void TA1_0_IRQHandler(void) {
+  uint8_t in   = P1->IN;
+  bool    idle = true;
+
+  TIMER_A1->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    uint8_t events = debounce_step(&state[i], (in & button_pins[i]) == 0);
+    // one sample gives at most one event
+    if (events) {
+      if (events == DEBOUNCE_EVENT_PRESS) {
+        pressed |= 1 << i;
+      } else if (events == DEBOUNCE_EVENT_RELEASE) {
+        pressed &= ~(1 << i);
+      }
+      queue_push(i, events);
+    }
+    idle = idle && debounce_is_idle(&state[i]);
+  }
+
+  if (idle) {
+    tick_stop();
+    P1->IFG &= ~BUTTON_MASK;
+    P1->IE  |= BUTTON_MASK;
+    // pressed again between the last sample and the enable, no edge left
+    if ((P1->IN & BUTTON_MASK) != BUTTON_MASK) {
+      P1->IE &= ~BUTTON_MASK;
+      tick_start();
+    }
+  }
+}
+
+bool buttons_get_event(button_event *e) {
+  uint8_t tail = queue_tail;
+  if (tail == queue_head) {
+    return false;
+  }
+  // the slot is read after the head that published it, and before the tail
+  // hands it back to the ISR
+  __DMB();
+  *e = queue[tail & (BUTTON_QUEUE_SIZE - 1)];
+  __DMB();
+  queue_tail = tail + 1;
+  return true;
+}
+
+uint8_t buttons_pressed(void) { return pressed; }
+
+uint32_t buttons_dropped(void) { return dropped; }
+
+void buttons_set_notify(void (*fn)(void)) { notify = fn; }
@@ -0,0 +1,37 @@
+#ifndef BUTTONS_H_
+#define BUTTONS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// S1 and S2 on P1, woken by a falling edge and debounced by a 5 ms TIMER_A1
+// tick on ACLK. The tick only runs while a button is down or settling, so
+// with nothing pressed the CPU can sit in LPM3 until the next edge.
+
+#define BUTTON_COUNT 2
+#define BUTTON_S1    0
+#define BUTTON_S2    1
+
+// event types, same values as the DEBOUNCE_EVENT_x bits
+#define BUTTON_PRESS   0x01
+#define BUTTON_RELEASE 0x02
+#define BUTTON_LONG    0x04
+#define BUTTON_REPEAT  0x08
+
+typedef struct {
+  uint8_t button;
+  uint8_t type;
+} button_event;
+
+// the pins themselves are set up by board_init()
+void buttons_init(void);
+// non-blocking, false when the queue is empty
+bool buttons_get_event(button_event *e);
+// debounced state, bit n set while button n is held
+uint8_t buttons_pressed(void);
+// fn runs in the tick ISR after every queued event, e.g. to post a task
+void buttons_set_notify(void (*fn)(void));
+// events lost because the queue was full
+uint32_t buttons_dropped(void);
+
+#endif /* BUTTONS_H_ */
@@ -0,0 +1,46 @@
+#include "debounce.h"
+
+void debounce_reset(debounce_state *s) {
+  s->integrator = 0;
+  s->pressed    = false;
+  s->held       = 0;
+}
+
+uint8_t debounce_step(debounce_state *s, bool raw) {
+  // integrate toward the raw level, a bounce only moves it one step
+  if (raw) {
+    if (s->integrator < DEBOUNCE_TICKS) {
+      s->integrator++;
+    }
+  } else if (s->integrator > 0) {
+    s->integrator--;
+  }
+
+  if (!s->pressed) {
+    if (s->integrator == DEBOUNCE_TICKS) {
+      s->pressed = true;
+      s->held    = 0;
+      return DEBOUNCE_EVENT_PRESS;
+    }
+    return 0;
+  }
+
+  if (s->integrator == 0) {
+    s->pressed = false;
+    return DEBOUNCE_EVENT_RELEASE;
+  }
+
+  s->held++;
+  if (s->held == DEBOUNCE_LONG_TICKS) {
+    return DEBOUNCE_EVENT_LONG;
+  }
+  if (s->held == DEBOUNCE_LONG_TICKS + DEBOUNCE_REPEAT) {
+    s->held = DEBOUNCE_LONG_TICKS; // wrap so a held button never overflows
+    return DEBOUNCE_EVENT_REPEAT;
+  }
+  return 0;
+}
+
+bool debounce_is_idle(const debounce_state *s) {
+  return !s->pressed && s->integrator == 0;
+}
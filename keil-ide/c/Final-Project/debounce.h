@@ -0,0 +1,33 @@
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Debounce state machine for one button, advanced once per tick with the raw
+// (active high) pin level. It has no hardware dependencies so recorded bounce
+// traces can be replayed through it off target.
+
+// all counts are in ticks
+#define DEBOUNCE_TICKS      4   // samples to agree before a change is taken
+#define DEBOUNCE_LONG_TICKS 200 // held this long gives a long press
+#define DEBOUNCE_REPEAT     40  // then a repeat every this many ticks
+
+#define DEBOUNCE_EVENT_PRESS   0x01
+#define DEBOUNCE_EVENT_RELEASE 0x02
+#define DEBOUNCE_EVENT_LONG    0x04
+#define DEBOUNCE_EVENT_REPEAT  0x08
+
+typedef struct {
+  uint8_t  integrator; // 0 released .. DEBOUNCE_TICKS pressed
+  bool     pressed;
+  uint16_t held;
+} debounce_state;
+
+void debounce_reset(debounce_state *s);
+// returns the DEBOUNCE_EVENT_x bits produced by this sample
+uint8_t debounce_step(debounce_state *s, bool raw);
+// released and settled, nothing left to sample
+bool debounce_is_idle(const debounce_state *s);
+
+#endif /* DEBOUNCE_H_ */
@@ -0,0 +1,123 @@
+#include "encoder.h"
+#include "msp.h"
+#include "power.h"
+#include "quadrature.h"
+#include <stdbool.h>
+
+// capture on both edges of CCIxA, synchronised to the timer clock
+#define ENCODER_CCTL                                                           \
+  (TIMER_A_CCTLN_CM_3 | TIMER_A_CCTLN_CCIS_0 | TIMER_A_CCTLN_SCS |             \
+   TIMER_A_CCTLN_CAP | TIMER_A_CCTLN_CCIE)
+
+static quadrature_state  state;
+static volatile uint16_t overflows;
+static volatile uint32_t overruns; // captures lost to COV
+
+// CCR1 samples A and CCR2 samples B
+static const uint8_t channel_bits[3] = {0, QUADRATURE_A, QUADRATURE_B};
+
+static uint8_t read_levels(void) {
+  return ((TIMER_A2->CCTL[1] & TIMER_A_CCTLN_CCI) ? QUADRATURE_A : 0) |
+         ((TIMER_A2->CCTL[2] & TIMER_A_CCTLN_CCI) ? QUADRATURE_B : 0);
+}
+
+// ACLK is asynchronous to MCLK, read until two samples agree
+static uint16_t read_counter(void) {
+  uint16_t a, b;
+  do {
+    a = TIMER_A2->R;
+    b = TIMER_A2->R;
+  } while (a != b);
+  return a;
+}
+
+static uint32_t now(void) {
+  uint16_t hi = overflows;
+  uint16_t lo = read_counter();
+  // wrapped but the overflow has not been counted yet
+  if ((TIMER_A2->CTL & TIMER_A_CTL_IFG) && lo < 0x8000) {
+    hi++;
+  }
+  return ((uint32_t)hi << 16) | lo;
+}
+
+void encoder_init(void) {
+  TIMER_A2->CTL     = TIMER_A_CTL_SSEL__ACLK | TIMER_A_CTL_MC__STOP;
+  TIMER_A2->CCTL[1] = ENCODER_CCTL;
+  TIMER_A2->CCTL[2] = ENCODER_CCTL;
+  overflows         = 0;
+  overruns          = 0;
+  quadrature_reset(&state, read_levels(), 0);
+
+  TIMER_A2->CTL = TIMER_A_CTL_SSEL__ACLK | TIMER_A_CTL_MC__CONTINUOUS |
+                  TIMER_A_CTL_CLR | TIMER_A_CTL_IE;
+  NVIC_EnableIRQ(TA2_N_IRQn);
+  // ACLK keeps capturing in LPM3, only LPM4 would stop it
+  power_require(POWER_NEED_ACLK);
+  power_load_on(ENERGY_TIMER_ACLK);
+}
+
+static void take_edge(uint8_t ccr) {
+  uint8_t  bit = channel_bits[ccr];
+  uint16_t hi  = overflows;
+  uint16_t capture;
+  uint32_t time;
+  uint8_t  ab;
+
+  // clear first: an edge captured from here on raises the flag again and is
+  // taken on the next pass instead of being lost
+  TIMER_A2->CCTL[ccr] &= ~TIMER_A_CCTLN_CCIFG;
+  capture = TIMER_A2->CCR[ccr];
+  // the counter wrapped before this capture, the overflow is still pending
+  if ((TIMER_A2->CTL & TIMER_A_CTL_IFG) && capture < 0x8000) {
+    hi++;
+  }
+  time = ((uint32_t)hi << 16) | capture;
+
+  if (TIMER_A2->CCTL[ccr] & TIMER_A_CCTLN_COV) {
+    // edges came faster than they were taken, the level is all that is left
+    TIMER_A2->CCTL[ccr] &= ~TIMER_A_CCTLN_COV;
+    overruns++;
+    ab = (state.ab & ~bit) | (read_levels() & bit);
+  } else {
+    // one capture is one edge of this channel
+    ab = state.ab ^ bit;
+  }
+  quadrature_step(&state, ab, time);
+}
+
+void TA2_N_IRQHandler(void) {
+  while (1) {
+    bool a = TIMER_A2->CCTL[1] & TIMER_A_CCTLN_CCIFG;
+    bool b = TIMER_A2->CCTL[2] & TIMER_A_CCTLN_CCIFG;
+
+    if (a && b) {
+      // both pending, the earlier capture first
+      take_edge((int16_t)(TIMER_A2->CCR[2] - TIMER_A2->CCR[1]) < 0 ? 2 : 1);
+    } else if (a) {
+      take_edge(1);
+    } else if (b) {
+      take_edge(2);
+    } else if (TIMER_A2->CTL & TIMER_A_CTL_IFG) {
+      // only once every capture from before the wrap is dated
+      TIMER_A2->CTL &= ~TIMER_A_CTL_IFG;
+      overflows++;
+    } else {
+      break;
+    }
+  }
+}
+
+int32_t encoder_position(void) { return state.position; }
+
+int32_t encoder_velocity(void) {
+  uint32_t primask = __get_PRIMASK();
+  int32_t  velocity;
+
+  __disable_irq();
+  velocity = quadrature_velocity(&state, now(), ENCODER_CLOCK_HZ);
+  __set_PRIMASK(primask);
+  return velocity;
+}
+
+uint32_t encoder_errors(void) { return state.errors + overruns; }
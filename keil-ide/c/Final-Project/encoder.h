@@ -0,0 +1,32 @@
+#ifndef ENCODER_H_
+#define ENCODER_H_
+
+#include <stdint.h>
+
+// Rotary encoder on P5.6 (A, TA2.1) and P5.7 (B, TA2.2). TIMER_A2 runs
+// continuously on ACLK and captures both edges of both channels, so no
+// edge depends on a poll. The capture interrupt feeds the edges to
+// quadrature.c in the order they came, each with its capture time extended
+// to 32 bits by counting overflows.
+//
+// Captures are synchronised to the 32768 Hz ACLK, which dates each edge to
+// about 30 us and misses pulses shorter than that. An edge not taken before
+// the next one of its channel is captured sets the capture overflow flag:
+// the channel is then resynchronised from its input level, counting an
+// error. A hand turned encoder gives a few hundred edges per second, well
+// within both. ACLK is kept running through idle (power.h), so the CPU
+// sleeps in LPM3 while it counts and each edge wakes it.
+
+#define ENCODER_CLOCK_HZ 32768 // ACLK, the capture time base
+
+// the pins themselves are set up by board_init()
+void encoder_init(void);
+// counts, 4 per cycle, forward with A leading B
+int32_t encoder_position(void);
+// counts per second; estimates over the time since the previous call, so
+// call it from one place at a steady rate
+int32_t encoder_velocity(void);
+// lost edges and skipped states so far
+uint32_t encoder_errors(void);
+
+#endif /* ENCODER_H_ */
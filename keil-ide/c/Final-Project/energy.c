@@ -0,0 +1,60 @@
+#include "energy.h"
+
+// Typical currents in nA at 3 V and 25 C, MCLK and SMCLK at 3 MHz from the
+// DCO, LDO at VCORE0, rounded from the MSP432P4111 datasheet. The LED is a
+// board figure, one colour through its series resistor.
+static const uint32_t cpu_na[ENERGY_CPU_MODES] = {
+    480000, // active, running from flash
+    250000, // LPM0, SMCLK on
+    1500,   // LPM3, REFO on for ACLK
+    600,    // LPM4
+};
+
+static const uint32_t unit_na[ENERGY_LOADS] = {
+    0,       // ENERGY_CPU, from cpu_na
+    160000,  // ENERGY_ADC
+    90000,   // ENERGY_REF, 2.5 V buffered
+    20000,   // ENERGY_UART
+    10000,   // ENERGY_TIMER_SMCLK
+    100,     // ENERGY_TIMER_ACLK
+    2000000, // ENERGY_LED
+};
+
+void energy_reset(energy_state *s, uint8_t mode, uint32_t now) {
+  for (uint8_t i = 0; i < ENERGY_LOADS; i++) {
+    s->units[i]  = 0;
+    s->charge[i] = 0;
+  }
+  s->mode = mode;
+  s->last = now;
+}
+
+uint32_t energy_current(const energy_state *s, uint8_t load) {
+  if (load == ENERGY_CPU) {
+    return cpu_na[s->mode];
+  }
+  return unit_na[load] * s->units[load];
+}
+
+void energy_update(energy_state *s, uint32_t now) {
+  uint32_t elapsed = now - s->last; // wraps with the time base
+
+  for (uint8_t i = 0; i < ENERGY_LOADS; i++) {
+    s->charge[i] += (uint64_t)energy_current(s, i) * elapsed;
+  }
+  s->last = now;
+}
+
+void energy_mode(energy_state *s, uint8_t mode, uint32_t now) {
+  energy_update(s, now);
+  s->mode = mode;
+}
+
+void energy_set(energy_state *s, uint8_t load, uint8_t units, uint32_t now) {
+  energy_update(s, now);
+  s->units[load] = units;
+}
+
+uint32_t energy_nah(const energy_state *s, uint8_t load, uint32_t hz) {
+  return (uint32_t)(s->charge[load] / ((uint64_t)hz * 3600));
+}
@@ -0,0 +1,48 @@
+#ifndef ENERGY_H_
+#define ENERGY_H_
+
+#include <stdint.h>
+
+// Charge estimate from the time each part of the board spends running.
+// Every change of the CPU low-power mode or of a load is an event with its
+// time. At each event the period since the previous one is charged to
+// every load at its current, which comes from a table of typical figures,
+// times the length of the period. Like quadrature.c it has no hardware
+// dependencies, so event traces can be replayed through it off target.
+//
+// The figures are estimates, good for comparing one build with another
+// rather than for a battery gauge; see energy.c.
+
+// CPU modes, indexed like enum power_mode in power.h
+#define ENERGY_CPU_MODES 4
+
+enum energy_load {
+  ENERGY_CPU,         // by mode, the rest are units running times a current
+  ENERGY_ADC,         // ADC14 converting
+  ENERGY_REF,         // REF_A and the temperature sensor powered
+  ENERGY_UART,        // eUSCI_A transmitting
+  ENERGY_TIMER_SMCLK, // Timer_A counting on SMCLK
+  ENERGY_TIMER_ACLK,  // Timer_A counting on ACLK
+  ENERGY_LED,         // RGB LED colours lit
+  ENERGY_LOADS,
+};
+
+typedef struct {
+  uint32_t last;                 // time of the previous event
+  uint8_t  mode;                 // of the CPU
+  uint8_t  units[ENERGY_LOADS];  // running of each load, ENERGY_CPU unused
+  uint64_t charge[ENERGY_LOADS]; // nA times ticks
+} energy_state;
+
+// nothing running, the CPU in mode, no charge
+void energy_reset(energy_state *s, uint8_t mode, uint32_t now);
+void energy_mode(energy_state *s, uint8_t mode, uint32_t now);
+void energy_set(energy_state *s, uint8_t load, uint8_t units, uint32_t now);
+// charges the period up to now, for totals that include it
+void energy_update(energy_state *s, uint32_t now);
+// present current of a load in nA
+uint32_t energy_current(const energy_state *s, uint8_t load);
+// charge of a load so far in nAh for a time base of hz
+uint32_t energy_nah(const energy_state *s, uint8_t load, uint32_t hz);
+
+#endif /* ENERGY_H_ */
@@ -1,87 +1,372 @@
 #include "lab_tasks.h"
 #include "adc_helper.h"
+#include "buttons.h"
+#include "encoder.h"
 #include "msp.h"
+#include "power.h"
+#include "sched.h"
 #include "uart_helper.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 
-// Must use Timer32
-void rgb_control(void) {
-  uart_send_str("Enter Combination of RGB (1 - 7): ");
-  int16_t rgb, op;
-  rgb = op = uart_get_char();
-  if (op == -1 || op > 7) {
-    op = 7;
-  }
-  uart_send_str("Enter Toggle Time: ");
-  int16_t toggle_time = uart_get_char();
-  op                  = toggle_time;
-  if (op == -1) {
-    uart_send_str("\r\nError: Invalid Toggle Time Input\r\n");
-  }
-  uart_send_str("Enter Number of Blinks: ");
-  op = uart_get_char();
-  if (op == -1) {
-    uart_send_str("\r\nError: Invalid Number of Blinks\r\n");
+#define MENU                                                                   \
+  "MSP432 Menu\r\n"                                                            \
+  "1. RGB Control\r\n"                                                         \
+  "2. Digital Input\r\n"                                                       \
+  "3. Temperature Reading\r\n"                                                 \
+  "4. Encoder\r\n"                                                             \
+  "5. Power\r\n"                                                               \
+  "6. Energy\r\n"
+
+// what the next line typed on the console is for
+enum lab_state {
+  STATE_MENU,
+  STATE_RGB_COMBO,
+  STATE_RGB_TIME,
+  STATE_RGB_BLINKS,
+  STATE_TEMP_COUNT,
+};
+
+static enum lab_state state;
+// the option running in the background, 0 for none; the console stays at
+// the menu meanwhile and the next choice stops it
+static int16_t running;
+
+static void console_task(void *arg);
+static void blink_task(void *arg);
+static void button_task(void *arg);
+static void temp_task(void *arg);
+static void encoder_task(void *arg);
+
+static sched_task console = SCHED_TASK_INIT(console_task, 0);
+static sched_task blink   = SCHED_TASK_INIT(blink_task, 0);
+static sched_task button  = SCHED_TASK_INIT(button_task, 0);
+static sched_task temp    = SCHED_TASK_INIT(temp_task, 0);
+static sched_task encoder = SCHED_TASK_INIT(encoder_task, 0);
+
+static void console_notify(void) { sched_post(&console); }
+static void button_notify(void) { sched_post(&button); }
+
+static void show_menu(void) {
+  state = STATE_MENU;
+  uart_send_str(MENU);
+}
+
+// an option that has run to its end
+static void finished(void) {
+  running = 0;
+  show_menu();
+}
+
+static void run_in_background(int16_t option) {
+  running = option;
+  state   = STATE_MENU;
+  uart_send_str("Choose an option to stop\r\n");
+}
+
+// Option 1: toggles every toggle_time seconds until blinks cycles are done
+static uint8_t  rgb;
+static int16_t  toggle_time;
+static uint16_t halves; // half cycles left
+
+// the colours lit count towards the energy estimate
+static void leds_changed(void) {
+  uint8_t on = P2->OUT & 0x7;
+  power_load_set(ENERGY_LED, (on & 1) + ((on >> 1) & 1) + ((on >> 2) & 1));
+}
+
+static void blink_task(void *arg) {
+  (void)arg;
+  P2->OUT ^= rgb;
+  leds_changed();
+  if (--halves == 0) {
+    sched_cancel(&blink);
+    uart_send_str("Done\r\n");
+    finished();
   }
+}
+
+static void blink_start(int16_t blinks) {
   uart_send_str("Blinking LED\r\n");
   P2->OUT &= ~0x7; // disable the LED
-
-  TIMER32_1->LOAD     = toggle_time * 3e6 - 1;
-  TIMER32_1->CONTROL |= 0x42; // periodic mode (restart timer), no interrupt or
-                              // prescale, 32-bit state, wrapping mode
-  TIMER32_1->CONTROL |= 0x80; // enable timer (bit7)
-  for (; op > 0; op--) {
-    // Enable the LED (MAKE IT ON)
-    P2->OUT |= rgb;
-
-    while ((TIMER32_1->RIS & 1) != 1) {} // while count is not done, wait
-    TIMER32_1->INTCLR &= ~0x01; // set INTCLR to 0 after count is reached
-    // DISABLE THE LED (MAKE IT OFF)
-    P2->OUT           &= ~rgb;
-
-    while ((TIMER32_1->RIS & 1) != 1) {} // while count is not done, wait
-    TIMER32_1->INTCLR &= ~0x01; // set INTCLR to 0 after count is reached
+  leds_changed();
+  if (blinks <= 0) {
+    uart_send_str("Done\r\n");
+    show_menu();
+    return;
   }
-  TIMER32_1->CONTROL &= ~0x80; // disable Timer32
-  uart_send_str("Done\r\n");
+
+  P2->OUT |= rgb; // first half cycle is ON
+  leds_changed();
+  halves = blinks * 2 - 1;
+  sched_post_periodic(&blink, SCHED_MS(toggle_time * 1000));
+  run_in_background(1);
 }
 
-void digital_input(void) {
-  bool button1 = (P1->IN & BIT1) == 0;
-  bool button2 = (P1->IN & BIT4) == 0;
-  if (button1 && button2) {
+// Option 2: reports every change until all buttons are released
+static void report_buttons(uint8_t pressed) {
+  if (pressed == ((1 << BUTTON_S1) | (1 << BUTTON_S2))) {
     uart_send_str("Buttons 1 and 2 are pressed\r\n");
-  } else if (button1) {
+  } else if (pressed & (1 << BUTTON_S1)) {
     uart_send_str("Buttons 1 is pressed\r\n");
-  } else if (button2) {
+  } else if (pressed & (1 << BUTTON_S2)) {
     uart_send_str("Button 2 is pressed\r\n");
   } else {
     uart_send_str("No Buttons are pressed\r\n");
   }
 }
 
-// Must use SysTick, wait every second
-void temp_reading(void) {
-  uart_send_str("Enter Number of Temperature Readings (1 - 5): ");
-  int16_t num_reads = uart_get_char();
-  if (num_reads == -1 || num_reads > 5) {
-    num_reads = 5;
+static bool watching_buttons;
+static bool watching_encoder; // option 4, any press returns to the menu
+
+static void button_task(void *arg) {
+  button_event e;
+  char         s[40];
+  bool         any = false;
+
+  (void)arg;
+  while (buttons_get_event(&e)) {
+    if (watching_encoder && e.type == BUTTON_PRESS) {
+      sched_cancel(&encoder);
+      watching_encoder = false;
+      finished();
+      continue;
+    }
+    if (!watching_buttons) {
+      continue; // presses made at the menu
+    }
+    any = true;
+    if (e.type == BUTTON_LONG) {
+      sprintf(s, "Button %d long press\r\n", e.button + 1);
+      uart_send_str(s);
+    } else if (e.type == BUTTON_REPEAT) {
+      sprintf(s, "Button %d repeat\r\n", e.button + 1);
+      uart_send_str(s);
+    } else {
+      report_buttons(buttons_pressed());
+    }
+  }
+
+  if (any && buttons_pressed() == 0) {
+    watching_buttons = false;
+    finished();
   }
-  SysTick->LOAD  = 3e6 - 1;
-  SysTick->CTRL |= 0x05; // system CLK, no interrupt, and disabled, then enable
-  for (uint8_t i = 0; i < num_reads; i++) {
-    char  s[200]   = {'\0'};
-    float tempf_c  = temp_read();
-    float tempf_f  = (tempf_c * 9.0 / 5.0) + 32;
-    tempf_c       *= 100;
-    tempf_f       *= 100;
-    sprintf(s, "Reading %d: %d.%02d C & %d.%02d F\r\n", i, (int)tempf_c / 100,
-            (int)tempf_c % 100, (int)tempf_f / 100, (int)tempf_f % 100);
+}
+
+static void digital_input(void) {
+  button_event e;
+
+  while (buttons_get_event(&e)) {} // drop presses made at the menu
+  report_buttons(buttons_pressed());
+  uart_send_str("Press buttons, release all to return\r\n");
+  watching_buttons = true;
+  run_in_background(2);
+}
 
+// Option 3: one reading now, then one every second
+static int16_t temp_reads;
+static int16_t temp_done;
+
+static void temp_task(void *arg) {
+  char  s[200]   = {'\0'};
+  float tempf_c  = temp_read();
+  float tempf_f  = (tempf_c * 9.0 / 5.0) + 32;
+
+  (void)arg;
+  tempf_c *= 100;
+  tempf_f *= 100;
+  sprintf(s, "Reading %d: %d.%02d C & %d.%02d F\r\n", temp_done,
+          (int)tempf_c / 100, (int)tempf_c % 100, (int)tempf_f / 100,
+          (int)tempf_f % 100);
+  uart_send_str(s);
+
+  if (++temp_done < temp_reads) {
+    sched_post_delayed(&temp, SCHED_MS(1000));
+  } else {
+    finished();
+  }
+}
+
+// Option 4: position and speed four times a second until a button is pressed
+static void encoder_task(void *arg) {
+  char s[80];
+
+  (void)arg;
+  sprintf(s, "Position %ld, %ld counts/s, %lu errors\r\n",
+          (long)encoder_position(), (long)encoder_velocity(),
+          (unsigned long)encoder_errors());
+  uart_send_str(s);
+}
+
+static void encoder_start(void) {
+  button_event e;
+
+  while (buttons_get_event(&e)) {} // drop presses made at the menu
+  uart_send_str("Turn the encoder, press a button to return\r\n");
+  watching_encoder = true;
+  encoder_velocity(); // starts the first estimate from here
+  sched_post_periodic(&encoder, SCHED_MS(250));
+  run_in_background(4);
+}
+
+// Cancels the running option's tasks, leaving the LEDs off
+static void stop_running(void) {
+  switch (running) {
+  case 1:
+    sched_cancel(&blink);
+    P2->OUT &= ~0x7;
+    leds_changed();
+    break;
+  case 2:
+    watching_buttons = false;
+    break;
+  case 3:
+    sched_cancel(&temp);
+    break;
+  case 4:
+    sched_cancel(&encoder);
+    watching_encoder = false;
+    break;
+  }
+  running = 0;
+  uart_send_str("Stopped\r\n");
+}
+
+// Option 5: time in each power mode since the previous report
+static void power_report(void) {
+  static const char *const names[POWER_MODES] = {"Active", "LPM0", "LPM3",
+                                                 "LPM4"};
+  power_stats st;
+  char        s[80];
+  uint32_t    total;
+  uint32_t    permille;
+
+  power_get_stats(&st);
+  power_reset_stats();
+  total = st.ticks[POWER_ACTIVE] + st.ticks[POWER_LPM0] + st.ticks[POWER_LPM3];
+
+  sprintf(s, "Power over the last %lu ms\r\n",
+          (unsigned long)((uint64_t)total * 1000 / SCHED_TICKS_PER_SEC));
+  uart_send_str(s);
+  for (uint8_t i = 0; i < POWER_MODES; i++) {
+    permille = total ? (uint32_t)((uint64_t)st.ticks[i] * 1000 / total) : 0;
+    if (i == POWER_ACTIVE) {
+      sprintf(s, "  %-6s %3lu.%lu%%\r\n", names[i],
+              (unsigned long)(permille / 10), (unsigned long)(permille % 10));
+    } else if (i == POWER_LPM4) {
+      // ACLK stops there, nothing measures the time
+      sprintf(s, "  %-6s %lu sleeps\r\n", names[i],
+              (unsigned long)st.entries[i]);
+    } else {
+      sprintf(s, "  %-6s %3lu.%lu%%, %lu sleeps\r\n", names[i],
+              (unsigned long)(permille / 10), (unsigned long)(permille % 10),
+              (unsigned long)st.entries[i]);
+    }
+    uart_send_str(s);
+  }
+  show_menu();
+}
+
+// Option 6: estimated charge of each load since boot
+static void energy_report(void) {
+  static const char *const names[ENERGY_LOADS] = {
+      "CPU", "ADC", "REF", "UART", "TA SMCLK", "TA ACLK", "LED"};
+  energy_state e;
+  char         s[80];
+  uint32_t     nah;
+  uint32_t     total = 0;
+
+  power_get_energy(&e);
+  uart_send_str("Charge since boot\r\n");
+  for (uint8_t i = 0; i < ENERGY_LOADS; i++) {
+    nah    = energy_nah(&e, i, SCHED_TICKS_PER_SEC);
+    total += nah;
+    sprintf(s, "  %-8s %6lu.%03lu uAh\r\n", names[i],
+            (unsigned long)(nah / 1000), (unsigned long)(nah % 1000));
     uart_send_str(s);
-    while ((SysTick->CTRL & 0x10000) == 0) {} // wait while COUNTFLAG not set
   }
-  SysTick->CTRL &= ~0x01; // disable SysTick
+  sprintf(s, "  %-8s %6lu.%03lu uAh\r\n", "Total",
+          (unsigned long)(total / 1000), (unsigned long)(total % 1000));
+  uart_send_str(s);
+  show_menu();
+}
+
+static void handle_line(int16_t op) {
+  switch (state) {
+  case STATE_MENU:
+    if (running) {
+      stop_running();
+    }
+    if (op == 1) {
+      uart_send_str("Enter Combination of RGB (1 - 7): ");
+      state = STATE_RGB_COMBO;
+    } else if (op == 2) {
+      digital_input();
+    } else if (op == 3) {
+      uart_send_str("Enter Number of Temperature Readings (1 - 5): ");
+      state = STATE_TEMP_COUNT;
+    } else if (op == 4) {
+      encoder_start();
+    } else if (op == 5) {
+      power_report();
+    } else if (op == 6) {
+      energy_report();
+    } else {
+      uart_send_str("\r\nError: Invalid Menu Input\r\n");
+      show_menu();
+    }
+    break;
+
+  case STATE_RGB_COMBO:
+    rgb = (op == -1 || op > 7) ? 7 : op;
+    uart_send_str("Enter Toggle Time: ");
+    state = STATE_RGB_TIME;
+    break;
+
+  case STATE_RGB_TIME:
+    toggle_time = op;
+    if (op == -1) {
+      uart_send_str("\r\nError: Invalid Toggle Time Input\r\n");
+    }
+    if (toggle_time < 1) {
+      toggle_time = 1;
+    }
+    uart_send_str("Enter Number of Blinks: ");
+    state = STATE_RGB_BLINKS;
+    break;
+
+  case STATE_RGB_BLINKS:
+    if (op == -1) {
+      uart_send_str("\r\nError: Invalid Number of Blinks\r\n");
+    }
+    blink_start(op);
+    break;
+
+  case STATE_TEMP_COUNT:
+    temp_reads = (op == -1 || op > 5) ? 5 : op;
+    temp_done  = 0;
+    if (temp_reads == 0) {
+      show_menu();
+    } else {
+      sched_post(&temp);
+      run_in_background(3);
+    }
+    break;
+  }
+}
+
+static void console_task(void *arg) {
+  int16_t op;
+
+  (void)arg;
+  while (uart_poll_line(&op)) {
+    handle_line(op);
+  }
+}
+
+void lab_tasks_init(void) {
+  buttons_set_notify(button_notify);
+  uart_set_rx_notify(console_notify);
+  show_menu();
 }
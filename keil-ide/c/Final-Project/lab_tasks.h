@@ -4,7 +4,7 @@
 // Option 1:
 /* Amount of time to toggle blinking of LED in seconds, how many seconds the LED
  * is ON and how many seconds the LED is OFF number of blinks is an entire cycle
- * ON and OFF Must use Timer32
+ * ON and OFF, timed by a periodic scheduler task
  */
 // Enter Combination of RGB (1 - 7):
 // Enter Toggle Time:
@@ -16,19 +16,23 @@
 // No Button pressed, Button 2 pressed, include all buttons that are pressed
 
 // Option 3:
-/* Delay must be with SysTick Timer */
+// one reading every second from a delayed scheduler task
 // Enter Number of Temperature Reading (1 - 5):
 // Reading 1:
 // Reading 2:
 // ...
 
+// Options 1 to 4 run in the background with the console at the menu;
+// choosing any option while one runs stops it first
+
 // INVALID DATA:
 // any invalid menu option will display an error msg
 // An invalid RGB value will default to 7
 // An invalid temp reading # will default to 5
 
-void rgb_control(void);
-void digital_input(void);
-void temp_reading(void);
+// Everything runs as sched.h tasks: console input, button events and the
+// timed parts of each option are posted from interrupts or timers, and the
+// CPU sleeps in between. Prints the menu.
+void lab_tasks_init(void);
 
 #endif /* LAB_TASKS_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Host check of the pin table in board.h
+ *
+ * Prints the register values the table folds to for each port it uses,
+ * which are what board_init() stores, and works them out again pin by pin
+ * from the rows. Build and run with `make board` in this directory.
+ *
+ * Checked:
+ *  - every folded register of every port, J included, matches the value
+ *    worked out from the rows
+ *  - no pin is in two rows, no mask is wider than a port, and no pin of
+ *    port J asks for an interrupt; the same as board.c's static asserts,
+ *    done here without them
+ */
+#include "board.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+#define PORTS 11 // 1 to 10 and J
+
+typedef struct {
+  unsigned port, mask, func, pull, drive, level, edge;
+} row;
+
+#define BOARD_ROW(arg, port, mask, func, pull, drive, level, edge)            \
+  {(port), (mask), (func), (pull), (drive), (level), (edge)},
+
+static const row rows[] = {BOARD_PINS(BOARD_ROW, 0)};
+
+#define ROWS (sizeof rows / sizeof rows[0])
+
+enum { OUT, REN, DS, DIR, SEL0, SEL1, IES, IE, REGS };
+
+static const char *const names[REGS] = {"OUT",  "REN",  "DS",  "DIR",
+                                        "SEL0", "SEL1", "IES", "IE"};
+
+static unsigned errors;
+
+static void fail(const char *what, unsigned port, unsigned value) {
+  if (errors++ < 10) {
+    printf("P%u: %s: 0x%02X\n", port, what, value);
+  }
+}
+
+// what the table folds to for one port
+static void folded(unsigned port, unsigned *reg) {
+  reg[OUT]  = BOARD_REG_OUT(port);
+  reg[REN]  = BOARD_REG_REN(port);
+  reg[DS]   = BOARD_REG_DS(port);
+  reg[DIR]  = BOARD_REG_DIR(port);
+  reg[SEL0] = BOARD_REG_SEL0(port);
+  reg[SEL1] = BOARD_REG_SEL1(port);
+  reg[IES]  = BOARD_REG_IES(port);
+  reg[IE]   = BOARD_REG_IE(port);
+}
+
+// the same, one pin at a time, and the pins the port's rows claim
+static unsigned by_pin(unsigned port, unsigned *reg) {
+  unsigned used = 0;
+
+  for (unsigned r = 0; r < REGS; r++) {
+    reg[r] = 0;
+  }
+  for (unsigned i = 0; i < ROWS; i++) {
+    const row *p = &rows[i];
+
+    if (p->port != port) {
+      continue;
+    }
+    if (p->mask & ~0xFFu) {
+      fail("mask wider than the port", port, p->mask);
+    }
+    for (unsigned bit = 1; bit & 0xFF; bit <<= 1) {
+      bool output = p->func & BOARD_DIR;
+
+      if (!(p->mask & bit)) {
+        continue;
+      }
+      if (used & bit) {
+        fail("pin in two rows", port, bit);
+      }
+      used |= bit;
+
+      if (output ? p->level == BOARD_HIGH : p->pull == BOARD_PULL_UP) {
+        reg[OUT] |= bit;
+      }
+      if (p->pull != BOARD_PULL_NONE) {
+        reg[REN] |= bit;
+      }
+      if (p->drive == BOARD_DRIVE_HIGH) {
+        reg[DS] |= bit;
+      }
+      if (output) {
+        reg[DIR] |= bit;
+      }
+      if (p->func & BOARD_SEL0) {
+        reg[SEL0] |= bit;
+      }
+      if (p->func & BOARD_SEL1) {
+        reg[SEL1] |= bit;
+      }
+      if (p->edge == BOARD_EDGE_FALLING) {
+        reg[IES] |= bit;
+      }
+      if (p->edge != BOARD_EDGE_NONE) {
+        reg[IE] |= bit;
+      }
+    }
+  }
+  return used;
+}
+
+int main(void) {
+  unsigned ports = 0, pins = 0, stores = 0;
+
+  for (unsigned port = 1; port <= PORTS; port++) {
+    unsigned fold[REGS], pin[REGS];
+    unsigned used = by_pin(port, pin);
+
+    folded(port, fold);
+    if (BOARD_REG_USED(port) != used) {
+      fail("pins used off the rows", port, BOARD_REG_USED(port));
+    }
+    if (!used) {
+      continue;
+    }
+    ports++;
+    for (unsigned bit = 1; bit & 0xFF; bit <<= 1) {
+      pins += (used & bit) != 0;
+    }
+
+    if (port == BOARD_PORT_J) {
+      printf("PJ ");
+      if (pin[IE]) {
+        fail("interrupt asked for on port J", port, pin[IE]);
+      }
+      stores += 6; // no interrupt registers
+    } else {
+      printf("P%-2u", port);
+      stores += 9; // IFG is cleared too
+    }
+    for (unsigned r = 0; r < REGS; r++) {
+      printf(" %s 0x%02X", names[r], fold[r]);
+      if (fold[r] != pin[r]) {
+        fail(names[r], port, fold[r]);
+      }
+    }
+    printf("\n");
+  }
+
+  printf("%u rows, %u pins on %u ports, %u stores, %u errors\n",
+         (unsigned)ROWS, pins, ports, stores, errors);
+  return errors ? 1 : 0;
+}
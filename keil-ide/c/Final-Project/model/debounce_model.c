@@ -0,0 +1,120 @@
+/*
+ * Host model of debounce.c
+ *
+ * Replays random button traces through the state machine and checks every
+ * event it produces. Build and run with `make debounce` in this directory.
+ *
+ * Each press and each release starts with a bounce, the raw level
+ * alternating and starting with the new level, then holds the new level.
+ * Once the change is taken, the level is broken by isolated glitches, one
+ * sample each and never two in a row. Checked:
+ *  - each press gives one PRESS and each release one RELEASE, no later
+ *    than DEBOUNCE_TICKS samples after its bounce
+ *  - the glitches give no events
+ *  - LONG comes DEBOUNCE_LONG_TICKS samples after the PRESS and a REPEAT
+ *    every DEBOUNCE_REPEAT samples after that, for as long as it is held
+ *  - the button is idle right after its RELEASE and not before
+ */
+#include "debounce.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PRESSES      20000
+#define MAX_BOUNCE   24
+#define MAX_HOLD     700
+#define MAX_GAP      300
+#define GLITCH_ODDS  8 // one sample in this many, once settled
+
+static debounce_state state;
+static uint32_t       now;
+static uint32_t       press_time;
+static uint32_t       errors, longs, repeats;
+
+static void fail(const char *what) {
+  if (errors++ < 10) {
+    printf("sample %u: %s\n", (unsigned)now, what);
+  }
+}
+
+// one sample, returns whether it gave the change the phase is waiting for
+static bool sample(bool raw, bool pressing, bool taken) {
+  uint8_t  events = debounce_step(&state, raw);
+  uint32_t held   = now - press_time;
+  bool     down   = pressing == taken; // still down until the RELEASE
+  bool     change = false;
+
+  if (events & DEBOUNCE_EVENT_PRESS) {
+    if (!pressing || taken) {
+      fail("unexpected PRESS");
+    }
+    press_time = now;
+    change     = true;
+  }
+  if (events & DEBOUNCE_EVENT_RELEASE) {
+    if (pressing || taken) {
+      fail("unexpected RELEASE");
+    }
+    if (!debounce_is_idle(&state)) {
+      fail("not idle after RELEASE");
+    }
+    change = true;
+  }
+
+  // held counts the samples since the PRESS while the button stays down
+  if (down && !(events & DEBOUNCE_EVENT_RELEASE)) {
+    bool want_long   = held == DEBOUNCE_LONG_TICKS;
+    bool want_repeat = held > DEBOUNCE_LONG_TICKS &&
+                       (held - DEBOUNCE_LONG_TICKS) % DEBOUNCE_REPEAT == 0;
+
+    if (!!(events & DEBOUNCE_EVENT_LONG) != want_long) {
+      fail(want_long ? "LONG missing" : "unexpected LONG");
+    }
+    if (!!(events & DEBOUNCE_EVENT_REPEAT) != want_repeat) {
+      fail(want_repeat ? "REPEAT missing" : "unexpected REPEAT");
+    }
+    longs   += want_long;
+    repeats += want_repeat;
+    if (debounce_is_idle(&state)) {
+      fail("idle while pressed");
+    }
+  } else if (events & (DEBOUNCE_EVENT_LONG | DEBOUNCE_EVENT_REPEAT)) {
+    fail("LONG or REPEAT while not held");
+  }
+
+  now++;
+  return change;
+}
+
+static void phase(bool pressing, uint32_t bounce, uint32_t hold) {
+  bool     taken   = false;
+  bool     glitch  = false;
+  uint32_t settled = now + bounce + DEBOUNCE_TICKS;
+
+  for (uint32_t i = 0; i < bounce; i++) {
+    taken |= sample((i & 1) ? !pressing : pressing, pressing, taken);
+  }
+  for (uint32_t i = 0; i < hold; i++) {
+    // a glitch only once the change is in, and never two in a row
+    glitch = taken && !glitch && rand() % GLITCH_ODDS == 0;
+    taken |= sample(glitch ? !pressing : pressing, pressing, taken);
+    if (!taken && now >= settled) {
+      fail(pressing ? "PRESS late" : "RELEASE late");
+      taken = true;
+    }
+  }
+}
+
+int main(void) {
+  srand(432);
+  debounce_reset(&state);
+
+  for (uint32_t i = 0; i < PRESSES; i++) {
+    phase(true, rand() % MAX_BOUNCE, DEBOUNCE_TICKS + rand() % MAX_HOLD);
+    phase(false, rand() % MAX_BOUNCE, DEBOUNCE_TICKS + rand() % MAX_GAP);
+  }
+
+  printf("%u presses, %u long presses, %u repeats, %u errors\n",
+         (unsigned)PRESSES, (unsigned)longs, (unsigned)repeats,
+         (unsigned)errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Host model of energy.c
+ *
+ * Replays event traces through the estimator and checks the charge it
+ * accounts to each load. Build and run with `make energy` in this directory.
+ *
+ * The short traces are written out by hand with their totals worked out
+ * from the datasheet figures in energy.c, so they also pin those figures.
+ * The long one is a random trace on the 32768 Hz scheduler clock, starting
+ * just before it wraps, with the CPU changing mode and loads switching on
+ * and off at random times. Checked:
+ *  - the present current of a load is its figure times the units running,
+ *    and of the CPU the figure of its mode
+ *  - after every event each load holds exactly the sum of its currents times
+ *    the time they ran, and its nAh are that sum rounded down
+ *  - an update with no time passed charges nothing
+ */
+#include "energy.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HZ      32768u
+#define HOUR    (HZ * 3600u)
+#define START   0xFFF00000u
+#define EVENTS  500000
+#define MAX_GAP 3000 // ticks between events
+#define UNITS   4    // most units of a load running at once
+
+typedef struct {
+  uint32_t time;
+  uint8_t  load; // ENERGY_CPU for a mode change
+  uint8_t  value;
+} event;
+
+typedef struct {
+  const char  *name;
+  uint8_t      mode; // of the CPU to start with
+  const event *events;
+  uint32_t     length;
+  uint32_t     end;               // time of the final update
+  uint32_t     nah[ENERGY_LOADS]; // expected
+} trace;
+
+static energy_state state;
+static uint32_t     errors;
+
+// hand-written traces
+
+static const event day_and_night[] = {
+    {0, ENERGY_LED, 2},    // an hour active with two colours lit
+    {HOUR, ENERGY_CPU, 2}, // then an hour in LPM3
+    {HOUR, ENERGY_LED, 0},
+};
+
+static const event adc_burst[] = {
+    {0, ENERGY_ADC, 0},
+    {1000, ENERGY_ADC, 1}, // one second converting
+    {1000 + HZ, ENERGY_ADC, 0},
+};
+
+static const event wrap[] = {
+    {START, ENERGY_UART, 1}, // a 32 second transmission across the wrap
+    {START + 32 * HZ, ENERGY_UART, 0},
+    {START + 32 * HZ, ENERGY_TIMER_ACLK, 1}, // an hour counting on ACLK
+};
+
+static const trace traces[] = {
+    {"day and night", 0, day_and_night, 3, 2 * HOUR,
+     {481500, 0, 0, 0, 0, 0, 4000000}},
+    // 160000 nA for a second is 44.4 nAh, the CPU in LPM0 since tick 0
+    {"ADC burst", 1, adc_burst, 3, 1000 + HZ, {71, 44, 0, 0, 0, 0, 0}},
+    // 20000 nA for 32 s is 177.8 nAh
+    {"time base wrap", 0, wrap, 3, START + 32 * HZ + HOUR,
+     {484266, 0, 0, 177, 0, 100, 0}},
+};
+
+static void apply(const event *e) {
+  if (e->load == ENERGY_CPU) {
+    energy_mode(&state, e->value, e->time);
+  } else {
+    energy_set(&state, e->load, e->value, e->time);
+  }
+}
+
+static void replay(const trace *t) {
+  energy_reset(&state, t->mode, t->events[0].time);
+  for (uint32_t i = 0; i < t->length; i++) {
+    apply(&t->events[i]);
+  }
+  energy_update(&state, t->end);
+
+  for (uint8_t load = 0; load < ENERGY_LOADS; load++) {
+    uint32_t nah = energy_nah(&state, load, HZ);
+
+    if (nah != t->nah[load]) {
+      printf("%s: load %u, %u nAh, expected %u\n", t->name, load,
+             (unsigned)nah, (unsigned)t->nah[load]);
+      errors++;
+    }
+  }
+}
+
+// random trace
+
+static uint32_t now;
+static uint8_t  mode;
+static uint8_t  units[ENERGY_LOADS];
+static uint32_t mode_na[ENERGY_CPU_MODES];
+static uint32_t unit_na[ENERGY_LOADS];
+static uint64_t charge[ENERGY_LOADS]; // nA times ticks, as it should be
+
+static void fail(const char *what, uint8_t load) {
+  if (errors++ < 10) {
+    printf("tick %u: %s, load %u\n", (unsigned)now, what, load);
+  }
+}
+
+static uint32_t current(uint8_t load) {
+  return load == ENERGY_CPU ? mode_na[mode] : unit_na[load] * units[load];
+}
+
+// the figures, read back through energy_current
+static void figures(void) {
+  for (uint8_t m = 0; m < ENERGY_CPU_MODES; m++) {
+    energy_reset(&state, m, 0);
+    mode_na[m] = energy_current(&state, ENERGY_CPU);
+  }
+  energy_reset(&state, 0, 0);
+  for (uint8_t load = ENERGY_CPU + 1; load < ENERGY_LOADS; load++) {
+    energy_set(&state, load, 1, 0);
+    unit_na[load] = energy_current(&state, load);
+  }
+}
+
+static void check(void) {
+  for (uint8_t load = 0; load < ENERGY_LOADS; load++) {
+    if (energy_current(&state, load) != current(load)) {
+      fail("wrong current", load);
+    }
+    if (state.charge[load] != charge[load]) {
+      fail("wrong charge", load);
+    }
+    if (energy_nah(&state, load, HZ) !=
+        (uint32_t)(charge[load] / ((uint64_t)HZ * 3600))) {
+      fail("wrong nAh", load);
+    }
+  }
+}
+
+static void random_trace(void) {
+  figures();
+
+  now  = START;
+  mode = 0;
+  energy_reset(&state, mode, now);
+
+  for (uint32_t i = 0; i < EVENTS; i++) {
+    uint32_t gap  = rand() % MAX_GAP;
+    uint8_t  load = rand() % ENERGY_LOADS;
+
+    for (uint8_t k = 0; k < ENERGY_LOADS; k++) {
+      charge[k] += (uint64_t)current(k) * gap;
+    }
+    now += gap;
+
+    if (load == ENERGY_CPU) {
+      mode = rand() % ENERGY_CPU_MODES;
+      energy_mode(&state, mode, now);
+    } else if (rand() % 8 == 0) {
+      // the second with no time passed charges nothing
+      energy_update(&state, now);
+      energy_update(&state, now);
+    } else {
+      units[load] = rand() % (UNITS + 1);
+      energy_set(&state, load, units[load], now);
+    }
+    check();
+  }
+}
+
+int main(void) {
+  uint64_t total = 0;
+
+  srand(432);
+
+  for (size_t i = 0; i < sizeof traces / sizeof traces[0]; i++) {
+    replay(&traces[i]);
+  }
+  random_trace();
+
+  for (uint8_t load = 0; load < ENERGY_LOADS; load++) {
+    total += energy_nah(&state, load, HZ);
+  }
+  printf("%u events over %.1f hours, %llu nAh in all, %u errors\n",
+         (unsigned)EVENTS, (double)(now - START) / HOUR,
+         (unsigned long long)total, (unsigned)errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * Host stand-in for the device header, with the pin bits board.h's table
+ * is written in
+ */
+#ifndef MODEL_MSP_H_
+#define MODEL_MSP_H_
+
+#define BIT0 0x01
+#define BIT1 0x02
+#define BIT2 0x04
+#define BIT3 0x08
+#define BIT4 0x10
+#define BIT5 0x20
+#define BIT6 0x40
+#define BIT7 0x80
+
+#endif // MODEL_MSP_H_
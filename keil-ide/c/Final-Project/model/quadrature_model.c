@@ -0,0 +1,328 @@
+/*
+ * Host model of quadrature.c
+ *
+ * Replays A/B sequences through the decoder and checks the position, the
+ * errors and the velocity it gives. Build and run with `make quadrature` in
+ * this directory.
+ *
+ * A few short sequences are written out by hand, covering each kind of
+ * transition, the position wrapping and the velocity after a stop. The rest
+ * is the trace of a simulated shaft on a 1 MHz time base that wraps about a
+ * second in. The shaft turns at a constant speed for a random time, up to
+ * MAX_RATE edges a second either way, stops, or dithers on one edge. Now and
+ * then two edges come too close to be told apart and the decoder only sees
+ * the levels after both. The velocity is estimated every ESTIMATE_US, as a
+ * control loop would. Checked:
+ *  - the position follows the shaft, and an edge pair seen as one in the
+ *    same direction counts one error and loses its two counts
+ *  - an estimate from edges all at one speed is that speed, to within the
+ *    1 us resolution of the edge times
+ *  - with no count since the last estimate the velocity keeps its sign,
+ *    never grows, and is at most one count over the time since the last edge
+ */
+#include "quadrature.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HZ          1000000
+#define START       0xFFF00000u
+#define SEGMENTS    3000
+#define MAX_LENGTH  200000 // us a segment lasts
+#define MAX_RATE    40000  // edges a second
+#define ESTIMATE_US 1000
+#define MERGE_ODDS  2000 // one edge in this many seen with the next
+
+static const uint8_t levels[4] = {0, QUADRATURE_A,
+                                  QUADRATURE_A | QUADRATURE_B, QUADRATURE_B};
+
+static quadrature_state state;
+static uint32_t         errors;
+
+static void fail(const char *what, uint32_t time) {
+  if (errors++ < 10) {
+    printf("%s at %u us\n", what, (unsigned)time);
+  }
+}
+
+// hand-written sequences
+
+typedef struct {
+  const char *name;
+  const char *ab; // levels, one pair of bits per edge after the first
+  int32_t     position;
+  uint32_t    errors;
+} sequence;
+
+static const sequence sequences[] = {
+    {"forward cycle", "00 10 11 01 00", 4, 0},
+    {"reverse cycle", "00 01 11 10 00", -4, 0},
+    {"dither", "00 10 00 10 00 10 00", 0, 0},
+    {"no change", "00 00 10 10 11 11", 2, 0},
+    {"skipped state", "00 11 01 00", 2, 1},
+    {"reversal across a skip", "00 10 01 11", 0, 1},
+    {"skips both ways", "00 11 00 01 10", -1, 3},
+};
+
+static uint8_t parse(const char *ab) {
+  return (ab[0] == '1' ? QUADRATURE_A : 0) | (ab[1] == '1' ? QUADRATURE_B : 0);
+}
+
+static void replay(const sequence *q) {
+  uint32_t time = 0;
+
+  quadrature_reset(&state, parse(q->ab), time);
+  for (const char *ab = q->ab + 2; *ab; ab += 3) {
+    time += 1000;
+    quadrature_step(&state, parse(ab + 1), time);
+  }
+  if (state.position != q->position || state.errors != q->errors) {
+    printf("%s: position %d, %u errors, expected %d and %u\n", q->name,
+           (int)state.position, (unsigned)state.errors, (int)q->position,
+           (unsigned)q->errors);
+    errors++;
+  }
+}
+
+static void check_velocity(const char *what, uint32_t now, int32_t expected) {
+  int32_t velocity = quadrature_velocity(&state, now, HZ);
+
+  if (velocity != expected) {
+    printf("%s: velocity %d, expected %d\n", what, (int)velocity,
+           (int)expected);
+    errors++;
+  }
+}
+
+static void fixed(void) {
+  uint32_t time = 0;
+  int      k;
+
+  for (size_t i = 0; i < sizeof sequences / sizeof sequences[0]; i++) {
+    replay(&sequences[i]);
+  }
+
+  // 40 counts forward one every ms, then 20 back one every 500 us
+  quadrature_reset(&state, levels[0], time);
+  for (k = 1; k <= 40; k++) {
+    time += 1000;
+    quadrature_step(&state, levels[k & 3], time);
+  }
+  check_velocity("forward", time + 10, 1000);
+  for (k = 39; k >= 20; k--) {
+    time += 500;
+    quadrature_step(&state, levels[k & 3], time);
+  }
+  check_velocity("reverse", time, -2000);
+
+  // stopped: at most one count over the time since the last edge
+  check_velocity("stopped 100 ms", time + 100000, -10);
+  check_velocity("stopped 2 s", time + 2000000, 0);
+
+  // the first edge after the stop: one count over the whole wait
+  time += 1000000;
+  quadrature_step(&state, levels[21 & 3], time);
+  check_velocity("edge after the stop", time, 1);
+
+  // the position wraps instead of overflowing
+  quadrature_reset(&state, levels[0], 0);
+  state.position      = INT32_MAX;
+  state.mark_position = INT32_MAX;
+  quadrature_step(&state, levels[1], 5);
+  if (state.position != INT32_MIN) {
+    printf("wrap: position %d\n", (int)state.position);
+    errors++;
+  }
+  check_velocity("wrap", 5, 200000);
+}
+
+// simulated shaft
+
+static double   clock_us; // since START
+static int64_t  shaft;    // counts
+static double   phase;    // fraction of a count past shaft
+static int      segment;
+static uint64_t edges, merges, estimates, checked;
+
+static int64_t  lost;         // counts the decoder could not see
+static uint32_t skips;        // edge pairs it saw as a skipped state
+static bool     hidden;       // the last edge waits to be seen with the next
+static int      hidden_step;  // its direction
+static uint32_t hidden_time;  // and time
+static uint32_t merge_time;   // of the first edge of the last pair seen as one
+static int      edge_segment; // of the last counted edge
+static double   edge_rate;    // the shaft speed then
+static int      mark_segment; // of the edge the next estimate starts from
+static int32_t  velocity;
+static double   rate; // of the segment, counts a second
+
+static uint32_t time_of(double us) {
+  return START + (uint32_t)(uint64_t)(us + 0.5);
+}
+
+static void edge(int step) {
+  uint32_t time = time_of(clock_us);
+
+  shaft += step;
+  edges++;
+
+  if (!hidden && rand() % MERGE_ODDS == 0) {
+    hidden      = true;
+    hidden_step = step;
+    hidden_time = time;
+    return;
+  }
+  if (hidden) {
+    // both levels changed in one step, or none if it turned back
+    hidden     = false;
+    merge_time = hidden_time;
+    merges++;
+    if (hidden_step == step) {
+      lost += 2 * step;
+      skips++;
+    }
+  }
+
+  if (quadrature_step(&state, levels[shaft & 3], time) != 0) {
+    edge_segment = segment;
+    edge_rate    = rate;
+  }
+  if (state.position != (int32_t)(uint32_t)(uint64_t)(shaft - lost) ||
+      state.errors != skips) {
+    fail("position or errors differ", time);
+    lost  = shaft - state.position;
+    skips = state.errors;
+  }
+}
+
+static void estimate(void) {
+  uint32_t now     = time_of(clock_us);
+  int32_t  counts  = state.position - state.mark_position;
+  uint32_t since   = now - state.edge_time;
+  int32_t  last    = velocity;
+  uint32_t span    = state.edge_time - state.mark_time;
+  // a pair seen as one after the mark time loses counts but not time
+  bool uniform = mark_segment == edge_segment && edge_rate != 0 &&
+                 (int32_t)(merge_time - state.mark_time) < 0;
+
+  velocity = quadrature_velocity(&state, now, HZ);
+  estimates++;
+
+  if (counts != 0) {
+    if (uniform && span > 1) {
+      // each edge time is within half a microsecond of the true one
+      double tolerance = (edge_rate < 0 ? -edge_rate : edge_rate) / (span - 1);
+
+      if (velocity < edge_rate - tolerance - 1 ||
+          velocity > edge_rate + tolerance + 1) {
+        fail("velocity differs from the shaft", now);
+      }
+      checked++;
+    }
+    mark_segment = edge_segment;
+  } else {
+    if ((last >= 0 && (velocity < 0 || velocity > last)) ||
+        (last < 0 && (velocity > 0 || velocity < last))) {
+      fail("velocity grew with no count", now);
+    }
+    uint32_t speed = velocity < 0 ? 0u - (uint32_t)velocity : velocity;
+
+    if (since && speed > HZ / since) {
+      fail("velocity over one count since the last edge", now);
+    }
+  }
+}
+
+// advances the clock to t, estimating on the way
+static void advance(double t) {
+  double next = ((uint64_t)(clock_us / ESTIMATE_US) + 1.0) * ESTIMATE_US;
+
+  while (next <= t) {
+    clock_us = next;
+    estimate();
+    next += ESTIMATE_US;
+  }
+  clock_us = t;
+}
+
+static void turn(double length) {
+  double end = clock_us + length;
+
+  for (;;) {
+    double to_edge;
+
+    if (rate == 0) {
+      advance(end);
+      return;
+    }
+    to_edge = (rate > 0 ? 1 - phase : phase) / (rate > 0 ? rate : -rate) * HZ;
+    if (clock_us + to_edge > end) {
+      phase += (end - clock_us) * rate / HZ;
+      advance(end);
+      return;
+    }
+    advance(clock_us + to_edge);
+    phase = rate > 0 ? 0 : 1;
+    edge(rate > 0 ? 1 : -1);
+  }
+}
+
+static void dither(double length) {
+  double end  = clock_us + length;
+  int    step = rand() % 2 ? 1 : -1;
+
+  for (;;) {
+    double gap = 5 + rand() % 500;
+
+    if (clock_us + gap > end) {
+      advance(end);
+      break;
+    }
+    advance(clock_us + gap);
+    edge(step);
+    step = -step;
+  }
+  phase = 0.5;
+}
+
+static void simulate(void) {
+  quadrature_reset(&state, levels[0], START);
+  mark_segment = -1; // the first estimate starts from the reset, no edge
+  merge_time   = START - 1;
+
+  for (segment = 0; segment < SEGMENTS; segment++) {
+    double length = 1 + rand() % MAX_LENGTH;
+    int    kind   = rand() % 8;
+
+    if (kind == 0) {
+      rate = 0;
+      dither(length);
+      continue;
+    }
+    if (kind == 1) {
+      rate = 0;
+    } else if (kind == 2) {
+      rate = 1 + rand() % 200;
+    } else {
+      rate = 1 + rand() % MAX_RATE;
+    }
+    if (rand() % 2) {
+      rate = -rate;
+    }
+    turn(length);
+  }
+}
+
+int main(void) {
+  srand(432);
+
+  fixed();
+  simulate();
+
+  printf("%llu edges (%llu seen with the next), %llu estimates (%llu checked "
+         "against the shaft), %u errors\n",
+         (unsigned long long)edges, (unsigned long long)merges,
+         (unsigned long long)estimates, (unsigned long long)checked,
+         (unsigned)errors);
+  return errors ? 1 : 0;
+}
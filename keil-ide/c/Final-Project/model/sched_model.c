@@ -0,0 +1,261 @@
+/*
+ * Host model of sched.c
+ *
+ * Runs the scheduler core against a simulated clock through sched_port.h and
+ * checks every task it runs and every time it sleeps. Build and run with
+ * `make sched` in this directory.
+ *
+ * The clock starts just before the 32-bit tick count wraps. Tasks take a
+ * random time to run and post, delay, make periodic or cancel random tasks,
+ * themselves included. A simulated interrupt posts random tasks at random
+ * times; it is taken when the port lock is released, as on target. Idling
+ * moves the clock straight to the armed deadline or the next interrupt,
+ * whichever comes first. The model keeps its own copy of what each task is
+ * waiting for. Checked:
+ *  - a task runs only when posted, or once its deadline has passed
+ *  - periodic tasks come back one period after their last deadline, or one
+ *    period after they ran if they fell a whole period behind
+ *  - the scheduler never sleeps with work due, and arms the port for the
+ *    earliest deadline exactly, or disarms it when nothing is delayed
+ *  - tasks run with the lock released, the port is armed and idled with it
+ *    held
+ */
+#include "sched.h"
+#include "sched_port.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TASKS       12
+#define START       0xFFF00000u // wraps about 30 seconds in
+#define DURATION    (SCHED_TICKS_PER_SEC * 3600u)
+#define MAX_RUN     64                  // ticks a task takes
+#define MAX_DELAY   SCHED_MS(4000)      // over several turns of the wheel
+#define MAX_PERIOD  SCHED_MS(2000)
+#define MAX_IRQ_GAP SCHED_MS(300)
+
+typedef struct {
+  uint32_t ready;   // runs posted, two if posted again once taken to run
+  bool     delayed; // waiting for deadline
+  uint32_t deadline;
+  uint32_t period;
+} expected;
+
+static sched_task tasks[TASKS];
+static expected   want[TASKS];
+
+// simulated port
+
+static uint32_t now = START;
+static uint32_t lock_depth;
+static bool     armed;
+static uint32_t alarm_time;
+static uint32_t next_irq;
+static jmp_buf  finished;
+
+static uint64_t runs, late_runs, irq_posts, sleeps, errors;
+
+static void fail(const char *what, int task) {
+  if (errors++ < 10) {
+    printf("tick %u (+%u): %s, task %d\n", (unsigned)now,
+           (unsigned)(now - START), what, task);
+  }
+}
+
+static uint32_t random_ticks(uint32_t max) {
+  return (uint32_t)(((uint64_t)rand() * (max + 1)) / ((uint64_t)RAND_MAX + 1));
+}
+
+static bool due(const expected *e) {
+  return e->ready || (e->delayed && (int32_t)(e->deadline - now) <= 0);
+}
+
+// the scheduler calls, the model updated first since an interrupt can be
+// taken as the call releases the lock
+
+static void post(int i) {
+  if (!sched_is_pending(&tasks[i])) {
+    // idle, or taken off the queue by an interrupted sched_run_once and
+    // about to run: either way it runs once more
+    want[i].ready++;
+  } else if (!want[i].ready) {
+    want[i].delayed = false;
+    want[i].ready   = 1;
+  }
+  sched_post(&tasks[i]);
+}
+
+static void post_delayed(int i, uint32_t delay) {
+  want[i] = (expected){0, true, now + delay, 0};
+  sched_post_delayed(&tasks[i], delay);
+}
+
+static void post_periodic(int i, uint32_t period) {
+  want[i] = (expected){0, true, now + period, period};
+  sched_post_periodic(&tasks[i], period);
+}
+
+static void cancel(int i) {
+  want[i] = (expected){0, false, 0, 0};
+  sched_cancel(&tasks[i]);
+}
+
+static void interrupt(void) {
+  next_irq = now + 1 + random_ticks(MAX_IRQ_GAP);
+  for (int n = 1 + rand() % 3; n > 0; n--) {
+    post(rand() % TASKS);
+    irq_posts++;
+  }
+}
+
+void sched_port_init(void) {}
+
+uint32_t sched_port_now(void) { return now; }
+
+void sched_port_arm(uint32_t deadline) {
+  if (!lock_depth) {
+    fail("armed without the lock", -1);
+  }
+  armed      = true;
+  alarm_time = deadline;
+}
+
+void sched_port_disarm(void) {
+  if (!lock_depth) {
+    fail("disarmed without the lock", -1);
+  }
+  armed = false;
+}
+
+uint32_t sched_port_lock(void) { return lock_depth++; }
+
+void sched_port_unlock(uint32_t state) {
+  lock_depth = state;
+  // a pending interrupt is taken as soon as the lock is released
+  if (!lock_depth && (int32_t)(now - next_irq) >= 0) {
+    interrupt();
+  }
+}
+
+void sched_port_idle(void) {
+  bool     delayed  = false;
+  uint32_t earliest = 0;
+
+  if (!lock_depth) {
+    fail("idled without the lock", -1);
+  }
+  for (int i = 0; i < TASKS; i++) {
+    if (due(&want[i])) {
+      fail("slept with the task due", i);
+    }
+    if (want[i].delayed &&
+        (!delayed || (int32_t)(want[i].deadline - earliest) < 0)) {
+      earliest = want[i].deadline;
+      delayed  = true;
+    }
+  }
+  if (delayed != armed || (armed && alarm_time != earliest)) {
+    fail("armed for the wrong deadline", -1);
+  }
+
+  if (now - START >= DURATION) {
+    longjmp(finished, 1);
+  }
+
+  // wake on the alarm or the interrupt, the interrupt then taken on unlock
+  sleeps++;
+  if (armed && (int32_t)(alarm_time - next_irq) < 0) {
+    now = alarm_time;
+  } else {
+    now = next_irq;
+  }
+}
+
+// tasks
+
+static void task(void *arg) {
+  int       self = (int)(intptr_t)arg;
+  expected *e    = &want[self];
+
+  if (lock_depth) {
+    fail("ran with the lock held", self);
+  }
+  if (e->delayed && (int32_t)(e->deadline - now) <= 0) {
+    if (now != e->deadline) {
+      late_runs++;
+    }
+    e->delayed = false;
+  } else if (e->ready) {
+    e->ready--;
+  } else {
+    fail(e->delayed ? "ran early" : "ran while not pending", self);
+    e->delayed = false;
+  }
+  runs++;
+
+  now += random_ticks(MAX_RUN);
+
+  for (int n = rand() % 3; n > 0; n--) {
+    int other = rand() % TASKS;
+
+    switch (rand() % 8) {
+    case 0:
+    case 1:
+      post(other);
+      break;
+    case 2:
+    case 3:
+    case 4:
+      post_delayed(other, random_ticks(MAX_DELAY));
+      break;
+    case 5:
+      post_periodic(other, 1 + random_ticks(MAX_PERIOD));
+      break;
+    case 6:
+      cancel(other);
+      break;
+    default:
+      if (sched_is_pending(&tasks[other]) !=
+          (want[other].ready || want[other].delayed)) {
+        fail("pending state differs", other);
+      }
+      break;
+    }
+  }
+
+  // not posted again while it ran: a periodic task goes back on the wheel
+  if (e->period && !e->ready && !e->delayed) {
+    e->deadline += e->period;
+    if ((int32_t)(e->deadline - now) <= 0) {
+      e->deadline = now + e->period;
+    }
+    e->delayed = true;
+  }
+}
+
+int main(void) {
+  srand(432);
+
+  for (int i = 0; i < TASKS; i++) {
+    tasks[i] = (sched_task)SCHED_TASK_INIT(task, (void *)(intptr_t)i);
+  }
+  sched_init();
+  next_irq = now + random_ticks(MAX_IRQ_GAP);
+
+  for (int i = 0; i < TASKS / 2; i++) {
+    post_periodic(i, 1 + random_ticks(MAX_PERIOD));
+  }
+  post_delayed(TASKS / 2, SCHED_MS(1000));
+  post(TASKS / 2 + 1);
+
+  if (!setjmp(finished)) {
+    sched_run();
+  }
+
+  printf("%llu tasks run (%llu late), %llu posts from interrupts, %llu "
+         "sleeps, %llu errors\n",
+         (unsigned long long)runs, (unsigned long long)late_runs,
+         (unsigned long long)irq_posts, (unsigned long long)sleeps,
+         (unsigned long long)errors);
+  return errors ? 1 : 0;
+}
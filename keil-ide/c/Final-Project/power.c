@@ -0,0 +1,130 @@
+#include "power.h"
+#include "msp.h"
+#include "sched_port.h"
+
+static volatile uint8_t smclk_users;
+static volatile uint8_t aclk_users;
+
+static power_stats  stats;
+static uint32_t     stats_start;
+static energy_state energy; // zero is nothing running, active, at time 0
+
+void power_require(uint8_t needs) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (needs & POWER_NEED_SMCLK) {
+    smclk_users++;
+  }
+  if (needs & POWER_NEED_ACLK) {
+    aclk_users++;
+  }
+  __set_PRIMASK(primask);
+}
+
+void power_release(uint8_t needs) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if ((needs & POWER_NEED_SMCLK) && smclk_users) {
+    smclk_users--;
+  }
+  if ((needs & POWER_NEED_ACLK) && aclk_users) {
+    aclk_users--;
+  }
+  __set_PRIMASK(primask);
+}
+
+uint8_t power_select(bool armed, int32_t ticks_left) {
+  if (smclk_users || (armed && ticks_left < POWER_LPM3_MIN_TICKS)) {
+    return POWER_LPM0;
+  }
+  if (aclk_users || armed) {
+    return POWER_LPM3;
+  }
+  return POWER_LPM4;
+}
+
+void power_enter(uint8_t mode) {
+  uint32_t start = sched_port_now();
+  uint32_t now;
+
+  if (mode == POWER_LPM0) {
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+  } else {
+    // LPM4 is LPM3 with nothing left running on ACLK; keep AMR, writing
+    // it would request an active mode change
+    PCM->CTL0 = PCM_CTL0_KEY_VAL | PCM_CTL0_LPMR__LPM3 |
+                (PCM->CTL0 & PCM_CTL0_AMR_MASK);
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+  }
+  energy_mode(&energy, mode, start);
+  // WFI wakes on a pending interrupt even with PRIMASK set
+  __WFI();
+  SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+  now = sched_port_now();
+  energy_mode(&energy, POWER_ACTIVE, now);
+  stats.entries[mode]++;
+  if (mode != POWER_LPM4) {
+    stats.ticks[mode] += now - start;
+  }
+}
+
+void power_get_stats(power_stats *s) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *s = stats;
+  // the rest of the time since the reset
+  s->ticks[POWER_ACTIVE] = sched_port_now() - stats_start -
+                           s->ticks[POWER_LPM0] - s->ticks[POWER_LPM3];
+  __set_PRIMASK(primask);
+}
+
+void power_reset_stats(void) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  for (uint8_t i = 0; i < POWER_MODES; i++) {
+    stats.ticks[i]   = 0;
+    stats.entries[i] = 0;
+  }
+  stats_start = sched_port_now();
+  __set_PRIMASK(primask);
+}
+
+void power_load_on(uint8_t load) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  energy_set(&energy, load, energy.units[load] + 1, sched_port_now());
+  __set_PRIMASK(primask);
+}
+
+void power_load_off(uint8_t load) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (energy.units[load]) {
+    energy_set(&energy, load, energy.units[load] - 1, sched_port_now());
+  }
+  __set_PRIMASK(primask);
+}
+
+void power_load_set(uint8_t load, uint8_t units) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  energy_set(&energy, load, units, sched_port_now());
+  __set_PRIMASK(primask);
+}
+
+void power_get_energy(energy_state *e) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  energy_update(&energy, sched_port_now());
+  *e = energy;
+  __set_PRIMASK(primask);
+}
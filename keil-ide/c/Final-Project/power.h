@@ -0,0 +1,66 @@
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "energy.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Low-power idle manager. Drivers say which clocks they need kept running
+// while the CPU sleeps, and the scheduler's idle loop sleeps in the deepest
+// mode that keeps those and its next deadline:
+//   SMCLK needed, or a deadline too close for LPM3    LPM0
+//   ACLK needed, or a deadline armed                  LPM3
+//   neither                                           LPM4
+// In LPM4 ACLK stops too, the scheduler time stands still and only port
+// interrupts wake the CPU.
+//
+// Time spent in each mode is counted in scheduler ticks, which wrap after
+// 36 hours. The time in LPM4 is not seen by anything, only its sleeps are
+// counted.
+//
+// The same events feed a charge estimate since boot (energy.h), along with
+// the loads the drivers report running. The charge of anything left running
+// through LPM4 is missed with its time.
+
+#define POWER_NEED_SMCLK 0x01
+#define POWER_NEED_ACLK  0x02
+
+// waking from LPM3 costs about as much as sleeping this long in LPM0
+#define POWER_LPM3_MIN_TICKS 2
+
+enum power_mode {
+  POWER_ACTIVE,
+  POWER_LPM0,
+  POWER_LPM3,
+  POWER_LPM4,
+  POWER_MODES,
+};
+
+typedef struct {
+  uint32_t ticks[POWER_MODES];   // POWER_LPM4 stays 0
+  uint32_t entries[POWER_MODES]; // sleeps, POWER_ACTIVE stays 0
+} power_stats;
+
+// counted, so every require needs its release; safe from ISRs
+void power_require(uint8_t needs);
+void power_release(uint8_t needs);
+
+// deepest mode for the current needs, with the port alarm armed ticks_left
+// ahead or not armed at all
+uint8_t power_select(bool armed, int32_t ticks_left);
+// called with interrupts locked, sleeps until one is pending
+void    power_enter(uint8_t mode);
+
+// residency since boot or the previous reset
+void power_get_stats(power_stats *s);
+void power_reset_stats(void);
+
+// a unit of an ENERGY_x load started or stopped, counted; safe from ISRs
+void power_load_on(uint8_t load);
+void power_load_off(uint8_t load);
+// for loads that are set rather than counted
+void power_load_set(uint8_t load, uint8_t units);
+// charge since boot, up to now
+void power_get_energy(energy_state *e);
+
+#endif /* POWER_H_ */
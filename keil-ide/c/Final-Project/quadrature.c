@@ -0,0 +1,73 @@
+#include "quadrature.h"
+
+#define SKIP 2
+
+// count change, indexed by (previous levels << 2) | new levels
+static const int8_t transitions[16] = {
+    0,    -1,   1,    SKIP, // from 00
+    1,    0,    SKIP, -1,   // from 01
+    -1,   SKIP, 0,    1,    // from 10
+    SKIP, 1,    -1,   0,    // from 11
+};
+
+void quadrature_reset(quadrature_state *s, uint8_t ab, uint32_t now) {
+  s->ab            = ab & (QUADRATURE_A | QUADRATURE_B);
+  s->position      = 0;
+  s->errors        = 0;
+  s->edge_time     = now;
+  s->mark_position = 0;
+  s->mark_time     = now;
+  s->velocity      = 0;
+}
+
+int8_t quadrature_step(quadrature_state *s, uint8_t ab, uint32_t time) {
+  int8_t change;
+
+  ab     &= QUADRATURE_A | QUADRATURE_B;
+  change  = transitions[(s->ab << 2) | ab];
+  s->ab   = ab;
+
+  if (change == SKIP) {
+    // an edge was missed, the direction is unknown
+    s->errors++;
+    return 0;
+  }
+  if (change != 0) {
+    // unsigned so the position wraps instead of overflowing
+    s->position  = (int32_t)((uint32_t)s->position + (uint32_t)change);
+    s->edge_time = time;
+  }
+  return change;
+}
+
+int32_t quadrature_velocity(quadrature_state *s, uint32_t now, uint32_t hz) {
+  uint32_t span;
+  int32_t  counts =
+      (int32_t)((uint32_t)s->position - (uint32_t)s->mark_position);
+
+  if (counts != 0) {
+    // whole counts over the exact time they took, not over the call period
+    span = s->edge_time - s->mark_time;
+    if (span == 0) {
+      span = 1;
+    }
+    s->velocity      = (int32_t)((int64_t)counts * hz / span);
+    s->mark_position = s->position;
+    s->mark_time     = s->edge_time;
+    return s->velocity;
+  }
+
+  // no edge since: the next one is at least now - edge_time away, which
+  // bounds the speed to one count over that time
+  span = now - s->edge_time;
+  if (span != 0) {
+    uint32_t bound = hz / span;
+
+    if (s->velocity > 0 && (uint32_t)s->velocity > bound) {
+      s->velocity = (int32_t)bound;
+    } else if (s->velocity < 0 && 0u - (uint32_t)s->velocity > bound) {
+      s->velocity = -(int32_t)bound;
+    }
+  }
+  return s->velocity;
+}
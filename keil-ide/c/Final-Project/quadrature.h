@@ -0,0 +1,38 @@
+#ifndef QUADRATURE_H_
+#define QUADRATURE_H_
+
+#include <stdint.h>
+
+// Quadrature decoder for one encoder, advanced once per edge with the new
+// A/B levels and the time of the edge. The count change comes from a
+// 16-entry table indexed by the previous and new levels, so every edge of
+// both channels counts (4 counts per cycle). Like debounce.c it has no
+// hardware dependencies, so recorded A/B sequences can be replayed through
+// it off target.
+
+// levels are passed as A in bit 1, B in bit 0; forward is A leading B,
+// 00 10 11 01
+#define QUADRATURE_A 0x2
+#define QUADRATURE_B 0x1
+
+typedef struct {
+  uint8_t  ab;       // last levels
+  int32_t  position; // counts, wraps
+  uint32_t errors;   // transitions that changed both levels at once
+  // velocity, counts between two estimates over the time between the
+  // edges that bound them
+  uint32_t edge_time; // time of the last counted edge
+  int32_t  mark_position;
+  uint32_t mark_time;
+  int32_t  velocity;
+} quadrature_state;
+
+void quadrature_reset(quadrature_state *s, uint8_t ab, uint32_t now);
+// returns the count change, -1, 0 or 1; a skipped state counts as an error
+// and takes the new levels without counting
+int8_t quadrature_step(quadrature_state *s, uint8_t ab, uint32_t time);
+// counts per second for a time base of hz, from the edges since the last
+// call; with no edge since, it decays as no count could have been missed
+int32_t quadrature_velocity(quadrature_state *s, uint32_t now, uint32_t hz);
+
+#endif /* QUADRATURE_H_ */
@@ -0,0 +1,225 @@
+#include "sched.h"
+#include "sched_port.h"
+#include <stddef.h>
+
+#define SCHED_IDLE    0
+#define SCHED_READY   1
+#define SCHED_DELAYED 2
+
+#define SCHED_SLOT_TICKS (1u << SCHED_SLOT_SHIFT)
+#define SCHED_SLOT_OF(t) (((t) >> SCHED_SLOT_SHIFT) & (SCHED_WHEEL_SLOTS - 1))
+
+static sched_task *ready_head;
+static sched_task *ready_tail;
+static sched_task *wheel[SCHED_WHEEL_SLOTS];
+static uint32_t    wheel_time; // everything due before this has been expired
+
+// all list helpers run with the port lock held
+
+static void ready_push(sched_task *t) {
+  t->next  = NULL;
+  t->state = SCHED_READY;
+  if (ready_tail) {
+    ready_tail->next = t;
+  } else {
+    ready_head = t;
+  }
+  ready_tail = t;
+}
+
+static sched_task *ready_pop(void) {
+  sched_task *t = ready_head;
+  if (t) {
+    ready_head = t->next;
+    if (!ready_head) {
+      ready_tail = NULL;
+    }
+    t->state = SCHED_IDLE;
+  }
+  return t;
+}
+
+static void wheel_insert(sched_task *t) {
+  sched_task **slot = &wheel[SCHED_SLOT_OF(t->deadline)];
+  t->next           = *slot;
+  *slot             = t;
+  t->state          = SCHED_DELAYED;
+}
+
+static void wheel_remove(sched_task *t) {
+  for (sched_task **p = &wheel[SCHED_SLOT_OF(t->deadline)]; *p;
+       p = &(*p)->next) {
+    if (*p == t) {
+      *p       = t->next;
+      t->state = SCHED_IDLE;
+      return;
+    }
+  }
+}
+
+static void unlink(sched_task *t) {
+  if (t->state == SCHED_DELAYED) {
+    wheel_remove(t);
+  } else if (t->state == SCHED_READY) {
+    sched_task **p = &ready_head;
+    sched_task  *prev = NULL;
+    while (*p != t) {
+      prev = *p;
+      p    = &(*p)->next;
+    }
+    *p = t->next;
+    if (ready_tail == t) {
+      ready_tail = prev;
+    }
+    t->state = SCHED_IDLE;
+  }
+}
+
+// move every task due at now from the wheel to the ready list
+static void wheel_expire(uint32_t now) {
+  uint32_t slots = ((now >> SCHED_SLOT_SHIFT) -
+                    (wheel_time >> SCHED_SLOT_SHIFT)) + 1;
+  uint32_t slot  = SCHED_SLOT_OF(wheel_time);
+
+  if (slots > SCHED_WHEEL_SLOTS) {
+    slots = SCHED_WHEEL_SLOTS;
+  }
+  for (; slots > 0; slots--, slot = (slot + 1) & (SCHED_WHEEL_SLOTS - 1)) {
+    sched_task **p = &wheel[slot];
+    while (*p) {
+      sched_task *t = *p;
+      if ((int32_t)(t->deadline - now) <= 0) {
+        *p = t->next;
+        ready_push(t);
+      } else {
+        p = &t->next; // a later turn of the wheel
+      }
+    }
+  }
+  wheel_time = now;
+}
+
+// earliest deadline on the wheel, walking slots in time order so the search
+// usually stops at the first occupied slot
+static bool wheel_next(uint32_t now, uint32_t *deadline) {
+  uint32_t best  = UINT32_MAX;
+  uint32_t slot  = SCHED_SLOT_OF(now);
+  uint32_t ahead = SCHED_SLOT_TICKS - (now & (SCHED_SLOT_TICKS - 1));
+  bool     found = false;
+
+  for (uint32_t i = 0; i < SCHED_WHEEL_SLOTS; i++) {
+    for (sched_task *t = wheel[slot]; t; t = t->next) {
+      uint32_t d = t->deadline - now;
+      if (d < best) {
+        best  = d;
+        found = true;
+      }
+    }
+    // nothing in a later slot can beat a deadline inside this one
+    if (found && best < ahead) {
+      break;
+    }
+    slot   = (slot + 1) & (SCHED_WHEEL_SLOTS - 1);
+    ahead += SCHED_SLOT_TICKS;
+  }
+
+  *deadline = now + best;
+  return found;
+}
+
+void sched_init(void) {
+  ready_head = ready_tail = NULL;
+  for (uint32_t i = 0; i < SCHED_WHEEL_SLOTS; i++) {
+    wheel[i] = NULL;
+  }
+  sched_port_init();
+  wheel_time = sched_port_now();
+}
+
+void sched_post(sched_task *t) {
+  uint32_t state = sched_port_lock();
+  if (t->state != SCHED_READY) {
+    unlink(t);
+    ready_push(t);
+  }
+  sched_port_unlock(state);
+}
+
+void sched_post_delayed(sched_task *t, uint32_t delay) {
+  uint32_t state = sched_port_lock();
+  unlink(t);
+  t->period   = 0;
+  t->deadline = sched_port_now() + delay;
+  wheel_insert(t);
+  sched_port_unlock(state);
+}
+
+void sched_post_periodic(sched_task *t, uint32_t period) {
+  uint32_t state = sched_port_lock();
+  unlink(t);
+  t->period   = period;
+  t->deadline = sched_port_now() + period;
+  wheel_insert(t);
+  sched_port_unlock(state);
+}
+
+void sched_cancel(sched_task *t) {
+  uint32_t state = sched_port_lock();
+  unlink(t);
+  t->period = 0;
+  sched_port_unlock(state);
+}
+
+bool sched_is_pending(const sched_task *t) { return t->state != SCHED_IDLE; }
+
+uint32_t sched_now(void) { return sched_port_now(); }
+
+bool sched_run_once(void) {
+  bool     ran   = false;
+  uint32_t state = sched_port_lock();
+  wheel_expire(sched_port_now());
+
+  for (sched_task *t = ready_pop(); t; t = ready_pop()) {
+    sched_port_unlock(state);
+    t->fn(t->arg);
+    ran   = true;
+    state = sched_port_lock();
+
+    // periodic tasks keep their phase unless they fell a whole period behind
+    if (t->period && t->state == SCHED_IDLE) {
+      uint32_t now  = sched_port_now();
+      t->deadline  += t->period;
+      if ((int32_t)(t->deadline - now) <= 0) {
+        t->deadline = now + t->period;
+      }
+      wheel_insert(t);
+    }
+  }
+
+  sched_port_unlock(state);
+  return ran;
+}
+
+void sched_run(void) {
+  while (1) {
+    if (sched_run_once()) {
+      continue;
+    }
+
+    uint32_t state = sched_port_lock();
+    if (!ready_head) {
+      uint32_t now = sched_port_now();
+      uint32_t deadline;
+      wheel_expire(now);
+      if (!ready_head) {
+        if (wheel_next(now, &deadline)) {
+          sched_port_arm(deadline);
+        } else {
+          sched_port_disarm();
+        }
+        sched_port_idle();
+      }
+    }
+    sched_port_unlock(state);
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Run-to-completion scheduler. Tasks are callbacks that are posted to run as
+// soon as possible (from tasks or ISRs) or after a delay. Delayed tasks sit
+// in a hashed timer wheel and the port timer is programmed for the next
+// deadline only, so nothing ticks while the CPU sleeps.
+//
+// The core has no hardware dependencies; everything target specific goes
+// through sched_port.h, so it builds on a host against a simulated clock.
+
+// time is counted in port ticks, 32768 per second on target
+#define SCHED_TICKS_PER_SEC 32768u
+#define SCHED_MS(ms)                                                           \
+  ((uint32_t)(((uint64_t)(ms) * SCHED_TICKS_PER_SEC) / 1000))
+
+// wheel of 64 slots of 512 ticks, one turn is one second
+#define SCHED_WHEEL_SLOTS 64
+#define SCHED_SLOT_SHIFT  9
+
+typedef void (*sched_fn)(void *arg);
+
+typedef struct sched_task {
+  sched_fn           fn;
+  void              *arg;
+  struct sched_task *next;
+  uint32_t           deadline;
+  uint32_t           period; // 0 for one-shot
+  uint8_t            state;
+} sched_task;
+
+#define SCHED_TASK_INIT(fn, arg) {(fn), (arg), 0, 0, 0, 0}
+
+void sched_init(void);
+// run as soon as possible, safe from ISRs; no-op if already queued to run
+void sched_post(sched_task *t);
+// run once after delay ticks, replacing any pending delay
+void sched_post_delayed(sched_task *t, uint32_t delay);
+// run every period ticks, first after one period
+void sched_post_periodic(sched_task *t, uint32_t period);
+void sched_cancel(sched_task *t);
+bool sched_is_pending(const sched_task *t);
+uint32_t sched_now(void);
+
+// runs everything due at the current time, returns false if nothing ran
+bool sched_run_once(void);
+// never returns, sleeps through the port while there is nothing to run
+void sched_run(void);
+
+#endif /* SCHED_H_ */
@@ -0,0 +1,98 @@
+#include "sched_port.h"
+#include "msp.h"
+#include "power.h"
+
+// TIMER_A0 free running on ACLK (REFO, 32768 Hz). The 16-bit counter is
+// extended by counting overflows and CCR1 is the one-shot wake-up alarm.
+
+static volatile uint16_t overflows;
+static bool              armed;
+static uint32_t          armed_deadline;
+
+// ACLK is asynchronous to MCLK, read until two samples agree
+static uint16_t read_counter(void) {
+  uint16_t a, b;
+  do {
+    a = TIMER_A0->R;
+    b = TIMER_A0->R;
+  } while (a != b);
+  return a;
+}
+
+void sched_port_init(void) {
+  CS->KEY  = CS_KEY_VAL;
+  CS->CTL1 = (CS->CTL1 & ~CS_CTL1_SELA_MASK) | CS_CTL1_SELA__REFOCLK;
+  CS->KEY  = 0;
+
+  overflows         = 0;
+  TIMER_A0->CCTL[1] = 0;
+  TIMER_A0->CTL     = TIMER_A_CTL_SSEL__ACLK | TIMER_A_CTL_MC__CONTINUOUS |
+                  TIMER_A_CTL_CLR | TIMER_A_CTL_IE;
+  NVIC_EnableIRQ(TA0_N_IRQn);
+  power_load_on(ENERGY_TIMER_ACLK);
+}
+
+uint32_t sched_port_now(void) {
+  uint32_t state = sched_port_lock();
+  uint16_t hi    = overflows;
+  uint16_t lo    = read_counter();
+  // wrapped but the overflow interrupt has not run yet
+  if ((TIMER_A0->CTL & TIMER_A_CTL_IFG) && lo < 0x8000) {
+    hi++;
+  }
+  sched_port_unlock(state);
+  return ((uint32_t)hi << 16) | lo;
+}
+
+void sched_port_arm(uint32_t deadline) {
+  // a deadline more than one counter turn away matches early, the idle loop
+  // then just finds nothing due and arms again
+  armed              = true;
+  armed_deadline     = deadline;
+  TIMER_A0->CCR[1]   = (uint16_t)deadline;
+  TIMER_A0->CCTL[1]  = TIMER_A_CCTLN_CCIE;
+  // the counter may already be past a close deadline, never wait a turn
+  if ((int32_t)(deadline - sched_port_now()) <= 1) {
+    TIMER_A0->CCTL[1] |= TIMER_A_CCTLN_CCIFG;
+  }
+}
+
+void sched_port_disarm(void) {
+  armed             = false;
+  TIMER_A0->CCTL[1] = 0;
+}
+
+uint32_t sched_port_lock(void) {
+  uint32_t state = __get_PRIMASK();
+  __disable_irq();
+  return state;
+}
+
+void sched_port_unlock(uint32_t state) { __set_PRIMASK(state); }
+
+void sched_port_idle(void) {
+  uint8_t mode =
+      power_select(armed, (int32_t)(armed_deadline - sched_port_now()));
+
+  if (mode == POWER_LPM4) {
+    // nothing waits on the time, stop it so that ACLK can stop too
+    TIMER_A0->CTL &= ~TIMER_A_CTL_MC_MASK;
+    power_load_off(ENERGY_TIMER_ACLK);
+    power_enter(mode);
+    power_load_on(ENERGY_TIMER_ACLK);
+    TIMER_A0->CTL |= TIMER_A_CTL_MC__CONTINUOUS;
+  } else {
+    power_enter(mode);
+  }
+}
+
+void TA0_N_IRQHandler(void) {
+  uint16_t iv;
+  while ((iv = TIMER_A0->IV) != 0) { // reading IV clears the flag it reports
+    if (iv == 0x0E) {                // overflow
+      overflows++;
+    } else if (iv == 0x02) {         // CCR1 alarm, waking up is all it does
+      TIMER_A0->CCTL[1] &= ~TIMER_A_CCTLN_CCIE;
+    }
+  }
+}
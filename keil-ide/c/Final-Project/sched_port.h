@@ -0,0 +1,23 @@
+#ifndef SCHED_PORT_H_
+#define SCHED_PORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// What the scheduler core needs from the target (or from a simulated clock
+// on a host)
+
+void     sched_port_init(void);
+// free running tick count, wraps at 32 bits
+uint32_t sched_port_now(void);
+// wake the idle loop at deadline; sched_port_disarm() cancels it
+void     sched_port_arm(uint32_t deadline);
+void     sched_port_disarm(void);
+// critical section around the ready list, returns the state to restore
+uint32_t sched_port_lock(void);
+void     sched_port_unlock(uint32_t state);
+// called inside sched_port_lock(); sleep until an interrupt is pending and
+// return with the lock still held. On target the mode is left to power.h.
+void     sched_port_idle(void);
+
+#endif /* SCHED_PORT_H_ */
@@ -1,50 +1,140 @@
 #include "uart_helper.h"
 #include "msp.h"
+#include "power.h"
+#include "sched.h"
 #include <ctype.h>
 #include <stdlib.h>
 
+// SMCLK is kept this long after the last byte, then the console dozes
+#define UART_AWAKE_MS 10000
+// from the wake-up edge, for the rest of that byte to go by
+#define UART_WAKE_MS 2
+
+static void doze_task(void *arg);
+static void wake_task(void *arg);
+
+static sched_task doze = SCHED_TASK_INIT(doze_task, 0);
+static sched_task wake = SCHED_TASK_INIT(wake_task, 0);
+static bool       dozing; // RX is with the port, SMCLK released
+
 void uart_init(void) {
   EUSCI_A0->CTLW0 |= 0X1;
   EUSCI_A0->MCTLW  = 0X0;
   EUSCI_A0->CTLW0 |= 0x80;
   EUSCI_A0->BRW    = 0x34;
   EUSCI_A0->CTLW0 &= ~0x01;
-  P1->SEL0        |= 0x0C;
-  P1->SEL1        &= ~0x0C;
+  // the console clocks from SMCLK, awake until uart_set_rx_notify()
+  power_require(POWER_NEED_SMCLK);
 }
 
 void uart_send_str(const char *str) {
   uint32_t i = 0;
+  power_load_on(ENERGY_UART);
   while (str[i] != '\0') {
     EUSCI_A0->TXBUF = str[i];
     while ((EUSCI_A0->IFG & 0x02) == 0) {}
     i++;
   }
+  // the last byte is still shifting out, SMCLK may stop once it is idle
+  while (EUSCI_A0->STATW & 0x01) {}
+  power_load_off(ENERGY_UART);
 }
-int16_t uart_get_char(void) {
-  uint8_t i = 0;
-  char    command[3]; // 'c\r\0'
-
-  while (1) {
-    if ((EUSCI_A0->IFG & 0x01) != 0) { // data in RX buffer
-      command[i]      = EUSCI_A0->RXBUF;
-      EUSCI_A0->TXBUF = command[i];          // echo
-      while ((EUSCI_A0->IFG & 0x02) == 0) {} // wait
-
-      if (command[i] == '\r') {
-        command[i] = '\0';
-        break;
-      } else {
-        i++;
-      }
+
+static void (*rx_notify)(void);
+static char    line[8];
+static uint8_t line_len;
+
+void uart_set_rx_notify(void (*fn)(void)) {
+  rx_notify     = fn;
+  EUSCI_A0->IE |= 0x01; // RX interrupt
+  NVIC_EnableIRQ(EUSCIA0_IRQn);
+  sched_post_delayed(&doze, SCHED_MS(UART_AWAKE_MS));
+}
+
+// Hands RX over to the port: a falling edge, the start bit of the next byte,
+// asks for SMCLK again
+static void doze_task(void *arg) {
+  uint32_t primask = __get_PRIMASK();
+
+  (void)arg;
+  // in the middle of a byte, or a line held low
+  if ((EUSCI_A0->STATW & 0x01) || !(P1->IN & UART_RX_PIN)) {
+    sched_post_delayed(&doze, SCHED_MS(UART_AWAKE_MS));
+    return;
+  }
+
+  __disable_irq();
+  dozing        = true;
+  EUSCI_A0->IE &= ~0x01; // whatever the UART makes of a pin it lost
+  P1->SEL0     &= ~UART_RX_PIN;
+  P1->IES      |= UART_RX_PIN;
+  P1->IFG      &= ~UART_RX_PIN;
+  P1->IE       |= UART_RX_PIN;
+  power_release(POWER_NEED_SMCLK);
+  // a start bit that came before the enable left no edge
+  if (!(P1->IN & UART_RX_PIN)) {
+    uart_rx_edge();
+  }
+  __set_PRIMASK(primask);
+}
+
+void uart_rx_edge(void) {
+  P1->IE  &= ~UART_RX_PIN;
+  P1->IFG &= ~UART_RX_PIN;
+  power_require(POWER_NEED_SMCLK);
+  sched_post_delayed(&wake, SCHED_MS(UART_WAKE_MS));
+}
+
+// the line is idle again, give it back to the UART
+static void wake_task(void *arg) {
+  (void)arg;
+  P1->SEL0 |= UART_RX_PIN;
+  while (EUSCI_A0->IFG & 0x01) {
+    (void)EUSCI_A0->RXBUF;
+  }
+  dozing        = false;
+  EUSCI_A0->IE |= 0x01;
+  sched_post_delayed(&doze, SCHED_MS(UART_AWAKE_MS));
+}
+
+// hand RX to the task, it takes the bytes and turns the interrupt back on
+void EUSCIA0_IRQHandler(void) {
+  if (EUSCI_A0->IFG & EUSCI_A0->IE & 0x01) {
+    EUSCI_A0->IE &= ~0x01;
+    if (rx_notify) {
+      rx_notify();
     }
   }
+}
+
+bool uart_poll_line(int16_t *value) {
+  while (EUSCI_A0->IFG & 0x01) {
+    char c          = EUSCI_A0->RXBUF;
+    EUSCI_A0->TXBUF = c;                   // echo
+    while ((EUSCI_A0->IFG & 0x02) == 0) {} // wait
+    sched_post_delayed(&doze, SCHED_MS(UART_AWAKE_MS));
 
-  if (!isdigit(command[0])) { // check if the character is a digit
-    uart_send_str("\n\rError: Non-numeric input\r\n");
-    return -1;
+    if (c != '\r') {
+      if (line_len < sizeof(line) - 1) {
+        line[line_len++] = c;
+      }
+      continue;
+    }
+
+    line[line_len] = '\0';
+    line_len       = 0;
+    if (!isdigit(line[0])) { // check if the character is a digit
+      uart_send_str("\n\rError: Non-numeric input\r\n");
+      *value = -1;
+    } else {
+      uart_send_str("\n\r");
+      *value = atoi(line);
+    }
+    return true;
   }
 
-  uart_send_str("\n\r");
-  return atoi(command);
-}
\ No newline at end of file
+  if (!dozing) {
+    EUSCI_A0->IE |= 0x01; // anything arriving from here on interrupts again
+  }
+  return false;
+}
@@ -1,10 +1,26 @@
 #ifndef UART_HELPER_H_
 #define UART_HELPER_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
-void    uart_init(void);
-void    uart_send_str(const char *);
-int16_t uart_get_char(void);
+// RX on P1.2. The console keeps SMCLK only while it is in use: 10 s after
+// the last byte it dozes, handing P1.2 to the port interrupt so the CPU can
+// sleep in LPM3. The start bit of the next byte wakes it; that byte and
+// anything else typed in the next 2 ms are dropped, so the first key
+// pressed after a quiet spell only wakes the console.
+#define UART_RX_PIN 0x04 // BIT2
+
+void uart_init(void);
+void uart_send_str(const char *);
+
+// non-blocking input: fn runs from the RX interrupt when a byte arrives, the
+// task it wakes then calls uart_poll_line() until it returns false
+void uart_set_rx_notify(void (*fn)(void));
+// true once a line is complete, *value its number, or -1 if it does not
+// start with a digit
+bool uart_poll_line(int16_t *value);
+// the falling edge on UART_RX_PIN while dozing, from the port 1 interrupt
+void uart_rx_edge(void);
 
 #endif /* UART_HELPER_H_ */
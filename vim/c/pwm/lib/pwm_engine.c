@@ -0,0 +1,301 @@
+#include "pwm_engine.h"
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// the timer and DMA levels of the interrupt priority plan
+#define PWM_TIMER_PRIORITY 0x60
+#define PWM_DMA_PRIORITY   0x40
+
+typedef struct {
+  uint16_t period;  // 0 until pwm_init()
+  uint8_t  pending; // bit n set: duty[n] waits for the next period
+  uint16_t duty[PWM_LAST_CHANNEL + 1];
+  // DMA stream
+  const uint16_t *table;
+  uint16_t        length;
+  uint8_t         channel;
+  bool            repeat;
+  volatile bool   streaming;
+} pwm_timer;
+
+static const uint32_t bases[PWM_TIMERS] = {TIMER_A0_BASE, TIMER_A1_BASE,
+                                           TIMER_A2_BASE, TIMER_A3_BASE};
+static const IRQn_Type ccr0_irqs[PWM_TIMERS] = {TA0_0_IRQn, TA1_0_IRQn,
+                                                TA2_0_IRQn, TA3_0_IRQn};
+// the DMA channel each timer's CCR0 can trigger is 2 * timer
+static const uint32_t dma_triggers[PWM_TIMERS] = {
+    DMA_CH0_TIMERA0CCR0, DMA_CH2_TIMERA1CCR0, DMA_CH4_TIMERA2CCR0,
+    DMA_CH6_TIMERA3CCR0};
+
+static pwm_timer timers[PWM_TIMERS];
+
+static DMA_ControlTable dma_table[32] __attribute__((aligned(1024)));
+
+#ifdef PWM_MODEL
+// the host model has to see every output mode change, however brief
+void model_mode_written(Timer_A_Type *r, uint8_t channel);
+#endif
+
+static uint32_t lock(void) {
+  uint32_t state = __get_PRIMASK();
+  __disable_irq();
+  return state;
+}
+
+static void unlock(uint32_t state) { __set_PRIMASK(state); }
+
+static bool valid(uint8_t timer, uint8_t channel) {
+  return timer < PWM_TIMERS && timers[timer].period &&
+         channel >= PWM_FIRST_CHANNEL && channel <= PWM_LAST_CHANNEL;
+}
+
+static void set_mode(Timer_A_Type *r, uint8_t channel, uint16_t mode) {
+  r->CCTL[channel] = mode;
+#ifdef PWM_MODEL
+  model_mode_written(r, channel);
+#endif
+}
+
+static uint16_t counter(Timer_A_Type *r) {
+  uint16_t value;
+  // the timer clock may not be MCLK, read until two agree
+  do {
+    value = r->R;
+  } while (value != r->R);
+  return value;
+}
+
+// Runs at the start of a period, some way into it. The period starts as the
+// counter counts to CCR0, which it then holds for a whole timer clock, many
+// CPU cycles on a divided clock. Reset/set mode sets the output there and
+// resets it as the counter counts to CCRn.
+static void latch(Timer_A_Type *r, uint8_t channel, uint32_t duty,
+                  uint32_t period) {
+  uint16_t compare;
+
+  if (duty == 0) {
+    // low from here, cutting short a pulse already started
+    set_mode(r, channel, TIMER_A_OUTPUTMODE_OUTBITVALUE);
+    return;
+  }
+
+  // a compare value past CCR0 never resets the output
+  compare         = duty >= period ? period : duty - 1;
+  r->CCR[channel] = compare;
+
+  if ((r->CCTL[channel] & TIMER_A_CCTLN_OUTMOD_MASK) !=
+      TIMER_A_OUTPUTMODE_RESET_SET) {
+    // was held low, stays low until the next period sets it
+    set_mode(r, channel, TIMER_A_OUTPUTMODE_RESET_SET);
+  } else {
+    // the counter may have passed the new value before it was written and
+    // the reset never come, make it now; a no-op if the old value reset it.
+    // Still at CCR0 it has passed nothing, the pulse has only just been set.
+    uint16_t value = counter(r);
+    if (value >= compare && value != r->CCR[0]) {
+      set_mode(r, channel, TIMER_A_OUTPUTMODE_OUTBITVALUE);
+      set_mode(r, channel, TIMER_A_OUTPUTMODE_RESET_SET);
+    }
+  }
+}
+
+static void ccr0_handler(uint8_t timer) {
+  Timer_A_Type *r = TIMER_A_CMSIS(bases[timer]);
+  pwm_timer    *t = &timers[timer];
+  uint8_t       pending;
+
+  r->CCTL[0] &= ~(TIMER_A_CCTLN_CCIE | TIMER_A_CCTLN_CCIFG);
+  pending    = t->pending;
+  t->pending = 0;
+
+  for (uint8_t channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+       channel++) {
+    if (pending & (1u << channel)) {
+      latch(r, channel, t->duty[channel], t->period);
+    }
+  }
+}
+
+void TA0_0_IRQHandler(void) { ccr0_handler(0); }
+void TA1_0_IRQHandler(void) { ccr0_handler(1); }
+void TA2_0_IRQHandler(void) { ccr0_handler(2); }
+void TA3_0_IRQHandler(void) { ccr0_handler(3); }
+
+void pwm_init(uint8_t timer, uint_fast16_t clock_source, uint_fast16_t divider,
+              uint32_t period) {
+  if (timer >= PWM_TIMERS || period < 2 || period > 0xFFFF) {
+    return;
+  }
+
+  Timer_A_UpModeConfig config = {
+      clock_source,
+      divider,
+      period - 1,
+      TIMER_A_TAIE_INTERRUPT_DISABLE,
+      TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE,
+      TIMER_A_DO_CLEAR,
+  };
+  Timer_A_Type *r = TIMER_A_CMSIS(bases[timer]);
+
+  pwm_stream_stop(timer);
+  Timer_A_stopTimer(bases[timer]);
+
+  timers[timer].period  = period;
+  timers[timer].pending = 0;
+  for (uint8_t channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+       channel++) {
+    set_mode(r, channel, TIMER_A_OUTPUTMODE_OUTBITVALUE);
+  }
+
+  Timer_A_configureUpMode(bases[timer], &config);
+  NVIC_SetPriority(ccr0_irqs[timer],
+                   PWM_TIMER_PRIORITY >> (8 - __NVIC_PRIO_BITS));
+  NVIC_EnableIRQ(ccr0_irqs[timer]);
+  Timer_A_startCounter(bases[timer], TIMER_A_UP_MODE);
+}
+
+void pwm_enable(uint8_t timer, uint8_t channel, uint32_t duty) {
+  pwm_set_duty(timer, channel, duty);
+}
+
+void pwm_disable(uint8_t timer, uint8_t channel) {
+  if (!valid(timer, channel)) {
+    return;
+  }
+
+  uint32_t state = lock();
+  timers[timer].pending &= ~(1u << channel);
+  set_mode(TIMER_A_CMSIS(bases[timer]), channel,
+           TIMER_A_OUTPUTMODE_OUTBITVALUE);
+  unlock(state);
+}
+
+void pwm_set_duty(uint8_t timer, uint8_t channel, uint32_t duty) {
+  if (!valid(timer, channel)) {
+    return;
+  }
+
+  Timer_A_Type *r = TIMER_A_CMSIS(bases[timer]);
+  pwm_timer    *t = &timers[timer];
+
+  if (duty > t->period) {
+    duty = t->period;
+  }
+
+  uint32_t state   = lock();
+  t->duty[channel] = duty;
+  if (!t->pending) {
+    // a flag left over from an earlier period would latch right away
+    r->CCTL[0] = (r->CCTL[0] & ~TIMER_A_CCTLN_CCIFG) | TIMER_A_CCTLN_CCIE;
+  }
+  t->pending |= 1u << channel;
+  unlock(state);
+}
+
+bool pwm_duty_pending(uint8_t timer) {
+  return timer < PWM_TIMERS && timers[timer].pending;
+}
+
+static void dma_arm(uint8_t timer, uint32_t structure, uint32_t mode) {
+  pwm_timer *t = &timers[timer];
+
+  DMA_setChannelControl(structure | (2 * timer),
+                        UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_NONE |
+                            UDMA_ARB_1);
+  DMA_setChannelTransfer(structure | (2 * timer), mode, (void *)t->table,
+                         (void *)&TIMER_A_CMSIS(bases[timer])->CCR[t->channel],
+                         t->length);
+}
+
+void pwm_stream_start(uint8_t timer, uint8_t channel, const uint16_t *table,
+                      uint16_t length, bool repeat) {
+  if (!valid(timer, channel) || length == 0 ||
+      length > PWM_STREAM_MAX_LENGTH) {
+    return;
+  }
+
+  Timer_A_Type *r           = TIMER_A_CMSIS(bases[timer]);
+  pwm_timer    *t           = &timers[timer];
+  uint32_t      dma_channel = 2 * timer;
+
+  pwm_stream_stop(timer);
+
+  // the stream owns the compare register, and it only counts in reset/set
+  // mode; held low until the first period the DMA writes
+  uint32_t state = lock();
+  t->pending &= ~(1u << channel);
+  if ((r->CCTL[channel] & TIMER_A_CCTLN_OUTMOD_MASK) !=
+      TIMER_A_OUTPUTMODE_RESET_SET) {
+    r->CCR[channel] = table[0];
+    set_mode(r, channel, TIMER_A_OUTPUTMODE_RESET_SET);
+  }
+  unlock(state);
+
+  if (!DMA_getControlBase()) {
+    DMA_enableModule();
+    DMA_setControlBase(dma_table);
+  }
+  NVIC_SetPriority(DMA_INT0_IRQn, PWM_DMA_PRIORITY >> (8 - __NVIC_PRIO_BITS));
+  NVIC_EnableIRQ(DMA_INT0_IRQn);
+
+  t->table   = table;
+  t->length  = length;
+  t->channel = channel;
+  t->repeat  = repeat;
+
+  DMA_assignChannel(dma_triggers[timer]);
+  DMA_disableChannelAttribute(dma_channel, UDMA_ATTR_ALL);
+  if (repeat) {
+    // primary and alternate both cover the whole table, the interrupt
+    // rearms each as the other takes over
+    dma_arm(timer, UDMA_PRI_SELECT, UDMA_MODE_PINGPONG);
+    dma_arm(timer, UDMA_ALT_SELECT, UDMA_MODE_PINGPONG);
+  } else {
+    dma_arm(timer, UDMA_PRI_SELECT, UDMA_MODE_BASIC);
+  }
+  DMA_clearInterruptFlag(dma_channel);
+  t->streaming = true;
+  DMA_enableChannel(dma_channel);
+}
+
+void pwm_stream_stop(uint8_t timer) {
+  if (timer >= PWM_TIMERS || !timers[timer].streaming) {
+    return;
+  }
+
+  DMA_disableChannel(2 * timer);
+  DMA_clearInterruptFlag(2 * timer);
+  timers[timer].streaming = false;
+}
+
+bool pwm_stream_running(uint8_t timer) {
+  return timer < PWM_TIMERS && timers[timer].streaming;
+}
+
+void DMA_INT0_IRQHandler(void) {
+  uint32_t status = DMA_getInterruptStatus();
+
+  for (uint8_t timer = 0; timer < PWM_TIMERS; timer++) {
+    pwm_timer *t           = &timers[timer];
+    uint32_t   dma_channel = 2 * timer;
+
+    if (!t->streaming || !(status & (1u << dma_channel))) {
+      continue;
+    }
+
+    DMA_clearInterruptFlag(dma_channel);
+    if (!t->repeat) {
+      t->streaming = false;
+      continue;
+    }
+    if (DMA_getChannelMode(UDMA_PRI_SELECT | dma_channel) == UDMA_MODE_STOP) {
+      dma_arm(timer, UDMA_PRI_SELECT, UDMA_MODE_PINGPONG);
+    }
+    if (DMA_getChannelMode(UDMA_ALT_SELECT | dma_channel) == UDMA_MODE_STOP) {
+      dma_arm(timer, UDMA_ALT_SELECT, UDMA_MODE_PINGPONG);
+    }
+    // both ran out before this interrupt, the channel stopped
+    if (!DMA_isChannelEnabled(dma_channel)) {
+      DMA_enableChannel(dma_channel);
+    }
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ * PWM on all four Timer_A instances
+ *
+ * Each timer counts up with CCR0 setting the period and drives up to four
+ * outputs, CCR1 to CCR4, in reset/set mode: high from the start of each
+ * period for duty timer clocks. Routing the TAx.n pins to the outputs is left
+ * to the caller.
+ *
+ * Timer_A has no shadow registers, and a compare value written while the
+ * counter is between the old and the new one makes that period glitch: a
+ * missed reset leaves the output high for the whole period. pwm_set_duty()
+ * therefore only records the new duty; the CCR0 interrupt writes it at the
+ * start of the next period, so each period runs at either the old or the new
+ * duty. A duty shorter than the interrupt latency cannot be latched in time;
+ * that one period is cut short at the latch instead of running to the end.
+ *
+ * pwm_stream_start() goes further and has the DMA write a table of compare
+ * values into one channel per timer, one per period, triggered by CCR0 with
+ * no CPU involvement. Repeating tables cost one DMA interrupt per pass.
+ *
+ * pwm_engine.c defines TA0_0_IRQHandler to TA3_0_IRQHandler, at the timer
+ * level of the interrupt priority plan (0x60), and DMA_INT0_IRQHandler at the
+ * DMA level (0x40). It sets up the DMA control table unless something else
+ * already has.
+ */
+#ifndef PWM_ENGINE_H_
+#define PWM_ENGINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PWM_TIMERS        4
+#define PWM_FIRST_CHANNEL 1
+#define PWM_LAST_CHANNEL  4
+
+// the most compare values one DMA pass can write
+#define PWM_STREAM_MAX_LENGTH 1024
+
+// stream table entry for a duty of 1 to period - 1 timer clocks
+#define PWM_STREAM_COMPARE(duty) ((uint16_t)((duty) - 1))
+
+// timer 0 to 3 counts up from clock_source divided by divider (driverlib
+// TIMER_A_CLOCKSOURCE_ and TIMER_A_CLOCKSOURCE_DIVIDER_ values), period timer
+// clocks, 2 to 65535, per period. All its outputs start low.
+void pwm_init(uint8_t timer, uint_fast16_t clock_source, uint_fast16_t divider,
+              uint32_t period);
+// starts driving channel 1 to 4 of timer, at duty from the next period on
+void pwm_enable(uint8_t timer, uint8_t channel, uint32_t duty);
+// drives channel low from now on
+void pwm_disable(uint8_t timer, uint8_t channel);
+
+// duty 0 to period timer clocks high per period, from the next period on;
+// the last call before the period ends wins
+void pwm_set_duty(uint8_t timer, uint8_t channel, uint32_t duty);
+// true until the next period boundary has latched the pwm_set_duty() calls
+bool pwm_duty_pending(uint8_t timer);
+
+// has the DMA write table[0], table[1], ... into channel's compare register
+// at the start of each period, looping over it if repeat. Entries are
+// PWM_STREAM_COMPARE() values, length 1 to PWM_STREAM_MAX_LENGTH. Replaces any
+// stream on the same timer, and pwm_set_duty() on the channel has no lasting
+// effect while it runs. Without repeat the last entry stays in force.
+void pwm_stream_start(uint8_t timer, uint8_t channel, const uint16_t *table,
+                      uint16_t length, bool repeat);
+// stops the DMA, the last value written stays in force
+void pwm_stream_stop(uint8_t timer);
+bool pwm_stream_running(uint8_t timer);
+
+#endif /* PWM_ENGINE_H_ */
@@ -0,0 +1,557 @@
+/*
+ * Host model of lib/pwm_engine.c
+ *
+ * Runs the engine against simulated Timer_A and DMA registers, one CPU
+ * cycle at a time, and checks every period of every channel against the duty
+ * asked for. Build and run with `make model`.
+ *
+ * The simulated timer follows the Timer_A chapter of the reference manual. It
+ * counts at SMCLK, taken to be MCLK, divided by 1, 8 or 64, or at ACLK, so
+ * that the CPU sees the counter hold each value for several cycles. In up
+ * mode the counter counts to CCR0, holds it for one clock and counts from
+ * there to 0. A period starts as it counts to CCR0: that sets CCIFG and, in
+ * reset/set mode, the output, which is reset as it counts to CCRn, so compare
+ * value c gives c + 1 clocks high; in mode 0 the output follows OUT at once.
+ * CCIFG triggers the DMA, whose write lands within that first clock, and the
+ * CCR0 interrupt, which runs up to MAX_LATENCY timer clocks later, at any CPU
+ * cycle in between.
+ *
+ * Checked for each period:
+ *  - the output is a single pulse starting with the period, never split
+ *  - without a latch in the period, the pulse is the duty in force
+ *  - with one, it is the old duty if that pulse had already ended, the new
+ *    one if the latch came in time for it, and cut at the latch otherwise
+ *  - streamed channels follow their table, looping or holding the last entry
+ */
+#include "pwm_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define MAX_LATENCY     12
+#define MAX_DMA_LATENCY 100
+#define MIN_PERIOD      40
+#define MAX_PERIOD      300
+#define ACLK_CYCLES     92 // MCLK at its 3 MHz default over 32768 Hz
+
+#define CHANNELS (PWM_LAST_CHANNEL + 1)
+
+void TA0_0_IRQHandler(void);
+void TA1_0_IRQHandler(void);
+void TA2_0_IRQHandler(void);
+void TA3_0_IRQHandler(void);
+void DMA_INT0_IRQHandler(void);
+
+static void (*const ccr0_handlers[PWM_TIMERS])(void) = {
+    TA0_0_IRQHandler, TA1_0_IRQHandler, TA2_0_IRQHandler, TA3_0_IRQHandler};
+
+// simulated hardware
+
+Timer_A_Type model_timers[4];
+
+static uint64_t now;
+static bool     running[PWM_TIMERS];
+static uint32_t cycles_per_clock[PWM_TIMERS];
+static bool     out[PWM_TIMERS][CHANNELS];
+static uint64_t flag_time[PWM_TIMERS];
+static uint32_t latency[PWM_TIMERS];
+static bool     nvic_enabled[64];
+static uint32_t primask;
+
+typedef struct {
+  const uint16_t    *src;
+  volatile uint16_t *dst;
+  uint32_t           remaining;
+  uint32_t           mode;
+} dma_structure;
+
+static struct {
+  dma_structure structures[2];
+  bool          enabled;
+  bool          alternate;
+  uint32_t      mapping;
+  bool          request;
+} dma[8];
+
+static void    *dma_base;
+static uint32_t dma_flags;
+static uint64_t dma_flag_time;
+static uint32_t dma_latency;
+
+// checking
+
+#define STREAM_NONE  0
+#define STREAM_FIRST 1 // started, the DMA writes from the next period
+#define STREAM_ON    2
+
+typedef struct {
+  // the period in progress
+  uint32_t high;
+  bool     seen_low;
+  bool     split;
+  // duties
+  uint32_t in_force;
+  uint32_t requested;
+  bool     latched;
+  uint32_t latched_pulse;
+  uint32_t next_in_force;
+  // stream
+  int             stream;
+  const uint16_t *table;
+  uint32_t        length;
+  uint32_t        entry;
+  bool            repeat;
+} channel_check;
+
+static channel_check checks[PWM_TIMERS][CHANNELS];
+static uint8_t       model_pending[PWM_TIMERS];
+static uint32_t      periods[PWM_TIMERS];
+
+static uint64_t periods_checked, latches, cut_latches, stream_periods;
+static uint64_t errors;
+
+// driverlib stand-ins
+
+void Timer_A_configureUpMode(uint32_t                    timer,
+                             const Timer_A_UpModeConfig *config) {
+  Timer_A_Type *r = TIMER_A_CMSIS(timer);
+  r->CTL          = config->clockSource;
+  cycles_per_clock[timer] = config->clockSource == TIMER_A_CLOCKSOURCE_ACLK
+                                ? ACLK_CYCLES
+                                : config->clockSourceDivider;
+  r->CCR[0]       = config->timerPeriod;
+  r->CCTL[0] &= ~TIMER_A_CCTLN_CCIE;
+  if (config->timerClear) {
+    r->R = 0;
+  }
+}
+
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode) {
+  TIMER_A_CMSIS(timer)->CTL |= timerMode;
+  running[timer] = true;
+}
+
+void Timer_A_stopTimer(uint32_t timer) {
+  TIMER_A_CMSIS(timer)->CTL &= ~TIMER_A_CTL_MC_MASK;
+  running[timer] = false;
+}
+
+void  DMA_enableModule(void) {}
+void  DMA_setControlBase(void *controlTable) { dma_base = controlTable; }
+void *DMA_getControlBase(void) { return dma_base; }
+
+void DMA_assignChannel(uint32_t mapping) {
+  dma[mapping & 7].mapping = mapping;
+}
+
+void DMA_disableChannelAttribute(uint32_t channelNum, uint32_t attr) {
+  if (attr == UDMA_ATTR_ALL) {
+    dma[channelNum].alternate = false;
+  }
+}
+
+void DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control) {
+  if (control !=
+      (UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_NONE | UDMA_ARB_1)) {
+    printf("unexpected DMA control %08x\n", (unsigned)control);
+    errors++;
+  }
+  (void)channelStructIndex;
+}
+
+void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode,
+                            void *srcAddr, void *dstAddr,
+                            uint32_t transferSize) {
+  dma_structure *s =
+      &dma[channelStructIndex & 7].structures[channelStructIndex >> 3 & 1];
+  s->src       = srcAddr;
+  s->dst       = dstAddr;
+  s->remaining = transferSize;
+  s->mode      = mode;
+}
+
+uint32_t DMA_getChannelMode(uint32_t channelStructIndex) {
+  return dma[channelStructIndex & 7]
+      .structures[channelStructIndex >> 3 & 1]
+      .mode;
+}
+
+void DMA_enableChannel(uint32_t channelNum) { dma[channelNum].enabled = true; }
+void DMA_disableChannel(uint32_t channelNum) {
+  dma[channelNum].enabled = false;
+}
+bool DMA_isChannelEnabled(uint32_t channelNum) {
+  return dma[channelNum].enabled;
+}
+uint32_t DMA_getInterruptStatus(void) { return dma_flags; }
+void DMA_clearInterruptFlag(uint32_t channel) { dma_flags &= ~(1u << channel); }
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) {
+  (void)irq;
+  (void)priority;
+}
+void     NVIC_EnableIRQ(IRQn_Type irq) { nvic_enabled[irq] = true; }
+uint32_t __get_PRIMASK(void) { return primask; }
+void     __set_PRIMASK(uint32_t state) { primask = state; }
+void     __disable_irq(void) { primask = 1; }
+
+// called by the engine for every output mode write
+void model_mode_written(Timer_A_Type *r, uint8_t channel) {
+  int timer = r - model_timers;
+  if ((r->CCTL[channel] & TIMER_A_CCTLN_OUTMOD_MASK) ==
+      TIMER_A_OUTPUTMODE_OUTBITVALUE) {
+    out[timer][channel] = r->CCTL[channel] & TIMER_A_CCTLN_OUT;
+  }
+}
+
+// simulation
+
+static uint32_t period_of(int timer) {
+  return model_timers[timer].CCR[0] + 1u;
+}
+
+static bool level(int timer, int channel) {
+  Timer_A_Type *r = &model_timers[timer];
+  if ((r->CCTL[channel] & TIMER_A_CCTLN_OUTMOD_MASK) ==
+      TIMER_A_OUTPUTMODE_OUTBITVALUE) {
+    return r->CCTL[channel] & TIMER_A_CCTLN_OUT;
+  }
+  return out[timer][channel];
+}
+
+static void sample(int timer, int channel) {
+  channel_check *c = &checks[timer][channel];
+  if (level(timer, channel)) {
+    if (c->seen_low) {
+      c->split = true;
+    }
+    c->high++;
+  } else {
+    c->seen_low = true;
+  }
+}
+
+static void fail(int timer, int channel, const char *what, uint32_t got,
+                 uint32_t expected) {
+  if (errors < 20) {
+    printf("cycle %llu timer %d channel %d period %u: %s, %u high, expected "
+           "%u\n",
+           (unsigned long long)now, timer, channel, periods[timer], what, got,
+           expected);
+  }
+  errors++;
+}
+
+static void end_period(int timer, int channel) {
+  channel_check *c = &checks[timer][channel];
+  uint32_t       expected;
+
+  if (c->stream == STREAM_ON) {
+    expected = c->table[c->entry] + 1u;
+    if (c->entry + 1 < c->length) {
+      c->entry++;
+    } else if (c->repeat) {
+      c->entry = 0;
+    }
+    stream_periods++;
+  } else {
+    expected = c->latched ? c->latched_pulse : c->in_force;
+    if (c->latched) {
+      c->in_force = c->next_in_force;
+      c->latched  = false;
+    }
+    if (c->stream == STREAM_FIRST) {
+      c->stream = STREAM_ON;
+      c->entry  = 0;
+    }
+  }
+
+  if (c->split) {
+    fail(timer, channel, "split pulse", c->high, expected);
+  } else if (c->high != expected) {
+    fail(timer, channel, "wrong pulse", c->high, expected);
+  }
+  periods_checked++;
+
+  c->high     = 0;
+  c->seen_low = false;
+  c->split    = false;
+}
+
+// the pulse of the period in which a latch t clocks into it moves a channel
+// from duty old to duty new; see the comment at the top
+static uint32_t latched_pulse(uint32_t old, uint32_t new, uint32_t t,
+                              uint32_t period) {
+  if (old == 0) {
+    return 0;
+  }
+  if (old < period && old <= t) {
+    return old;
+  }
+  if (new == 0) {
+    return t;
+  }
+  if (new >= period) {
+    return period;
+  }
+  return new > t ? new : t;
+}
+
+static void clock_timer(int timer) {
+  Timer_A_Type *r = &model_timers[timer];
+
+  if (!running[timer]) {
+    return;
+  }
+
+  uint16_t next  = r->R == r->CCR[0] ? 0 : r->R + 1;
+  bool     start = next == r->CCR[0];
+
+  // the level each channel held through the clock now ending
+  for (int channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+       channel++) {
+    sample(timer, channel);
+  }
+
+  if (start) {
+    for (int channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+         channel++) {
+      end_period(timer, channel);
+    }
+    periods[timer]++;
+  }
+
+  for (int channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+       channel++) {
+    if ((r->CCTL[channel] & TIMER_A_CCTLN_OUTMOD_MASK) !=
+        TIMER_A_OUTPUTMODE_RESET_SET) {
+      continue;
+    }
+    if (next == r->CCR[channel]) {
+      out[timer][channel] = false;
+    }
+    if (start) {
+      out[timer][channel] = true;
+    }
+  }
+
+  r->R = next;
+
+  if (start) {
+    r->CCTL[0] |= TIMER_A_CCTLN_CCIFG;
+    flag_time[timer] = now;
+    latency[timer]   = 1 + rand() % (MAX_LATENCY * cycles_per_clock[timer]);
+    if (dma[2 * timer].mapping == (0x06000000u | (2u * timer))) {
+      dma[2 * timer].request = true;
+    }
+  }
+}
+
+static void run_dma(void) {
+  for (int channel = 0; channel < 8; channel++) {
+    if (!dma[channel].request) {
+      continue;
+    }
+    dma[channel].request = false;
+    if (!dma[channel].enabled) {
+      continue;
+    }
+
+    dma_structure *s = &dma[channel].structures[dma[channel].alternate];
+    if (s->mode == UDMA_MODE_STOP) {
+      dma[channel].enabled = false;
+      continue;
+    }
+
+    *s->dst = *s->src++;
+    if (--s->remaining == 0) {
+      uint32_t mode = s->mode;
+      s->mode       = UDMA_MODE_STOP;
+      if (!dma_flags) {
+        dma_flag_time = now;
+        dma_latency   = 1 + rand() % MAX_DMA_LATENCY;
+      }
+      dma_flags |= 1u << channel;
+      if (mode == UDMA_MODE_PINGPONG) {
+        dma[channel].alternate = !dma[channel].alternate;
+      } else {
+        dma[channel].enabled = false;
+      }
+    }
+  }
+}
+
+static void run_interrupts(void) {
+  if (primask) {
+    return;
+  }
+
+  if (dma_flags && nvic_enabled[DMA_INT0_IRQn] &&
+      now - dma_flag_time >= dma_latency) {
+    DMA_INT0_IRQHandler();
+  }
+
+  for (int timer = 0; timer < PWM_TIMERS; timer++) {
+    Timer_A_Type  *r    = &model_timers[timer];
+    const uint16_t want = TIMER_A_CCTLN_CCIE | TIMER_A_CCTLN_CCIFG;
+
+    if ((r->CCTL[0] & want) != want ||
+        now - flag_time[timer] < latency[timer]) {
+      continue;
+    }
+
+    for (int channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+         channel++) {
+      channel_check *c = &checks[timer][channel];
+      if (!(model_pending[timer] & (1u << channel))) {
+        continue;
+      }
+      c->latched       = true;
+      // the counter holds CCR0 through the first clock of the period
+      c->latched_pulse = latched_pulse(c->in_force, c->requested,
+                                       r->R == r->CCR[0] ? 0 : r->R + 1u,
+                                       period_of(timer));
+      c->next_in_force = c->requested;
+      latches++;
+      if (c->latched_pulse != c->in_force &&
+          c->latched_pulse != c->requested) {
+        cut_latches++;
+      }
+    }
+    model_pending[timer] = 0;
+
+    ccr0_handlers[timer]();
+  }
+}
+
+static void clock(void) {
+  now++;
+  for (int timer = 0; timer < PWM_TIMERS; timer++) {
+    if (now % cycles_per_clock[timer] == 0) {
+      clock_timer(timer);
+    }
+  }
+  run_dma();
+  run_interrupts();
+}
+
+// test driver
+
+static uint32_t random_duty(uint32_t period) {
+  switch (rand() % 10) {
+  case 0:
+    return 0;
+  case 1:
+    return period;
+  case 2:
+    return period + 5; // clamped to period
+  case 3:
+    return 1 + rand() % (MAX_LATENCY + 2);
+  default:
+    return 1 + rand() % (period - 1);
+  }
+}
+
+static void set_duty(int timer, int channel, uint32_t duty) {
+  uint32_t period = period_of(timer);
+
+  pwm_set_duty(timer, channel, duty);
+  checks[timer][channel].requested = duty > period ? period : duty;
+  model_pending[timer] |= 1u << channel;
+}
+
+static void random_updates(uint64_t cycles, uint32_t one_in) {
+  for (uint64_t i = 0; i < cycles; i++) {
+    clock();
+    if (rand() % one_in) {
+      continue;
+    }
+    int timer   = rand() % PWM_TIMERS;
+    int channel = PWM_FIRST_CHANNEL + rand() % PWM_LAST_CHANNEL;
+    if (checks[timer][channel].stream != STREAM_NONE) {
+      continue;
+    }
+    set_duty(timer, channel, random_duty(period_of(timer)));
+  }
+}
+
+static void start_stream(int timer, int channel, const uint16_t *table,
+                         uint32_t length, bool repeat) {
+  channel_check *c = &checks[timer][channel];
+
+  pwm_stream_start(timer, channel, table, length, repeat);
+  model_pending[timer] &= ~(1u << channel);
+  c->stream = STREAM_FIRST;
+  c->table  = table;
+  c->length = length;
+  c->repeat = repeat;
+}
+
+static void stop_stream(int timer, int channel) {
+  channel_check *c = &checks[timer][channel];
+
+  pwm_stream_stop(timer);
+  c->in_force = c->stream == STREAM_ON ? c->table[c->entry] + 1u : c->in_force;
+  c->stream   = STREAM_NONE;
+}
+
+static void fill(uint16_t *table, uint32_t length, uint32_t period) {
+  for (uint32_t i = 0; i < length; i++) {
+    table[i] = PWM_STREAM_COMPARE(1 + rand() % (period - 1));
+  }
+}
+
+int main(void) {
+  static const uint16_t clocks[PWM_TIMERS][2] = {
+      {TIMER_A_CLOCKSOURCE_SMCLK, TIMER_A_CLOCKSOURCE_DIVIDER_1},
+      {TIMER_A_CLOCKSOURCE_SMCLK, TIMER_A_CLOCKSOURCE_DIVIDER_8},
+      {TIMER_A_CLOCKSOURCE_SMCLK, TIMER_A_CLOCKSOURCE_DIVIDER_64},
+      {TIMER_A_CLOCKSOURCE_ACLK, TIMER_A_CLOCKSOURCE_DIVIDER_1},
+  };
+  static uint16_t fade[37], once[20];
+
+  srand(432);
+
+  for (int timer = 0; timer < PWM_TIMERS; timer++) {
+    pwm_init(timer, clocks[timer][0], clocks[timer][1],
+             MIN_PERIOD + rand() % (MAX_PERIOD - MIN_PERIOD));
+    for (int channel = PWM_FIRST_CHANNEL; channel <= PWM_LAST_CHANNEL;
+         channel++) {
+      uint32_t duty = 1 + rand() % (period_of(timer) - 1);
+
+      pwm_enable(timer, channel, duty);
+      checks[timer][channel].requested = duty;
+      model_pending[timer] |= 1u << channel;
+    }
+  }
+
+  // shadowed updates only
+  random_updates(12000000, 50);
+
+  // two streams alongside them
+  fill(fade, 37, period_of(1));
+  fill(once, 20, period_of(3));
+  start_stream(1, 2, fade, 37, true);
+  start_stream(3, 4, once, 20, false);
+  random_updates(4000000, 50);
+
+  if (pwm_stream_running(3)) {
+    printf("one-shot stream still running\n");
+    errors++;
+  }
+  if (!pwm_stream_running(1)) {
+    printf("repeating stream stopped\n");
+    errors++;
+  }
+
+  stop_stream(1, 2);
+  stop_stream(3, 4);
+  random_updates(2000000, 50);
+
+  printf("%llu periods checked, %llu latches (%llu cut short), %llu streamed "
+         "periods, %llu errors\n",
+         (unsigned long long)periods_checked, (unsigned long long)latches,
+         (unsigned long long)cut_latches, (unsigned long long)stream_periods,
+         (unsigned long long)errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Host stand-in for the parts of driverlib and the device header that
+ * lib/pwm_engine.c uses, with the same names and values. The registers are
+ * plain memory that model.c steps like the hardware would.
+ */
+#ifndef MODEL_DRIVERLIB_H_
+#define MODEL_DRIVERLIB_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  volatile uint16_t CTL;
+  volatile uint16_t CCTL[7];
+  volatile uint16_t R;
+  volatile uint16_t CCR[7];
+  volatile uint16_t EX0;
+} Timer_A_Type;
+
+extern Timer_A_Type model_timers[4];
+
+// bases are indexes into model_timers
+#define TIMER_A0_BASE    0
+#define TIMER_A1_BASE    1
+#define TIMER_A2_BASE    2
+#define TIMER_A3_BASE    3
+#define TIMER_A_CMSIS(x) (&model_timers[x])
+
+#define TIMER_A_CTL_MC_MASK       0x0030
+#define TIMER_A_CCTLN_CCIFG       0x0001
+#define TIMER_A_CCTLN_OUT         0x0004
+#define TIMER_A_CCTLN_CCIE        0x0010
+#define TIMER_A_CCTLN_OUTMOD_MASK 0x00E0
+
+#define TIMER_A_CLOCKSOURCE_ACLK            0x0100
+#define TIMER_A_CLOCKSOURCE_SMCLK           0x0200
+#define TIMER_A_CLOCKSOURCE_DIVIDER_1       0x01
+#define TIMER_A_CLOCKSOURCE_DIVIDER_8       0x08
+#define TIMER_A_CLOCKSOURCE_DIVIDER_64      0x40
+#define TIMER_A_TAIE_INTERRUPT_DISABLE      0x00
+#define TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE 0x00
+#define TIMER_A_DO_CLEAR                    0x0004
+#define TIMER_A_UP_MODE                     0x0010
+#define TIMER_A_OUTPUTMODE_OUTBITVALUE      0x0000
+#define TIMER_A_OUTPUTMODE_RESET_SET        0x00E0
+
+typedef struct {
+  uint_fast16_t clockSource;
+  uint_fast16_t clockSourceDivider;
+  uint_fast16_t timerPeriod;
+  uint_fast16_t timerInterruptEnable_TAIE;
+  uint_fast16_t captureCompareInterruptEnable_CCR0_CCIE;
+  uint_fast16_t timerClear;
+} Timer_A_UpModeConfig;
+
+void Timer_A_configureUpMode(uint32_t                    timer,
+                             const Timer_A_UpModeConfig *config);
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode);
+void Timer_A_stopTimer(uint32_t timer);
+
+typedef struct {
+  volatile void    *srcEndAddr;
+  volatile void    *dstEndAddr;
+  volatile uint32_t control;
+  volatile uint32_t spare;
+} DMA_ControlTable;
+
+#define DMA_CH0_TIMERA0CCR0 0x06000000
+#define DMA_CH2_TIMERA1CCR0 0x06000002
+#define DMA_CH4_TIMERA2CCR0 0x06000004
+#define DMA_CH6_TIMERA3CCR0 0x06000006
+
+#define UDMA_ATTR_ALL      0x0000000F
+#define UDMA_MODE_STOP     0x00000000
+#define UDMA_MODE_BASIC    0x00000001
+#define UDMA_MODE_PINGPONG 0x00000003
+#define UDMA_DST_INC_NONE  0xc0000000
+#define UDMA_SRC_INC_16    0x04000000
+#define UDMA_SIZE_16       0x11000000
+#define UDMA_ARB_1         0x00000000
+#define UDMA_PRI_SELECT    0x00000000
+#define UDMA_ALT_SELECT    0x00000008
+
+void     DMA_enableModule(void);
+void     DMA_setControlBase(void *controlTable);
+void    *DMA_getControlBase(void);
+void     DMA_assignChannel(uint32_t mapping);
+void     DMA_disableChannelAttribute(uint32_t channelNum, uint32_t attr);
+void     DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control);
+void     DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode,
+                                void *srcAddr, void *dstAddr,
+                                uint32_t transferSize);
+uint32_t DMA_getChannelMode(uint32_t channelStructIndex);
+void     DMA_enableChannel(uint32_t channelNum);
+void     DMA_disableChannel(uint32_t channelNum);
+bool     DMA_isChannelEnabled(uint32_t channelNum);
+uint32_t DMA_getInterruptStatus(void);
+void     DMA_clearInterruptFlag(uint32_t channel);
+
+typedef enum {
+  TA0_0_IRQn    = 8,
+  TA1_0_IRQn    = 10,
+  TA2_0_IRQn    = 12,
+  TA3_0_IRQn    = 14,
+  DMA_INT0_IRQn = 34,
+} IRQn_Type;
+
+#define __NVIC_PRIO_BITS 3
+
+void     NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+void     NVIC_EnableIRQ(IRQn_Type irq);
+uint32_t __get_PRIMASK(void);
+void     __set_PRIMASK(uint32_t primask);
+void     __disable_irq(void);
+
+#endif /* MODEL_DRIVERLIB_H_ */
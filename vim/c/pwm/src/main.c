@@ -1,5 +1,14 @@
+#include "pwm_engine.h"
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
+// 100 kHz from the 12 MHz SMCLK
+#define PERIOD 120
+
+// P2.5 ramps up and down once per pass over this, 10 ms
+#define FADE_STEPS 1000
+
+static uint16_t fade[FADE_STEPS];
+
 int main(void) {
   /* Stop Watchdog Timer */
   WDT_A_holdTimer();
@@ -12,23 +21,25 @@ int main(void) {
   CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
   CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
 
-  /* Set P2.4 as Timer_A output for PWM */
-  GPIO_setAsPeripheralModuleFunctionOutputPin(GPIO_PORT_P2, GPIO_PIN4,
-                                              GPIO_PRIMARY_MODULE_FUNCTION);
+  /* Set P2.4 (TA0.1) and P2.5 (TA0.2) as Timer_A outputs for PWM */
+  GPIO_setAsPeripheralModuleFunctionOutputPin(
+      GPIO_PORT_P2, GPIO_PIN4 | GPIO_PIN5, GPIO_PRIMARY_MODULE_FUNCTION);
+
+  pwm_init(0, TIMER_A_CLOCKSOURCE_SMCLK, TIMER_A_CLOCKSOURCE_DIVIDER_1,
+           PERIOD);
+
+  /* Duty cycle = 72.5% on P2.4 */
+  pwm_enable(0, 1, PERIOD * 725 / 1000);
 
-  /* Configure Timer_A for PWM */
-  Timer_A_PWMConfig pwm_config = {
-      TIMER_A_CLOCKSOURCE_SMCLK,     // SMCLK as clock source
-      TIMER_A_CLOCKSOURCE_DIVIDER_1, // Divider = 1
-      (12000000 / 100000.0) - 1,     // Period for 100 kHz PWM with 12MHz SMCLK
-      TIMER_A_CAPTURECOMPARE_REGISTER_1,  // Use CCR1 for PWM
-      TIMER_A_OUTPUTMODE_RESET_SET,       // PWM output mode
-      ((12000000 / 100000.0) - 1) * 0.725 // Duty cycle = 72.5%
-  };
+  /* Triangle from 1 to PERIOD - 1 clocks and back on P2.5, fed by the DMA */
+  for (uint16_t i = 0; i < FADE_STEPS; i++) {
+    uint32_t ramp = i < FADE_STEPS / 2 ? i : FADE_STEPS - 1 - i;
+    uint32_t duty = 1 + ramp * (PERIOD - 2) / (FADE_STEPS / 2 - 1);
 
-  /* Generate PWM */
-  Timer_A_generatePWM(TIMER_A0_BASE, &pwm_config);
+    fade[i] = PWM_STREAM_COMPARE(duty);
+  }
+  pwm_stream_start(0, 2, fade, FADE_STEPS, true);
 
-  /* Enter low power mode */
+  /* Enter low power mode, the DMA and timer interrupts wake it */
   while (1) { PCM_gotoLPM0(); }
 }
@@ -0,0 +1,526 @@
+#include "rtos.h"
+#include <string.h>
+#include <ti/devices/msp432p4xx/driverlib/fpu.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+#define STATE_READY   0
+#define STATE_BLOCKED 1
+#define STATE_DEAD    2
+
+// thread mode, process stack, no FPU state yet
+#define EXC_RETURN_THREAD_PSP 0xFFFFFFFDu
+
+#define STR_(x) #x
+#define STR(x)  STR_(x)
+
+// read by PendSV_Handler
+rtos_thread *volatile rtos_current;
+rtos_thread *volatile rtos_next;
+
+static rtos_list         ready[RTOS_PRIORITIES];
+static uint32_t          ready_bits;
+static rtos_thread      *timers;
+static volatile uint32_t ticks;
+static uint32_t          tick_cycles;
+
+static rtos_thread idle_thread;
+static uint32_t    idle_stack[RTOS_MIN_STACK_WORDS];
+
+static uint32_t lock(void) {
+  uint32_t state = __get_BASEPRI();
+  __set_BASEPRI_MAX(RTOS_SYSCALL_PRIORITY);
+  return state;
+}
+
+static void unlock(uint32_t state) { __set_BASEPRI(state); }
+
+// Lists: circular, head->prev is the tail. Everything below runs locked.
+
+static void list_append(rtos_list *l, rtos_thread *t) {
+  if (l->head) {
+    t->next             = l->head;
+    t->prev             = l->head->prev;
+    l->head->prev->next = t;
+    l->head->prev       = t;
+  } else {
+    l->head = t->next = t->prev = t;
+  }
+}
+
+static void list_remove(rtos_list *l, rtos_thread *t) {
+  if (t->next == t) {
+    l->head = 0;
+  } else {
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    if (l->head == t) {
+      l->head = t->next;
+    }
+  }
+}
+
+// behind every waiter of the same or higher priority
+static void wait_insert(rtos_list *l, rtos_thread *t) {
+  rtos_thread *w = l->head;
+
+  if (!w) {
+    list_append(l, t);
+    return;
+  }
+  do {
+    if (w->priority < t->priority) {
+      break;
+    }
+    w = w->next;
+  } while (w != l->head);
+
+  // in front of w, which is the head again if everyone went first
+  t->next       = w;
+  t->prev       = w->prev;
+  w->prev->next = t;
+  w->prev       = t;
+  if (w == l->head && w->priority < t->priority) {
+    l->head = t;
+  }
+}
+
+static void ready_insert(rtos_thread *t) {
+  t->state = STATE_READY;
+  list_append(&ready[t->priority], t);
+  ready_bits |= 1u << t->priority;
+}
+
+static void ready_remove(rtos_thread *t) {
+  list_remove(&ready[t->priority], t);
+  if (!ready[t->priority].head) {
+    ready_bits &= ~(1u << t->priority);
+  }
+}
+
+static void timer_insert(rtos_thread *t, uint32_t wake) {
+  rtos_thread **p = &timers;
+  while (*p && (int32_t)((*p)->wake - wake) <= 0) {
+    p = &(*p)->timer_next;
+  }
+  t->wake       = wake;
+  t->timed      = true;
+  t->timer_next = *p;
+  *p            = t;
+}
+
+static void timer_remove(rtos_thread *t) {
+  for (rtos_thread **p = &timers; *p; p = &(*p)->timer_next) {
+    if (*p == t) {
+      *p = t->timer_next;
+      break;
+    }
+  }
+  t->timed = false;
+}
+
+// the idle thread is always ready, so there is always a bit to find
+static void reschedule(void) {
+  rtos_thread *best = ready[31 - __CLZ(ready_bits)].head;
+  rtos_next         = best;
+  if (best != rtos_current) {
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+  }
+}
+
+// deadlines are compared by their signed distance from ticks, so they can be
+// at most 2^31 - 1 ahead
+static uint32_t clamp_timeout(uint32_t timeout) {
+  if (timeout != RTOS_WAIT_FOREVER && timeout > RTOS_MAX_TIMEOUT) {
+    return RTOS_MAX_TIMEOUT;
+  }
+  return timeout;
+}
+
+// takes the running thread off the ready list, the switch happens once the
+// caller unlocks
+static void block(rtos_list *wait, uint32_t timeout) {
+  rtos_thread *t = rtos_current;
+
+  ready_remove(t);
+  t->state = STATE_BLOCKED;
+  if (wait) {
+    wait_insert(wait, t);
+    t->wait_list = wait;
+  }
+  if (timeout != RTOS_WAIT_FOREVER) {
+    timer_insert(t, ticks + clamp_timeout(timeout));
+  }
+  reschedule();
+}
+
+static void wake(rtos_thread *t) {
+  if (t->wait_list) {
+    list_remove(t->wait_list, t);
+    t->wait_list = 0;
+  }
+  if (t->timed) {
+    timer_remove(t);
+  }
+  ready_insert(t);
+}
+
+static void set_priority(rtos_thread *t, uint8_t priority) {
+  if (t->state == STATE_READY) {
+    ready_remove(t);
+    t->priority = priority;
+    ready_insert(t);
+  } else {
+    t->priority = priority;
+    if (t->wait_list) { // keep the wait list in priority order
+      list_remove(t->wait_list, t);
+      wait_insert(t->wait_list, t);
+    }
+  }
+}
+
+static void thread_exit(void) {
+  uint32_t state = lock();
+  ready_remove(rtos_current);
+  rtos_current->state = STATE_DEAD;
+  reschedule();
+  unlock(state);
+  while (1) {}
+}
+
+static void idle(void *arg) {
+  (void)arg;
+  while (1) {
+    __WFI();
+  }
+}
+
+void rtos_init(void) {
+  for (uint32_t i = 0; i < RTOS_PRIORITIES; i++) {
+    ready[i].head = 0;
+  }
+  ready_bits   = 0;
+  timers       = 0;
+  ticks        = 0;
+  rtos_current = 0;
+
+  // s16-s31 are only stacked by threads that touched the FPU, s0-s15 only
+  // once an ISR does
+  FPU_enableModule();
+  FPU_enableLazyStacking();
+
+  rtos_thread_create(&idle_thread, "idle", idle, 0, idle_stack,
+                     RTOS_MIN_STACK_WORDS, 0);
+}
+
+void rtos_thread_create(rtos_thread *t, const char *name, rtos_entry entry,
+                        void *arg, uint32_t *stack, uint32_t stack_words,
+                        uint8_t priority) {
+  // AAPCS wants the stack 8 byte aligned at the exception frame
+  uint32_t *sp = (uint32_t *)((uint32_t)(stack + stack_words) & ~7u);
+
+  // exception frame, popped by the hardware
+  *--sp = 0x01000000u;                // xPSR, Thumb
+  *--sp = (uint32_t)entry & ~1u;      // PC
+  *--sp = (uint32_t)thread_exit;      // LR
+  *--sp = 0;                          // R12
+  *--sp = 0;                          // R3
+  *--sp = 0;                          // R2
+  *--sp = 0;                          // R1
+  *--sp = (uint32_t)arg;              // R0
+  // saved by PendSV_Handler
+  *--sp = EXC_RETURN_THREAD_PSP;      // LR
+  for (uint32_t i = 4; i <= 11; i++) { // R11 to R4
+    *--sp = 0;
+  }
+
+  t->sp            = sp;
+  t->timed         = false;
+  t->wait_list     = 0;
+  t->held          = 0;
+  t->blocked_on    = 0;
+  t->priority      = priority;
+  t->base_priority = priority;
+  t->name          = name;
+
+  uint32_t state = lock();
+  ready_insert(t);
+  if (rtos_current) {
+    reschedule();
+  }
+  unlock(state);
+}
+
+void rtos_start(uint32_t core_hz) {
+  lock(); // nothing may run before the first switch
+
+  tick_cycles = core_hz / RTOS_TICK_HZ;
+  SysTick_Config(tick_cycles);
+
+  // the tick calls into the kernel, so it has to be maskable by it
+  NVIC_SetPriority(SysTick_IRQn, 0x60 >> (8 - __NVIC_PRIO_BITS));
+  NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+
+  rtos_next = ready[31 - __CLZ(ready_bits)].head;
+  SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+  __set_BASEPRI(0);
+  __enable_irq();
+
+  while (1) {} // PendSV never comes back here
+}
+
+rtos_thread *rtos_self(void) { return rtos_current; }
+
+uint32_t rtos_ticks(void) { return ticks; }
+
+uint32_t rtos_tick_cycles(void) { return tick_cycles; }
+
+void rtos_yield(void) {
+  uint32_t  state = lock();
+  rtos_list *l     = &ready[rtos_current->priority];
+  if (l->head == rtos_current) {
+    l->head = rtos_current->next;
+  }
+  reschedule();
+  unlock(state);
+}
+
+void rtos_sleep(uint32_t delay) {
+  if (delay == 0) {
+    rtos_yield();
+    return;
+  }
+
+  uint32_t state = lock();
+  block(0, delay);
+  unlock(state);
+}
+
+void rtos_mutex_init(rtos_mutex *m) {
+  m->owner        = 0;
+  m->next_held    = 0;
+  m->waiters.head = 0;
+}
+
+static void mutex_take(rtos_mutex *m, rtos_thread *t) {
+  m->owner     = t;
+  m->next_held = t->held;
+  t->held      = m;
+}
+
+void rtos_mutex_lock(rtos_mutex *m) {
+  uint32_t     state = lock();
+  rtos_thread *self  = rtos_current;
+
+  if (!m->owner) {
+    mutex_take(m, self);
+    unlock(state);
+    return;
+  }
+
+  // lend our priority down the chain of owners, each one may itself be
+  // waiting for a mutex held by someone lower
+  for (rtos_mutex *w = m; w && w->owner->priority < self->priority;
+       w = w->owner->blocked_on) {
+    set_priority(w->owner, self->priority);
+  }
+
+  self->blocked_on = m;
+  block(&m->waiters, RTOS_WAIT_FOREVER);
+  unlock(state);
+  // rtos_mutex_unlock() handed it straight to us
+}
+
+void rtos_mutex_unlock(rtos_mutex *m) {
+  uint32_t     state = lock();
+  rtos_thread *self  = rtos_current;
+  rtos_thread *next  = m->waiters.head;
+  uint8_t      priority;
+
+  for (rtos_mutex **p = &self->held; *p; p = &(*p)->next_held) {
+    if (*p == m) {
+      *p = m->next_held;
+      break;
+    }
+  }
+
+  m->owner = 0;
+  if (next) {
+    next->blocked_on = 0;
+    wake(next);
+    mutex_take(m, next);
+  }
+
+  // keep only what waiters on the mutexes still held are owed
+  priority = self->base_priority;
+  for (rtos_mutex *h = self->held; h; h = h->next_held) {
+    if (h->waiters.head && h->waiters.head->priority > priority) {
+      priority = h->waiters.head->priority;
+    }
+  }
+  if (priority != self->priority) {
+    set_priority(self, priority);
+  }
+
+  reschedule();
+  unlock(state);
+}
+
+void rtos_queue_init(rtos_queue *q, void *buffer, uint16_t item_size,
+                     uint16_t capacity) {
+  q->buffer         = buffer;
+  q->item_size      = item_size;
+  q->capacity       = capacity;
+  q->count          = 0;
+  q->head           = 0;
+  q->senders.head   = 0;
+  q->receivers.head = 0;
+}
+
+static void queue_put(rtos_queue *q, const void *item) {
+  uint16_t tail = q->head + q->count;
+  if (tail >= q->capacity) {
+    tail -= q->capacity;
+  }
+  memcpy(&q->buffer[tail * q->item_size], item, q->item_size);
+  q->count++;
+  if (q->receivers.head) {
+    wake(q->receivers.head);
+    reschedule();
+  }
+}
+
+static void queue_get(rtos_queue *q, void *item) {
+  memcpy(item, &q->buffer[q->head * q->item_size], q->item_size);
+  if (++q->head == q->capacity) {
+    q->head = 0;
+  }
+  q->count--;
+  if (q->senders.head) {
+    wake(q->senders.head);
+    reschedule();
+  }
+}
+
+// blocks on wait until ready() or the deadline, true if ready() came first;
+// returns locked
+static bool queue_wait(rtos_queue *q, rtos_list *wait,
+                       bool (*ready)(rtos_queue *), uint32_t timeout,
+                       uint32_t *state) {
+  uint32_t deadline;
+
+  timeout  = clamp_timeout(timeout);
+  deadline = ticks + timeout;
+
+  while (!ready(q)) {
+    uint32_t left = timeout;
+    if (timeout != RTOS_WAIT_FOREVER) {
+      left = deadline - ticks;
+      if ((int32_t)left <= 0) { // also RTOS_NO_WAIT
+        return false;
+      }
+    }
+    block(wait, left);
+    unlock(*state);
+    // woken by the other side, or timed out; either way look again
+    *state = lock();
+  }
+  return true;
+}
+
+static bool queue_has_space(rtos_queue *q) { return q->count < q->capacity; }
+
+static bool queue_has_item(rtos_queue *q) { return q->count != 0; }
+
+bool rtos_queue_send(rtos_queue *q, const void *item, uint32_t timeout) {
+  uint32_t state = lock();
+  bool     ok    = queue_wait(q, &q->senders, queue_has_space, timeout, &state);
+  if (ok) {
+    queue_put(q, item);
+  }
+  unlock(state);
+  return ok;
+}
+
+bool rtos_queue_receive(rtos_queue *q, void *item, uint32_t timeout) {
+  uint32_t state = lock();
+  bool     ok = queue_wait(q, &q->receivers, queue_has_item, timeout, &state);
+  if (ok) {
+    queue_get(q, item);
+  }
+  unlock(state);
+  return ok;
+}
+
+bool rtos_queue_send_from_isr(rtos_queue *q, const void *item) {
+  uint32_t state = lock();
+  bool     ok    = queue_has_space(q);
+  if (ok) {
+    queue_put(q, item);
+  }
+  unlock(state);
+  return ok;
+}
+
+bool rtos_queue_receive_from_isr(rtos_queue *q, void *item) {
+  uint32_t state = lock();
+  bool     ok    = queue_has_item(q);
+  if (ok) {
+    queue_get(q, item);
+  }
+  unlock(state);
+  return ok;
+}
+
+void SysTick_Handler(void) {
+  uint32_t state = lock();
+  uint32_t now   = ++ticks;
+
+  while (timers && (int32_t)(now - timers->wake) >= 0) {
+    rtos_thread *t = timers;
+    timers         = t->timer_next;
+    t->timed       = false;
+    wake(t);
+  }
+
+  // time slice between threads of the running priority
+  if (rtos_current && rtos_current->state == STATE_READY) {
+    rtos_list *l = &ready[rtos_current->priority];
+    if (l->head == rtos_current) {
+      l->head = rtos_current->next;
+    }
+  }
+
+  reschedule();
+  unlock(state);
+}
+
+// Saves R4-R11 and EXC_RETURN (plus S16-S31 if the thread's frame has FPU
+// state) on the outgoing process stack, restores them from rtos_next's.
+// Runs with kernel interrupts masked so rtos_next cannot change under it.
+__attribute__((naked)) void PendSV_Handler(void) {
+  __asm volatile("  movs    r0, #" STR(RTOS_SYSCALL_PRIORITY) "\n"
+                 "  msr     basepri, r0\n"
+                 "  ldr     r3, =rtos_current\n"
+                 "  ldr     r2, [r3]\n"
+                 "  cbz     r2, 1f\n" // first switch, nothing to save
+                 "  mrs     r0, psp\n"
+                 "  tst     lr, #0x10\n"
+                 "  it      eq\n"
+                 "  vstmdbeq r0!, {s16-s31}\n"
+                 "  stmdb   r0!, {r4-r11, lr}\n"
+                 "  str     r0, [r2]\n"
+                 "1:\n"
+                 "  ldr     r1, =rtos_next\n"
+                 "  ldr     r2, [r1]\n"
+                 "  str     r2, [r3]\n"
+                 "  ldr     r0, [r2]\n"
+                 "  ldmia   r0!, {r4-r11, lr}\n"
+                 "  tst     lr, #0x10\n"
+                 "  it      eq\n"
+                 "  vldmiaeq r0!, {s16-s31}\n"
+                 "  msr     psp, r0\n"
+                 "  movs    r0, #0\n"
+                 "  msr     basepri, r0\n"
+                 "  bx      lr\n"
+                 "  .ltorg\n");
+}
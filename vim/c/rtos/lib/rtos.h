@@ -0,0 +1,119 @@
+/*
+ * Small preemptive kernel for the Cortex-M4F
+ *
+ * Fixed priority threads, 0 (idle) to RTOS_PRIORITIES - 1 (most urgent).
+ * The highest priority ready thread always runs and threads of the same
+ * priority share the CPU round robin, one tick at a time. Picking the next
+ * thread is O(1): one bit per priority with a ready thread, found with CLZ.
+ *
+ * Context switches happen in PendSV at the lowest exception priority, so any
+ * number of kernel calls from ISRs collapse into one switch on the way out.
+ * FPU registers are only saved for threads that have used the FPU (lazy
+ * stacking, see FPU_enableLazyStacking()).
+ *
+ * The kernel masks interrupts with BASEPRI, never PRIMASK. ISRs at a
+ * priority numerically below RTOS_SYSCALL_PRIORITY are never delayed by it,
+ * but must not call into it either. ISRs that do may only use the _from_isr
+ * calls.
+ */
+#ifndef RTOS_H_
+#define RTOS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RTOS_PRIORITIES 32
+#define RTOS_TICK_HZ    1000
+
+// BASEPRI inside the kernel, the DMA level of the interrupt.h priority plan;
+// TOP and FAST ISRs are above it
+#define RTOS_SYSCALL_PRIORITY 0x40
+
+// timeouts, in ticks; longer ones than RTOS_MAX_TIMEOUT, 24 days at 1 kHz,
+// are cut to it
+#define RTOS_NO_WAIT      0
+#define RTOS_MAX_TIMEOUT  0x7FFFFFFFu
+#define RTOS_WAIT_FOREVER 0xFFFFFFFFu
+
+// smallest useful stack: both exception frames with FPU state plus a little
+#define RTOS_MIN_STACK_WORDS 128
+
+typedef void (*rtos_entry)(void *arg);
+
+struct rtos_list;
+struct rtos_mutex;
+
+typedef struct rtos_thread {
+  uint32_t *sp; // must stay first, PendSV_Handler saves to it
+  // ready or wait list, circular
+  struct rtos_thread *next;
+  struct rtos_thread *prev;
+  // sleep and timeout list, sorted by wake
+  struct rtos_thread *timer_next;
+  uint32_t            wake;
+  bool                timed;
+  struct rtos_list   *wait_list;  // list blocked on, if any
+  struct rtos_mutex  *held;       // mutexes owned, last locked first
+  struct rtos_mutex  *blocked_on; // for passing on inherited priority
+  uint8_t             priority;   // may be raised by priority inheritance
+  uint8_t             base_priority;
+  uint8_t             state;
+  const char         *name;
+} rtos_thread;
+
+typedef struct rtos_list {
+  rtos_thread *head;
+} rtos_list;
+
+// non-recursive, owned by the thread that locked it
+typedef struct rtos_mutex {
+  rtos_thread       *owner;
+  struct rtos_mutex *next_held;
+  rtos_list          waiters; // highest priority first
+} rtos_mutex;
+
+// fixed size items copied in and out of a caller supplied ring buffer
+typedef struct {
+  uint8_t  *buffer;
+  uint16_t  item_size;
+  uint16_t  capacity;
+  uint16_t  count;
+  uint16_t  head;
+  rtos_list senders;
+  rtos_list receivers;
+} rtos_queue;
+
+// sets up the idle thread and the FPU, call before anything else
+void rtos_init(void);
+// stack is stack_words words, at least RTOS_MIN_STACK_WORDS; priority 1 to
+// RTOS_PRIORITIES - 1. May be called before or after rtos_start().
+void rtos_thread_create(rtos_thread *t, const char *name, rtos_entry entry,
+                        void *arg, uint32_t *stack, uint32_t stack_words,
+                        uint8_t priority);
+// starts SysTick at RTOS_TICK_HZ from core_hz and runs the threads, the
+// calling stack becomes the interrupt stack
+void rtos_start(uint32_t core_hz) __attribute__((noreturn));
+
+rtos_thread *rtos_self(void);
+uint32_t     rtos_ticks(void);
+// SysTick reload, the number of core clocks per tick
+uint32_t     rtos_tick_cycles(void);
+void         rtos_yield(void);
+void         rtos_sleep(uint32_t ticks);
+
+void rtos_mutex_init(rtos_mutex *m);
+// raises the owner (and whatever it is blocked on) to the caller's priority
+// until it unlocks
+void rtos_mutex_lock(rtos_mutex *m);
+void rtos_mutex_unlock(rtos_mutex *m);
+
+void rtos_queue_init(rtos_queue *q, void *buffer, uint16_t item_size,
+                     uint16_t capacity);
+// false if the timeout ran out first
+bool rtos_queue_send(rtos_queue *q, const void *item, uint32_t timeout);
+bool rtos_queue_receive(rtos_queue *q, void *item, uint32_t timeout);
+// never block, false when full or empty
+bool rtos_queue_send_from_isr(rtos_queue *q, const void *item);
+bool rtos_queue_receive_from_isr(rtos_queue *q, void *item);
+
+#endif /* RTOS_H_ */
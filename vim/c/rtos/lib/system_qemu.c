@@ -0,0 +1,14 @@
+/*
+ * SystemInit for `make QEMU=1`. The mps2-an386 board QEMU emulates has the
+ * same Cortex-M4F core but none of the MSP432 clock, power or watchdog
+ * modules, so system_msp432p4111.c is left out and only the FPU is enabled.
+ */
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+// the board's fixed system clock
+uint32_t SystemCoreClock = 25000000;
+
+void SystemInit(void) {
+  SCB->CPACR |= ((3UL << 10 * 2) | /* Set CP10 Full Access */
+                 (3UL << 11 * 2)); /* Set CP11 Full Access */
+}
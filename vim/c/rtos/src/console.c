@@ -0,0 +1,67 @@
+#include "console.h"
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#ifdef RTOS_QEMU
+
+#define UART0_DATA    (*(volatile uint32_t *)0x40004000)
+#define UART0_STATE   (*(volatile uint32_t *)0x40004004)
+#define UART0_CTRL    (*(volatile uint32_t *)0x40004008)
+#define UART0_BAUDDIV (*(volatile uint32_t *)0x40004010)
+
+void console_init(void) {
+  UART0_BAUDDIV = 16;
+  UART0_CTRL    = 0x01; // TX enable
+}
+
+static void console_putc(char c) {
+  while (UART0_STATE & 0x01) {} // TX buffer full
+  UART0_DATA = c;
+}
+
+#else
+
+// 115200 baud from a 12 MHz SMCLK
+static const eUSCI_UART_ConfigV1 uart_config = {
+    EUSCI_A_UART_CLOCKSOURCE_SMCLK,                // SMCLK Clock Source
+    6,                                             // BRDIV = 6
+    8,                                             // UCxBRF = 8
+    0x20,                                          // UCxBRS = 0x20
+    EUSCI_A_UART_NO_PARITY,                        // No Parity
+    EUSCI_A_UART_LSB_FIRST,                        // LSB First
+    EUSCI_A_UART_ONE_STOP_BIT,                     // One stop bit
+    EUSCI_A_UART_MODE,                             // UART mode
+    EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION, // Oversampling
+    EUSCI_A_UART_8_BIT_LEN                         // 8 bit data length
+};
+
+void console_init(void) {
+  /* P1.2 and P1.3 in UART mode */
+  GPIO_setAsPeripheralModuleFunctionInputPin(
+      GPIO_PORT_P1, GPIO_PIN2 | GPIO_PIN3, GPIO_PRIMARY_MODULE_FUNCTION);
+
+  UART_initModule(EUSCI_A0_BASE, &uart_config);
+  UART_enableModule(EUSCI_A0_BASE);
+}
+
+static void console_putc(char c) { UART_transmitData(EUSCI_A0_BASE, c); }
+
+#endif
+
+void console_puts(const char *s) {
+  while (*s) {
+    console_putc(*s++);
+  }
+}
+
+void console_put_uint(uint32_t value) {
+  char     buf[11];
+  uint32_t i = sizeof(buf) - 1;
+
+  buf[i] = '\0';
+  do {
+    buf[--i]  = '0' + (value % 10);
+    value    /= 10;
+  } while (value);
+
+  console_puts(&buf[i]);
+}
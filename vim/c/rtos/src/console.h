@@ -0,0 +1,12 @@
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include <stdint.h>
+
+// eUSCI_A0 at 115200 (the LaunchPad's backchannel UART), or the CMSDK UART0
+// of the mps2-an386 board when built with QEMU=1. Blocking, not thread safe.
+void console_init(void);
+void console_puts(const char *s);
+void console_put_uint(uint32_t value);
+
+#endif /* CONSOLE_H_ */
@@ -0,0 +1,234 @@
+/*
+ * Kernel benchmarks, printed on the console:
+ *
+ *   yield          one switch between two threads of the same priority
+ *   yield fpu      the same with both threads holding FPU state
+ *   queue          a send/receive round trip through a higher priority
+ *                  thread, two switches
+ *   isr to thread  from an ISR sending on a queue to the woken thread
+ *                  running
+ *   inheritance    a high thread waiting on a mutex held by a low one while
+ *                  a middle one spins; only short if the low one was boosted
+ *
+ * Times are in core clocks, read from SysTick. Under QEMU they count
+ * instructions of the emulated 25 MHz board (run with -icount shift=0), only
+ * good for comparing one build against another.
+ */
+#include "console.h"
+#include "rtos.h"
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define BENCH_ROUNDS 1000
+#define STACK_WORDS  256
+
+// any line nothing else drives, pended from software
+#define BENCH_IRQn T32_INTC_IRQn
+
+static rtos_thread bench_thread;
+static uint32_t    bench_stack[STACK_WORDS * 2];
+static rtos_thread workers[8];
+static uint32_t    worker_stacks[8][STACK_WORDS];
+
+static rtos_mutex console_lock;
+
+static uint32_t   done_buffer[2];
+static rtos_queue done;
+
+static uint32_t   request_buffer[1], response_buffer[1];
+static rtos_queue requests, responses;
+
+static uint32_t   isr_buffer[4];
+static rtos_queue isr_stamps;
+
+static rtos_mutex shared;
+
+// core clocks since rtos_start(), wraps
+static uint32_t cycles(void) {
+  uint32_t t, v;
+  do {
+    t = rtos_ticks();
+    v = SysTick->VAL;
+  } while (t != rtos_ticks());
+  return t * rtos_tick_cycles() + (rtos_tick_cycles() - 1 - v);
+}
+
+static void report(const char *name, uint32_t value, const char *unit) {
+  rtos_mutex_lock(&console_lock);
+  console_puts(name);
+  console_puts(": ");
+  console_put_uint(value);
+  console_puts(unit);
+  console_puts("\r\n");
+  rtos_mutex_unlock(&console_lock);
+}
+
+static void start_worker(uint32_t n, rtos_entry entry, void *arg,
+                         uint8_t priority) {
+  rtos_thread_create(&workers[n], "worker", entry, arg, worker_stacks[n],
+                     STACK_WORDS, priority);
+}
+
+// the last one out tells the bench thread
+static volatile uint32_t yielders_left;
+
+static void yielder(void *arg) {
+  (void)arg;
+  for (uint32_t i = 0; i < BENCH_ROUNDS; i++) {
+    rtos_yield();
+  }
+  if (--yielders_left == 0) {
+    uint32_t now = cycles();
+    rtos_queue_send(&done, &now, RTOS_WAIT_FOREVER);
+  }
+}
+
+static void fpu_yielder(void *arg) {
+  volatile float x = 0.0f;
+
+  (void)arg;
+  for (uint32_t i = 0; i < BENCH_ROUNDS; i++) {
+    x += 1.0f; // the thread now has FPU state to switch
+    rtos_yield();
+  }
+  if (--yielders_left == 0) {
+    uint32_t now = cycles();
+    rtos_queue_send(&done, &now, RTOS_WAIT_FOREVER);
+  }
+}
+
+static void echo(void *arg) {
+  uint32_t value;
+
+  (void)arg;
+  while (1) {
+    rtos_queue_receive(&requests, &value, RTOS_WAIT_FOREVER);
+    rtos_queue_send(&responses, &value, RTOS_WAIT_FOREVER);
+  }
+}
+
+void T32_INTC_IRQHandler(void) {
+  uint32_t now = cycles();
+  rtos_queue_send_from_isr(&isr_stamps, &now);
+}
+
+static volatile uint32_t isr_max, isr_total;
+
+static void isr_waiter(void *arg) {
+  uint32_t stamp;
+
+  (void)arg;
+  while (1) {
+    rtos_queue_receive(&isr_stamps, &stamp, RTOS_WAIT_FOREVER);
+    uint32_t latency = cycles() - stamp;
+    isr_total += latency;
+    if (latency > isr_max) {
+      isr_max = latency;
+    }
+  }
+}
+
+static volatile uint8_t boosted;
+
+static void low(void *arg) {
+  (void)arg;
+  rtos_mutex_lock(&shared);
+  rtos_sleep(5); // high blocks on the mutex meanwhile
+  boosted = rtos_self()->priority;
+  rtos_mutex_unlock(&shared);
+}
+
+static void high(void *arg) {
+  (void)arg;
+  uint32_t start = rtos_ticks();
+  rtos_mutex_lock(&shared);
+  uint32_t waited = rtos_ticks() - start;
+  rtos_mutex_unlock(&shared);
+  rtos_queue_send(&done, &waited, RTOS_WAIT_FOREVER);
+}
+
+static uint32_t yield_bench(rtos_entry entry, uint32_t first_worker) {
+  uint32_t start, end;
+
+  // both run at a lower priority, so only once this thread waits
+  yielders_left = 2;
+  start_worker(first_worker, entry, 0, 3);
+  start_worker(first_worker + 1, entry, 0, 3);
+  start = cycles();
+  rtos_queue_receive(&done, &end, RTOS_WAIT_FOREVER);
+  return (end - start) / (2 * BENCH_ROUNDS);
+}
+
+static void bench(void *arg) {
+  uint32_t start, value, waited;
+
+  (void)arg;
+  rtos_mutex_lock(&console_lock);
+  console_puts("\r\nrtos benchmarks, ");
+  console_put_uint(BENCH_ROUNDS);
+  console_puts(" rounds\r\n");
+  rtos_mutex_unlock(&console_lock);
+
+  report("yield", yield_bench(yielder, 0), " cycles");
+  report("yield fpu", yield_bench(fpu_yielder, 2), " cycles");
+
+  start_worker(4, echo, 0, 5);
+  start = cycles();
+  for (uint32_t i = 0; i < BENCH_ROUNDS; i++) {
+    rtos_queue_send(&requests, &i, RTOS_WAIT_FOREVER);
+    rtos_queue_receive(&responses, &value, RTOS_WAIT_FOREVER);
+  }
+  report("queue", (cycles() - start) / BENCH_ROUNDS, " cycles");
+
+  // the ISR has to be maskable by the kernel to call into it
+  start_worker(5, isr_waiter, 0, 6);
+  NVIC_SetPriority(BENCH_IRQn, 0x80 >> (8 - __NVIC_PRIO_BITS));
+  NVIC_EnableIRQ(BENCH_IRQn);
+  for (uint32_t i = 0; i < BENCH_ROUNDS; i++) {
+    NVIC_SetPendingIRQ(BENCH_IRQn); // isr_waiter is done before this returns
+  }
+  NVIC_DisableIRQ(BENCH_IRQn);
+  report("isr to thread", isr_total / BENCH_ROUNDS, " cycles");
+  report("isr to thread max", isr_max, " cycles");
+
+  // low takes the mutex first, high then blocks on it while this thread
+  // spins at the priority in between
+  start_worker(6, low, 0, 2);
+  rtos_sleep(1);
+  start_worker(7, high, 0, 6);
+  start = rtos_ticks();
+  while (rtos_ticks() - start < 20) {}
+  rtos_queue_receive(&done, &waited, RTOS_WAIT_FOREVER);
+  report("inheritance wait", waited, " ticks");
+  report("inheritance boost", boosted, "");
+}
+
+int main(void) {
+  uint32_t core_hz;
+
+#ifdef RTOS_QEMU
+  core_hz = SystemCoreClock;
+#else
+  /* Stop Watchdog Timer */
+  WDT_A_holdTimer();
+
+  /* MCLK and SMCLK from the DCO at 12 MHz */
+  CS_setDCOCenteredFrequency(CS_DCO_FREQUENCY_12);
+  CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  core_hz = CS_getMCLK();
+#endif
+
+  console_init();
+
+  rtos_init();
+  rtos_mutex_init(&console_lock);
+  rtos_mutex_init(&shared);
+  rtos_queue_init(&done, done_buffer, sizeof(uint32_t), 2);
+  rtos_queue_init(&requests, request_buffer, sizeof(uint32_t), 1);
+  rtos_queue_init(&responses, response_buffer, sizeof(uint32_t), 1);
+  rtos_queue_init(&isr_stamps, isr_buffer, sizeof(uint32_t), 4);
+
+  rtos_thread_create(&bench_thread, "bench", bench, 0, bench_stack,
+                     STACK_WORDS * 2, 4);
+  rtos_start(core_hz);
+}